@@ -39,6 +39,9 @@
 
 #include "fileinfothread_p.h"
 #include <qdiriterator.h>
+#include <qelapsedtimer.h>
+
+#include <algorithm>
 
 #include <QDebug>
 
@@ -51,6 +54,7 @@ FileInfoThread::FileInfoThread(QObject *parent)
 #endif
       sortFlags(QDir::Name),
       needUpdate(true),
+      pathUpdate(false),
       folderUpdate(false),
       sortUpdate(false),
       showFiles(true),
@@ -109,6 +113,7 @@ void FileInfoThread::setPath(const QString &path)
 #endif
     currentPath = path;
     needUpdate = true;
+    pathUpdate = true;
     condition.wakeAll();
 }
 
@@ -214,32 +219,94 @@ void FileInfoThread::updateFile(const QString &path)
 }
 #endif
 
+namespace {
+
+/*
+    Orders FileProperty entries the same way QDir::entryInfoList() orders
+    QFileInfo entries for the sort flags used by the model, so that batches
+    can be merged into the list incrementally as the directory is read.
+*/
+class FilePropertyLessThan
+{
+public:
+    FilePropertyLessThan(QDir::SortFlags flags) : flags(flags) {}
+
+    bool isUnsorted() const { return (flags & QDir::SortByMask) == QDir::Unsorted; }
+
+    bool operator()(const FileProperty &f1, const FileProperty &f2) const
+    {
+        if ((flags & QDir::DirsFirst) && f1.isDir() != f2.isDir())
+            return f1.isDir();
+        if ((flags & QDir::DirsLast) && f1.isDir() != f2.isDir())
+            return !f1.isDir();
+
+        qint64 r = 0;
+        switch (flags & QDir::SortByMask) {
+        case QDir::Time:
+            r = f2.lastModified().toMSecsSinceEpoch() - f1.lastModified().toMSecsSinceEpoch();
+            break;
+        case QDir::Size:
+            r = f2.size() - f1.size();
+            break;
+        case QDir::Type:
+            r = suffix(f1).compare(suffix(f2));
+            break;
+        default:
+            break;
+        }
+
+        if (r == 0)
+            r = f1.fileName().compare(f2.fileName());
+
+        return (flags & QDir::Reversed) ? r > 0 : r < 0;
+    }
+
+private:
+    // QDir sorts by QFileInfo::suffix(), whereas FileProperty holds the complete suffix.
+    static QString suffix(const FileProperty &file)
+    {
+        const QString name = file.fileName();
+        const int dot = name.lastIndexOf(QLatin1Char('.'));
+        return dot < 0 ? QString() : name.mid(dot + 1);
+    }
+
+    QDir::SortFlags flags;
+};
+
+}
+
 void FileInfoThread::run()
 {
     forever {
-        bool updateFiles = false;
         QMutexLocker locker(&mutex);
-        if (abort) {
-            return;
-        }
-        if (currentPath.isEmpty() || !needUpdate)
+        while (!abort && (currentPath.isEmpty() || !(pathUpdate || needUpdate || folderUpdate || sortUpdate)))
             condition.wait(&mutex);
 
         if (abort) {
             return;
         }
 
-        if (!currentPath.isEmpty()) {
-            updateFiles = true;
-        }
-        if (updateFiles)
-            getFileInfos(currentPath);
-        locker.unlock();
+        getFileInfos(currentPath);
     }
 }
 
-
+/*
+    Called with the mutex locked. A new path is streamed to the model in
+    batches, a change to the folder or the filters is applied as a diff
+    against the current list, and a change to the sort order only resorts
+    the list already held in memory.
+*/
 void FileInfoThread::getFileInfos(const QString &path)
+{
+    if (pathUpdate)
+        scanFileInfos(path);
+    else if (folderUpdate || needUpdate)
+        updateFileInfos(path);
+    else if (sortUpdate)
+        sortFileInfos(path);
+}
+
+QDir::Filters FileInfoThread::fileFilters(const QString &path) const
 {
     QDir::Filters filter;
     if (caseSensitive)
@@ -256,50 +323,220 @@ void FileInfoThread::getFileInfos(const QString &path)
         filter = filter | QDir::Hidden;
     if (showOnlyReadable)
         filter = filter | QDir::Readable;
+    return filter;
+}
+
+QDir::SortFlags FileInfoThread::fileSortFlags() const
+{
+    QDir::SortFlags flags = sortFlags;
     if (showDirsFirst)
-        sortFlags = sortFlags | QDir::DirsFirst;
+        flags |= QDir::DirsFirst;
+    return flags;
+}
 
-    QDir currentDir(path, QString(), sortFlags);
+/*
+    Reads and sorts the whole directory. Called with the mutex unlocked.
+*/
+QList<FileProperty> FileInfoThread::readFileInfos(const QString &path, QDir::Filters filter, const QStringList &filters, QDir::SortFlags flags)
+{
     QList<FileProperty> filePropertyList;
+    QDirIterator it(path, filters, filter);
+    while (it.hasNext()) {
+        it.next();
+        filePropertyList << FileProperty(it.fileInfo());
+    }
 
-    const QFileInfoList fileInfoList = currentDir.entryInfoList(nameFilters, filter, sortFlags);
+    const FilePropertyLessThan lessThan(flags);
+    if (!lessThan.isUnsorted())
+        std::sort(filePropertyList.begin(), filePropertyList.end(), lessThan);
+    return filePropertyList;
+}
 
-    if (!fileInfoList.isEmpty()) {
-        filePropertyList.reserve(fileInfoList.count());
-        for (const QFileInfo &info : fileInfoList) {
-            //qDebug() << "Adding file : " << info.fileName() << "to list ";
-            filePropertyList << FileProperty(info);
-        }
-        if (folderUpdate) {
-            int fromIndex = 0;
-            int toIndex = currentFileList.size()-1;
-            findChangeRange(filePropertyList, fromIndex, toIndex);
-            folderUpdate = false;
-            currentFileList = filePropertyList;
-            //qDebug() << "emit directoryUpdated : " << fromIndex << " " << toIndex;
-            emit directoryUpdated(path, filePropertyList, fromIndex, toIndex);
-        } else {
-            currentFileList = filePropertyList;
-            if (sortUpdate) {
-                emit sortFinished(filePropertyList);
-                sortUpdate = false;
-            } else
-                emit directoryChanged(path, filePropertyList);
-        }
+/*
+    Sorts \a batch and merges it into currentFileList. The first batch of a
+    scan replaces the list and ends the model reset, later ones are
+    published as insertions at their final positions.
+*/
+void FileInfoThread::publishBatch(const QString &path, QList<FileProperty> &batch, QDir::SortFlags flags, bool reset)
+{
+    const FilePropertyLessThan lessThan(flags);
+    if (!lessThan.isUnsorted())
+        std::sort(batch.begin(), batch.end(), lessThan);
+
+    if (reset) {
+        currentFileList = batch;
+        emit directoryChanged(path, batch);
+        return;
+    }
+
+    if (batch.isEmpty())
+        return;
+
+    QVector<int> positions;
+    positions.reserve(batch.size());
+
+    if (lessThan.isUnsorted()) {
+        for (int i = 0; i < batch.size(); ++i)
+            positions << currentFileList.size() + i;
+        currentFileList += batch;
     } else {
-        // The directory is empty
-        if (folderUpdate) {
-            int fromIndex = 0;
-            int toIndex = currentFileList.size()-1;
-            folderUpdate = false;
-            currentFileList.clear();
-            emit directoryUpdated(path, filePropertyList, fromIndex, toIndex);
-        } else {
-            currentFileList.clear();
-            emit directoryChanged(path, filePropertyList);
+        QList<FileProperty> merged;
+        merged.reserve(currentFileList.size() + batch.size());
+        int i = 0;
+        for (const FileProperty &file : qAsConst(batch)) {
+            while (i < currentFileList.size() && !lessThan(file, currentFileList.at(i)))
+                merged << currentFileList.at(i++);
+            positions << merged.size();
+            merged << file;
         }
+        while (i < currentFileList.size())
+            merged << currentFileList.at(i++);
+        currentFileList = merged;
     }
+
+    emit filesInserted(path, batch, positions);
+}
+
+void FileInfoThread::scanFileInfos(const QString &path)
+{
+    const QDir::Filters filter = fileFilters(path);
+    const QStringList filters = nameFilters;
+    const QDir::SortFlags flags = fileSortFlags();
+    // The scan reflects all settings made so far.
+    pathUpdate = false;
     needUpdate = false;
+    folderUpdate = false;
+    sortUpdate = false;
+    mutex.unlock();
+
+    QDirIterator it(path, filters, filter);
+    QList<FileProperty> batch;
+    int batchSize = InitialBatchSize;
+    bool reset = true;
+    bool interrupted = false;
+    QElapsedTimer timer;
+    timer.start();
+
+    while (it.hasNext()) {
+        it.next();
+        batch << FileProperty(it.fileInfo());
+        if (batch.size() >= batchSize || timer.hasExpired(BatchInterval)) {
+            mutex.lock();
+            interrupted = abort || pathUpdate;
+            if (!interrupted)
+                publishBatch(path, batch, flags, reset);
+            mutex.unlock();
+            if (interrupted)
+                break;
+            reset = false;
+            batch.clear();
+            batchSize = qMin(2 * batchSize, int(MaximumBatchSize));
+            timer.restart();
+        }
+    }
+
+    mutex.lock();
+    if (!interrupted && !abort && !pathUpdate)
+        publishBatch(path, batch, flags, reset);
+}
+
+void FileInfoThread::updateFileInfos(const QString &path)
+{
+    const QDir::Filters filter = fileFilters(path);
+    const QStringList filters = nameFilters;
+    const QDir::SortFlags flags = fileSortFlags();
+    needUpdate = false;
+    folderUpdate = false;
+    mutex.unlock();
+
+    const QList<FileProperty> filePropertyList = readFileInfos(path, filter, filters, flags);
+
+    mutex.lock();
+    if (abort || pathUpdate)
+        return;
+
+    QHash<QString, int> oldIndexes;
+    oldIndexes.reserve(currentFileList.size());
+    for (int i = 0; i < currentFileList.size(); ++i)
+        oldIndexes.insert(currentFileList.at(i).fileName(), i);
+
+    QVector<bool> kept(currentFileList.size(), false);
+    QList<FileProperty> inserted;
+    QVector<int> insertedPositions;
+    QList<FileProperty> changed;
+    QVector<int> changedPositions;
+    bool ordered = true;
+    int lastIndex = -1;
+
+    for (int i = 0; i < filePropertyList.size(); ++i) {
+        const FileProperty &file = filePropertyList.at(i);
+        const auto it = oldIndexes.constFind(file.fileName());
+        if (it == oldIndexes.constEnd() || currentFileList.at(*it) != file) {
+            inserted << file;
+            insertedPositions << i;
+            continue;
+        }
+
+        kept[*it] = true;
+        if (*it < lastIndex)
+            ordered = false;
+        lastIndex = *it;
+
+        const FileProperty &old = currentFileList.at(*it);
+        if (old.size() != file.size() || old.lastModified() != file.lastModified()
+                || old.lastRead() != file.lastRead()) {
+            changed << file;
+            changedPositions << i;
+        }
+    }
+
+    if (!ordered) {
+        // Entries that were kept have moved relative to each other (e.g. a
+        // file was touched while sorting by time); publish the whole range.
+        int fromIndex = 0;
+        int toIndex = currentFileList.size()-1;
+        findChangeRange(filePropertyList, fromIndex, toIndex);
+        currentFileList = filePropertyList;
+        emit directoryUpdated(path, filePropertyList, fromIndex, toIndex);
+        return;
+    }
+
+    QVector<int> removedPositions;
+    for (int i = 0; i < kept.size(); ++i) {
+        if (!kept.at(i))
+            removedPositions << i;
+    }
+
+    currentFileList = filePropertyList;
+    if (!removedPositions.isEmpty())
+        emit filesRemoved(path, removedPositions);
+    if (!insertedPositions.isEmpty())
+        emit filesInserted(path, inserted, insertedPositions);
+    if (!changedPositions.isEmpty())
+        emit filesChanged(path, changed, changedPositions);
+}
+
+void FileInfoThread::sortFileInfos(const QString &path)
+{
+    const QDir::SortFlags flags = fileSortFlags();
+    sortUpdate = false;
+
+    const FilePropertyLessThan lessThan(flags);
+    if (lessThan.isUnsorted()) {
+        // The directory order is only known by reading it again.
+        const QDir::Filters filter = fileFilters(path);
+        const QStringList filters = nameFilters;
+        mutex.unlock();
+        const QList<FileProperty> filePropertyList = readFileInfos(path, filter, filters, flags);
+        mutex.lock();
+        if (abort || pathUpdate)
+            return;
+        currentFileList = filePropertyList;
+    } else {
+        std::stable_sort(currentFileList.begin(), currentFileList.end(), lessThan);
+    }
+
+    emit sortFinished(currentFileList);
 }
 
 void FileInfoThread::findChangeRange(const QList<FileProperty> &list, int &fromIndex, int &toIndex)
@@ -57,6 +57,7 @@
 #include <QFileSystemWatcher>
 #include <QFileInfo>
 #include <QDir>
+#include <QVector>
 
 #include "fileproperty_p.h"
 
@@ -68,6 +69,9 @@ Q_SIGNALS:
     void directoryChanged(const QString &directory, const QList<FileProperty> &list) const;
     void directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex) const;
     void sortFinished(const QList<FileProperty> &list) const;
+    void filesInserted(const QString &directory, const QList<FileProperty> &files, const QVector<int> &positions) const;
+    void filesRemoved(const QString &directory, const QVector<int> &positions) const;
+    void filesChanged(const QString &directory, const QList<FileProperty> &files, const QVector<int> &positions) const;
 
 public:
     FileInfoThread(QObject *parent = 0);
@@ -96,9 +100,23 @@ public Q_SLOTS:
 protected:
     void run() override;
     void getFileInfos(const QString &path);
+    void scanFileInfos(const QString &path);
+    void updateFileInfos(const QString &path);
+    void sortFileInfos(const QString &path);
     void findChangeRange(const QList<FileProperty> &list, int &fromIndex, int &toIndex);
 
 private:
+    enum {
+        InitialBatchSize = 128,
+        MaximumBatchSize = 8192,
+        BatchInterval = 100 // ms
+    };
+
+    QDir::Filters fileFilters(const QString &path) const;
+    QDir::SortFlags fileSortFlags() const;
+    QList<FileProperty> readFileInfos(const QString &path, QDir::Filters filter, const QStringList &filters, QDir::SortFlags flags);
+    void publishBatch(const QString &path, QList<FileProperty> &batch, QDir::SortFlags flags, bool reset);
+
     QMutex mutex;
     QWaitCondition condition;
     volatile bool abort;
@@ -112,6 +130,7 @@ private:
     QString rootPath;
     QStringList nameFilters;
     bool needUpdate;
+    bool pathUpdate;
     bool folderUpdate;
     bool sortUpdate;
     bool showFiles;
@@ -44,6 +44,8 @@
 #include <qqmlcontext.h>
 #include <qqmlfile.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 class QQuickFolderListModelPrivate
@@ -63,6 +65,7 @@ public:
 
     QQuickFolderListModel *q_ptr;
     QUrl currentDir;
+    QString currentPath;
     QUrl rootDir;
     FileInfoThread fileInfoThread;
     QList<FileProperty> data;
@@ -78,6 +81,10 @@ public:
     bool showHidden;
     bool caseSensitive;
 
+    enum {
+        MaximumInsertionRuns = 16
+    };
+
     ~QQuickFolderListModelPrivate() {}
     void init();
     void updateSorting();
@@ -86,6 +93,9 @@ public:
     void _q_directoryChanged(const QString &directory, const QList<FileProperty> &list);
     void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex);
     void _q_sortFinished(const QList<FileProperty> &list);
+    void _q_filesInserted(const QString &directory, const QList<FileProperty> &files, const QVector<int> &positions);
+    void _q_filesRemoved(const QString &directory, const QVector<int> &positions);
+    void _q_filesChanged(const QString &directory, const QList<FileProperty> &files, const QVector<int> &positions);
 
     static QString resolvePath(const QUrl &path);
 };
@@ -95,12 +105,19 @@ void QQuickFolderListModelPrivate::init()
 {
     Q_Q(QQuickFolderListModel);
     qRegisterMetaType<QList<FileProperty> >("QList<FileProperty>");
+    qRegisterMetaType<QVector<int> >("QVector<int>");
     q->connect(&fileInfoThread, SIGNAL(directoryChanged(QString,QList<FileProperty>)),
                q, SLOT(_q_directoryChanged(QString,QList<FileProperty>)));
     q->connect(&fileInfoThread, SIGNAL(directoryUpdated(QString,QList<FileProperty>,int,int)),
                q, SLOT(_q_directoryUpdated(QString,QList<FileProperty>,int,int)));
     q->connect(&fileInfoThread, SIGNAL(sortFinished(QList<FileProperty>)),
                q, SLOT(_q_sortFinished(QList<FileProperty>)));
+    q->connect(&fileInfoThread, SIGNAL(filesInserted(QString,QList<FileProperty>,QVector<int>)),
+               q, SLOT(_q_filesInserted(QString,QList<FileProperty>,QVector<int>)));
+    q->connect(&fileInfoThread, SIGNAL(filesRemoved(QString,QVector<int>)),
+               q, SLOT(_q_filesRemoved(QString,QVector<int>)));
+    q->connect(&fileInfoThread, SIGNAL(filesChanged(QString,QList<FileProperty>,QVector<int>)),
+               q, SLOT(_q_filesChanged(QString,QList<FileProperty>,QVector<int>)));
     q->connect(q, SIGNAL(rowCountChanged()), q, SIGNAL(countChanged()));
 }
 
@@ -198,6 +215,99 @@ void QQuickFolderListModelPrivate::_q_sortFinished(const QList<FileProperty> &li
     q->endInsertRows();
 }
 
+/*
+    The thread streams a directory in sorted batches and publishes later
+    changes to it as diffs. \a positions are ascending; for insertions they
+    are the final rows of \a files, for removals the rows before removal.
+    Notifications for a folder that has since been replaced are dropped.
+
+    Each run of adjacent rows is inserted with a single pass over the list.
+    A batch interleaved with the existing rows in more than
+    MaximumInsertionRuns runs is merged in one pass and applied as a reset
+    instead.
+*/
+void QQuickFolderListModelPrivate::_q_filesInserted(const QString &directory, const QList<FileProperty> &files, const QVector<int> &positions)
+{
+    Q_Q(QQuickFolderListModel);
+    if (directory != currentPath)
+        return;
+
+    int runs = 0;
+    for (int i = 0; i < positions.size(); ++i) {
+        if (i == 0 || positions.at(i) != positions.at(i - 1) + 1)
+            ++runs;
+    }
+
+    if (runs > MaximumInsertionRuns) {
+        QList<FileProperty> merged;
+        merged.reserve(data.size() + files.size());
+        int row = 0;
+        for (int i = 0; i < positions.size(); ++i) {
+            while (merged.size() < positions.at(i))
+                merged << data.at(row++);
+            merged << files.at(i);
+        }
+        while (row < data.size())
+            merged << data.at(row++);
+
+        q->beginResetModel();
+        data = merged;
+        q->endResetModel();
+        emit q->rowCountChanged();
+        return;
+    }
+
+    QModelIndex parent;
+    for (int i = 0; i < positions.size();) {
+        int j = i + 1;
+        while (j < positions.size() && positions.at(j) == positions.at(j - 1) + 1)
+            ++j;
+        const int first = positions.at(i);
+        const int count = j - i;
+        q->beginInsertRows(parent, first, first + count - 1);
+        // Append the run and rotate it into place, which moves the following rows only once.
+        for (; i < j; ++i)
+            data << files.at(i);
+        std::rotate(data.begin() + first, data.end() - count, data.end());
+        q->endInsertRows();
+    }
+    emit q->rowCountChanged();
+}
+
+void QQuickFolderListModelPrivate::_q_filesRemoved(const QString &directory, const QVector<int> &positions)
+{
+    Q_Q(QQuickFolderListModel);
+    if (directory != currentPath)
+        return;
+
+    QModelIndex parent;
+    for (int j = positions.size(); j > 0;) {
+        int i = j - 1;
+        while (i > 0 && positions.at(i - 1) == positions.at(i) - 1)
+            --i;
+        q->beginRemoveRows(parent, positions.at(i), positions.at(j - 1));
+        data.erase(data.begin() + positions.at(i), data.begin() + positions.at(j - 1) + 1);
+        q->endRemoveRows();
+        j = i;
+    }
+    emit q->rowCountChanged();
+}
+
+void QQuickFolderListModelPrivate::_q_filesChanged(const QString &directory, const QList<FileProperty> &files, const QVector<int> &positions)
+{
+    Q_Q(QQuickFolderListModel);
+    if (directory != currentPath)
+        return;
+
+    for (int i = 0; i < positions.size();) {
+        const int first = positions.at(i);
+        int last = first;
+        for (; i < positions.size() && positions.at(i) == last; ++i, ++last)
+            data[last] = files.at(i);
+        emit q->dataChanged(q->createIndex(first, 0), q->createIndex(last - 1, 0));
+    }
+}
+
 QString QQuickFolderListModelPrivate::resolvePath(const QUrl &path)
 {
     QString localPath = QQmlFile::urlToLocalFileOrQrc(path);
@@ -431,9 +541,11 @@ void QQuickFolderListModel::setFolder(const QUrl &folder)
         d->fileInfoThread.removePath(d->currentDir.path());
 
     d->currentDir = folder;
+    d->currentPath = resolvedPath;
 
     QFileInfo info(resolvedPath);
     if (!info.exists() || !info.isDir()) {
+        d->currentPath.clear();
         d->data.clear();
         endResetModel();
         emit rowCountChanged();
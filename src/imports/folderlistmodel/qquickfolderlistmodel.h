@@ -168,6 +168,9 @@ private:
     Q_PRIVATE_SLOT(d_func(), void _q_directoryChanged(const QString &directory, const QList<FileProperty> &list))
     Q_PRIVATE_SLOT(d_func(), void _q_directoryUpdated(const QString &directory, const QList<FileProperty> &list, int fromIndex, int toIndex))
     Q_PRIVATE_SLOT(d_func(), void _q_sortFinished(const QList<FileProperty> &list))
+    Q_PRIVATE_SLOT(d_func(), void _q_filesInserted(const QString &directory, const QList<FileProperty> &files, const QVector<int> &positions))
+    Q_PRIVATE_SLOT(d_func(), void _q_filesRemoved(const QString &directory, const QVector<int> &positions))
+    Q_PRIVATE_SLOT(d_func(), void _q_filesChanged(const QString &directory, const QList<FileProperty> &files, const QVector<int> &positions))
 };
 //![class end]
 
@@ -54,6 +54,8 @@
 #include <QXmlResultItems>
 #include <QXmlNodeModelIndex>
 #include <QBuffer>
+#include <QXmlStreamReader>
+#include <QRegularExpression>
 #include <QNetworkRequest>
 #include <QNetworkReply>
 #include <QTimer>
@@ -154,6 +156,14 @@ typedef QPair<int, int> QQuickXmlListRange;
     \sa XmlListModel
 */
 
+struct XmlStreamingRole
+{
+    QStringList path;       // element names relative to the row element
+    QString attribute;      // attribute of the last element in path, if any
+    bool valid;
+    bool number;
+};
+
 struct XmlQueryJob
 {
     int queryId;
@@ -165,8 +175,63 @@ struct XmlQueryJob
     QStringList keyRoleQueries;
     QStringList keyRoleResultsCache;
     QString prefix;
+    bool streaming;
+    QStringList streamingPath;
+    QList<XmlStreamingRole> streamingRoles;
 };
 
+/*
+    Queries made up of plain element steps can be evaluated with a
+    QXmlStreamReader in a single pass over the document, instead of one
+    XQuery pass for the rows and one per role. The row query must be an
+    absolute path such as "/rss/channel/item", and role queries must be
+    relative paths ending in string() or number(), optionally selecting an
+    attribute, such as "title/string()" or "@id/number()". Anything else
+    (predicates, axes, "//", namespaces, key roles) uses XQuery.
+*/
+static bool isSimpleXmlName(const QString &name)
+{
+    static const QRegularExpression re(QStringLiteral("^[A-Za-z_][A-Za-z0-9_.\\-]*$"));
+    return re.match(name).hasMatch();
+}
+
+static bool parseStreamingRowQuery(const QString &query, QStringList *path)
+{
+    if (!query.startsWith(QLatin1Char('/')) || query.startsWith(QLatin1String("//")))
+        return false;
+    *path = query.mid(1).split(QLatin1Char('/'));
+    for (const QString &step : qAsConst(*path)) {
+        if (!isSimpleXmlName(step))
+            return false;
+    }
+    return true;
+}
+
+static bool parseStreamingRoleQuery(const QString &query, XmlStreamingRole *role)
+{
+    QStringList steps = query.split(QLatin1Char('/'));
+    const QString function = steps.takeLast();
+    if (function == QLatin1String("string()"))
+        role->number = false;
+    else if (function == QLatin1String("number()"))
+        role->number = true;
+    else
+        return false;
+
+    if (!steps.isEmpty() && steps.last().startsWith(QLatin1Char('@'))) {
+        role->attribute = steps.takeLast().mid(1);
+        if (!isSimpleXmlName(role->attribute))
+            return false;
+    }
+    for (const QString &step : qAsConst(steps)) {
+        if (!isSimpleXmlName(step))
+            return false;
+    }
+    role->path = steps;
+    role->valid = true;
+    return true;
+}
+
 
 class QQuickXmlQueryEngine;
 class QQuickXmlQueryThreadObject : public QObject
@@ -208,6 +273,8 @@ private:
     void processQuery(XmlQueryJob *job);
     void doQueryJob(XmlQueryJob *job, QQuickXmlQueryResult *currentResult);
     void doSubQueryJob(XmlQueryJob *job, QQuickXmlQueryResult *currentResult);
+    void doStreamingQueryJob(XmlQueryJob *job);
+    bool publishResult(const QQuickXmlQueryResult &result);
     void getValuesOfKeyRoles(const XmlQueryJob& currentJob, QStringList *values, QXmlQuery *query) const;
     void addIndexToRangeList(QList<QQuickXmlListRange> *ranges, int index) const;
 
@@ -284,17 +351,28 @@ int QQuickXmlQueryEngine::doQuery(QString query, QString namespaces, QByteArray
     job.query = QLatin1String("doc($src)") + query;
     job.namespaces = namespaces;
     job.keyRoleResultsCache = keyRoleResultsCache;
+    job.streaming = namespaces.isEmpty() && parseStreamingRowQuery(query, &job.streamingPath);
 
     for (int i=0; i<roleObjects->count(); i++) {
+        XmlStreamingRole streamingRole;
+        streamingRole.valid = false;
+        streamingRole.number = false;
         if (!roleObjects->at(i)->isValid()) {
             job.roleQueries << QString();
+            job.streamingRoles << streamingRole;
             continue;
         }
         job.roleQueries << roleObjects->at(i)->query();
         job.roleQueryErrorId << static_cast<void*>(roleObjects->at(i));
         if (roleObjects->at(i)->isKey())
             job.keyRoleQueries << job.roleQueries.last();
+        if (job.streaming && !parseStreamingRoleQuery(job.roleQueries.last(), &streamingRole))
+            job.streaming = false;
+        job.streamingRoles << streamingRole;
     }
+    // Key roles are compared against the complete document.
+    if (!job.keyRoleQueries.isEmpty())
+        job.streaming = false;
 
     {
         QMutexLocker ml(&m_mutex);
@@ -362,8 +440,15 @@ QQuickXmlQueryEngine *QQuickXmlQueryEngine::instance(QQmlEngine *engine)
 
 void QQuickXmlQueryEngine::processQuery(XmlQueryJob *job)
 {
+    if (job->streaming) {
+        doStreamingQueryJob(job);
+        return;
+    }
+
     QQuickXmlQueryResult result;
     result.queryId = job->queryId;
+    result.append = false;
+    result.partial = false;
     doQueryJob(job, &result);
     doSubQueryJob(job, &result);
 
@@ -536,6 +621,151 @@ void QQuickXmlQueryEngine::doSubQueryJob(XmlQueryJob *currentJob, QQuickXmlQuery
     }*/
 }
 
+/*
+    Emits \a result unless the job has been cancelled. Returns false if it
+    has been, in which case no further results should be published for it.
+*/
+bool QQuickXmlQueryEngine::publishResult(const QQuickXmlQueryResult &result)
+{
+    QMutexLocker ml(&m_mutex);
+    if (m_cancelledJobs.contains(result.queryId)) {
+        m_cancelledJobs.remove(result.queryId);
+        return false;
+    }
+    emit queryCompleted(result);
+    return true;
+}
+
+/*
+    Evaluates the row and role queries in a single pass over the document,
+    publishing the rows in batches as they are read. The first batch
+    replaces the contents of the model, later ones are appended. Batches
+    start small so that a view can be populated early, and grow so that
+    large documents are not published row by row.
+*/
+void QQuickXmlQueryEngine::doStreamingQueryJob(XmlQueryJob *job)
+{
+    enum { InitialBatchSize = 64, MaximumBatchSize = 4096 };
+
+    const QList<XmlStreamingRole> &roles = job->streamingRoles;
+    const QStringList &rowPath = job->streamingPath;
+    const int roleCount = roles.count();
+
+    QQuickXmlQueryResult result;
+    result.queryId = job->queryId;
+    result.size = 0;
+    result.append = false;
+    result.partial = true;
+    for (int i = 0; i < roleCount; ++i)
+        result.data << QList<QVariant>();
+
+    QVector<QString> values(roleCount);
+    QVector<bool> found(roleCount);
+    QVector<int> captureDepth(roleCount);
+    QStringList elements;
+    int rowDepth = -1;
+    int batchSize = InitialBatchSize;
+
+    QXmlStreamReader reader(job->data);
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QXmlStreamReader::StartElement: {
+            // XPath names without a prefix only match elements in no namespace.
+            elements << (reader.namespaceUri().isEmpty() ? reader.name().toString() : QString());
+            if (rowDepth < 0) {
+                if (elements != rowPath)
+                    break;
+                rowDepth = elements.count();
+                values.fill(QString());
+                found.fill(false);
+                captureDepth.fill(-1);
+            }
+
+            const int depth = elements.count() - rowDepth;
+            for (int i = 0; i < roleCount; ++i) {
+                const XmlStreamingRole &role = roles.at(i);
+                if (!role.valid || found.at(i) || captureDepth.at(i) >= 0 || role.path.count() != depth)
+                    continue;
+                bool match = true;
+                for (int j = 0; match && j < depth; ++j)
+                    match = role.path.at(j) == elements.at(rowDepth + j);
+                if (!match)
+                    continue;
+                if (role.attribute.isEmpty()) {
+                    captureDepth[i] = elements.count();
+                } else if (reader.attributes().hasAttribute(role.attribute)) {
+                    values[i] = reader.attributes().value(role.attribute).toString();
+                    found[i] = true;
+                }
+            }
+            break;
+        }
+        case QXmlStreamReader::Characters:
+            if (rowDepth < 0)
+                break;
+            for (int i = 0; i < roleCount; ++i) {
+                if (captureDepth.at(i) >= 0)
+                    values[i] += reader.text();
+            }
+            break;
+        case QXmlStreamReader::EndElement:
+            if (rowDepth < 0) {
+                elements.removeLast();
+                break;
+            }
+            for (int i = 0; i < roleCount; ++i) {
+                if (captureDepth.at(i) == elements.count()) {
+                    captureDepth[i] = -1;
+                    found[i] = true;
+                }
+            }
+            if (elements.count() == rowDepth) {
+                // As with the XQuery evaluation, a missing value is an empty string.
+                for (int i = 0; i < roleCount; ++i) {
+                    const XmlStreamingRole &role = roles.at(i);
+                    if (!role.valid) {
+                        result.data[i] << QVariant();
+                    } else if (!found.at(i)) {
+                        result.data[i] << QVariant(QString(QLatin1String("")));
+                    } else if (role.number) {
+                        bool ok = false;
+                        const double number = values.at(i).trimmed().toDouble(&ok);
+                        result.data[i] << QVariant(ok ? number : qQNaN());
+                    } else {
+                        result.data[i] << QVariant(values.at(i));
+                    }
+                }
+                ++result.size;
+                rowDepth = -1;
+
+                if (result.size >= batchSize) {
+                    if (!publishResult(result))
+                        return;
+                    result.append = true;
+                    result.size = 0;
+                    for (int i = 0; i < roleCount; ++i)
+                        result.data[i].clear();
+                    batchSize = qMin(2 * batchSize, int(MaximumBatchSize));
+                }
+            }
+            elements.removeLast();
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (reader.hasError()) {
+        // A document that cannot be parsed yields no rows at all.
+        result.append = false;
+        result.size = 0;
+        for (int i = 0; i < roleCount; ++i)
+            result.data[i].clear();
+    }
+    result.partial = false;
+    publishResult(result);
+}
+
 class QQuickXmlListModelPrivate : public QAbstractItemModelPrivate
 {
     Q_DECLARE_PUBLIC(QQuickXmlListModel)
@@ -692,6 +922,14 @@ void QQuickXmlListModelPrivate::clear_role(QQmlListProperty<QQuickXmlListModelRo
     Note this means when XmlListModel is used for a view, the view is not
     populated until the model is loaded.
 
+    If the \l query is a plain absolute path such as "/rss/channel/item", no
+    namespaces are declared, no role is a key, and every XmlRole query is a
+    plain relative path ending in \c string() or \c number() (optionally
+    selecting an attribute, such as "@id/string()"), the document is read in a
+    single pass and rows are added to the model in batches while it is
+    parsed. \l status remains \c XmlListModel.Loading until the last batch
+    has been added.
+
 
     \section2 Using Key XML Roles
 
@@ -1127,6 +1365,8 @@ void QQuickXmlListModel::dataCleared()
     r.size = 0;
     r.removed << qMakePair(0, count());
     r.keyRoleResultsCache = d->keyRoleResultsCache;
+    r.append = false;
+    r.partial = false;
     queryCompleted(r);
 }
 
@@ -1150,17 +1390,30 @@ void QQuickXmlListModel::queryCompleted(const QQuickXmlQueryResult &result)
         return;
 
     int origCount = d->size;
+
+    if (result.append) {
+        // A further batch of rows from a streaming query.
+        if (result.size > 0) {
+            beginInsertRows(QModelIndex(), d->size, d->size + result.size - 1);
+            for (int i = 0; i < result.data.count() && i < d->data.count(); ++i)
+                d->data[i] += result.data.at(i);
+            d->size += result.size;
+            endInsertRows();
+            emit countChanged();
+        }
+        if (!result.partial) {
+            queryFinished(result);
+            emit statusChanged(d->status);
+        }
+        return;
+    }
+
     bool sizeChanged = result.size != d->size;
 
     d->size = result.size;
     d->data = result.data;
-    d->keyRoleResultsCache = result.keyRoleResultsCache;
-    if (d->src.isEmpty() && d->xml.isEmpty())
-        d->status = Null;
-    else
-        d->status = Ready;
-    d->errorString.clear();
-    d->queryId = -1;
+    if (!result.partial)
+        queryFinished(result);
 
     bool hasKeys = false;
     for (int i=0; i<d->roleObjects.count(); i++) {
@@ -1199,7 +1452,20 @@ void QQuickXmlListModel::queryCompleted(const QQuickXmlQueryResult &result)
     if (sizeChanged)
         emit countChanged();
 
-    emit statusChanged(d->status);
+    if (!result.partial)
+        emit statusChanged(d->status);
+}
+
+void QQuickXmlListModel::queryFinished(const QQuickXmlQueryResult &result)
+{
+    Q_D(QQuickXmlListModel);
+    d->keyRoleResultsCache = result.keyRoleResultsCache;
+    if (d->src.isEmpty() && d->xml.isEmpty())
+        d->status = Null;
+    else
+        d->status = Ready;
+    d->errorString.clear();
+    d->queryId = -1;
 }
 
 QT_END_NAMESPACE
@@ -73,6 +73,8 @@ struct QQuickXmlQueryResult {
     QList<QPair<int, int> > inserted;
     QList<QPair<int, int> > removed;
     QStringList keyRoleResultsCache;
+    bool append;    // the rows follow those of an earlier result for the same query
+    bool partial;   // more results for the same query will follow
 };
 
 class QQuickXmlListModel : public QAbstractListModel, public QQmlParserStatus
@@ -151,6 +153,8 @@ private Q_SLOTS:
     void queryError(void* object, const QString& error);
 
 private:
+    void queryFinished(const QQuickXmlQueryResult &);
+
     Q_DECLARE_PRIVATE(QQuickXmlListModel)
     Q_DISABLE_COPY(QQuickXmlListModel)
 };
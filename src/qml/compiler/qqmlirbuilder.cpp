@@ -1050,6 +1050,7 @@ void IRBuilder::setBindingValue(QV4::CompiledData::Binding *binding, QQmlJS::AST
     binding->valueLocation.line = loc.startLine;
     binding->valueLocation.column = loc.startColumn;
     binding->type = QV4::CompiledData::Binding::Type_Invalid;
+    binding->simpleBindingIndex = 0;
     if (_propertyDeclaration && (_propertyDeclaration->flags & QV4::CompiledData::Property::IsReadOnly))
         binding->flags |= QV4::CompiledData::Binding::InitializerForReadOnlyDeclaration;
 
@@ -2248,6 +2249,108 @@ QV4::Compiler::Codegen::Reference JSCodeGen::fallbackNameLookup(const QString &n
     return Reference();
 }
 
+QString JSCodeGen::simpleBindingDescriptor(AST::Node *node)
+{
+#ifndef V4_BOOTSTRAP
+    if (_disableAcceleratedLookups)
+        return QString();
+
+    AST::ExpressionStatement *statement = AST::cast<AST::ExpressionStatement *>(node);
+    if (!statement)
+        return QString();
+
+    AST::ExpressionNode *expression = statement->expression;
+    while (AST::NestedExpression *nested = AST::cast<AST::NestedExpression *>(expression))
+        expression = nested->expression;
+
+    AST::BinaryExpression *binary = AST::cast<AST::BinaryExpression *>(expression);
+    if (!binary) {
+        const QString operand = simpleBindingOperand(expression);
+        // A constant on its own is a plain value binding already
+        if (operand.startsWith(QLatin1Char('=')))
+            return QString();
+        return operand;
+    }
+
+    QChar op;
+    switch (binary->op) {
+    case QSOperator::Add: op = QLatin1Char('+'); break;
+    case QSOperator::Sub: op = QLatin1Char('-'); break;
+    case QSOperator::Mul: op = QLatin1Char('*'); break;
+    case QSOperator::Div: op = QLatin1Char('/'); break;
+    default: return QString();
+    }
+
+    const QString left = simpleBindingOperand(binary->left);
+    const QString right = simpleBindingOperand(binary->right);
+    if (left.isEmpty() || right.isEmpty())
+        return QString();
+    if (left.startsWith(QLatin1Char('=')) && right.startsWith(QLatin1Char('=')))
+        return QString();
+
+    return left + QLatin1Char(' ') + op + QLatin1Char(' ') + right;
+#else
+    Q_UNUSED(node)
+    return QString();
+#endif // V4_BOOTSTRAP
+}
+
+QString JSCodeGen::simpleBindingOperand(AST::ExpressionNode *expression)
+{
+#ifndef V4_BOOTSTRAP
+    while (AST::NestedExpression *nested = AST::cast<AST::NestedExpression *>(expression))
+        expression = nested->expression;
+
+    if (AST::NumericLiteral *literal = AST::cast<AST::NumericLiteral *>(expression))
+        return QLatin1Char('=') + QString::number(literal->value, 'g', 17);
+    if (AST::UnaryMinusExpression *minus = AST::cast<AST::UnaryMinusExpression *>(expression)) {
+        if (AST::NumericLiteral *literal = AST::cast<AST::NumericLiteral *>(minus->expression))
+            return QLatin1Char('=') + QString::number(-literal->value, 'g', 17);
+        return QString();
+    }
+
+    // Collect a member chain like parent.anchors.left, innermost name last
+    QStringList members;
+    while (AST::FieldMemberExpression *member = AST::cast<AST::FieldMemberExpression *>(expression)) {
+        members.prepend(member->name.toString());
+        expression = member->base;
+    }
+    if (members.count() > 3)
+        return QString();
+
+    AST::IdentifierExpression *root = AST::cast<AST::IdentifierExpression *>(expression);
+    if (!root)
+        return QString();
+
+    // Resolve the root the same way fallbackNameLookup() does, and give up wherever
+    // that would only be decided at run-time.
+    const QString name = root->name.toString();
+    QString operand;
+    for (const IdMapping &mapping : qAsConst(_idObjects)) {
+        if (name == mapping.name) {
+            operand = QLatin1Char('$') + QString::number(mapping.idIndex);
+            break;
+        }
+    }
+
+    if (operand.isEmpty()) {
+        if (name.at(0).isUpper() || !_scopeObject)
+            return QString();
+        QQmlPropertyData *data = lookupQmlCompliantProperty(_scopeObject, name);
+        if (!data)
+            return QString();
+        operand = QLatin1Char('@') + QString::number(data->coreIndex());
+    }
+
+    for (const QString &member : qAsConst(members))
+        operand += QLatin1Char('.') + member;
+    return operand;
+#else
+    Q_UNUSED(expression)
+    return QString();
+#endif // V4_BOOTSTRAP
+}
+
 #ifndef V4_BOOTSTRAP
 
 QQmlPropertyData *PropertyResolver::property(const QString &name, bool *notInRevision, RevisionCheck check) const
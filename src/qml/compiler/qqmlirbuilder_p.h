@@ -631,6 +631,10 @@ struct Q_QML_PRIVATE_EXPORT JSCodeGen : public QV4::Compiler::Codegen
                        AST::FormalParameterList *formals,
                        AST::SourceElements *body) override;
 
+    // Returns a descriptor for binding expressions that can be evaluated without
+    // running JavaScript, or an empty string. See QQmlSimpleBindingProgram.
+    QString simpleBindingDescriptor(AST::Node *node);
+
 protected:
     void beginFunctionBodyHook() override;
     Reference fallbackNameLookup(const QString &name) override;
@@ -638,6 +642,7 @@ protected:
 private:
     // returns nullptr if lookup needs to happen by name
     QQmlPropertyData *lookupQmlCompliantProperty(QQmlPropertyCache *cache, const QString &name);
+    QString simpleBindingOperand(AST::ExpressionNode *expression);
 
     QString sourceCode;
     QQmlJS::Engine *jsEngine; // needed for memory pool
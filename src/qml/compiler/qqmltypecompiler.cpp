@@ -1364,6 +1364,18 @@ bool QQmlJSCodeGenerator::compileJavaScriptCodeInObjectsRecursively(int objectIn
 
         QQmlJS::MemoryPool *pool = compiler->memoryPool();
         object->runtimeFunctionIndices.allocate(pool, runtimeFunctionIndices);
+
+        for (QmlIR::Binding *binding = object->firstBinding(); binding; binding = binding->next) {
+            if (binding->type != QV4::CompiledData::Binding::Type_Script
+                    || !binding->isValueBinding() || binding->isFunctionExpression())
+                continue;
+            const QmlIR::CompiledFunctionOrExpression *foe = object->functionsAndExpressions->slowAt(binding->value.compiledScriptIndex);
+            if (foe->disableAcceleratedLookups)
+                continue;
+            const QString descriptor = v4CodeGen->simpleBindingDescriptor(foe->node);
+            if (!descriptor.isEmpty())
+                binding->simpleBindingIndex = compiler->registerString(descriptor);
+        }
     }
 
     for (const QmlIR::Binding *binding = object->firstBinding(); binding; binding = binding->next) {
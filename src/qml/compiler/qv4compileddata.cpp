@@ -50,6 +50,8 @@
 #include <private/qqmltypeloader_p.h>
 #include <private/qqmlengine_p.h>
 #include <private/qv4vme_moth_p.h>
+#include <private/qqmlbinding_p.h>
+#include <private/qqmlobjectcreator_p.h>
 #include "qv4compilationunitmapper_p.h"
 #include <QQmlPropertyMap>
 #include <QDateTime>
@@ -211,6 +213,7 @@ void CompilationUnit::unlink()
         isRegisteredWithEngine = false;
     }
 
+    QQmlObjectCreatorPreparation::cancel(this);
     propertyCaches.clear();
 
     for (int ii = 0; ii < dependentScripts.count(); ++ii)
@@ -267,6 +270,16 @@ IdentifierHash<int> CompilationUnit::namedObjectsPerComponent(int componentObjec
     return *it;
 }
 
+const QQmlSimpleBindingProgram *CompilationUnit::simpleBindingProgram(int descriptorIndex)
+{
+    auto it = simpleBindingProgramCache.find(descriptorIndex);
+    if (it == simpleBindingProgramCache.end()) {
+        QSharedPointer<const QQmlSimpleBindingProgram> program(QQmlSimpleBindingProgram::parse(stringAt(descriptorIndex)));
+        it = simpleBindingProgramCache.insert(descriptorIndex, program);
+    }
+    return it->data();
+}
+
 void CompilationUnit::finalizeCompositeType(QQmlEnginePrivate *qmlEngine)
 {
     this->qmlEngine = qmlEngine;
@@ -55,6 +55,7 @@
 #include <QStringList>
 #include <QHash>
 #include <QUrl>
+#include <QSharedPointer>
 
 #include <private/qv4value_p.h>
 #include <private/qv4executableallocator_p.h>
@@ -72,13 +73,15 @@
 QT_BEGIN_NAMESPACE
 
 // Bump this whenever the compiler data structures change in an incompatible way.
-#define QV4_DATA_STRUCTURE_VERSION 0x15
+#define QV4_DATA_STRUCTURE_VERSION 0x16
 
 class QIODevice;
 class QQmlPropertyCache;
 class QQmlPropertyData;
 class QQmlTypeNameCache;
 class QQmlScriptData;
+struct QQmlSimpleBindingProgram;
+class QQmlObjectCreatorPreparation;
 class QQmlType;
 class QQmlEngine;
 
@@ -332,7 +335,7 @@ struct Q_QML_PRIVATE_EXPORT Binding
     Location location;
     Location valueLocation;
 
-    quint32_le padding;
+    quint32_le simpleBindingIndex; // Set for Type_Script bindings that can be evaluated without JavaScript, see QQmlSimpleBindingProgram
 
     bool isValueBinding() const
     {
@@ -948,6 +951,14 @@ public:
     QHash<int, IdentifierHash<int>> namedObjectsPerComponentCache;
     IdentifierHash<int> namedObjectsPerComponent(int componentObjectIndex);
 
+    // mapping from string index of a simple binding descriptor to its parsed program
+    // this is initialized on-demand by QQmlObjectCreator
+    QHash<int, QSharedPointer<const QQmlSimpleBindingProgram>> simpleBindingProgramCache;
+    const QQmlSimpleBindingProgram *simpleBindingProgram(int descriptorIndex);
+
+    // Instantiation work scheduled on a worker thread, see QQmlObjectCreatorPreparation
+    QQmlObjectCreatorPreparation *instantiationPreparation = nullptr;
+
     void finalizeCompositeType(QQmlEnginePrivate *qmlEngine);
 
     int totalBindingsCount = 0; // Number of bindings used in this type
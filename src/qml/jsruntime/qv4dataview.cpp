@@ -134,7 +134,7 @@ ReturnedValue DataViewPrototype::method_get_byteLength(const FunctionObject *b,
     if (!v)
         return b->engine()->throwTypeError();
 
-    return Encode(v->d()->byteLength);
+    return Encode(v->byteLength());
 }
 
 ReturnedValue DataViewPrototype::method_get_byteOffset(const FunctionObject *b, const Value *thisObject, const Value *, int)
@@ -154,7 +154,7 @@ ReturnedValue DataViewPrototype::method_getChar(const FunctionObject *b, const V
         return b->engine()->throwTypeError();
     double l = argv[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return b->engine()->throwTypeError();
     idx += v->d()->byteOffset;
 
@@ -171,7 +171,7 @@ ReturnedValue DataViewPrototype::method_get(const FunctionObject *b, const Value
         return b->engine()->throwTypeError();
     double l = argv[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return b->engine()->throwTypeError();
     idx += v->d()->byteOffset;
 
@@ -192,7 +192,7 @@ ReturnedValue DataViewPrototype::method_getFloat(const FunctionObject *b, const
         return b->engine()->throwTypeError();
     double l = argv[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return b->engine()->throwTypeError();
     idx += v->d()->byteOffset;
 
@@ -229,7 +229,7 @@ ReturnedValue DataViewPrototype::method_setChar(const FunctionObject *b, const V
         return b->engine()->throwTypeError();
     double l = argv[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return b->engine()->throwTypeError();
     idx += v->d()->byteOffset;
 
@@ -247,7 +247,7 @@ ReturnedValue DataViewPrototype::method_set(const FunctionObject *b, const Value
         return b->engine()->throwTypeError();
     double l = argv[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return b->engine()->throwTypeError();
     idx += v->d()->byteOffset;
 
@@ -271,7 +271,7 @@ ReturnedValue DataViewPrototype::method_setFloat(const FunctionObject *b, const
         return b->engine()->throwTypeError();
     double l = argv[0].toNumber();
     uint idx = (uint)l;
-    if (l != idx || idx + sizeof(T) > v->d()->byteLength)
+    if (l != idx || idx + sizeof(T) > v->byteLength())
         return b->engine()->throwTypeError();
     idx += v->d()->byteOffset;
 
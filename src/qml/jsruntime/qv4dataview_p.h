@@ -52,6 +52,7 @@
 
 #include "qv4object_p.h"
 #include "qv4functionobject_p.h"
+#include "qv4arraybuffer_p.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -87,6 +88,11 @@ struct DataView : Object
 {
     V4_OBJECT2(DataView, Object)
     V4_PROTOTYPE(dataViewPrototype)
+
+    // A view on a buffer that was transferred to a WorkerScript is empty
+    uint byteLength() const {
+        return d()->byteOffset + d()->byteLength <= d()->buffer->byteLength() ? d()->byteLength : 0;
+    }
 };
 
 struct DataViewPrototype: Object
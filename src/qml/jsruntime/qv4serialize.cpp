@@ -49,6 +49,7 @@
 #include <private/qv4sequenceobject_p.h>
 #include <private/qv4objectproto_p.h>
 #include <private/qv4qobjectwrapper_p.h>
+#include <private/qv4arraybuffer_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -66,6 +67,7 @@ using namespace QV4;
 //    + Number
 //    + Date
 //    + RegExp
+//    + ArrayBuffer
 // <quint8 type><quint24 size><data>
 
 enum Type {
@@ -83,7 +85,8 @@ enum Type {
     WorkerDate,
     WorkerRegexp,
     WorkerListModel,
-    WorkerSequence
+    WorkerSequence,
+    WorkerArrayBuffer
 };
 
 static inline quint32 valueheader(Type type, quint32 size = 0)
@@ -146,7 +149,18 @@ static inline void *popPtr(const char *&data)
 // serialization/deserialization failures
 
 #define ALIGN(size) (((size) + 3) & ~3)
-void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine *engine)
+// Leaves \a buffer empty once its contents have been transferred to another thread
+static void neuter(Heap::ArrayBuffer *buffer)
+{
+    if (!buffer->data->ref.deref())
+        QTypedArrayData<char>::deallocate(buffer->data);
+    buffer->data = QTypedArrayData<char>::allocate(1);
+    buffer->data->size = 0;
+    *buffer->data->data() = 0;
+}
+
+void Serialize::serialize(QByteArray &data, const QV4::Value &v, const QVector<Heap::ArrayBuffer *> &transfer,
+                          ExecutionEngine *engine)
 {
     QV4::Scope scope(engine);
 
@@ -189,7 +203,7 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         push(data, valueheader(WorkerArray, length));
         ScopedValue val(scope);
         for (uint ii = 0; ii < length; ++ii)
-            serialize(data, (val = array->getIndexed(ii)), engine);
+            serialize(data, (val = array->getIndexed(ii)), transfer, engine);
     } else if (v.isInteger()) {
         reserve(data, 2 * sizeof(quint32));
         push(data, valueheader(WorkerInt32));
@@ -225,6 +239,18 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         char *buffer = data.data() + offset;
 
         memcpy(buffer, pattern.constData(), length*sizeof(QChar));
+    } else if (const QV4::ArrayBuffer *buffer = v.as<ArrayBuffer>()) {
+        // Typed arrays write straight into the buffer's data without detaching,
+        // so a buffer that stays usable on the sending side must be deep copied.
+        // A transferred buffer hands its data over and is left empty.
+        reserve(data, sizeof(quint32) + sizeof(void *));
+        push(data, valueheader(WorkerArrayBuffer));
+        if (transfer.contains(buffer->d())) {
+            push(data, (void *)new QByteArray(buffer->asByteArray()));
+            neuter(buffer->d());
+        } else {
+            push(data, (void *)new QByteArray(buffer->d()->data->data(), buffer->byteLength()));
+        }
     } else if (const QObjectWrapper *qobjectWrapper = v.as<QV4::QObjectWrapper>()) {
         // XXX TODO: Generalize passing objects between the main thread and worker scripts so
         // that others can trivially plug in their elements.
@@ -249,10 +275,10 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
             }
             reserve(data, sizeof(quint32) + length * sizeof(quint32));
             push(data, valueheader(WorkerSequence, length));
-            serialize(data, QV4::Primitive::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), engine); // sequence type
+            serialize(data, QV4::Primitive::fromInt32(QV4::SequencePrototype::metaTypeForSequence(o)), transfer, engine); // sequence type
             ScopedValue val(scope);
             for (uint ii = 0; ii < seqLength; ++ii)
-                serialize(data, (val = o->getIndexed(ii)), engine); // sequence elements
+                serialize(data, (val = o->getIndexed(ii)), transfer, engine); // sequence elements
 
             return;
         }
@@ -270,14 +296,14 @@ void Serialize::serialize(QByteArray &data, const QV4::Value &v, ExecutionEngine
         QV4::ScopedValue s(scope);
         for (quint32 ii = 0; ii < length; ++ii) {
             s = properties->getIndexed(ii);
-            serialize(data, s, engine);
+            serialize(data, s, transfer, engine);
 
             QV4::String *str = s->as<String>();
             val = o->get(str);
             if (scope.hasException())
                 scope.engine->catchException();
 
-            serialize(data, val, engine);
+            serialize(data, val, transfer, engine);
         }
         return;
     } else {
@@ -387,6 +413,13 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
         QVariant seqVariant = QV4::SequencePrototype::toVariant(array, sequenceType, &succeeded);
         return QV4::SequencePrototype::fromVariant(engine, seqVariant, &succeeded);
     }
+    case WorkerArrayBuffer:
+    {
+        QByteArray *bytes = (QByteArray *)popPtr(data);
+        QV4::ScopedValue rv(scope, engine->newArrayBuffer(*bytes));
+        delete bytes;
+        return rv->asReturnedValue();
+    }
     }
     Q_ASSERT(!"Unreachable");
     return QV4::Encode::undefined();
@@ -395,7 +428,31 @@ ReturnedValue Serialize::deserialize(const char *&data, ExecutionEngine *engine)
 QByteArray Serialize::serialize(const QV4::Value &value, ExecutionEngine *engine)
 {
     QByteArray rv;
-    serialize(rv, value, engine);
+    serialize(rv, value, QVector<Heap::ArrayBuffer *>(), engine);
+    return rv;
+}
+
+/*
+  As serialize(), except that the ArrayBuffers listed in the \a transferList array
+  are moved to the receiver: their contents are handed over without a copy and
+  the buffers are left empty on the sending side.
+*/
+QByteArray Serialize::serialize(const QV4::Value &value, const QV4::Value &transferList, ExecutionEngine *engine)
+{
+    QV4::Scope scope(engine);
+    QVector<Heap::ArrayBuffer *> transfer;
+    if (const QV4::ArrayObject *list = transferList.as<ArrayObject>()) {
+        QV4::Scoped<QV4::ArrayBuffer> buffer(scope);
+        const uint length = list->getLength();
+        for (uint ii = 0; ii < length; ++ii) {
+            buffer = list->getIndexed(ii);
+            if (buffer)
+                transfer.append(buffer->d());
+        }
+    }
+
+    QByteArray rv;
+    serialize(rv, value, transfer, engine);
     return rv;
 }
 
@@ -52,6 +52,7 @@
 //
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qvector.h>
 #include <private/qv4value_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -62,10 +63,11 @@ class Serialize {
 public:
 
     static QByteArray serialize(const Value &, ExecutionEngine *);
+    static QByteArray serialize(const Value &, const Value &transferList, ExecutionEngine *);
     static ReturnedValue deserialize(const QByteArray &, ExecutionEngine *);
 
 private:
-    static void serialize(QByteArray &, const Value &, ExecutionEngine *);
+    static void serialize(QByteArray &, const Value &, const QVector<Heap::ArrayBuffer *> &, ExecutionEngine *);
     static ReturnedValue deserialize(const char *&, ExecutionEngine *);
 };
 
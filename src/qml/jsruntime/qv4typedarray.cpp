@@ -240,7 +240,7 @@ ReturnedValue TypedArrayCtor::callAsConstructor(const FunctionObject *f, const V
         Scoped<ArrayBuffer> buffer(scope, typedArray->d()->buffer);
         uint srcElementSize = typedArray->d()->type->bytesPerElement;
         uint destElementSize = operations[that->d()->type].bytesPerElement;
-        uint byteLength = typedArray->d()->byteLength;
+        uint byteLength = typedArray->byteLength();
         uint destByteLength = byteLength*destElementSize/srcElementSize;
 
         Scoped<ArrayBuffer> newBuffer(scope, scope.engine->newArrayBuffer(destByteLength));
@@ -426,7 +426,7 @@ ReturnedValue TypedArrayPrototype::method_get_byteLength(const FunctionObject *b
     if (!v)
         return v4->throwTypeError();
 
-    return Encode(v->d()->byteLength);
+    return Encode(v->byteLength());
 }
 
 ReturnedValue TypedArrayPrototype::method_get_byteOffset(const FunctionObject *b, const Value *thisObject, const Value *, int)
@@ -446,7 +446,7 @@ ReturnedValue TypedArrayPrototype::method_get_length(const FunctionObject *b, co
     if (!v)
         return v4->throwTypeError();
 
-    return Encode(v->d()->byteLength/v->d()->type->bytesPerElement);
+    return Encode(v->length());
 }
 
 ReturnedValue TypedArrayPrototype::method_set(const FunctionObject *b, const Value *thisObject, const Value *argv, int argc)
@@ -510,15 +510,15 @@ ReturnedValue TypedArrayPrototype::method_set(const FunctionObject *b, const Val
     const char *src = srcBuffer->d()->data->data() + srcTypedArray->d()->byteOffset;
     if (srcTypedArray->d()->type == a->d()->type) {
         // same type of typed arrays, use memmove (as srcbuffer and buffer could be the same)
-        memmove(dest, src, srcTypedArray->d()->byteLength);
+        memmove(dest, src, srcTypedArray->byteLength());
         RETURN_UNDEFINED();
     }
 
     char *srcCopy = 0;
     if (buffer->d() == srcBuffer->d()) {
         // same buffer, need to take a temporary copy, to not run into problems
-        srcCopy = new char[srcTypedArray->d()->byteLength];
-        memcpy(srcCopy, src, srcTypedArray->d()->byteLength);
+        srcCopy = new char[srcTypedArray->byteLength()];
+        memcpy(srcCopy, src, srcTypedArray->byteLength());
         src = srcCopy;
     }
 
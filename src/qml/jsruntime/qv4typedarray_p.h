@@ -117,12 +117,13 @@ struct Q_QML_PRIVATE_EXPORT TypedArray : Object
 
     static Heap::TypedArray *create(QV4::ExecutionEngine *e, Heap::TypedArray::Type t);
 
+    // A view on a buffer that was transferred to a WorkerScript is empty
     uint byteLength() const {
-        return d()->byteLength;
+        return d()->byteOffset + d()->byteLength <= d()->buffer->byteLength() ? d()->byteLength : 0;
     }
 
     uint length() const {
-        return d()->byteLength/d()->type->bytesPerElement;
+        return byteLength()/d()->type->bytesPerElement;
     }
 
     QTypedArrayData<char> *arrayData() {
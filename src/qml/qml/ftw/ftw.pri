@@ -9,6 +9,7 @@ HEADERS +=  \
     $$PWD/qfinitestack_p.h \
     $$PWD/qrecursionwatcher_p.h \
     $$PWD/qrecyclepool_p.h \
+    $$PWD/qqmlarena_p.h \
     $$PWD/qflagpointer_p.h \
     $$PWD/qlazilyallocated_p.h \
     $$PWD/qqmlnullablevalue_p.h \
@@ -18,6 +19,7 @@ SOURCES += \
     $$PWD/qintrusivelist.cpp \
     $$PWD/qhashedstring.cpp \
     $$PWD/qqmlthread.cpp \
+    $$PWD/qqmlarena.cpp \
 
 # mirrors logic in $$QT_SOURCE_TREE/config.tests/unix/clock-gettime/clock-gettime.pri
 # clock_gettime() is implemented in librt on these systems
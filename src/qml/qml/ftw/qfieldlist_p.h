@@ -94,6 +94,7 @@ public:
     inline QFieldList();
     inline N *first() const;
     inline N *takeFirst();
+    inline N *takeAfter(N *);
 
     inline void append(N *);
     inline void prepend(N *);
@@ -255,6 +256,23 @@ N *QFieldList<N, nextMember>::takeFirst()
     return value;
 }
 
+template<class N, N *N::*nextMember>
+N *QFieldList<N, nextMember>::takeAfter(N *after)
+{
+    if (!after)
+        return takeFirst();
+
+    N *value = after->*nextMember;
+    if (value) {
+        after->*nextMember = value->*nextMember;
+        if (_last == value)
+            _last = after;
+        value->*nextMember = 0;
+        --_count;
+    }
+    return value;
+}
+
 template<class N, N *N::*nextMember>
 void QFieldList<N, nextMember>::append(N *v)
 {
@@ -0,0 +1,67 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qqmlarena_p.h"
+
+QT_BEGIN_NAMESPACE
+
+QBasicAtomicInt QQmlArena::enabled = Q_BASIC_ATOMIC_INITIALIZER(-1);
+QBasicAtomicInt QQmlArena::liveArenas = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+/*
+  Objects allocated with and without the arena header can't be told apart, so this
+  is decided once and never changes afterwards.
+*/
+int QQmlArena::initEnabled()
+{
+    const QByteArray value = qgetenv("QML_CREATION_ARENA");
+    const int state = (value.isEmpty() || value == "0" || value == "false") ? 0 : 1;
+    enabled.testAndSetRelaxed(-1, state);
+    return enabled.load();
+}
+
+/*
+  Returns the number of arenas which have not freed their pages yet.
+*/
+int QQmlArena::liveArenaCount()
+{
+    return liveArenas.load();
+}
+
+QT_END_NAMESPACE
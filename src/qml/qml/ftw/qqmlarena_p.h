@@ -0,0 +1,234 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQml module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QQMLARENA_P_H
+#define QQMLARENA_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qatomic.h>
+#include <private/qtqmlglobal_p.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+
+QT_BEGIN_NAMESPACE
+
+#define QQMLARENACOOKIE 0x4A7E1D5C
+
+// A bump allocator for small objects that are usually destroyed together, like the
+// engine internal objects created for one component instance. Memory is not reused
+// when an object is destroyed; the pages are freed once the owner released its hold
+// and every object allocated from the arena is gone.
+//
+// Classes opt in with Q_QML_ARENA_ALLOCATED. Arenas are only used with QML_CREATION_ARENA
+// set; then every allocation of such a class remembers where it came from, so that
+// objects allocated with a plain new and objects allocated with new (arena) can be
+// deleted the same way. Otherwise the class uses the global operator new and delete,
+// without any extra memory. This is decided once, on the first allocation.
+class Q_QML_PRIVATE_EXPORT QQmlArena
+{
+public:
+    static inline QQmlArena *create();
+    inline void release();
+
+    static inline bool isEnabled();
+    static int liveArenaCount();
+
+    static inline void *allocate(QQmlArena *arena, size_t size);
+    static inline void deallocate(void *ptr);
+
+private:
+    inline QQmlArena();
+    inline void *allocateFromPage(size_t size);
+    inline void destroy();
+
+    static int initEnabled();
+    static QBasicAtomicInt enabled; // -1 until decided
+    static QBasicAtomicInt liveArenas;
+
+    enum { PageSize = 4096 };
+
+    union Header {
+        QQmlArena *arena;
+        qint64 q_for_alignment_1;
+        double q_for_alignment_2;
+    };
+
+    struct Page {
+        Page *nextPage;
+        size_t used;
+        size_t size;
+        union {
+            char array[1];
+            qint64 q_for_alignment_1;
+            double q_for_alignment_2;
+        };
+    };
+
+    bool hold;
+    QAtomicInt outstandingItems; // Plus one while the owner holds the arena
+    quint32 cookie;
+    Page *currentPage;
+};
+
+#define Q_QML_ARENA_ALLOCATED \
+    static void *operator new(size_t size) { return QQmlArena::allocate(nullptr, size); } \
+    static void *operator new(size_t size, QQmlArena *arena) { return QQmlArena::allocate(arena, size); } \
+    static void operator delete(void *ptr) { QQmlArena::deallocate(ptr); } \
+    static void operator delete(void *ptr, QQmlArena *) { QQmlArena::deallocate(ptr); }
+
+QQmlArena::QQmlArena()
+    : hold(true), outstandingItems(1), cookie(QQMLARENACOOKIE), currentPage(0)
+{
+    liveArenas.ref();
+}
+
+QQmlArena *QQmlArena::create()
+{
+    Q_ASSERT(isEnabled());
+    return new QQmlArena;
+}
+
+void QQmlArena::release()
+{
+    Q_ASSERT(hold);
+    hold = false;
+    if (!outstandingItems.deref())
+        destroy();
+}
+
+bool QQmlArena::isEnabled()
+{
+    int state = enabled.load();
+    if (Q_UNLIKELY(state == -1))
+        state = initEnabled();
+    return state;
+}
+
+void QQmlArena::destroy()
+{
+    liveArenas.deref();
+
+    Page *p = currentPage;
+    while (p) {
+        Page *n = p->nextPage;
+        free(p);
+        p = n;
+    }
+
+    delete this;
+}
+
+void *QQmlArena::allocateFromPage(size_t size)
+{
+    size = (size + sizeof(Header) - 1) & ~(sizeof(Header) - 1);
+
+    if (!currentPage || currentPage->size - currentPage->used < size) {
+        const size_t pageSize = qMax(size_t(PageSize), size);
+        Page *p = (Page *)malloc(offsetof(Page, array) + pageSize);
+        Q_CHECK_PTR(p);
+        p->nextPage = currentPage;
+        p->used = 0;
+        p->size = pageSize;
+        currentPage = p;
+    }
+
+    void *rv = currentPage->array + currentPage->used;
+    currentPage->used += size;
+    return rv;
+}
+
+void *QQmlArena::allocate(QQmlArena *arena, size_t size)
+{
+    if (!isEnabled()) {
+        Q_ASSERT(!arena);
+        return ::operator new(size);
+    }
+
+    Header *header;
+    if (arena) {
+        Q_ASSERT(arena->cookie == QQMLARENACOOKIE && arena->hold);
+        header = (Header *)arena->allocateFromPage(sizeof(Header) + size);
+        arena->outstandingItems.ref();
+    } else {
+        header = (Header *)malloc(sizeof(Header) + size);
+        Q_CHECK_PTR(header);
+    }
+
+    header->arena = arena;
+    return header + 1;
+}
+
+void QQmlArena::deallocate(void *ptr)
+{
+    if (!ptr)
+        return;
+
+    if (!isEnabled()) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    Header *header = static_cast<Header *>(ptr) - 1;
+    QQmlArena *arena = header->arena;
+    if (!arena) {
+        free(header);
+        return;
+    }
+
+    Q_ASSERT(arena->cookie == QQMLARENACOOKIE);
+    if (!arena->outstandingItems.deref())
+        arena->destroy();
+}
+
+QT_END_NAMESPACE
+
+#endif // QQMLARENA_P_H
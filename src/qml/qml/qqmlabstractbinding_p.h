@@ -55,6 +55,7 @@
 #include <QtCore/qshareddata.h>
 #include <private/qtqmlglobal_p.h>
 #include <private/qqmlproperty_p.h>
+#include <private/qqmlarena_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -67,6 +68,8 @@ protected:
 public:
     virtual ~QQmlAbstractBinding();
 
+    Q_QML_ARENA_ALLOCATED
+
     typedef QExplicitlySharedDataPointer<QQmlAbstractBinding> Ptr;
 
     virtual QString expression() const;
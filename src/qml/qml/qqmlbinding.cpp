@@ -53,9 +53,13 @@
 #include <private/qv4variantobject_p.h>
 
 #include <QVariant>
+#include <QtCore/qcoreapplication.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qnumeric.h>
 #include <QVector>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 QQmlBinding *QQmlBinding::create(const QQmlPropertyData *property, const QQmlScriptString &script, QObject *obj, QQmlContext *ctxt)
@@ -137,6 +141,8 @@ void QQmlBinding::setNotifyOnValueChanged(bool v)
 
 void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
 {
+    m_updatePending = false;
+
     if (!enabledFlag() || !context() || !context()->isValid())
         return;
 
@@ -146,12 +152,7 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
 
     // Check for a binding update loop
     if (Q_UNLIKELY(updatingFlag())) {
-        QQmlPropertyData *d = nullptr;
-        QQmlPropertyData vtd;
-        getPropertyData(&d, &vtd);
-        Q_ASSERT(d);
-        QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, 0);
-        QQmlAbstractBinding::printBindingLoopError(p);
+        reportBindingLoop();
         return;
     }
     setUpdatingFlag(true);
@@ -340,6 +341,393 @@ QQmlBinding *QQmlBinding::createTranslationBinding(QV4::CompiledData::Compilatio
     return b;
 }
 
+namespace {
+
+bool parseSimpleBindingOperand(const QStringRef &text, QQmlSimpleBindingProgram::Operand *operand)
+{
+    if (text.isEmpty())
+        return false;
+
+    bool ok = false;
+    const QChar kind = text.at(0);
+    if (kind == QLatin1Char('=')) {
+        operand->kind = QQmlSimpleBindingProgram::Operand::Constant;
+        operand->constant = text.mid(1).toDouble(&ok);
+        return ok;
+    }
+
+    if (kind == QLatin1Char('$'))
+        operand->kind = QQmlSimpleBindingProgram::Operand::IdObject;
+    else if (kind == QLatin1Char('@'))
+        operand->kind = QQmlSimpleBindingProgram::Operand::ScopeProperty;
+    else
+        return false;
+
+    const QVector<QStringRef> path = text.mid(1).split(QLatin1Char('.'));
+    operand->index = path.first().toInt(&ok);
+    if (!ok || operand->index < 0)
+        return false;
+
+    for (int i = 1; i < path.count(); ++i) {
+        if (path.at(i).isEmpty())
+            return false;
+        QQmlSimpleBindingProgram::Member member;
+        member.name = path.at(i).toString();
+        operand->members.append(member);
+    }
+    return true;
+}
+
+} // unnamed namespace
+
+QQmlSimpleBindingProgram *QQmlSimpleBindingProgram::parse(const QString &descriptor)
+{
+    const QVector<QStringRef> parts = descriptor.splitRef(QLatin1Char(' '));
+    if (parts.count() != 1 && parts.count() != 3)
+        return nullptr;
+
+    QScopedPointer<QQmlSimpleBindingProgram> program(new QQmlSimpleBindingProgram);
+    if (!parseSimpleBindingOperand(parts.at(0), &program->operands[0]))
+        return nullptr;
+    if (parts.count() == 1)
+        return program->operands[0].kind == Operand::Constant ? nullptr : program.take();
+
+    const QStringRef op = parts.at(1);
+    if (op == QLatin1String("+"))
+        program->op = Add;
+    else if (op == QLatin1String("-"))
+        program->op = Subtract;
+    else if (op == QLatin1String("*"))
+        program->op = Multiply;
+    else if (op == QLatin1String("/"))
+        program->op = Divide;
+    else
+        return nullptr;
+
+    if (!parseSimpleBindingOperand(parts.at(2), &program->operands[1]))
+        return nullptr;
+    return program.take();
+}
+
+// Evaluates a QQmlSimpleBindingProgram by reading the properties directly through the
+// property cache, capturing the same dependencies the JavaScript code would. Whenever
+// the program runs into something it does not handle (a null object on the path, a
+// property type it can't read, a number that does not fit the target), the binding
+// falls back to the JavaScript function compiled for it, so that errors and corner
+// cases behave exactly the same.
+class QQmlSimpleBinding : public GenericBinding<QMetaType::UnknownType>
+{
+public:
+    QQmlSimpleBinding(const QQmlSimpleBindingProgram *program)
+        : m_program(program)
+    {}
+
+protected:
+    void doUpdate(const DeleteWatcher &watcher,
+                  QQmlPropertyData::WriteFlags flags, QV4::Scope &scope) override final
+    {
+        if (evaluateDirectly(flags))
+            return;
+        if (!watcher.wasDeleted())
+            QQmlNonbindingBinding::doUpdate(watcher, flags, scope);
+    }
+
+private:
+    struct Value {
+        enum Kind {
+            Invalid,
+            Number,
+            Boolean,
+            String
+        };
+
+        Kind kind = Invalid;
+        double number = 0;
+        bool boolean = false;
+        QString string;
+    };
+
+    bool evaluateDirectly(QQmlPropertyData::WriteFlags flags);
+    bool evaluateOperand(const QQmlSimpleBindingProgram::Operand &operand, QQmlPropertyCapture *capture,
+                         const DeleteWatcher &watcher, Value *value);
+    QQmlPropertyData *memberProperty(const QQmlSimpleBindingProgram::Member &member, QObject *object);
+    bool acceptsValue(const Value &value) const;
+    void writeValue(const Value &value, QQmlPropertyData::WriteFlags flags);
+
+    const QQmlSimpleBindingProgram *m_program;
+};
+
+// Returns true if the binding was evaluated and written, false if the caller needs to
+// fall back to JavaScript (or the binding was deleted while evaluating).
+bool QQmlSimpleBinding::evaluateDirectly(QQmlPropertyData::WriteFlags flags)
+{
+    if (hasError())
+        return false;
+
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(context()->engine);
+
+    DeleteWatcher watcher(this);
+    QQmlPropertyCapture capture(context()->engine, this, &watcher);
+    QQmlPropertyCapture *lastPropertyCapture = ep->propertyCapture;
+    ep->propertyCapture = &capture;
+    capture.guards.copyAndClearPrepend(activeGuards);
+
+    Value left;
+    Value right;
+    bool ok = evaluateOperand(m_program->operands[0], &capture, watcher, &left);
+    if (ok && m_program->op != QQmlSimpleBindingProgram::NoOperator)
+        ok = evaluateOperand(m_program->operands[1], &capture, watcher, &right);
+
+    ep->propertyCapture = lastPropertyCapture;
+
+    if (watcher.wasDeleted()) {
+        while (QQmlJavaScriptExpressionGuard *g = capture.guards.takeFirst())
+            g->Delete();
+        delete capture.errorString;
+        capture.errorString = 0;
+        return false;
+    }
+
+    if (ok) {
+        switch (m_program->op) {
+        case QQmlSimpleBindingProgram::NoOperator:
+            break;
+        case QQmlSimpleBindingProgram::Add:
+            if (left.kind == Value::String && right.kind == Value::String)
+                left.string += right.string;
+            else if (left.kind == Value::Number && right.kind == Value::Number)
+                left.number += right.number;
+            else
+                ok = false;
+            break;
+        default:
+            if (left.kind != Value::Number || right.kind != Value::Number)
+                ok = false;
+            else if (m_program->op == QQmlSimpleBindingProgram::Subtract)
+                left.number -= right.number;
+            else if (m_program->op == QQmlSimpleBindingProgram::Multiply)
+                left.number *= right.number;
+            else
+                left.number /= right.number;
+            break;
+        }
+    }
+
+    if (ok)
+        ok = acceptsValue(left);
+
+    if (!ok) {
+        // Hand the guards over to the JavaScript evaluation, which will reuse them
+        while (QQmlJavaScriptExpressionGuard *g = capture.guards.takeFirst())
+            activeGuards.prepend(g);
+        delete capture.errorString;
+        capture.errorString = 0;
+        return false;
+    }
+
+    if (capture.errorString) {
+        for (int ii = 0; ii < capture.errorString->count(); ++ii)
+            qWarning("%s", qPrintable(capture.errorString->at(ii)));
+        delete capture.errorString;
+        capture.errorString = 0;
+    }
+
+    while (QQmlJavaScriptExpressionGuard *g = capture.guards.takeFirst())
+        g->Delete();
+
+    cancelPermanentGuards();
+
+    if (isAddedToObject())
+        writeValue(left, flags);
+    return true;
+}
+
+bool QQmlSimpleBinding::evaluateOperand(const QQmlSimpleBindingProgram::Operand &operand, QQmlPropertyCapture *capture,
+                                        const DeleteWatcher &watcher, Value *value)
+{
+    if (operand.kind == QQmlSimpleBindingProgram::Operand::Constant) {
+        value->kind = Value::Number;
+        value->number = operand.constant;
+        return true;
+    }
+
+    QObject *object = nullptr;
+    QQmlPropertyData *property = nullptr;
+    if (operand.kind == QQmlSimpleBindingProgram::Operand::IdObject) {
+        QQmlContextData *ctxt = context();
+        if (operand.index >= ctxt->idValueCount)
+            return false;
+        capture->captureProperty(&ctxt->idValues[operand.index].bindings);
+        object = ctxt->idValues[operand.index].data();
+    } else {
+        object = scopeObject();
+        if (!object)
+            return false;
+        QQmlPropertyCache *cache = QQmlData::ensurePropertyCache(context()->engine, object);
+        property = cache ? cache->property(operand.index) : nullptr;
+        if (!property)
+            return false;
+    }
+
+    // Walk the member chain; every step but the last has to yield an object
+    for (int i = 0, count = operand.members.count(); i <= count; ++i) {
+        if (property) {
+            if (property->isFunction() || property->isVarProperty() || property->isQList()
+                    || property->isQJSValue())
+                return false;
+
+            QQmlData::flushPendingBinding(object, QQmlPropertyIndex(property->coreIndex()));
+            if (watcher.wasDeleted())
+                return false;
+            if (!property->isConstant())
+                capture->captureProperty(object, property->coreIndex(), property->notifyIndex());
+
+            if (i == count) {
+                const int type = property->propType();
+                if (property->isEnum() || type == QMetaType::Int) {
+                    int v = 0;
+                    property->readProperty(object, &v);
+                    value->kind = Value::Number;
+                    value->number = v;
+                } else if (type == QMetaType::Double) {
+                    value->kind = Value::Number;
+                    property->readProperty(object, &value->number);
+                } else if (type == QMetaType::Float) {
+                    float v = 0;
+                    property->readProperty(object, &v);
+                    value->kind = Value::Number;
+                    value->number = v;
+                } else if (type == QMetaType::Bool) {
+                    value->kind = Value::Boolean;
+                    property->readProperty(object, &value->boolean);
+                } else if (type == QMetaType::QString) {
+                    value->kind = Value::String;
+                    property->readProperty(object, &value->string);
+                } else {
+                    return false;
+                }
+                return true;
+            }
+
+            if (!property->isQObject())
+                return false;
+            QObject *next = nullptr;
+            property->readProperty(object, &next);
+            object = next;
+        } else if (i == count) {
+            // An id on its own is an object, leave that to the generic code
+            return false;
+        }
+
+        if (!object || QQmlData::wasDeleted(object))
+            return false;
+        property = memberProperty(operand.members.at(i), object);
+        if (!property)
+            return false;
+    }
+
+    Q_UNREACHABLE();
+    return false;
+}
+
+QQmlPropertyData *QQmlSimpleBinding::memberProperty(const QQmlSimpleBindingProgram::Member &member, QObject *object)
+{
+    QQmlPropertyCache *cache = QQmlData::ensurePropertyCache(context()->engine, object);
+    if (!cache)
+        return nullptr;
+    if (member.cache.data() != cache) {
+        member.cache = cache;
+        member.property = cache->property(member.name, object, context());
+    }
+    return member.property;
+}
+
+bool QQmlSimpleBinding::acceptsValue(const Value &value) const
+{
+    QQmlPropertyData *pd;
+    QQmlPropertyData vpd;
+    getPropertyData(&pd, &vpd);
+    if (!pd || vpd.isValid())
+        return false;
+
+    switch (pd->propType()) {
+    case QMetaType::Int:
+        return value.kind == Value::Number && qIsFinite(value.number);
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return value.kind == Value::Number;
+    case QMetaType::Bool:
+        return value.kind == Value::Boolean;
+    case QMetaType::QString:
+        return value.kind == Value::String;
+    default:
+        return false;
+    }
+}
+
+void QQmlSimpleBinding::writeValue(const Value &value, QQmlPropertyData::WriteFlags flags)
+{
+    QQmlPropertyData *pd;
+    QQmlPropertyData vpd;
+    getPropertyData(&pd, &vpd);
+    Q_ASSERT(pd);
+
+    switch (pd->propType()) {
+    case QMetaType::Int:
+        doStore<int>(value.number, pd, flags);
+        break;
+    case QMetaType::Double:
+        doStore<double>(value.number, pd, flags);
+        break;
+    case QMetaType::Float:
+        doStore<float>(value.number, pd, flags);
+        break;
+    case QMetaType::Bool:
+        doStore<bool>(value.boolean, pd, flags);
+        break;
+    case QMetaType::QString:
+        doStore<QString>(value.string, pd, flags);
+        break;
+    default:
+        Q_UNREACHABLE();
+        break;
+    }
+}
+
+QQmlBinding *QQmlBinding::createSimpleBinding(const QQmlPropertyData *property, const QQmlSimpleBindingProgram *program,
+                                              QV4::Function *function, QObject *obj, QQmlContextData *ctxt,
+                                              QV4::ExecutionContext *scope)
+{
+    Q_ASSERT(program);
+
+    // Only the types the program can produce are handled directly
+    const int type = (property && property->isFullyResolved()) ? property->propType() : QMetaType::UnknownType;
+    switch (type) {
+    case QMetaType::Int:
+    case QMetaType::Double:
+    case QMetaType::Float:
+    case QMetaType::Bool:
+    case QMetaType::QString:
+        if (!property->isQObject() && !property->isEnum())
+            break;
+        Q_FALLTHROUGH();
+    default:
+        return create(property, function, obj, ctxt, scope);
+    }
+
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(ctxt);
+    QQmlBinding *b = new (ep ? ep->activeArena : nullptr) QQmlSimpleBinding(program);
+
+    b->setNotifyOnValueChanged(true);
+    b->QQmlJavaScriptExpression::setContext(ctxt);
+    b->setScopeObject(obj);
+
+    Q_ASSERT(scope);
+    b->setupFunction(scope, function);
+
+    return b;
+}
+
 Q_NEVER_INLINE bool QQmlBinding::slowWrite(const QQmlPropertyData &core,
                                            const QQmlPropertyData &valueTypeData,
                                            const QV4::Value &result,
@@ -474,9 +862,127 @@ QString QQmlBinding::expressionIdentifier() const
 
 void QQmlBinding::expressionChanged()
 {
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(context());
+    if (Q_UNLIKELY(ep && ep->batchedBindingUpdates)) {
+        scheduleUpdate(ep);
+        return;
+    }
+
     update();
 }
 
+namespace {
+// Orders the pending binding queue as a min-heap on the dependency depth, so that a binding
+// is only evaluated after the dirty bindings it depends on.
+struct PendingUpdateGreater
+{
+    bool operator()(const QQmlEnginePrivate::PendingBindingUpdate &lhs,
+                    const QQmlEnginePrivate::PendingBindingUpdate &rhs) const
+    {
+        return lhs.depth > rhs.depth;
+    }
+};
+}
+
+/*!
+    \internal
+
+    Marks the binding dirty instead of evaluating it right away. All dirty bindings of
+    \a ep are re-evaluated once, in order of their dependency depth, by
+    flushPendingUpdates(). That happens when control returns to the event loop, or
+    earlier if the window polishes its items first.
+
+    A binding may be queued again after it was evaluated in a flush, when a dependency
+    with a stale depth changes after it. That is only a binding loop if the binding is
+    invalidated by its own evaluation, or by the bindings that evaluation invalidated in
+    turn. The direct path finds these with the updating flag, as they are evaluated
+    recursively. Batched evaluations are not nested, so the chain of evaluations that
+    queued each other is followed instead.
+*/
+void QQmlBinding::scheduleUpdate(QQmlEnginePrivate *ep)
+{
+    if (m_updatePending)
+        return;
+
+    const int cause = ep->flushingBindingUpdates ? ep->currentBindingEvaluation : -1;
+    for (int i = cause; i != -1; i = ep->bindingEvaluations.at(i).cause) {
+        if (ep->bindingEvaluations.at(i).binding == this) {
+            if (!QQmlData::wasDeleted(targetObject()))
+                reportBindingLoop();
+            return;
+        }
+    }
+
+    m_batchCause = cause;
+    m_updatePending = true;
+    ref.ref();
+    ep->pendingBindingUpdates.append({ dependencyDepth(), this });
+    std::push_heap(ep->pendingBindingUpdates.begin(), ep->pendingBindingUpdates.end(),
+                   PendingUpdateGreater());
+
+    if (!ep->flushingBindingUpdates && !ep->bindingUpdatesScheduled) {
+        ep->bindingUpdatesScheduled = true;
+        QCoreApplication::postEvent(QQmlEnginePrivate::get(ep), new QEvent(QQmlEnginePrivate::bindingUpdateEventType()));
+    }
+}
+
+void QQmlBinding::flushPendingUpdates(QQmlEnginePrivate *ep)
+{
+    if (ep->flushingBindingUpdates)
+        return;
+
+    ep->flushingBindingUpdates = true;
+
+    QVector<QQmlEnginePrivate::PendingBindingUpdate> &queue = ep->pendingBindingUpdates;
+    while (!queue.isEmpty()) {
+        std::pop_heap(queue.begin(), queue.end(), PendingUpdateGreater());
+        QQmlBinding *binding = queue.takeLast().binding;
+
+        // The binding may have been updated directly since it was queued
+        if (!binding->m_updatePending) {
+            if (!binding->ref.deref())
+                delete binding;
+            continue;
+        }
+
+        // The evaluation keeps the reference of the queue until the end of the flush, so
+        // that the bindings in the chain of evaluations stay alive while it is followed.
+        ep->currentBindingEvaluation = ep->bindingEvaluations.size();
+        ep->bindingEvaluations.append({ binding, binding->m_batchCause });
+        binding->m_batchCause = -1;
+        binding->update();
+        ep->currentBindingEvaluation = -1;
+    }
+
+    for (const QQmlEnginePrivate::BindingEvaluation &evaluation : qAsConst(ep->bindingEvaluations)) {
+        if (!evaluation.binding->ref.deref())
+            delete evaluation.binding;
+    }
+    ep->bindingEvaluations.clear();
+    ep->flushingBindingUpdates = false;
+}
+
+void QQmlBinding::clearPendingUpdates(QQmlEnginePrivate *ep)
+{
+    QVector<QQmlEnginePrivate::PendingBindingUpdate> queue;
+    queue.swap(ep->pendingBindingUpdates);
+    for (const QQmlEnginePrivate::PendingBindingUpdate &pending : qAsConst(queue)) {
+        pending.binding->m_updatePending = false;
+        if (!pending.binding->ref.deref())
+            delete pending.binding;
+    }
+}
+
+void QQmlBinding::reportBindingLoop()
+{
+    QQmlPropertyData *d = nullptr;
+    QQmlPropertyData vtd;
+    getPropertyData(&d, &vtd);
+    Q_ASSERT(d);
+    QQmlProperty p = QQmlPropertyPrivate::restore(targetObject(), *d, &vtd, 0);
+    QQmlAbstractBinding::printBindingLoopError(p);
+}
+
 void QQmlBinding::refresh()
 {
     update();
@@ -670,28 +1176,30 @@ protected:
 
 QQmlBinding *QQmlBinding::newBinding(QQmlEnginePrivate *engine, const QQmlPropertyData *property)
 {
+    QQmlArena *arena = engine ? engine->activeArena : nullptr;
+
     if (property && property->isQObject())
-        return new QObjectPointerBinding(engine, property->propType());
+        return new (arena) QObjectPointerBinding(engine, property->propType());
 
     const int type = (property && property->isFullyResolved()) ? property->propType() : QMetaType::UnknownType;
 
     if (type == qMetaTypeId<QQmlBinding *>()) {
-        return new QQmlBindingBinding;
+        return new (arena) QQmlBindingBinding;
     }
 
     switch (type) {
     case QMetaType::Bool:
-        return new GenericBinding<QMetaType::Bool>;
+        return new (arena) GenericBinding<QMetaType::Bool>;
     case QMetaType::Int:
-        return new GenericBinding<QMetaType::Int>;
+        return new (arena) GenericBinding<QMetaType::Int>;
     case QMetaType::Double:
-        return new GenericBinding<QMetaType::Double>;
+        return new (arena) GenericBinding<QMetaType::Double>;
     case QMetaType::Float:
-        return new GenericBinding<QMetaType::Float>;
+        return new (arena) GenericBinding<QMetaType::Float>;
     case QMetaType::QString:
-        return new GenericBinding<QMetaType::QString>;
+        return new (arena) GenericBinding<QMetaType::QString>;
     default:
-        return new GenericBinding<QMetaType::UnknownType>;
+        return new (arena) GenericBinding<QMetaType::UnknownType>;
     }
 }
 
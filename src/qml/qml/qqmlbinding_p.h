@@ -63,10 +63,61 @@
 
 #include <private/qqmlabstractbinding_p.h>
 #include <private/qqmljavascriptexpression_p.h>
+#include <private/qqmlpropertycache_p.h>
 
 QT_BEGIN_NAMESPACE
 
 class QQmlContext;
+
+/*
+    A binding expression that the type compiler found simple enough to be evaluated
+    without running JavaScript: a property read through a short chain of QObject
+    properties, starting at an id object or a property of the scope object, or two
+    such operands (or one and a number) combined with +, -, * or /.
+
+    The program is parsed from the descriptor string the compiler stored with the
+    binding (see QmlIR::JSCodeGen::simpleBindingDescriptor()):
+
+        descriptor := operand [' ' operator ' ' operand]
+        operand    := '=' number | '$' idIndex members | '@' coreIndex members
+        members    := ('.' name)*
+*/
+struct Q_QML_PRIVATE_EXPORT QQmlSimpleBindingProgram
+{
+    enum Operator {
+        NoOperator,
+        Add,
+        Subtract,
+        Multiply,
+        Divide
+    };
+
+    struct Member {
+        QString name;
+        // Result of the last lookup of name, valid for objects with the given cache
+        mutable QQmlRefPointer<QQmlPropertyCache> cache;
+        mutable QQmlPropertyData *property = nullptr;
+    };
+
+    struct Operand {
+        enum Kind {
+            Constant,
+            IdObject,
+            ScopeProperty
+        };
+
+        Kind kind = Constant;
+        int index = -1; // id index or scope object property index
+        double constant = 0;
+        QVector<Member> members;
+    };
+
+    Operand operands[2];
+    Operator op = NoOperator;
+
+    static QQmlSimpleBindingProgram *parse(const QString &descriptor);
+};
+
 class Q_QML_PRIVATE_EXPORT QQmlBinding : public QQmlJavaScriptExpression,
                                          public QQmlAbstractBinding
 {
@@ -77,6 +128,9 @@ public:
                                const QString &url = QString(), quint16 lineNumber = 0);
     static QQmlBinding *create(const QQmlPropertyData *property, QV4::Function *function,
                                QObject *obj, QQmlContextData *ctxt, QV4::ExecutionContext *scope);
+    static QQmlBinding *createSimpleBinding(const QQmlPropertyData *property, const QQmlSimpleBindingProgram *program,
+                                            QV4::Function *function, QObject *obj, QQmlContextData *ctxt,
+                                            QV4::ExecutionContext *scope);
     static QQmlBinding *createTranslationBinding(QV4::CompiledData::CompilationUnit *unit, const QV4::CompiledData::Binding *binding,
                                                  QObject *obj, QQmlContextData *ctxt);
     ~QQmlBinding();
@@ -102,6 +156,9 @@ public:
     QString expressionIdentifier() const override;
     void expressionChanged() override;
 
+    static void flushPendingUpdates(QQmlEnginePrivate *ep);
+    static void clearPendingUpdates(QQmlEnginePrivate *ep);
+
     /**
      * This method returns a snapshot of the currently tracked dependencies of
      * this binding. The dependencies can change upon reevaluation. This method is
@@ -127,7 +184,15 @@ private:
     inline bool enabledFlag() const;
     inline void setEnabledFlag(bool);
 
+    void scheduleUpdate(QQmlEnginePrivate *ep);
+    void reportBindingLoop();
+
     static QQmlBinding *newBinding(QQmlEnginePrivate *engine, const QQmlPropertyData *property);
+
+    // State for batched updates (QML_BATCHED_BINDINGS): the evaluation of the current flush
+    // that queued this binding, if any, and whether it is queued.
+    int m_batchCause = -1;
+    bool m_updatePending = false;
 };
 
 bool QQmlBinding::updatingFlag() const
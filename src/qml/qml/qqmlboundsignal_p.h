@@ -60,6 +60,7 @@
 #include <private/qqmlrefcount_p.h>
 #include <private/qqmlglobal_p.h>
 #include <private/qbitfield_p.h>
+#include <private/qqmlarena_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -108,6 +109,8 @@ public:
     QQmlBoundSignal(QObject *target, int signal, QObject *owner, QQmlEngine *engine);
     ~QQmlBoundSignal();
 
+    Q_QML_ARENA_ALLOCATED
+
     void removeFromObject();
 
     QQmlBoundSignalExpression *expression() const;
@@ -65,6 +65,7 @@
 #include <private/qobject_p.h>
 #include <private/qflagpointer_p.h>
 #include <private/qqmlguard_p.h>
+#include <private/qqmlarena_p.h>
 
 #include <private/qv4compileddata_p.h>
 #include <private/qv4identifier_p.h>
@@ -113,6 +114,9 @@ class Q_QML_PRIVATE_EXPORT QQmlContextData
 public:
     QQmlContextData();
     QQmlContextData(QQmlContext *);
+
+    Q_QML_ARENA_ALLOCATED
+
     void emitDestruction();
     void clearContext();
     void invalidate();
@@ -60,6 +60,7 @@
 #include "qqmlincubator.h"
 #include "qqmlabstracturlinterceptor.h"
 #include <private/qqmlboundsignal_p.h>
+#include <private/qqmlbinding_p.h>
 #include <QtCore/qstandardpaths.h>
 #include <QtCore/qsettings.h>
 #include <QtCore/qmetaobject.h>
@@ -665,6 +666,9 @@ the same object as is returned from the Qt.include() call.
 */
 // Qt.include() is implemented in qv4include.cpp
 
+DEFINE_BOOL_CONFIG_OPTION(qmlBatchedBindings, QML_BATCHED_BINDINGS)
+DEFINE_BOOL_CONFIG_OPTION(qmlWorkerScriptPool, QML_WORKER_SCRIPT_POOL)
+
 QQmlEnginePrivate::QQmlEnginePrivate(QQmlEngine *e)
 : propertyCapture(0), rootContext(0),
 #if QT_CONFIG(qml_debug)
@@ -672,8 +676,10 @@ QQmlEnginePrivate::QQmlEnginePrivate(QQmlEngine *e)
 #endif
   outputWarningsToMsgLog(true),
   cleanup(0), erroredBindings(0), inProgressCreations(0),
-  workerScriptEngine(0),
-  activeObjectCreator(0),
+  batchedBindingUpdates(qmlBatchedBindings()), bindingUpdatesScheduled(false),
+  flushingBindingUpdates(false), currentBindingEvaluation(-1),
+  workerScriptPoolSize(qmlWorkerScriptPool() ? qMax(1, QThread::idealThreadCount()) : 1),
+  activeObjectCreator(0), activeArena(0),
 #if QT_CONFIG(qml_network)
   networkAccessManager(0), networkAccessManagerFactory(0),
 #endif
@@ -697,6 +703,7 @@ QQmlEnginePrivate::~QQmlEnginePrivate()
     }
 
     doDeleteInEngineThread();
+    QQmlBinding::clearPendingUpdates(this);
 
     if (incubationController) incubationController->d = 0;
     incubationController = 0;
@@ -949,12 +956,28 @@ void QQmlEnginePrivate::init()
     rootContext = new QQmlContext(q,true);
 }
 
+/*
+  Each QQuickWorkerScriptEngine runs its WorkerScripts on one thread. With
+  QML_WORKER_SCRIPT_POOL set, WorkerScripts are spread over up to
+  workerScriptPoolSize threads, one per core, each new one going to the thread
+  running the fewest. A ListModel must not
+  then be passed to WorkerScripts on different threads, as its worker copy is not
+  synchronized between them.
+*/
 QQuickWorkerScriptEngine *QQmlEnginePrivate::getWorkerScriptEngine()
 {
     Q_Q(QQmlEngine);
-    if (!workerScriptEngine)
-        workerScriptEngine = new QQuickWorkerScriptEngine(q);
-    return workerScriptEngine;
+    QQuickWorkerScriptEngine *leastBusy = 0;
+    for (QQuickWorkerScriptEngine *engine : qAsConst(workerScriptEngines)) {
+        if (!leastBusy || engine->workerScriptCount() < leastBusy->workerScriptCount())
+            leastBusy = engine;
+    }
+
+    if (!leastBusy || (leastBusy->workerScriptCount() > 0 && workerScriptEngines.count() < workerScriptPoolSize)) {
+        leastBusy = new QQuickWorkerScriptEngine(q);
+        workerScriptEngines.append(leastBusy);
+    }
+    return leastBusy;
 }
 
 /*!
@@ -1479,6 +1502,8 @@ bool QQmlEngine::event(QEvent *e)
     Q_D(QQmlEngine);
     if (e->type() == QEvent::User)
         d->doDeleteInEngineThread();
+    else if (e->type() == QQmlEnginePrivate::bindingUpdateEventType())
+        d->flushPendingBindingUpdates();
     else if (e->type() == QEvent::LanguageChange) {
         retranslate();
     }
@@ -1497,6 +1522,25 @@ void QQmlEnginePrivate::doDeleteInEngineThread()
         delete d;
 }
 
+QEvent::Type QQmlEnginePrivate::bindingUpdateEventType()
+{
+    static const QEvent::Type type = QEvent::Type(QEvent::registerEventType());
+    return type;
+}
+
+/*!
+  \internal
+
+  Re-evaluates the bindings that were marked dirty since the last flush. This is a
+  no-op unless batched binding updates are enabled.
+*/
+void QQmlEnginePrivate::flushPendingBindingUpdates()
+{
+    bindingUpdatesScheduled = false;
+    if (!pendingBindingUpdates.isEmpty())
+        QQmlBinding::flushPendingUpdates(this);
+}
+
 namespace QtQml {
 
 void qmlExecuteDeferred(QObject *object)
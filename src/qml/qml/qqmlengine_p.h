@@ -75,6 +75,8 @@
 #include <QtCore/qmutex.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qthread.h>
+#include <QtCore/qvector.h>
+#include <QtCore/qcoreevent.h>
 
 #include <private/qobject_p.h>
 
@@ -94,6 +96,7 @@ class QQmlNetworkAccessManagerFactory;
 class QQmlTypeNameCache;
 class QQmlComponentAttached;
 class QQmlCleanup;
+class QQmlArena;
 class QQmlDelayedError;
 class QQuickWorkerScriptEngine;
 class QQmlObjectCreator;
@@ -101,6 +104,7 @@ class QDir;
 class QQmlIncubator;
 class QQmlProfiler;
 class QQmlPropertyCapture;
+class QQmlBinding;
 
 // This needs to be declared here so that the pool for it can live in QQmlEnginePrivate.
 // The inline method definitions are in qqmljavascriptexpression_p.h
@@ -150,11 +154,32 @@ public:
     QQmlDelayedError *erroredBindings;
     int inProgressCreations;
 
+    // Bindings marked dirty, waiting to be re-evaluated in dependency order.
+    // Only used if QML_BATCHED_BINDINGS is set.
+    struct PendingBindingUpdate {
+        quint16 depth;
+        QQmlBinding *binding;
+    };
+    // A binding evaluated in the current flush, and the evaluation that queued it.
+    struct BindingEvaluation {
+        QQmlBinding *binding;
+        int cause;
+    };
+    bool batchedBindingUpdates;
+    bool bindingUpdatesScheduled;
+    bool flushingBindingUpdates;
+    int currentBindingEvaluation;
+    QVector<PendingBindingUpdate> pendingBindingUpdates;
+    QVector<BindingEvaluation> bindingEvaluations;
+    void flushPendingBindingUpdates();
+    static QEvent::Type bindingUpdateEventType();
+
     QV8Engine *v8engine() const { return q_func()->handle(); }
     QV4::ExecutionEngine *v4engine() const { return QV8Engine::getV4(q_func()->handle()); }
 
     QQuickWorkerScriptEngine *getWorkerScriptEngine();
-    QQuickWorkerScriptEngine *workerScriptEngine;
+    QVector<QQuickWorkerScriptEngine *> workerScriptEngines;
+    int workerScriptPoolSize;
 
     QUrl baseUrl;
 
@@ -162,6 +187,7 @@ public:
     void registerFinalizeCallback(QObject *obj, int index);
 
     QQmlObjectCreator *activeObjectCreator;
+    QQmlArena *activeArena; // Arena of the active object creator, if it has one
 #if QT_CONFIG(qml_network)
     QNetworkAccessManager *createNetworkAccessManager(QObject *parent) const;
     QNetworkAccessManager *getNetworkAccessManager() const;
@@ -192,11 +218,21 @@ public:
         QIntrusiveListNode next;
         // Unfortunate workaround for MSVC
         QIntrusiveListNode nextWaitingFor;
+        // Incubators with a higher priority are processed first
+        int priority = 0;
     };
-    QIntrusiveList<Incubator, &Incubator::next> incubatorList;
+    typedef QIntrusiveList<Incubator, &Incubator::next> IncubatorList;
+    enum { LowestIncubatorPriority = -1, HighestIncubatorPriority = 1 };
+    // One list per priority, so that picking the next incubator is constant time
+    IncubatorList incubatorLists[HighestIncubatorPriority - LowestIncubatorPriority + 1];
     unsigned int incubatorCount;
     QQmlIncubationController *incubationController;
     void incubate(QQmlIncubator &, QQmlContextData *);
+    Incubator *nextIncubator() const;
+    static int boundIncubatorPriority(int priority)
+    { return qBound<int>(LowestIncubatorPriority, priority, HighestIncubatorPriority); }
+    IncubatorList &incubatorList(int priority)
+    { return incubatorLists[boundIncubatorPriority(priority) - LowestIncubatorPriority]; }
 
     // These methods may be called from any thread
     inline bool isEngineThread() const;
@@ -71,6 +71,7 @@ void QQmlEnginePrivate::incubate(QQmlIncubator &i, QQmlContextData *forContext)
         if (parentIncubator && parentIncubator->isAsynchronous) {
             mode = QQmlIncubator::Asynchronous;
             p->waitingOnMe = parentIncubator;
+            p->priority = parentIncubator->priority;
             parentIncubator->waitingFor.insert(p.data());
         }
     }
@@ -89,7 +90,7 @@ void QQmlEnginePrivate::incubate(QQmlIncubator &i, QQmlContextData *forContext)
             p->incubate(i);
         }
     } else {
-        incubatorList.insert(p.data());
+        incubatorList(p->priority).insert(p.data());
         incubatorCount++;
 
         p->vmeGuard.guard(p->creator.data());
@@ -100,6 +101,21 @@ void QQmlEnginePrivate::incubate(QQmlIncubator &i, QQmlContextData *forContext)
     }
 }
 
+/*
+  Returns the incubator to advance next: the first one of the highest non-empty
+  priority list.  As incubators are inserted at the front of their list, the most
+  recently started one wins among equal priorities, so that nested incubators
+  complete before the incubator waiting for them.
+*/
+QQmlEnginePrivate::Incubator *QQmlEnginePrivate::nextIncubator() const
+{
+    for (int i = HighestIncubatorPriority - LowestIncubatorPriority; i >= 0; --i) {
+        if (Incubator *next = incubatorLists[i].first())
+            return next;
+    }
+    return nullptr;
+}
+
 /*!
 Sets the engine's incubation \a controller.  The engine can only have one active controller
 and it does not take ownership of it.
@@ -257,6 +273,23 @@ void QQmlIncubationController::incubatingObjectCountChanged(int incubatingObject
     Q_UNUSED(incubatingObjectCount);
 }
 
+/*
+  Changes the order in which this incubator is processed relative to the other
+  asynchronous incubators of the engine.  Incubators this one is waiting for are
+  given the same priority, as it cannot complete before them.
+*/
+void QQmlIncubatorPrivate::setPriority(int newPriority)
+{
+    newPriority = QQmlEnginePrivate::boundIncubatorPriority(newPriority);
+    if (newPriority != priority && next.isInList()) {
+        next.remove();
+        enginePriv->incubatorList(newPriority).insert(this);
+    }
+    priority = newPriority;
+    for (QIPBase *i = waitingFor.first(); i; i = waitingFor.next(i))
+        static_cast<QQmlIncubatorPrivate *>(i)->setPriority(newPriority);
+}
+
 void QQmlIncubatorPrivate::forceCompletion(QQmlInstantiationInterrupt &i)
 {
     while (QQmlIncubator::Loading == status) {
@@ -405,7 +438,7 @@ void QQmlIncubationController::incubateFor(int msecs)
     QQmlInstantiationInterrupt i(msecs * 1000000);
     i.reset();
     do {
-        static_cast<QQmlIncubatorPrivate*>(d->incubatorList.first())->incubate(i);
+        static_cast<QQmlIncubatorPrivate*>(d->nextIncubator())->incubate(i);
     } while (d && d->incubatorCount != 0 && !i.shouldInterrupt());
 }
 
@@ -424,7 +457,7 @@ void QQmlIncubationController::incubateWhile(volatile bool *flag, int msecs)
     QQmlInstantiationInterrupt i(flag, msecs * 1000000);
     i.reset();
     do {
-        static_cast<QQmlIncubatorPrivate*>(d->incubatorList.first())->incubate(i);
+        static_cast<QQmlIncubatorPrivate*>(d->nextIncubator())->incubate(i);
     } while (d && d->incubatorCount != 0 && !i.shouldInterrupt());
 }
 
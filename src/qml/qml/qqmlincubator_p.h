@@ -103,6 +103,8 @@ public:
     void forceCompletion(QQmlInstantiationInterrupt &i);
     void incubate(QQmlInstantiationInterrupt &i);
 
+    void setPriority(int newPriority);
+
     // used by Qt Quick Controls 2
     Q_QML_PRIVATE_EXPORT static void cancel(QObject *object, QQmlContext *context = 0);
 };
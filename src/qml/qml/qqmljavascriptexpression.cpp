@@ -50,6 +50,9 @@
 #include <private/qqmlglobal_p.h>
 #include <private/qv4qobjectwrapper_p.h>
 #include <private/qqmlbuiltinfunctions_p.h>
+#include <private/qqmlbinding_p.h>
+
+#include <limits>
 
 QT_BEGIN_NAMESPACE
 
@@ -270,15 +273,11 @@ void QQmlPropertyCapture::captureProperty(QQmlNotifier *n, Duration duration)
         return;
 
     Q_ASSERT(expression);
-    // Try and find a matching guard
-    while (!guards.isEmpty() && !guards.first()->isConnected(n))
-        guards.takeFirst()->Delete();
-
-    QQmlJavaScriptExpressionGuard *g = 0;
-    if (!guards.isEmpty()) {
-        g = guards.takeFirst();
+    QQmlJavaScriptExpressionGuard *g = takeMatchingGuard([n](QQmlJavaScriptExpressionGuard *g) {
+        return g->isConnected(n);
+    });
+    if (g) {
         g->cancelNotify();
-        Q_ASSERT(g->isConnected(n));
     } else {
         g = QQmlJavaScriptExpressionGuard::New(expression, engine);
         g->connect(n);
@@ -319,15 +318,11 @@ void QQmlPropertyCapture::captureProperty(QObject *o, int c, int n, Duration dur
         errorString->append(error);
     } else {
 
-        // Try and find a matching guard
-        while (!guards.isEmpty() && !guards.first()->isConnected(o, n))
-            guards.takeFirst()->Delete();
-
-        QQmlJavaScriptExpressionGuard *g = 0;
-        if (!guards.isEmpty()) {
-            g = guards.takeFirst();
+        QQmlJavaScriptExpressionGuard *g = takeMatchingGuard([o, n](QQmlJavaScriptExpressionGuard *g) {
+            return g->isConnected(o, n);
+        });
+        if (g) {
             g->cancelNotify();
-            Q_ASSERT(g->isConnected(o, n));
         } else {
             g = QQmlJavaScriptExpressionGuard::New(expression, engine);
             g->connect(o, n, engine, doNotify);
@@ -337,9 +332,35 @@ void QQmlPropertyCapture::captureProperty(QObject *o, int c, int n, Duration dur
             expression->permanentGuards.prepend(g);
         else
             expression->activeGuards.prepend(g);
+
+        if (Q_UNLIKELY(QQmlEnginePrivate::get(engine)->batchedBindingUpdates))
+            updateDependencyDepth(o, c);
     }
 }
 
+/*! \internal
+
+    Raises the dependency depth of the capturing expression above the depth of the
+    binding on property \a c of \a o, if there is one. Batched binding updates use
+    the depth to re-evaluate dirty bindings in topological order.
+
+    The depth only ever grows, as dependencies captured permanently are not seen
+    again on later evaluations.
+*/
+void QQmlPropertyCapture::updateDependencyDepth(QObject *o, int c)
+{
+    if (c < 0)
+        return;
+
+    QQmlAbstractBinding *binding = QQmlPropertyPrivate::binding(o, QQmlPropertyIndex(c));
+    if (!binding || binding->isValueTypeProxy())
+        return;
+
+    const quint16 depth = static_cast<QQmlBinding *>(binding)->dependencyDepth();
+    if (depth < std::numeric_limits<quint16>::max() && depth >= expression->m_dependencyDepth)
+        expression->m_dependencyDepth = depth + 1;
+}
+
 void QQmlPropertyCapture::registerQmlDependencies(QV4::Heap::QmlContext *context, const QV4::ExecutionEngine *engine, const QV4::CompiledData::Function *compiledFunction)
 {
     // Let the caller check and avoid the function call :)
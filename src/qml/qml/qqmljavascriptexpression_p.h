@@ -124,6 +124,8 @@ public:
 
     QV4::Function *function() const;
 
+    quint16 dependencyDepth() const { return m_dependencyDepth; }
+
     virtual void refresh();
 
     class DeleteWatcher {
@@ -175,6 +177,7 @@ private:
     friend class QQmlPropertyCapture;
     friend void QQmlJavaScriptExpressionGuard_callback(QQmlNotifierEndpoint *, void **);
     friend class QQmlTranslationBinding;
+    friend class QQmlSimpleBinding;
 
     QQmlDelayedError *m_error;
 
@@ -182,6 +185,8 @@ private:
     QQmlJavaScriptExpression **m_prevExpression;
     QQmlJavaScriptExpression  *m_nextExpression;
     bool m_permanentDependenciesRegistered = false;
+    // Longest chain of bindings this expression depends on; only tracked for batched binding updates
+    quint16 m_dependencyDepth = 0;
 
     QV4::PersistentValue m_qmlScope;
     QQmlRefPointer<QV4::CompiledData::CompilationUnit> m_compilationUnit;
@@ -193,7 +198,7 @@ class QQmlPropertyCapture
 {
 public:
     QQmlPropertyCapture(QQmlEngine *engine, QQmlJavaScriptExpression *e, QQmlJavaScriptExpression::DeleteWatcher *w)
-    : engine(engine), expression(e), watcher(w), errorString(0) { }
+    : engine(engine), expression(e), watcher(w), errorString(0), guardCursor(0) { }
 
     ~QQmlPropertyCapture()  {
         Q_ASSERT(guards.isEmpty());
@@ -208,14 +213,51 @@ public:
     static void registerQmlDependencies(QV4::Heap::QmlContext *context, const QV4::ExecutionEngine *engine, const QV4::CompiledData::Function *compiledFunction);
     void captureProperty(QQmlNotifier *, Duration duration = OnlyOnce);
     void captureProperty(QObject *, int, int, Duration duration = OnlyOnce, bool doNotify = true);
+    void updateDependencyDepth(QObject *, int);
 
     QQmlEngine *engine;
     QQmlJavaScriptExpression *expression;
     QQmlJavaScriptExpression::DeleteWatcher *watcher;
     QFieldList<QQmlJavaScriptExpressionGuard, &QQmlJavaScriptExpressionGuard::next> guards;
     QStringList *errorString;
+
+private:
+    template<typename Matcher>
+    inline QQmlJavaScriptExpressionGuard *takeMatchingGuard(Matcher matches);
+
+    // The unmatched guard after which the next dependency is expected, or 0
+    // when it is expected at the front of the list
+    QQmlJavaScriptExpressionGuard *guardCursor;
 };
 
+/*
+    Takes the guard from the previous evaluation that is already connected to the
+    dependency being captured, so that it can be reused as is. Guards that are not
+    matched stay in the list until the evaluation finishes, and only those are
+    disconnected then.
+
+    Dependencies are mostly captured in the same order on every evaluation, so the
+    guard following the previous match is tried first. The whole list is only
+    searched when that fails, and the search moves the cursor to where the match
+    was found.
+*/
+template<typename Matcher>
+QQmlJavaScriptExpressionGuard *QQmlPropertyCapture::takeMatchingGuard(Matcher matches)
+{
+    QQmlJavaScriptExpressionGuard *expected = guardCursor ? guards.next(guardCursor) : guards.first();
+    if (expected && matches(expected))
+        return guards.takeAfter(guardCursor);
+
+    QQmlJavaScriptExpressionGuard *previous = 0;
+    for (QQmlJavaScriptExpressionGuard *g = guards.first(); g; previous = g, g = guards.next(g)) {
+        if (matches(g)) {
+            guardCursor = previous;
+            return guards.takeAfter(previous);
+        }
+    }
+    return 0;
+}
+
 QQmlJavaScriptExpression::DeleteWatcher::DeleteWatcher(QQmlJavaScriptExpression *e)
 : _c(0), _w(0), _s(e)
 {
@@ -56,20 +56,33 @@
 #include <private/qqmldebugconnector_p.h>
 #include <private/qqmldebugserviceinterfaces_p.h>
 
+#include <QtCore/qset.h>
+#include <QtCore/qthreadpool.h>
+
 QT_USE_NAMESPACE
 
 namespace {
 struct ActiveOCRestorer
 {
-    ActiveOCRestorer(QQmlObjectCreator *creator, QQmlEnginePrivate *ep)
-    : ep(ep), oldCreator(ep->activeObjectCreator) { ep->activeObjectCreator = creator; }
-    ~ActiveOCRestorer() { ep->activeObjectCreator = oldCreator; }
+    ActiveOCRestorer(QQmlObjectCreator *creator, QQmlArena *arena, QQmlEnginePrivate *ep)
+    : ep(ep), oldCreator(ep->activeObjectCreator), oldArena(ep->activeArena)
+    { ep->activeObjectCreator = creator; ep->activeArena = arena; }
+    ~ActiveOCRestorer() { ep->activeObjectCreator = oldCreator; ep->activeArena = oldArena; }
 
     QQmlEnginePrivate *ep;
     QQmlObjectCreator *oldCreator;
+    QQmlArena *oldArena;
 };
 }
 
+DEFINE_BOOL_CONFIG_OPTION(disableSimpleBindings, QML_DISABLE_SIMPLE_BINDINGS)
+DEFINE_BOOL_CONFIG_OPTION(parallelInstantiation, QML_PARALLEL_INSTANTIATION)
+
+namespace {
+// -1 follows QML_PARALLEL_INSTANTIATION, see QQmlObjectCreatorPreparation::setEnabled()
+QBasicAtomicInt parallelInstantiationOverride = Q_BASIC_ATOMIC_INITIALIZER(-1);
+}
+
 QQmlObjectCreator::QQmlObjectCreator(QQmlContextData *parentContext, QV4::CompiledData::CompilationUnit *compilationUnit, QQmlContextData *creationContext,
                                      QQmlIncubatorPrivate *incubator)
     : phase(Startup)
@@ -89,6 +102,8 @@ QQmlObjectCreator::QQmlObjectCreator(QQmlContextData *parentContext, QV4::Compil
     sharedState->allJavaScriptObjects = 0;
     sharedState->creationContext = creationContext;
     sharedState->rootContext = 0;
+    if (QQmlArena::isEnabled())
+        sharedState->arena = QQmlArena::create();
 
     if (auto profiler = QQmlEnginePrivate::get(engine)->profiler) {
         Q_QML_PROFILE_IF_ENABLED(QQmlProfilerDefinitions::ProfileCreating, profiler,
@@ -118,6 +133,7 @@ void QQmlObjectCreator::init(QQmlContextData *providedParentContext)
 
     if (compilationUnit && !compilationUnit->engine)
         compilationUnit->linkToEngine(v4);
+    QQmlObjectCreatorPreparation::complete(compilationUnit);
 
     qmlUnit = compilationUnit->data;
     context = 0;
@@ -169,7 +185,7 @@ QObject *QQmlObjectCreator::create(int subComponentIndex, QObject *parent, QQmlI
         objectToCreate = compObj->bindingTable()->value.objectIndex;
     }
 
-    context = new QQmlContextData;
+    context = new (sharedState->arena) QQmlContextData;
     context->isInternal = true;
     context->imports = compilationUnit->typeNameCache;
     context->initFromTypeCompilationUnit(compilationUnit, subComponentIndex);
@@ -806,7 +822,7 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *property, con
         if (binding->flags & QV4::CompiledData::Binding::IsSignalHandlerExpression) {
             QV4::Function *runtimeFunction = compilationUnit->runtimeFunctions[binding->value.compiledScriptIndex];
             int signalIndex = _propertyCache->methodIndexToSignalIndex(property->coreIndex());
-            QQmlBoundSignal *bs = new QQmlBoundSignal(_bindingTarget, signalIndex, _scopeObject, engine);
+            QQmlBoundSignal *bs = new (sharedState->arena) QQmlBoundSignal(_bindingTarget, signalIndex, _scopeObject, engine);
             QQmlBoundSignalExpression *expr = new QQmlBoundSignalExpression(_bindingTarget, signalIndex,
                                                                             context, _scopeObject, runtimeFunction, currentQmlContext());
 
@@ -828,7 +844,13 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *property, con
                 qmlBinding = QQmlBinding::createTranslationBinding(compilationUnit, binding, _scopeObject, context);
             } else {
                 QV4::Function *runtimeFunction = compilationUnit->runtimeFunctions[binding->value.compiledScriptIndex];
-                qmlBinding = QQmlBinding::create(prop, runtimeFunction, _scopeObject, context, currentQmlContext());
+                const QQmlSimpleBindingProgram *program = nullptr;
+                if (binding->simpleBindingIndex && !_valueTypeProperty && !property->isAlias() && !disableSimpleBindings())
+                    program = compilationUnit->simpleBindingProgram(binding->simpleBindingIndex);
+                if (program)
+                    qmlBinding = QQmlBinding::createSimpleBinding(prop, program, runtimeFunction, _scopeObject, context, currentQmlContext());
+                else
+                    qmlBinding = QQmlBinding::create(prop, runtimeFunction, _scopeObject, context, currentQmlContext());
             }
             qmlBinding->setTarget(_bindingTarget, *prop, subprop);
 
@@ -1041,7 +1063,7 @@ QObject *QQmlObjectCreator::createInstance(int index, QObject *parent, bool isCo
     const QV4::CompiledData::Object *obj = qmlUnit->objectAt(index);
     QQmlObjectCreationProfiler profiler(sharedState->profiler.profiler, obj);
 
-    ActiveOCRestorer ocRestorer(this, QQmlEnginePrivate::get(engine));
+    ActiveOCRestorer ocRestorer(this, sharedState->arena, QQmlEnginePrivate::get(engine));
 
     bool isComponent = false;
     QObject *instance = 0;
@@ -1218,7 +1240,9 @@ QQmlContextData *QQmlObjectCreator::finalize(QQmlInstantiationInterrupt &interru
     phase = Finalizing;
 
     QQmlObjectCreatorRecursionWatcher watcher(this);
-    ActiveOCRestorer ocRestorer(this, QQmlEnginePrivate::get(engine));
+    // Bindings created from here on, for example by Component.onCompleted handlers, can be
+    // installed on objects outside of this instance and would keep the arena alive.
+    ActiveOCRestorer ocRestorer(this, nullptr, QQmlEnginePrivate::get(engine));
 
     while (!sharedState->allCreatedBindings.isEmpty()) {
         QQmlAbstractBinding::Ptr b = sharedState->allCreatedBindings.pop();
@@ -1335,7 +1359,7 @@ bool QQmlObjectCreator::populateInstance(int index, QObject *instance, QObject *
     if (propertyCaches->needsVMEMetaObject(_compiledObjectIndex)) {
         Q_ASSERT(!cache.isNull());
         // install on _object
-        vmeMetaObject = new QQmlVMEMetaObject(v4, _qobject, cache, compilationUnit, _compiledObjectIndex);
+        vmeMetaObject = new (sharedState->arena) QQmlVMEMetaObject(v4, _qobject, cache, compilationUnit, _compiledObjectIndex);
         if (_ddata->propertyCache)
             _ddata->propertyCache->release();
         _ddata->propertyCache = cache;
@@ -1375,8 +1399,162 @@ bool QQmlObjectCreator::populateInstance(int index, QObject *instance, QObject *
     return errors.isEmpty();
 }
 
+QQmlObjectCreatorPreparation::QQmlObjectCreatorPreparation(const QV4::CompiledData::Unit *data)
+    : data(data)
+    , state(Queued)
+{
+    setAutoDelete(false);
+}
+
+QQmlObjectCreatorPreparation::~QQmlObjectCreatorPreparation()
+{
+    for (const MetaObjectTask &task : qAsConst(metaObjectTasks))
+        free(task.metaObject);
+    for (const BindingProgramTask &task : qAsConst(bindingProgramTasks))
+        delete task.program;
+}
+
+bool QQmlObjectCreatorPreparation::isEnabled()
+{
+    const int enabled = parallelInstantiationOverride.load();
+    return enabled == -1 ? parallelInstantiation() : enabled;
+}
+
+/*
+  Overrides QML_PARALLEL_INSTANTIATION for compilation units finalized from now on.
+*/
+void QQmlObjectCreatorPreparation::setEnabled(bool enabled)
+{
+    parallelInstantiationOverride.store(enabled);
+}
+
+void QQmlObjectCreatorPreparation::schedule(QV4::CompiledData::CompilationUnit *compilationUnit)
+{
+    if (!isEnabled() || compilationUnit->instantiationPreparation)
+        return;
+
+    QScopedPointer<QQmlObjectCreatorPreparation> preparation(new QQmlObjectCreatorPreparation(compilationUnit->data));
+
+    QSet<QQmlPropertyCache *> seenCaches;
+    const QQmlPropertyCacheVector &propertyCaches = compilationUnit->propertyCaches;
+    for (int i = 0; i < propertyCaches.count(); ++i) {
+        QQmlPropertyCache *cache = propertyCaches.at(i);
+        if (!cache || !propertyCaches.needsVMEMetaObject(i) || cache->metaObject() || seenCaches.contains(cache))
+            continue;
+        seenCaches.insert(cache);
+
+        // A composite base type may not have its meta object yet, that one is created
+        // on demand as before.
+        const QMetaObject *superClass = cache->parent() ? cache->parent()->metaObject() : nullptr;
+        if (!superClass)
+            continue;
+
+        // Property lookups on either thread resolve properties lazily, which writes to the
+        // cache. Resolve everything the worker reads up front, so that the cache is not
+        // modified while the meta object is built.
+        cache->resolveAll();
+        preparation->metaObjectTasks.append({ cache, superClass, nullptr });
+    }
+
+    QSet<int> seenDescriptors;
+    const QV4::CompiledData::Unit *data = compilationUnit->data;
+    for (quint32 i = 0; i < data->nObjects; ++i) {
+        const QV4::CompiledData::Object *object = data->objectAt(i);
+        const QV4::CompiledData::Binding *binding = object->bindingTable();
+        for (quint32 j = 0; j < object->nBindings; ++j, ++binding) {
+            const int descriptorIndex = binding->simpleBindingIndex;
+            if (!descriptorIndex || seenDescriptors.contains(descriptorIndex)
+                    || compilationUnit->simpleBindingProgramCache.contains(descriptorIndex))
+                continue;
+            seenDescriptors.insert(descriptorIndex);
+            preparation->bindingProgramTasks.append({ descriptorIndex, nullptr });
+        }
+    }
+
+    if (preparation->metaObjectTasks.isEmpty() && preparation->bindingProgramTasks.isEmpty())
+        return;
+
+    compilationUnit->instantiationPreparation = preparation.take();
+    QThreadPool::globalInstance()->start(compilationUnit->instantiationPreparation);
+}
+
+void QQmlObjectCreatorPreparation::run()
+{
+    {
+        QMutexLocker locker(&mutex);
+        state = Running;
+    }
 
+    for (MetaObjectTask &task : metaObjectTasks)
+        task.metaObject = task.cache->buildMetaObject(task.superClass);
+    for (BindingProgramTask &task : bindingProgramTasks)
+        task.program = QQmlSimpleBindingProgram::parse(data->stringAt(task.descriptorIndex));
 
+    QMutexLocker locker(&mutex);
+    state = Finished;
+    finished.wakeAll();
+}
+
+void QQmlObjectCreatorPreparation::waitForFinished()
+{
+    {
+        QMutexLocker locker(&mutex);
+        if (state == Finished)
+            return;
+        if (state == Running) {
+            while (state != Finished)
+                finished.wait(&mutex);
+            return;
+        }
+    }
+
+    // Not picked up by the pool yet, so do the work here rather than wait for it
+    if (QThreadPool::globalInstance()->tryTake(this)) {
+        run();
+        return;
+    }
+
+    QMutexLocker locker(&mutex);
+    while (state != Finished)
+        finished.wait(&mutex);
+}
+
+void QQmlObjectCreatorPreparation::complete(QV4::CompiledData::CompilationUnit *compilationUnit)
+{
+    QQmlObjectCreatorPreparation *preparation = compilationUnit ? compilationUnit->instantiationPreparation : nullptr;
+    if (Q_LIKELY(!preparation))
+        return;
+
+    compilationUnit->instantiationPreparation = nullptr;
+    preparation->waitForFinished();
+
+    for (MetaObjectTask &task : preparation->metaObjectTasks) {
+        if (task.cache->adoptMetaObject(task.metaObject))
+            task.metaObject = nullptr;
+    }
+
+    for (BindingProgramTask &task : preparation->bindingProgramTasks) {
+        if (!compilationUnit->simpleBindingProgramCache.contains(task.descriptorIndex)) {
+            compilationUnit->simpleBindingProgramCache.insert(task.descriptorIndex,
+                    QSharedPointer<const QQmlSimpleBindingProgram>(task.program));
+            task.program = nullptr;
+        }
+    }
+
+    delete preparation;
+}
+
+void QQmlObjectCreatorPreparation::cancel(QV4::CompiledData::CompilationUnit *compilationUnit)
+{
+    QQmlObjectCreatorPreparation *preparation = compilationUnit->instantiationPreparation;
+    if (Q_LIKELY(!preparation))
+        return;
+
+    compilationUnit->instantiationPreparation = nullptr;
+    if (!QThreadPool::globalInstance()->tryTake(preparation))
+        preparation->waitForFinished();
+    delete preparation;
+}
 
 QQmlObjectCreatorRecursionWatcher::QQmlObjectCreatorRecursionWatcher(QQmlObjectCreator *creator)
     : sharedState(creator->sharedState)
@@ -57,8 +57,12 @@
 #include <private/qfinitestack_p.h>
 #include <private/qrecursionwatcher_p.h>
 #include <private/qqmlprofiler_p.h>
+#include <private/qqmlarena_p.h>
 
 #include <qpointer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qwaitcondition.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -69,6 +73,8 @@ class QQmlIncubatorPrivate;
 
 struct QQmlObjectCreatorSharedState : public QSharedData
 {
+    ~QQmlObjectCreatorSharedState() { if (arena) arena->release(); }
+
     QQmlContextData *rootContext;
     QQmlContextData *creationContext;
     QFiniteStack<QQmlAbstractBinding::Ptr> allCreatedBindings;
@@ -79,6 +85,59 @@ struct QQmlObjectCreatorSharedState : public QSharedData
     QList<QQmlEnginePrivate::FinalizeCallback> finalizeCallbacks;
     QQmlVmeProfiler profiler;
     QRecursionNode recursionNode;
+    // Optional arena for the engine internal objects created for this instance (QML_CREATION_ARENA)
+    QQmlArena *arena = nullptr;
+};
+
+// The part of instantiating objects from a compilation unit that doesn't depend on any
+// live object: building the meta objects of the property caches that get a
+// QQmlVMEMetaObject, and parsing the programs of simple bindings. For large components
+// this runs on the global thread pool once the type is compiled (opt-in through
+// QML_PARALLEL_INSTANTIATION); the first QQmlObjectCreator for the unit waits for it, or
+// does the remaining work itself, and publishes the results on its own thread.
+class Q_QML_PRIVATE_EXPORT QQmlObjectCreatorPreparation : public QRunnable
+{
+public:
+    static bool isEnabled();
+    static void setEnabled(bool enabled);
+
+    static void schedule(QV4::CompiledData::CompilationUnit *compilationUnit);
+    static void complete(QV4::CompiledData::CompilationUnit *compilationUnit);
+    static void cancel(QV4::CompiledData::CompilationUnit *compilationUnit);
+
+    ~QQmlObjectCreatorPreparation();
+
+    void run() override;
+
+private:
+    QQmlObjectCreatorPreparation(const QV4::CompiledData::Unit *data);
+
+    void waitForFinished();
+
+    struct MetaObjectTask {
+        QQmlPropertyCache *cache; // owned by the compilation unit
+        const QMetaObject *superClass;
+        QMetaObject *metaObject;
+    };
+
+    struct BindingProgramTask {
+        int descriptorIndex;
+        QQmlSimpleBindingProgram *program;
+    };
+
+    const QV4::CompiledData::Unit *data;
+    QVector<MetaObjectTask> metaObjectTasks;
+    QVector<BindingProgramTask> bindingProgramTasks;
+
+    enum State {
+        Queued,
+        Running,
+        Finished
+    };
+
+    QMutex mutex;
+    QWaitCondition finished;
+    State state;
 };
 
 class QQmlObjectCreator
@@ -417,16 +417,52 @@ const QMetaObject *QQmlPropertyCache::createMetaObject()
 {
     if (!_metaObject) {
         _ownMetaObject = true;
-
-        QMetaObjectBuilder builder;
-        toMetaObjectBuilder(builder);
-        builder.setSuperClass(_parent->createMetaObject());
-        _metaObject = builder.toMetaObject();
+        _metaObject = buildMetaObject(_parent->createMetaObject());
     }
 
     return _metaObject;
 }
 
+/*!
+Builds the meta object for this cache on top of \a superClass without storing it.
+This only reads from the cache, so once resolveAll() has been called it can be done
+on another thread while the cache is not modified. The caller owns the returned meta object until it is handed back to
+the cache with adoptMetaObject().
+*/
+QMetaObject *QQmlPropertyCache::buildMetaObject(const QMetaObject *superClass)
+{
+    QMetaObjectBuilder builder;
+    toMetaObjectBuilder(builder);
+    builder.setSuperClass(superClass);
+    return builder.toMetaObject();
+}
+
+/*!
+Takes ownership of \a metaObject, built with buildMetaObject(), unless the cache
+created its own meta object in the meantime. Returns false in that case.
+*/
+bool QQmlPropertyCache::adoptMetaObject(QMetaObject *metaObject)
+{
+    if (_metaObject)
+        return false;
+
+    _ownMetaObject = true;
+    _metaObject = metaObject;
+    return true;
+}
+
+/*!
+Resolves every property and method in the cache, and the ones they override, so that
+later lookups don't write to the cache.
+*/
+void QQmlPropertyCache::resolveAll() const
+{
+    for (StringCache::ConstIterator iter = stringCache.begin(), cend = stringCache.end(); iter != cend; ++iter) {
+        for (QQmlPropertyData *data = iter.value().second; data; data = overrideData(data))
+            ensureResolved(data);
+    }
+}
+
 QQmlPropertyData *QQmlPropertyCache::defaultProperty() const
 {
     return property(defaultPropertyName(), 0, 0);
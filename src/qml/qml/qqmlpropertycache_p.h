@@ -426,6 +426,9 @@ public:
 
     const QMetaObject *metaObject() const;
     const QMetaObject *createMetaObject();
+    QMetaObject *buildMetaObject(const QMetaObject *superClass);
+    bool adoptMetaObject(QMetaObject *metaObject);
+    void resolveAll() const;
     const QMetaObject *firstCppMetaObject() const;
 
     template<typename K>
@@ -51,6 +51,7 @@
 #include <private/qqmltypecompiler_p.h>
 #include <private/qqmlpropertyvalidator_p.h>
 #include <private/qqmlpropertycachecreator_p.h>
+#include <private/qqmlobjectcreator_p.h>
 #include <private/qdeferredcleanup_p.h>
 
 #include <QtCore/qdir.h>
@@ -2334,6 +2335,7 @@ void QQmlTypeData::done()
         }
 
         m_compiledData->finalizeCompositeType(enginePrivate);
+        QQmlObjectCreatorPreparation::schedule(m_compiledData.data());
     }
 
     {
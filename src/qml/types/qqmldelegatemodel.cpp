@@ -55,6 +55,8 @@
 
 QT_BEGIN_NAMESPACE
 
+DEFINE_BOOL_CONFIG_OPTION(qmlCoalesceDataChanges, QML_COALESCE_DATA_CHANGES)
+
 class QQmlDelegateModelItem;
 
 namespace QV4 {
@@ -213,6 +215,9 @@ QQmlDelegateModelPrivate::QQmlDelegateModelPrivate(QQmlContext *ctxt)
     , m_transaction(false)
     , m_incubatorCleanupScheduled(false)
     , m_waitingToFetchMore(false)
+    , m_coalesceDataChanges(qmlCoalesceDataChanges())
+    , m_dataChangesScheduled(false)
+    , m_pendingAllRolesChanged(false)
     , m_cacheItems(0)
     , m_items(0)
     , m_persistedItems(0)
@@ -263,7 +268,9 @@ QQmlDelegateModel::~QQmlDelegateModel()
 {
     Q_D(QQmlDelegateModel);
 
-    for (QQmlDelegateModelItem *cacheItem : qAsConst(d->m_cache)) {
+    const QList<QQmlDelegateModelItem *> cacheItems = d->m_cache + d->m_reusableItemsPool;
+    d->m_reusableItemsPool.clear();
+    for (QQmlDelegateModelItem *cacheItem : cacheItems) {
         if (cacheItem->object) {
             delete cacheItem->object;
 
@@ -371,9 +378,14 @@ void QQmlDelegateModel::setModel(const QVariant &model)
 {
     Q_D(QQmlDelegateModel);
 
+    _q_flushDataChanges();
+
     if (d->m_complete)
         _q_itemsRemoved(0, d->m_count);
 
+    // Pooled items are bound to the data of the previous model.
+    d->drainReusableItemsPool(0);
+
     d->m_adaptorModel.setModel(model, this, d->m_context->engine());
     d->m_adaptorModel.replaceWatchedRoles(QList<QByteArray>(), d->m_watchedRoles);
     for (int i = 0; d->m_parts && i < d->m_parts->models.count(); ++i) {
@@ -408,6 +420,8 @@ void QQmlDelegateModel::setDelegate(QQmlComponent *delegate)
         return;
     }
     bool wasValid = d->m_delegate != 0;
+    if (d->m_delegate != delegate)
+        d->drainReusableItemsPool(0);
     d->m_delegate = delegate;
     d->m_delegateValidated = false;
     if (wasValid && d->m_complete) {
@@ -467,7 +481,9 @@ void QQmlDelegateModel::setRootIndex(const QVariant &root)
     QModelIndex modelIndex = qvariant_cast<QModelIndex>(root);
     const bool changed = d->m_adaptorModel.rootIndex != modelIndex;
     if (changed || !d->m_adaptorModel.isValid()) {
+        _q_flushDataChanges();
         const int oldCount = d->m_count;
+        d->drainReusableItemsPool(0);
         d->m_adaptorModel.rootIndex = modelIndex;
         if (!d->m_adaptorModel.isValid() && d->m_adaptorModel.aim())  // The previous root index was invalidated, so we need to reconnect the model.
             d->m_adaptorModel.setModel(d->m_adaptorModel.list.list(), this, d->m_context->engine());
@@ -533,14 +549,30 @@ int QQmlDelegateModel::count() const
     return d->m_compositor.count(d->m_compositorGroup);
 }
 
-QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *object)
+QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(
+        QObject *object, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
+    Q_Q(QQmlDelegateModel);
     QQmlDelegateModel::ReleaseFlags stat = 0;
     if (!object)
         return stat;
 
     if (QQmlDelegateModelItem *cacheItem = QQmlDelegateModelItem::dataForObject(object)) {
         if (cacheItem->releaseObject()) {
+            if (reusableFlag == QQmlInstanceModel::Reusable && isReusable(cacheItem, object)) {
+                // Keep the delegate instance alive, unbound from the cache, so that a later
+                // request for another index can rebind it instead of creating a new one.
+                const int cacheIndex = m_cache.indexOf(cacheItem);
+                const int index = cacheIndex >= 0
+                        ? m_compositor.find(Compositor::Cache, cacheIndex).index[m_compositorGroup]
+                        : -1;
+                removeCacheItem(cacheItem);
+                cacheItem->poolTime = 0;
+                m_reusableItemsPool.append(cacheItem);
+                emit q->itemPooled(index, object);
+                return QQmlInstanceModel::Pooled;
+            }
+
             cacheItem->destroyObject();
             emitDestroyingItem(object);
             if (cacheItem->incubationTask) {
@@ -560,13 +592,29 @@ QQmlDelegateModel::ReleaseFlags QQmlDelegateModelPrivate::release(QObject *objec
   Returns ReleaseStatus flags.
 */
 
-QQmlDelegateModel::ReleaseFlags QQmlDelegateModel::release(QObject *item)
+QQmlDelegateModel::ReleaseFlags QQmlDelegateModel::release(QObject *item, ReusableFlag reusableFlag)
 {
     Q_D(QQmlDelegateModel);
-    QQmlInstanceModel::ReleaseFlags stat = d->release(item);
+    QQmlInstanceModel::ReleaseFlags stat = d->release(item, reusableFlag);
     return stat;
 }
 
+/*
+  Destroys pooled delegate instances which have not been reused within \a maxPoolTime
+  calls to this function.  Passing 0 empties the pool.
+*/
+void QQmlDelegateModel::drainReusableItemsPool(int maxPoolTime)
+{
+    Q_D(QQmlDelegateModel);
+    d->drainReusableItemsPool(maxPoolTime);
+}
+
+int QQmlDelegateModel::poolSize()
+{
+    Q_D(QQmlDelegateModel);
+    return d->m_reusableItemsPool.count();
+}
+
 // Cancel a requested async item
 void QQmlDelegateModel::cancel(int index)
 {
@@ -603,6 +651,23 @@ void QQmlDelegateModel::cancel(int index)
     }
 }
 
+/*
+  Changes the order in which the pending asynchronous request for \a index is
+  incubated relative to other asynchronous requests, for example to create the
+  delegates a view is scrolling towards before those it is moving away from.
+*/
+void QQmlDelegateModel::setIncubationPriority(int index, IncubationPriority priority)
+{
+    Q_D(QQmlDelegateModel);
+    if (!d->m_delegate || index < 0 || index >= d->m_compositor.count(d->m_compositorGroup))
+        return;
+
+    Compositor::iterator it = d->m_compositor.find(d->m_compositorGroup, index);
+    QQmlDelegateModelItem *cacheItem = it->inCache() ? d->m_cache.at(it.cacheIndex) : 0;
+    if (cacheItem && cacheItem->incubationTask)
+        QQmlIncubatorPrivate::get(cacheItem->incubationTask)->setPriority(priority);
+}
+
 void QQmlDelegateModelPrivate::group_append(
         QQmlListProperty<QQmlDelegateModelGroup> *property, QQmlDelegateModelGroup *group)
 {
@@ -871,6 +936,63 @@ void QQmlDelegateModelPrivate::removeCacheItem(QQmlDelegateModelItem *cacheItem)
     Q_ASSERT(m_cache.count() == m_compositor.count(Compositor::Cache));
 }
 
+/*
+  A delegate instance can only be pooled if nothing but the view refers to it and its
+  model data can be rebound to another index.  Packages are shared between the parts
+  of a model and are never pooled.
+*/
+bool QQmlDelegateModelPrivate::isReusable(QQmlDelegateModelItem *cacheItem, QObject *object) const
+{
+    return cacheItem->object == object
+            && cacheItem->scriptRef == 1
+            && !cacheItem->incubationTask
+            && !(cacheItem->groups & (Compositor::UnresolvedFlag | Compositor::PersistedFlag))
+            && cacheItem->isRebindable()
+            && !qmlobject_cast<QQuickPackage *>(object);
+}
+
+QQmlDelegateModelItem *QQmlDelegateModelPrivate::takeReusableItem()
+{
+    // Pooled items are not kept up to date with changes to the model, so any of
+    // them will do; the most recently pooled one is the least likely to be drained.
+    return m_reusableItemsPool.isEmpty() ? 0 : m_reusableItemsPool.takeLast();
+}
+
+void QQmlDelegateModelPrivate::reuseItem(QQmlDelegateModelItem *cacheItem, int index, int modelIndex)
+{
+    Q_Q(QQmlDelegateModel);
+    cacheItem->poolTime = 0;
+    cacheItem->rebindIndex(m_adaptorModel, modelIndex);
+
+    if (QQmlDelegateModelAttached *attached = cacheItem->attached) {
+        attached->resetCurrentIndex();
+        attached->emitChanges();
+    }
+
+    emit q->itemReused(index, cacheItem->object);
+}
+
+void QQmlDelegateModelPrivate::drainReusableItemsPool(int maxPoolTime)
+{
+    QList<QQmlDelegateModelItem *> expired;
+    for (auto it = m_reusableItemsPool.begin(); it != m_reusableItemsPool.end();) {
+        QQmlDelegateModelItem *cacheItem = *it;
+        if (++cacheItem->poolTime > maxPoolTime) {
+            expired.append(cacheItem);
+            it = m_reusableItemsPool.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (QQmlDelegateModelItem *cacheItem : qAsConst(expired)) {
+        QObject *object = cacheItem->object;
+        cacheItem->destroyObject();
+        emitDestroyingItem(object);
+        cacheItem->Dispose();
+    }
+}
+
 void QQmlDelegateModelPrivate::incubatorStatusChanged(QQDMIncubationTask *incubationTask, QQmlIncubator::Status status)
 {
     Q_Q(QQmlDelegateModel);
@@ -944,15 +1066,23 @@ QObject *QQmlDelegateModelPrivate::object(Compositor::Group group, int index, bo
     QQmlDelegateModelItem *cacheItem = it->inCache() ? m_cache.at(it.cacheIndex) : 0;
 
     if (!cacheItem) {
-        cacheItem = m_adaptorModel.createItem(m_cacheMetaType, it.modelIndex());
-        if (!cacheItem)
-            return 0;
+        bool reused = true;
+        cacheItem = takeReusableItem();
+        if (!cacheItem) {
+            reused = false;
+            cacheItem = m_adaptorModel.createItem(m_cacheMetaType, it.modelIndex());
+            if (!cacheItem)
+                return 0;
+        }
 
         cacheItem->groups = it->flags;
 
         m_cache.insert(it.cacheIndex, cacheItem);
         m_compositor.setFlags(it, 1, Compositor::CacheFlag);
         Q_ASSERT(m_cache.count() == m_compositor.count(Compositor::Cache));
+
+        if (reused)
+            reuseItem(cacheItem, index, it.modelIndex());
     }
 
     // Bump the reference counts temporarily so neither the content data or the delegate object
@@ -1537,6 +1667,7 @@ void QQmlDelegateModel::_q_rowsInserted(const QModelIndex &parent, int begin, in
 void QQmlDelegateModel::_q_rowsAboutToBeRemoved(const QModelIndex &parent, int begin, int end)
 {
     Q_D(QQmlDelegateModel);
+    _q_flushDataChanges();
     if (!d->m_adaptorModel.rootIndex.isValid())
         return;
     const QModelIndex index = d->m_adaptorModel.rootIndex;
@@ -1579,8 +1710,52 @@ void QQmlDelegateModel::_q_rowsMoved(
 void QQmlDelegateModel::_q_dataChanged(const QModelIndex &begin, const QModelIndex &end, const QVector<int> &roles)
 {
     Q_D(QQmlDelegateModel);
-    if (begin.parent() == d->m_adaptorModel.rootIndex)
+    if (begin.parent() != d->m_adaptorModel.rootIndex)
+        return;
+
+    if (!d->m_coalesceDataChanges) {
         _q_itemsChanged(begin.row(), end.row() - begin.row() + 1, roles);
+        return;
+    }
+
+    // Accumulate the changed rows and roles and notify delegates once when control returns to
+    // the event loop, or before the model next changes its rows.
+    d->m_pendingDataChanges.change(begin.row(), end.row() - begin.row() + 1);
+    if (roles.isEmpty()) {
+        d->m_pendingAllRolesChanged = true;
+    } else if (!d->m_pendingAllRolesChanged) {
+        for (int role : roles) {
+            if (!d->m_pendingDataChangedRoles.contains(role))
+                d->m_pendingDataChangedRoles.append(role);
+        }
+    }
+    if (!d->m_dataChangesScheduled) {
+        d->m_dataChangesScheduled = true;
+        QMetaObject::invokeMethod(this, "_q_flushDataChanges", Qt::QueuedConnection);
+    }
+}
+
+/*
+    Delivers the data changes accumulated by _q_dataChanged().  The union of the changed roles is
+    reported for every changed range.
+*/
+void QQmlDelegateModel::_q_flushDataChanges()
+{
+    Q_D(QQmlDelegateModel);
+    d->m_dataChangesScheduled = false;
+    if (d->m_pendingDataChanges.isEmpty())
+        return;
+
+    const QVector<QQmlChangeSet::Change> changes = d->m_pendingDataChanges.changes();
+    const QVector<int> roles = d->m_pendingAllRolesChanged
+            ? QVector<int>()
+            : d->m_pendingDataChangedRoles;
+    d->m_pendingDataChanges.clear();
+    d->m_pendingDataChangedRoles.clear();
+    d->m_pendingAllRolesChanged = false;
+
+    for (const QQmlChangeSet::Change &change : changes)
+        _q_itemsChanged(change.index, change.count, roles);
 }
 
 bool QQmlDelegateModel::isDescendantOf(const QPersistentModelIndex& desc, const QList< QPersistentModelIndex >& parents) const
@@ -1910,6 +2085,7 @@ QQmlDelegateModelItem::QQmlDelegateModelItem(
     , scriptRef(0)
     , groups(0)
     , index(modelIndex)
+    , poolTime(0)
 {
     metaType->addref();
 }
@@ -2193,6 +2369,22 @@ bool QQmlDelegateModelAttached::isUnresolved() const
     It is attached to each instance of the delegate.
 */
 
+/*
+  Re-reads the group indexes of a delegate instance which has been taken from the
+  pool of reusable items.  The changes are reported by the following emitChanges().
+*/
+void QQmlDelegateModelAttached::resetCurrentIndex()
+{
+    if (!m_cacheItem)
+        return;
+
+    QQmlDelegateModelPrivate * const model = QQmlDelegateModelPrivate::get(m_cacheItem->metaType->model);
+    Compositor::iterator it = model->m_compositor.find(
+            Compositor::Cache, model->m_cache.indexOf(m_cacheItem));
+    for (int i = 1; i < m_cacheItem->metaType->groupCount; ++i)
+        m_currentIndex[i] = it.index[i];
+}
+
 void QQmlDelegateModelAttached::emitChanges()
 {
     const int groupChanges = m_previousGroups ^ m_cacheItem->groups;
@@ -3148,7 +3340,7 @@ QObject *QQmlPartsModel::object(int index, bool asynchronous)
     return 0;
 }
 
-QQmlInstanceModel::ReleaseFlags QQmlPartsModel::release(QObject *item)
+QQmlInstanceModel::ReleaseFlags QQmlPartsModel::release(QObject *item, ReusableFlag)
 {
     QQmlInstanceModel::ReleaseFlags flags = 0;
 
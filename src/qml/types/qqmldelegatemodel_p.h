@@ -110,8 +110,11 @@ public:
     int count() const override;
     bool isValid() const override { return delegate() != 0; }
     QObject *object(int index, bool asynchronous = false) override;
-    ReleaseFlags release(QObject *object) override;
+    ReleaseFlags release(QObject *object, ReusableFlag reusableFlag = NotReusable) override;
     void cancel(int index) override;
+    void setIncubationPriority(int index, IncubationPriority priority) override;
+    void drainReusableItemsPool(int maxPoolTime) override;
+    int poolSize() override;
     QString stringValue(int index, const QString &role) override;
     void setWatchedRoles(const QList<QByteArray> &roles) override;
 
@@ -147,6 +150,7 @@ private Q_SLOTS:
     void _q_rowsMoved(const QModelIndex &, int, int, const QModelIndex &, int);
     void _q_dataChanged(const QModelIndex&,const QModelIndex&,const QVector<int> &);
     void _q_layoutChanged(const QList<QPersistentModelIndex>&, QAbstractItemModel::LayoutChangeHint);
+    void _q_flushDataChanges();
 
 private:
     bool isDescendantOf(const QPersistentModelIndex &desc, const QList<QPersistentModelIndex> &parents) const;
@@ -217,6 +221,7 @@ public:
 
     bool isUnresolved() const;
 
+    void resetCurrentIndex();
     void emitChanges();
 
     void emitUnresolvedChanged() { Q_EMIT unresolvedChanged(); }
@@ -125,6 +125,8 @@ public:
 
     virtual void setValue(const QString &role, const QVariant &value) { Q_UNUSED(role); Q_UNUSED(value); }
     virtual bool resolveIndex(const QQmlAdaptorModel &, int) { return false; }
+    virtual bool isRebindable() const { return false; }
+    virtual void rebindIndex(const QQmlAdaptorModel &, int) {}
 
     static QV4::ReturnedValue get_model(const QV4::BuiltinFunction *, QV4::CallData *callData);
     static QV4::ReturnedValue get_groups(const QV4::BuiltinFunction *, QV4::CallData *callData);
@@ -143,6 +145,7 @@ public:
     int scriptRef;
     int groups;
     int index;
+    int poolTime;
 
 Q_SIGNALS:
     void modelIndexChanged();
@@ -257,7 +260,9 @@ public:
 
     void requestMoreIfNecessary();
     QObject *object(Compositor::Group group, int index, bool asynchronous);
-    QQmlDelegateModel::ReleaseFlags release(QObject *object);
+    QQmlDelegateModel::ReleaseFlags release(
+            QObject *object,
+            QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
     QString stringValue(Compositor::Group group, int index, const QString &name);
     void emitCreatedPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
     void emitInitPackage(QQDMIncubationTask *incubationTask, QQuickPackage *package);
@@ -269,6 +274,11 @@ public:
     void emitDestroyingItem(QObject *item) { Q_EMIT q_func()->destroyingItem(item); }
     void removeCacheItem(QQmlDelegateModelItem *cacheItem);
 
+    bool isReusable(QQmlDelegateModelItem *cacheItem, QObject *object) const;
+    QQmlDelegateModelItem *takeReusableItem();
+    void reuseItem(QQmlDelegateModelItem *cacheItem, int index, int modelIndex);
+    void drainReusableItemsPool(int maxPoolTime);
+
     void updateFilterGroup();
 
     void addGroups(Compositor::iterator from, int count, Compositor::Group group, int groupFlags);
@@ -310,9 +320,13 @@ public:
     QQmlDelegateModelGroupEmitterList m_pendingParts;
 
     QList<QQmlDelegateModelItem *> m_cache;
+    QList<QQmlDelegateModelItem *> m_reusableItemsPool;
     QList<QQDMIncubationTask *> m_finishedIncubating;
     QList<QByteArray> m_watchedRoles;
 
+    QQmlChangeSet m_pendingDataChanges;
+    QVector<int> m_pendingDataChangedRoles;
+
     QString m_filterGroup;
 
     int m_count;
@@ -326,6 +340,9 @@ public:
     bool m_transaction : 1;
     bool m_incubatorCleanupScheduled : 1;
     bool m_waitingToFetchMore : 1;
+    bool m_coalesceDataChanges : 1;
+    bool m_dataChangesScheduled : 1;
+    bool m_pendingAllRolesChanged : 1;
 #else
     bool m_complete;
     bool m_delegateValidated;
@@ -333,6 +350,9 @@ public:
     bool m_transaction;
     bool m_incubatorCleanupScheduled;
     bool m_waitingToFetchMore;
+    bool m_coalesceDataChanges;
+    bool m_dataChangesScheduled;
+    bool m_pendingAllRolesChanged;
 #endif
 
     union {
@@ -362,7 +382,7 @@ public:
     int count() const override;
     bool isValid() const override;
     QObject *object(int index, bool asynchronous = false) override;
-    ReleaseFlags release(QObject *item) override;
+    ReleaseFlags release(QObject *item, ReusableFlag reusableFlag = NotReusable) override;
     QString stringValue(int index, const QString &role) override;
     QList<QByteArray> watchedRoles() const { return m_watchedRoles; }
     void setWatchedRoles(const QList<QByteArray> &roles) override;
@@ -62,6 +62,9 @@
 #include <QtCore/qdatetime.h>
 #include <QScopedValueRollback>
 
+#include <algorithm>
+#include <numeric>
+
 QT_BEGIN_NAMESPACE
 
 // Set to 1024 as a debugging aid - easier to distinguish uids from indices of elements/models.
@@ -69,17 +72,6 @@ enum { MIN_LISTMODEL_UID = 1024 };
 
 static QAtomicInt uidCounter(MIN_LISTMODEL_UID);
 
-template <typename T>
-static bool isMemoryUsed(const char *mem)
-{
-    for (size_t i=0 ; i < sizeof(T) ; ++i) {
-        if (mem[i] != 0)
-            return true;
-    }
-
-    return false;
-}
-
 static QString roleTypeName(ListLayout::Role::DataType t)
 {
     static const QString roleTypeNames[] = {
@@ -124,9 +116,6 @@ const ListLayout::Role &ListLayout::getRoleOrCreate(QV4::String *key, Role::Data
 
 const ListLayout::Role &ListLayout::createRole(const QString &key, ListLayout::Role::DataType type)
 {
-    const int dataSizes[] = { sizeof(QString), sizeof(double), sizeof(bool), sizeof(ListModel *), sizeof(QPointer<QObject>), sizeof(QVariantMap), sizeof(QDateTime), sizeof(QJSValue) };
-    const int dataAlignments[] = { sizeof(QString), sizeof(double), sizeof(bool), sizeof(ListModel *), sizeof(QObject *), sizeof(QVariantMap), sizeof(QDateTime), sizeof(QJSValue) };
-
     Role *r = new Role;
     r->name = key;
     r->type = type;
@@ -137,20 +126,6 @@ const ListLayout::Role &ListLayout::createRole(const QString &key, ListLayout::R
         r->subLayout = 0;
     }
 
-    int dataSize = dataSizes[type];
-    int dataAlignment = dataAlignments[type];
-
-    int dataOffset = (currentBlockOffset + dataAlignment-1) & ~(dataAlignment-1);
-    if (dataOffset + dataSize > ListElement::BLOCK_SIZE) {
-        r->blockIndex = ++currentBlock;
-        r->blockOffset = 0;
-        currentBlockOffset = dataSize;
-    } else {
-        r->blockIndex = currentBlock;
-        r->blockOffset = dataOffset;
-        currentBlockOffset = dataOffset + dataSize;
-    }
-
     int roleIndex = roles.count();
     r->index = roleIndex;
 
@@ -160,7 +135,7 @@ const ListLayout::Role &ListLayout::createRole(const QString &key, ListLayout::R
     return *r;
 }
 
-ListLayout::ListLayout(const ListLayout *other) : currentBlock(0), currentBlockOffset(0)
+ListLayout::ListLayout(const ListLayout *other)
 {
     const int otherRolesCount = other->roles.count();
     roles.reserve(otherRolesCount);
@@ -169,8 +144,6 @@ ListLayout::ListLayout(const ListLayout *other) : currentBlock(0), currentBlockO
         roles.append(role);
         roleHash.insert(role->name, role);
     }
-    currentBlockOffset = other->currentBlockOffset;
-    currentBlock = other->currentBlock;
 }
 
 ListLayout::~ListLayout()
@@ -188,17 +161,33 @@ void ListLayout::sync(ListLayout *src, ListLayout *target)
         target->roles.append(role);
         target->roleHash.insert(role->name, role);
     }
+}
+
+/*
+  Returns a string equal to \a s. If an equal string was interned recently,
+  the returned string shares its data. The table is small and direct-mapped,
+  so that the values that repeat across many elements, like categories or
+  states, are stored once, while unique values just replace each other
+  without the table growing.
+*/
+QString ListLayout::internString(const QString &s)
+{
+    if (s.isEmpty())
+        return s;
 
-    target->currentBlockOffset = src->currentBlockOffset;
-    target->currentBlock = src->currentBlock;
+    if (internedStrings.isEmpty())
+        internedStrings.resize(InternedStringCount);
+
+    QString &interned = internedStrings[qHash(s) & (InternedStringCount - 1)];
+    if (interned != s)
+        interned = s;
+    return interned;
 }
 
 ListLayout::Role::Role(const Role *other)
 {
     name = other->name;
     type = other->type;
-    blockIndex = other->blockIndex;
-    blockOffset = other->blockOffset;
     index = other->index;
     if (other->subLayout)
         subLayout = new ListLayout(other->subLayout);
@@ -261,1047 +250,1131 @@ const ListLayout::Role *ListLayout::getExistingRole(QV4::String *key) const
     return r;
 }
 
-QObject *ListModel::getOrCreateModelObject(QQmlListModel *model, int elementIndex)
+template <typename T>
+static void insertColumnRows(QVector<T> &values, int at, const QVector<T> *source, int from, int count)
 {
-    ListElement *e = elements[elementIndex];
-    if (e->m_objectCache == 0) {
-        e->m_objectCache = new QObject;
-        (void)new ModelNodeMetaObject(e->m_objectCache, model, elementIndex);
-    }
-    return e->m_objectCache;
+    values.insert(at, count, T());
+    if (source)
+        std::copy(source->constBegin() + from, source->constBegin() + from + count, values.begin() + at);
 }
 
-void ListModel::sync(ListModel *src, ListModel *target, QHash<int, ListModel *> *targetModelHash)
+/*
+  Inserts \a count values at \a at, copied from \a source starting at \a from,
+  or default values if \a source is null or holds a different type.
+*/
+void ListColumn::insertRows(int at, const ListColumn *source, int from, int count)
 {
-    // Sanity check
-    target->m_uid = src->m_uid;
-    if (targetModelHash)
-        targetModelHash->insert(target->m_uid, target);
-
-    // Build hash of elements <-> uid for each of the lists
-    QHash<int, ElementSync> elementHash;
-    for (int i=0 ; i < target->elements.count() ; ++i) {
-        ListElement *e = target->elements.at(i);
-        int uid = e->getUid();
-        ElementSync sync;
-        sync.target = e;
-        elementHash.insert(uid, sync);
-    }
-    for (int i=0 ; i < src->elements.count() ; ++i) {
-        ListElement *e = src->elements.at(i);
-        int uid = e->getUid();
+    Q_ASSERT(source != this);
+    if (source && source->type != type)
+        source = 0;
 
-        QHash<int, ElementSync>::iterator it = elementHash.find(uid);
-        if (it == elementHash.end()) {
-            ElementSync sync;
-            sync.src = e;
-            elementHash.insert(uid, sync);
-        } else {
-            ElementSync &sync = it.value();
-            sync.src = e;
-        }
+    switch (type) {
+    case ListLayout::Role::String:
+        insertColumnRows(strings, at, source ? &source->strings : 0, from, count);
+        break;
+    case ListLayout::Role::Number:
+        insertColumnRows(numbers, at, source ? &source->numbers : 0, from, count);
+        break;
+    case ListLayout::Role::Bool:
+        insertColumnRows(bools, at, source ? &source->bools : 0, from, count);
+        break;
+    case ListLayout::Role::List:
+        insertColumnRows(lists, at, source ? &source->lists : 0, from, count);
+        break;
+    case ListLayout::Role::QObject:
+        insertColumnRows(objects, at, source ? &source->objects : 0, from, count);
+        break;
+    case ListLayout::Role::VariantMap:
+    case ListLayout::Role::DateTime:
+    case ListLayout::Role::Function:
+        insertColumnRows(variants, at, source ? &source->variants : 0, from, count);
+        break;
+    default:
+        break;
     }
+}
 
-    // Get list of elements that are in the target but no longer in the source. These get deleted first.
-    QHash<int, ElementSync>::iterator it = elementHash.begin();
-    QHash<int, ElementSync>::iterator end = elementHash.end();
-    while (it != end) {
-        const ElementSync &s = it.value();
-        if (s.src == 0) {
-            s.target->destroy(target->m_layout);
-            target->elements.removeOne(s.target);
-            delete s.target;
-        }
-        ++it;
+void ListColumn::removeRows(int at, int count)
+{
+    switch (type) {
+    case ListLayout::Role::String:
+        strings.remove(at, count);
+        break;
+    case ListLayout::Role::Number:
+        numbers.remove(at, count);
+        break;
+    case ListLayout::Role::Bool:
+        bools.remove(at, count);
+        break;
+    case ListLayout::Role::List:
+        lists.remove(at, count);
+        break;
+    case ListLayout::Role::QObject:
+        objects.remove(at, count);
+        break;
+    case ListLayout::Role::VariantMap:
+    case ListLayout::Role::DateTime:
+    case ListLayout::Role::Function:
+        variants.remove(at, count);
+        break;
+    default:
+        break;
     }
+}
 
-    // Sync the layouts
-    ListLayout::sync(src->m_layout, target->m_layout);
+/*
+  Inserts \a count rows at \a at, copied from the rows of \a source starting
+  at \a from, or blank rows with new uids if \a source is null. Nested models
+  are not copied; the pointers to them are.
+*/
+void ListChunk::insertRows(int at, const ListChunk *source, int from, int count)
+{
+    Q_ASSERT(source != this);
+    const int rows = rowCount();
 
-    // Clear the target list, and append in correct order from the source
-    target->elements.clear();
-    for (int i=0 ; i < src->elements.count() ; ++i) {
-        ListElement *srcElement = src->elements.at(i);
-        it = elementHash.find(srcElement->getUid());
-        const ElementSync &s = it.value();
-        ListElement *targetElement = s.target;
-        if (targetElement == 0) {
-            targetElement = new ListElement(srcElement->getUid());
+    uids.insert(at, count, 0);
+    if (source) {
+        std::copy(source->uids.constBegin() + from, source->uids.constBegin() + from + count, uids.begin() + at);
+        if (columns.count() < source->columns.count())
+            columns.resize(source->columns.count());
+    } else {
+        for (int i = 0; i < count; ++i)
+            uids[at + i] = uidCounter.fetchAndAddOrdered(1);
+    }
+
+    for (int i = 0; i < columns.count(); ++i) {
+        ListColumn &c = columns[i];
+        const ListColumn *sourceColumn = source ? source->column(i) : 0;
+        if (c.type == ListLayout::Role::Invalid) {
+            if (!sourceColumn)
+                continue;
+            c.type = sourceColumn->type;
+            c.insertRows(0, 0, 0, rows);
         }
-        ListElement::sync(srcElement, src->m_layout, targetElement, target->m_layout, targetModelHash);
-        target->elements.append(targetElement);
+        c.insertRows(at, sourceColumn, from, count);
     }
+}
 
-    target->updateCacheIndices();
-
-    // Update values stored in target meta objects
-    for (int i=0 ; i < target->elements.count() ; ++i) {
-        ListElement *e = target->elements[i];
-        if (ModelNodeMetaObject *mo = e->objectCache())
-            mo->updateValues();
-    }
+/*
+  Removes \a count rows at \a at. Nested models in them are not destroyed.
+*/
+void ListChunk::removeRows(int at, int count)
+{
+    uids.remove(at, count);
+    for (int i = 0; i < columns.count(); ++i)
+        columns[i].removeRows(at, count);
 }
 
-ListModel::ListModel(ListLayout *layout, QQmlListModel *modelCache, int uid) : m_layout(layout), m_modelCache(modelCache)
+ListColumn &ListChunk::column(const ListLayout::Role &role)
 {
-    if (uid == -1)
-        uid = uidCounter.fetchAndAddOrdered(1);
-    m_uid = uid;
+    if (columns.count() <= role.index)
+        columns.resize(role.index + 1);
+
+    ListColumn &c = columns[role.index];
+    if (c.type == ListLayout::Role::Invalid) {
+        c.type = role.type;
+        c.insertRows(0, 0, 0, rowCount());
+    }
+    return c;
 }
 
-void ListModel::destroy()
+/*
+  Returns the value of \a role in \a row. Nested models are returned by
+  getListProperty() instead.
+*/
+QVariant ListChunk::getProperty(int row, const ListLayout::Role &role) const
 {
-    for (const auto &destroyer : remove(0, elements.count()))
-        destroyer();
+    const ListColumn *c = column(role.index);
 
-    m_uid = -1;
-    m_layout = 0;
-    if (m_modelCache && m_modelCache->m_primary == false)
-        delete m_modelCache;
-    m_modelCache = 0;
+    QVariant data;
+
+    switch (role.type) {
+        case ListLayout::Role::Number:
+            data = c ? c->numbers.at(row) : 0.0;
+            break;
+        case ListLayout::Role::String:
+            if (c && !c->strings.at(row).isNull())
+                data = c->strings.at(row);
+            break;
+        case ListLayout::Role::Bool:
+            data = c ? c->bools.at(row) : false;
+            break;
+        case ListLayout::Role::QObject:
+            if (QObject *object = c ? c->objects.at(row).data() : 0)
+                data = QVariant::fromValue(object);
+            break;
+        case ListLayout::Role::VariantMap:
+        case ListLayout::Role::DateTime:
+        case ListLayout::Role::Function:
+            if (c)
+                data = c->variants.at(row);
+            break;
+        default:
+            break;
+    }
+
+    return data;
 }
 
-int ListModel::appendElement()
+ListModel *ListChunk::getListProperty(int row, const ListLayout::Role &role) const
 {
-    int elementIndex = elements.count();
-    newElement(elementIndex);
-    return elementIndex;
+    const ListColumn *c = column(role.index);
+    return c && c->type == ListLayout::Role::List ? c->lists.at(row) : 0;
 }
 
-void ListModel::insertElement(int index)
+QObject *ListChunk::getQObjectProperty(int row, const ListLayout::Role &role) const
 {
-    newElement(index);
-    updateCacheIndices(index);
+    const ListColumn *c = column(role.index);
+    return c && c->type == ListLayout::Role::QObject ? c->objects.at(row).data() : 0;
 }
 
-void ListModel::move(int from, int to, int n)
+int ListChunk::setStringProperty(int row, const ListLayout::Role &role, const QString &s)
 {
-    if (from > to) {
-        // Only move forwards - flip if backwards moving
-        int tfrom = from;
-        int tto = to;
-        from = tto;
-        to = tto+n;
-        n = tfrom-tto;
-    }
+    int roleIndex = -1;
 
-    QPODVector<ListElement *, 4> store;
-    for (int i=0 ; i < (to-from) ; ++i)
-        store.append(elements[from+n+i]);
-    for (int i=0 ; i < n ; ++i)
-        store.append(elements[from+i]);
-    for (int i=0 ; i < store.count() ; ++i)
-        elements[from+i] = store[i];
+    if (role.type == ListLayout::Role::String) {
+        QString &value = column(role).strings[row];
+        bool changed = value.isNull() || value.compare(s) != 0;
+        // A null string marks a value that was never set.
+        value = s.isNull() ? QString(QLatin1String("")) : s;
+        if (changed)
+            roleIndex = role.index;
+    }
 
-    updateCacheIndices(from, to + n);
+    return roleIndex;
 }
 
-void ListModel::newElement(int index)
+int ListChunk::setDoubleProperty(int row, const ListLayout::Role &role, double d)
 {
-    ListElement *e = new ListElement;
-    elements.insert(index, e);
+    int roleIndex = -1;
+
+    if (role.type == ListLayout::Role::Number) {
+        double &value = column(role).numbers[row];
+        bool changed = value != d;
+        value = d;
+        if (changed)
+            roleIndex = role.index;
+    }
+
+    return roleIndex;
 }
 
-void ListModel::updateCacheIndices(int start, int end)
+int ListChunk::setBoolProperty(int row, const ListLayout::Role &role, bool b)
 {
-    int count = elements.count();
-
-    if (end < 0 || end > count)
-        end = count;
+    int roleIndex = -1;
 
-    for (int i = start; i < end; ++i) {
-        ListElement *e = elements.at(i);
-        if (ModelNodeMetaObject *mo = e->objectCache())
-            mo->m_elementIndex = i;
+    if (role.type == ListLayout::Role::Bool) {
+        bool &value = column(role).bools[row];
+        bool changed = value != b;
+        value = b;
+        if (changed)
+            roleIndex = role.index;
     }
-}
 
-QVariant ListModel::getProperty(int elementIndex, int roleIndex, const QQmlListModel *owner, QV4::ExecutionEngine *eng)
-{
-    if (roleIndex >= m_layout->roleCount())
-        return QVariant();
-    ListElement *e = elements[elementIndex];
-    const ListLayout::Role &r = m_layout->getExistingRole(roleIndex);
-    return e->getProperty(r, owner, eng);
+    return roleIndex;
 }
 
-ListModel *ListModel::getListProperty(int elementIndex, const ListLayout::Role &role)
+int ListChunk::setListProperty(int row, const ListLayout::Role &role, ListModel *m)
 {
-    ListElement *e = elements[elementIndex];
-    return e->getListProperty(role);
+    int roleIndex = -1;
+
+    if (role.type == ListLayout::Role::List) {
+        ListModel *&value = column(role).lists[row];
+        if (value && value != m) {
+            value->destroy();
+            delete value;
+        }
+        value = m;
+        roleIndex = role.index;
+    }
+
+    return roleIndex;
 }
 
-void ListModel::set(int elementIndex, QV4::Object *object, QVector<int> *roles)
+int ListChunk::setQObjectProperty(int row, const ListLayout::Role &role, QObject *o)
 {
-    ListElement *e = elements[elementIndex];
+    int roleIndex = -1;
 
-    QV4::ExecutionEngine *v4 = object->engine();
-    QV4::Scope scope(v4);
-    QV4::ScopedObject o(scope);
+    if (role.type == ListLayout::Role::QObject) {
+        QPointer<QObject> &value = column(role).objects[row];
+        bool changed = value.data() != o;
+        value = o;
+        if (changed)
+            roleIndex = role.index;
+    }
 
-    QV4::ObjectIterator it(scope, object, QV4::ObjectIterator::WithProtoChain|QV4::ObjectIterator::EnumerableOnly);
-    QV4::ScopedString propertyName(scope);
-    QV4::ScopedValue propertyValue(scope);
-    while (1) {
-        propertyName = it.nextPropertyNameAsString(propertyValue);
-        if (!propertyName)
-            break;
+    return roleIndex;
+}
 
-        // Check if this key exists yet
-        int roleIndex = -1;
+int ListChunk::setVariantMapProperty(int row, const ListLayout::Role &role, QV4::Object *o)
+{
+    int roleIndex = -1;
 
-        // Add the value now
-        if (const QV4::String *s = propertyValue->as<QV4::String>()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::String);
-            roleIndex = e->setStringProperty(r, s->toQString());
-        } else if (propertyValue->isNumber()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Number);
-            roleIndex = e->setDoubleProperty(r, propertyValue->asDouble());
-        } else if (QV4::ArrayObject *a = propertyValue->as<QV4::ArrayObject>()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::List);
-            ListModel *subModel = new ListModel(r.subLayout, 0, -1);
+    if (role.type == ListLayout::Role::VariantMap) {
+        column(role).variants[row] = QVariant(o->engine()->variantMapFromJS(o));
+        roleIndex = role.index;
+    }
 
-            int arrayLength = a->getLength();
-            for (int j=0 ; j < arrayLength ; ++j) {
-                o = a->getIndexed(j);
-                subModel->append(o);
-            }
+    return roleIndex;
+}
 
-            roleIndex = e->setListProperty(r, subModel);
-        } else if (propertyValue->isBoolean()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Bool);
-            roleIndex = e->setBoolProperty(r, propertyValue->booleanValue());
-        } else if (QV4::DateObject *dd = propertyValue->as<QV4::DateObject>()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::DateTime);
-            QDateTime dt = dd->toQDateTime();
-            roleIndex = e->setDateTimeProperty(r, dt);
-        } else if (QV4::FunctionObject *f = propertyValue->as<QV4::FunctionObject>()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Function);
-            QV4::ScopedFunctionObject func(scope, f);
-            QJSValue jsv;
-            QJSValuePrivate::setValue(&jsv, v4, func);
-            roleIndex = e->setFunctionProperty(r, jsv);
-        } else if (QV4::Object *o = propertyValue->as<QV4::Object>()) {
-            if (QV4::QObjectWrapper *wrapper = o->as<QV4::QObjectWrapper>()) {
-                QObject *o = wrapper->object();
-                const ListLayout::Role &role = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::QObject);
-                if (role.type == ListLayout::Role::QObject)
-                    roleIndex = e->setQObjectProperty(role, o);
-            } else {
-                const ListLayout::Role &role = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::VariantMap);
-                if (role.type == ListLayout::Role::VariantMap) {
-                    QV4::ScopedObject obj(scope, o);
-                    roleIndex = e->setVariantMapProperty(role, obj);
-                }
-            }
-        } else if (propertyValue->isNullOrUndefined()) {
-            const ListLayout::Role *r = m_layout->getExistingRole(propertyName);
-            if (r)
-                e->clearProperty(*r);
-        }
+int ListChunk::setVariantMapProperty(int row, const ListLayout::Role &role, QVariantMap *m)
+{
+    int roleIndex = -1;
 
-        if (roleIndex != -1)
-            roles->append(roleIndex);
+    if (role.type == ListLayout::Role::VariantMap) {
+        column(role).variants[row] = QVariant(m ? *m : QVariantMap());
+        roleIndex = role.index;
     }
 
-    if (ModelNodeMetaObject *mo = e->objectCache())
-        mo->updateValues(*roles);
+    return roleIndex;
 }
 
-void ListModel::set(int elementIndex, QV4::Object *object)
+int ListChunk::setDateTimeProperty(int row, const ListLayout::Role &role, const QDateTime &dt)
 {
-    if (!object)
-        return;
+    int roleIndex = -1;
 
-    ListElement *e = elements[elementIndex];
+    if (role.type == ListLayout::Role::DateTime) {
+        column(role).variants[row] = QVariant(dt);
+        roleIndex = role.index;
+    }
 
-    QV4::ExecutionEngine *v4 = object->engine();
-    QV4::Scope scope(v4);
-
-    QV4::ObjectIterator it(scope, object, QV4::ObjectIterator::WithProtoChain|QV4::ObjectIterator::EnumerableOnly);
-    QV4::ScopedString propertyName(scope);
-    QV4::ScopedValue propertyValue(scope);
-    QV4::ScopedObject o(scope);
-    while (1) {
-        propertyName = it.nextPropertyNameAsString(propertyValue);
-        if (!propertyName)
-            break;
-
-        // Add the value now
-        if (QV4::String *s = propertyValue->stringValue()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::String);
-            if (r.type == ListLayout::Role::String)
-                e->setStringPropertyFast(r, s->toQString());
-        } else if (propertyValue->isNumber()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Number);
-            if (r.type == ListLayout::Role::Number) {
-                e->setDoublePropertyFast(r, propertyValue->asDouble());
-            }
-        } else if (QV4::ArrayObject *a = propertyValue->as<QV4::ArrayObject>()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::List);
-            if (r.type == ListLayout::Role::List) {
-                ListModel *subModel = new ListModel(r.subLayout, 0, -1);
-
-                int arrayLength = a->getLength();
-                for (int j=0 ; j < arrayLength ; ++j) {
-                    o = a->getIndexed(j);
-                    subModel->append(o);
-                }
-
-                e->setListPropertyFast(r, subModel);
-            }
-        } else if (propertyValue->isBoolean()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Bool);
-            if (r.type == ListLayout::Role::Bool) {
-                e->setBoolPropertyFast(r, propertyValue->booleanValue());
-            }
-        } else if (QV4::DateObject *date = propertyValue->as<QV4::DateObject>()) {
-            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::DateTime);
-            if (r.type == ListLayout::Role::DateTime) {
-                QDateTime dt = date->toQDateTime();;
-                e->setDateTimePropertyFast(r, dt);
-            }
-        } else if (QV4::Object *o = propertyValue->as<QV4::Object>()) {
-            if (QV4::QObjectWrapper *wrapper = o->as<QV4::QObjectWrapper>()) {
-                QObject *o = wrapper->object();
-                const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::QObject);
-                if (r.type == ListLayout::Role::QObject)
-                    e->setQObjectPropertyFast(r, o);
-            } else {
-                const ListLayout::Role &role = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::VariantMap);
-                if (role.type == ListLayout::Role::VariantMap)
-                    e->setVariantMapFast(role, o);
-            }
-        } else if (propertyValue->isNullOrUndefined()) {
-            const ListLayout::Role *r = m_layout->getExistingRole(propertyName);
-            if (r)
-                e->clearProperty(*r);
-        }
-    }
+    return roleIndex;
 }
 
-QVector<std::function<void()>> ListModel::remove(int index, int count)
+int ListChunk::setFunctionProperty(int row, const ListLayout::Role &role, const QJSValue &f)
 {
-    QVector<std::function<void()>> toDestroy;
-    auto layout = m_layout;
-    for (int i=0 ; i < count ; ++i) {
-        auto element = elements[index+i];
-        toDestroy.append([element, layout](){
-            element->destroy(layout);
-            delete element;
-        });
-    }
-    elements.remove(index, count);
-    updateCacheIndices(index);
-    return toDestroy;
-}
+    int roleIndex = -1;
 
-void ListModel::insert(int elementIndex, QV4::Object *object)
-{
-    insertElement(elementIndex);
-    set(elementIndex, object);
+    if (role.type == ListLayout::Role::Function) {
+        column(role).variants[row] = QVariant::fromValue(f);
+        roleIndex = role.index;
+    }
+
+    return roleIndex;
 }
 
-int ListModel::append(QV4::Object *object)
+void ListChunk::clearProperty(int row, const ListLayout::Role &role)
 {
-    int elementIndex = appendElement();
-    set(elementIndex, object);
-    return elementIndex;
+    switch (role.type) {
+    case ListLayout::Role::String:
+        setStringProperty(row, role, QString());
+        break;
+    case ListLayout::Role::Number:
+        setDoubleProperty(row, role, 0.0);
+        break;
+    case ListLayout::Role::Bool:
+        setBoolProperty(row, role, false);
+        break;
+    case ListLayout::Role::List:
+        setListProperty(row, role, 0);
+        break;
+    case ListLayout::Role::QObject:
+        setQObjectProperty(row, role, 0);
+        break;
+    case ListLayout::Role::DateTime:
+        setDateTimeProperty(row, role, QDateTime());
+        break;
+    case ListLayout::Role::VariantMap:
+        setVariantMapProperty(row, role, (QVariantMap *)0);
+        break;
+    case ListLayout::Role::Function:
+        setFunctionProperty(row, role, QJSValue());
+        break;
+    default:
+        break;
+    }
 }
 
-int ListModel::setOrCreateProperty(int elementIndex, const QString &key, const QVariant &data)
+int ListChunk::setVariantProperty(int row, const ListLayout::Role &role, const QVariant &d)
 {
     int roleIndex = -1;
 
-    if (elementIndex >= 0 && elementIndex < elements.count()) {
-        ListElement *e = elements[elementIndex];
-
-        const ListLayout::Role *r = m_layout->getRoleOrCreate(key, data);
-        if (r) {
-            roleIndex = e->setVariantProperty(*r, data);
-
-            ModelNodeMetaObject *cache = e->objectCache();
-
-            if (roleIndex != -1 && cache)
-                cache->updateValues(QVector<int>(1, roleIndex));
-        }
+    switch (role.type) {
+        case ListLayout::Role::Number:
+            roleIndex = setDoubleProperty(row, role, d.toDouble());
+            break;
+        case ListLayout::Role::String:
+            roleIndex = setStringProperty(row, role, d.toString());
+            break;
+        case ListLayout::Role::Bool:
+            roleIndex = setBoolProperty(row, role, d.toBool());
+            break;
+        case ListLayout::Role::List:
+            roleIndex = setListProperty(row, role, d.value<ListModel *>());
+            break;
+        case ListLayout::Role::VariantMap: {
+                QVariantMap map = d.toMap();
+                roleIndex = setVariantMapProperty(row, role, &map);
+            }
+            break;
+        case ListLayout::Role::DateTime:
+            roleIndex = setDateTimeProperty(row, role, d.toDateTime());
+            break;
+        case ListLayout::Role::Function:
+            roleIndex = setFunctionProperty(row, role, d.value<QJSValue>());
+            break;
+        default:
+            break;
     }
 
     return roleIndex;
 }
 
-int ListModel::setExistingProperty(int elementIndex, const QString &key, const QV4::Value &data, QV4::ExecutionEngine *eng)
+int ListChunk::setJsProperty(int row, const ListLayout::Role &role, const QV4::Value &d, QV4::ExecutionEngine *eng, ListLayout *layout)
 {
+    // Check if this key exists yet
     int roleIndex = -1;
 
-    if (elementIndex >= 0 && elementIndex < elements.count()) {
-        ListElement *e = elements[elementIndex];
-        const ListLayout::Role *r = m_layout->getExistingRole(key);
-        if (r)
-            roleIndex = e->setJsProperty(*r, data, eng);
+    QV4::Scope scope(eng);
+
+    // Add the value now
+    if (d.isString()) {
+        QString qstr = layout->internString(d.toQString());
+        roleIndex = setStringProperty(row, role, qstr);
+    } else if (d.isNumber()) {
+        roleIndex = setDoubleProperty(row, role, d.asDouble());
+    } else if (d.as<QV4::ArrayObject>()) {
+        QV4::ScopedArrayObject a(scope, d);
+        if (role.type == ListLayout::Role::List) {
+            ListModel *subModel = new ListModel(role.subLayout, 0, -1);
+            subModel->append(a);
+            roleIndex = setListProperty(row, role, subModel);
+        } else {
+            qmlWarning(0) << QStringLiteral("Can't assign to existing role '%1' of different type [%2 -> %3]").arg(role.name).arg(roleTypeName(role.type)).arg(roleTypeName(ListLayout::Role::List));
+        }
+    } else if (d.isBoolean()) {
+        roleIndex = setBoolProperty(row, role, d.booleanValue());
+    } else if (d.as<QV4::DateObject>()) {
+        QV4::Scoped<QV4::DateObject> dd(scope, d);
+        QDateTime dt = dd->toQDateTime();
+        roleIndex = setDateTimeProperty(row, role, dt);
+    } else if (d.as<QV4::FunctionObject>()) {
+        QV4::ScopedFunctionObject f(scope, d);
+        QJSValue jsv;
+        QJSValuePrivate::setValue(&jsv, eng, f);
+        roleIndex = setFunctionProperty(row, role, jsv);
+    } else if (d.isObject()) {
+        QV4::ScopedObject o(scope, d);
+        QV4::QObjectWrapper *wrapper = o->as<QV4::QObjectWrapper>();
+        if (role.type == ListLayout::Role::QObject && wrapper) {
+            QObject *o = wrapper->object();
+            roleIndex = setQObjectProperty(row, role, o);
+        } else if (role.type == ListLayout::Role::VariantMap) {
+            roleIndex = setVariantMapProperty(row, role, o);
+        }
+    } else if (d.isNullOrUndefined()) {
+        clearProperty(row, role);
     }
 
     return roleIndex;
 }
 
-inline char *ListElement::getPropertyMemory(const ListLayout::Role &role)
+ListModel::ListModel(ListLayout *layout, QQmlListModel *modelCache, int uid) : m_elementCount(0), m_layout(layout), m_tracksModifications(false), m_modelCache(modelCache)
 {
-    ListElement *e = this;
-    int blockIndex = 0;
-    while (blockIndex < role.blockIndex) {
-        if (e->next == 0) {
-            e->next = new ListElement;
-            e->next->uid = uid;
-        }
-        e = e->next;
-        ++blockIndex;
-    }
-
-    char *mem = &e->data[role.blockOffset];
-    return mem;
+    if (uid == -1)
+        uid = uidCounter.fetchAndAddOrdered(1);
+    m_uid = uid;
 }
 
-ModelNodeMetaObject *ListElement::objectCache()
+void ListModel::destroy()
 {
-    if (!m_objectCache)
-        return 0;
-    return ModelNodeMetaObject::get(m_objectCache);
+    for (const auto &destroyer : remove(0, m_elementCount))
+        destroyer();
+
+    m_uid = -1;
+    m_layout = 0;
+    if (m_modelCache && m_modelCache->m_primary == false)
+        delete m_modelCache;
+    m_modelCache = 0;
 }
 
-QString *ListElement::getStringProperty(const ListLayout::Role &role)
+/*
+  Returns the index of the chunk holding \a elementIndex. One past the last
+  element maps to the last chunk. Chunks are never empty, so their start
+  indexes are strictly increasing.
+*/
+int ListModel::findChunk(int elementIndex) const
 {
-    char *mem = getPropertyMemory(role);
-    QString *s = reinterpret_cast<QString *>(mem);
-    return s->data_ptr() ? s : 0;
+    Q_ASSERT(!m_chunks.isEmpty());
+    const auto it = std::upper_bound(m_chunkStarts.constBegin(), m_chunkStarts.constEnd(), elementIndex);
+    return int(it - m_chunkStarts.constBegin()) - 1;
 }
 
-QObject *ListElement::getQObjectProperty(const ListLayout::Role &role)
+const ListChunk *ListModel::chunkAt(int elementIndex, int *row) const
 {
-    char *mem = getPropertyMemory(role);
-    QPointer<QObject> *o = reinterpret_cast<QPointer<QObject> *>(mem);
-    return o->data();
+    const int chunkIndex = findChunk(elementIndex);
+    *row = elementIndex - m_chunkStarts.at(chunkIndex);
+    return m_chunks.at(chunkIndex).constData();
 }
 
-QVariantMap *ListElement::getVariantMapProperty(const ListLayout::Role &role)
+ListChunk *ListModel::writableChunkAt(int elementIndex, int *row)
 {
-    QVariantMap *map = 0;
+    const int chunkIndex = findChunk(elementIndex);
+    *row = elementIndex - m_chunkStarts.at(chunkIndex);
+    ChunkPointer &chunk = m_chunks[chunkIndex];
+    chunk.detach();
+    return chunk.data();
+}
 
-    char *mem = getPropertyMemory(role);
-    if (isMemoryUsed<QVariantMap>(mem))
-        map = reinterpret_cast<QVariantMap *>(mem);
+void ListModel::updateChunkStarts(int firstChunk)
+{
+    firstChunk = qMin(firstChunk, m_chunks.count());
+    m_chunkStarts.resize(m_chunks.count());
 
-    return map;
+    int start = firstChunk > 0 ? m_chunkStarts.at(firstChunk - 1) + m_chunks.at(firstChunk - 1)->rowCount() : 0;
+    for (int i = firstChunk; i < m_chunks.count(); ++i) {
+        m_chunkStarts[i] = start;
+        start += m_chunks.at(i)->rowCount();
+    }
+    m_elementCount = start;
 }
 
-QDateTime *ListElement::getDateTimeProperty(const ListLayout::Role &role)
+/*
+  Inserts \a count rows at \a index, copied from the rows of \a source
+  starting at \a from, or blank rows if \a source is null. While the chunk
+  at \a index has room, the rows are added to it. Otherwise it is split at
+  \a index and the rows go into new chunks between the two halves, so that
+  inserting many rows only touches one existing chunk.
+*/
+void ListModel::insertRows(int index, const ListChunk *source, int from, int count)
 {
-    QDateTime *dt = 0;
+    if (count <= 0)
+        return;
 
-    char *mem = getPropertyMemory(role);
-    if (isMemoryUsed<QDateTime>(mem))
-        dt = reinterpret_cast<QDateTime *>(mem);
+    if (m_chunks.isEmpty()) {
+        m_chunks.append(ChunkPointer(new ListChunk));
+        updateChunkStarts();
+    }
 
-    return dt;
-}
+    const int chunkIndex = findChunk(index);
+    const int row = index - m_chunkStarts.at(chunkIndex);
+    m_chunks[chunkIndex].detach();
+    ListChunk *chunk = m_chunks[chunkIndex].data();
 
-QJSValue *ListElement::getFunctionProperty(const ListLayout::Role &role)
-{
-    QJSValue *f = 0;
+    if (chunk->rowCount() + count <= ListChunk::MaxRows) {
+        chunk->insertRows(row, source, from, count);
+        updateChunkStarts(chunkIndex);
+        return;
+    }
 
-    char *mem = getPropertyMemory(role);
-    if (isMemoryUsed<QJSValue>(mem))
-        f = reinterpret_cast<QJSValue *>(mem);
+    ChunkPointer tail;
+    if (row < chunk->rowCount()) {
+        tail = new ListChunk;
+        tail->insertRows(0, chunk, row, chunk->rowCount() - row);
+        chunk->removeRows(row, chunk->rowCount() - row);
+    }
 
-    return f;
+    int last = chunkIndex;
+    int inserted = 0;
+    for (;;) {
+        ListChunk *target = m_chunks[last].data();
+        const int n = qMin(count - inserted, ListChunk::MaxRows - target->rowCount());
+        target->insertRows(target->rowCount(), source, from + inserted, n);
+        inserted += n;
+        if (inserted == count)
+            break;
+        m_chunks.insert(++last, ChunkPointer(new ListChunk));
+    }
+
+    if (tail) {
+        ListChunk *target = m_chunks[last].data();
+        if (target->rowCount() + tail->rowCount() <= ListChunk::MaxRows)
+            target->insertRows(target->rowCount(), tail.constData(), 0, tail->rowCount());
+        else
+            m_chunks.insert(last + 1, tail);
+    }
+
+    updateChunkStarts(chunkIndex);
 }
 
-QPointer<QObject> *ListElement::getGuardProperty(const ListLayout::Role &role)
+/*
+  Removes \a count rows at \a index, without destroying what they hold.
+  Chunks left with few rows are merged with their neighbours.
+*/
+void ListModel::removeRows(int index, int count)
 {
-    char *mem = getPropertyMemory(role);
+    if (count <= 0)
+        return;
 
-    bool existingGuard = false;
-    for (size_t i=0 ; i < sizeof(QPointer<QObject>) ; ++i) {
-        if (mem[i] != 0) {
-            existingGuard = true;
-            break;
+    const int firstChunk = findChunk(index);
+    int chunkIndex = firstChunk;
+    int row = index - m_chunkStarts.at(chunkIndex);
+    while (count > 0) {
+        const int rows = m_chunks.at(chunkIndex)->rowCount();
+        const int n = qMin(count, rows - row);
+        if (n == rows) {
+            m_chunks.remove(chunkIndex);
+        } else {
+            m_chunks[chunkIndex].detach();
+            m_chunks[chunkIndex]->removeRows(row, n);
+            ++chunkIndex;
         }
+        count -= n;
+        row = 0;
     }
 
-    QPointer<QObject> *o = 0;
+    for (int i = qMin(firstChunk, m_chunks.count() - 2); i >= 0 && i >= firstChunk - 1; --i) {
+        const ListChunk *next = m_chunks.at(i + 1).constData();
+        if (m_chunks.at(i)->rowCount() + next->rowCount() > ListChunk::MaxRows / 2)
+            continue;
+        m_chunks[i].detach();
+        m_chunks[i]->insertRows(m_chunks.at(i)->rowCount(), next, 0, next->rowCount());
+        m_chunks.remove(i + 1);
+    }
 
-    if (existingGuard)
-        o = reinterpret_cast<QPointer<QObject> *>(mem);
+    updateChunkStarts(qMax(0, firstChunk - 1));
+}
 
-    return o;
+int ListModel::uidAt(int elementIndex) const
+{
+    int row;
+    const ListChunk *chunk = chunkAt(elementIndex, &row);
+    return chunk->uids.at(row);
 }
 
-ListModel *ListElement::getListProperty(const ListLayout::Role &role)
+ModelNodeMetaObject *ListModel::objectCache(int uid) const
 {
-    char *mem = getPropertyMemory(role);
-    ListModel **value = reinterpret_cast<ListModel **>(mem);
-    return *value;
+    QObject *object = m_objectCaches.value(uid);
+    return object ? ModelNodeMetaObject::get(object) : 0;
 }
 
-QVariant ListElement::getProperty(const ListLayout::Role &role, const QQmlListModel *owner, QV4::ExecutionEngine *eng)
+QObject *ListModel::getOrCreateModelObject(QQmlListModel *model, int elementIndex)
 {
-    char *mem = getPropertyMemory(role);
+    const int uid = uidAt(elementIndex);
+    QObject *object = m_objectCaches.value(uid);
+    if (object == 0) {
+        object = new QObject;
+        m_objectCaches.insert(uid, object);
+        (void)new ModelNodeMetaObject(object, model, elementIndex);
+    }
+    return object;
+}
 
-    QVariant data;
+void ListModel::sync(ListModel *src, ListModel *target, QHash<int, ListModel *> *targetModelHash)
+{
+    // Sanity check
+    target->m_uid = src->m_uid;
+    if (targetModelHash)
+        targetModelHash->insert(target->m_uid, target);
 
-    switch (role.type) {
-        case ListLayout::Role::Number:
-            {
-                double *value = reinterpret_cast<double *>(mem);
-                data = *value;
-            }
-            break;
-        case ListLayout::Role::String:
-            {
-                QString *value = reinterpret_cast<QString *>(mem);
-                if (value->data_ptr() != 0)
-                    data = *value;
-            }
-            break;
-        case ListLayout::Role::Bool:
-            {
-                bool *value = reinterpret_cast<bool *>(mem);
-                data = *value;
-            }
-            break;
-        case ListLayout::Role::List:
-            {
-                ListModel **value = reinterpret_cast<ListModel **>(mem);
-                ListModel *model = *value;
-
-                if (model) {
-                    if (model->m_modelCache == 0) {
-                        model->m_modelCache = new QQmlListModel(owner, model, eng);
-                        QQmlEngine::setContextForObject(model->m_modelCache, QQmlEngine::contextForObject(owner));
-                    }
-
-                    QObject *object = model->m_modelCache;
-                    data = QVariant::fromValue(object);
-                }
-            }
-            break;
-        case ListLayout::Role::QObject:
-            {
-                QPointer<QObject> *guard = reinterpret_cast<QPointer<QObject> *>(mem);
-                QObject *object = guard->data();
-                if (object)
-                    data = QVariant::fromValue(object);
-            }
-            break;
-        case ListLayout::Role::VariantMap:
-            {
-                if (isMemoryUsed<QVariantMap>(mem)) {
-                    QVariantMap *map = reinterpret_cast<QVariantMap *>(mem);
-                    data = *map;
-                }
-            }
-            break;
-        case ListLayout::Role::DateTime:
-            {
-                if (isMemoryUsed<QDateTime>(mem)) {
-                    QDateTime *dt = reinterpret_cast<QDateTime *>(mem);
-                    data = *dt;
-                }
+    // Sync the layouts
+    ListLayout::sync(src->m_layout, target->m_layout);
+
+    if (src->canShareChunks()) {
+        // Chunks are detached before they are written to, so both models can
+        // use the same ones until either of them changes a chunk.
+        target->m_chunks = src->m_chunks;
+        target->m_chunkStarts = src->m_chunkStarts;
+        target->m_elementCount = src->m_elementCount;
+
+        if (src->m_tracksModifications) {
+            for (int uid : qAsConst(src->m_removedUids))
+                delete target->m_objectCaches.take(uid);
+        } else {
+            target->removeStaleObjectCaches();
+        }
+    } else {
+        target->copyChunks(src, targetModelHash);
+        target->removeStaleObjectCaches();
+    }
+
+    target->updateCacheIndices();
+
+    // Update values stored in target meta objects. Changes inside nested
+    // models aren't tracked, so update all of them if there are any.
+    const bool syncAllElements = !src->m_tracksModifications || src->hasListRoles();
+    for (auto it = target->m_objectCaches.constBegin(); it != target->m_objectCaches.constEnd(); ++it) {
+        if (syncAllElements || src->m_modifiedUids.contains(it.key()))
+            ModelNodeMetaObject::get(it.value())->updateValues();
+    }
+    src->m_modifiedUids.clear();
+    src->m_removedUids.clear();
+}
+
+/*
+  Replaces the chunks of this model with copies of the chunks of \a src.
+  The nested models this model already has are synced in place, so that the
+  list models wrapping them stay valid.
+*/
+void ListModel::copyChunks(const ListModel *src, QHash<int, ListModel *> *targetModelHash)
+{
+    QHash<QPair<int, int>, ListModel *> targetSubModels;
+    for (const ChunkPointer &chunk : qAsConst(m_chunks)) {
+        for (int i = 0; i < chunk->columns.count(); ++i) {
+            const ListColumn &column = chunk->columns.at(i);
+            if (column.type != ListLayout::Role::List)
+                continue;
+            for (int row = 0; row < chunk->rowCount(); ++row) {
+                if (ListModel *subModel = column.lists.at(row))
+                    targetSubModels.insert(qMakePair(chunk->uids.at(row), i), subModel);
             }
-            break;
-        case ListLayout::Role::Function:
-            {
-                if (isMemoryUsed<QJSValue>(mem)) {
-                    QJSValue *func = reinterpret_cast<QJSValue *>(mem);
-                    data = QVariant::fromValue(*func);
-                }
+        }
+    }
+
+    QVector<ChunkPointer> chunks;
+    chunks.reserve(src->m_chunks.count());
+    for (const ChunkPointer &srcChunk : src->m_chunks) {
+        ChunkPointer chunk(new ListChunk(*srcChunk));
+        for (int i = 0; i < chunk->columns.count(); ++i) {
+            ListColumn &column = chunk->columns[i];
+            if (column.type != ListLayout::Role::List)
+                continue;
+            const ListLayout::Role &targetRole = m_layout->getExistingRole(i);
+            for (int row = 0; row < chunk->rowCount(); ++row) {
+                ListModel *srcSubModel = column.lists.at(row);
+                if (!srcSubModel)
+                    continue;
+                ListModel *targetSubModel = targetSubModels.take(qMakePair(chunk->uids.at(row), i));
+                if (!targetSubModel)
+                    targetSubModel = new ListModel(targetRole.subLayout, 0, srcSubModel->getUid());
+                ListModel::sync(srcSubModel, targetSubModel, targetModelHash);
+                column.lists[row] = targetSubModel;
             }
-            break;
-        default:
-            break;
+        }
+        chunks.append(chunk);
     }
 
-    return data;
+    // Nested models of elements that were removed, or whose list was cleared
+    for (ListModel *subModel : qAsConst(targetSubModels)) {
+        subModel->destroy();
+        delete subModel;
+    }
+
+    m_chunks = chunks;
+    updateChunkStarts();
 }
 
-int ListElement::setStringProperty(const ListLayout::Role &role, const QString &s)
+void ListModel::removeStaleObjectCaches()
 {
-    int roleIndex = -1;
+    if (m_objectCaches.isEmpty())
+        return;
 
-    if (role.type == ListLayout::Role::String) {
-        char *mem = getPropertyMemory(role);
-        QString *c = reinterpret_cast<QString *>(mem);
-        bool changed;
-        if (c->data_ptr() == 0) {
-            new (mem) QString(s);
-            changed = true;
+    QSet<int> uids;
+    for (const ChunkPointer &chunk : qAsConst(m_chunks)) {
+        for (int uid : chunk->uids)
+            uids.insert(uid);
+    }
+    for (auto it = m_objectCaches.begin(); it != m_objectCaches.end(); ) {
+        if (uids.contains(it.key())) {
+            ++it;
         } else {
-            changed = c->compare(s) != 0;
-            *c = s;
+            delete it.value();
+            it = m_objectCaches.erase(it);
         }
-        if (changed)
-            roleIndex = role.index;
     }
-
-    return roleIndex;
 }
 
-int ListElement::setDoubleProperty(const ListLayout::Role &role, double d)
+bool ListModel::hasListRoles() const
 {
-    int roleIndex = -1;
-
-    if (role.type == ListLayout::Role::Number) {
-        char *mem = getPropertyMemory(role);
-        double *value = reinterpret_cast<double *>(mem);
-        bool changed = *value != d;
-        *value = d;
-        if (changed)
-            roleIndex = role.index;
+    for (int i = 0; i < m_layout->roleCount(); ++i) {
+        if (m_layout->getExistingRole(i).type == ListLayout::Role::List)
+            return true;
     }
+    return false;
+}
 
-    return roleIndex;
+/*
+  Nested models belong to one model each, and functions to the engine they
+  were created in, so chunks holding either can't be shared with another
+  model.
+*/
+bool ListModel::canShareChunks() const
+{
+    for (int i = 0; i < m_layout->roleCount(); ++i) {
+        const ListLayout::Role::DataType type = m_layout->getExistingRole(i).type;
+        if (type == ListLayout::Role::List || type == ListLayout::Role::Function)
+            return false;
+    }
+    return true;
 }
 
-int ListElement::setBoolProperty(const ListLayout::Role &role, bool b)
+int ListModel::sharedChunkCount(const ListModel *other) const
 {
-    int roleIndex = -1;
+    QSet<const ListChunk *> otherChunks;
+    for (const ChunkPointer &chunk : other->m_chunks)
+        otherChunks.insert(chunk.constData());
 
-    if (role.type == ListLayout::Role::Bool) {
-        char *mem = getPropertyMemory(role);
-        bool *value = reinterpret_cast<bool *>(mem);
-        bool changed = *value != b;
-        *value = b;
-        if (changed)
-            roleIndex = role.index;
+    int count = 0;
+    for (const ChunkPointer &chunk : m_chunks) {
+        if (otherChunks.contains(chunk.constData()))
+            ++count;
     }
+    return count;
+}
 
-    return roleIndex;
+int ListModel::appendElement()
+{
+    int elementIndex = m_elementCount;
+    insertRows(elementIndex, 0, 0, 1);
+    return elementIndex;
 }
 
-int ListElement::setListProperty(const ListLayout::Role &role, ListModel *m)
+void ListModel::insertElement(int index)
 {
-    int roleIndex = -1;
+    insertRows(index, 0, 0, 1);
+    updateCacheIndices(index);
+}
 
-    if (role.type == ListLayout::Role::List) {
-        char *mem = getPropertyMemory(role);
-        ListModel **value = reinterpret_cast<ListModel **>(mem);
-        if (*value && *value != m) {
-            (*value)->destroy();
-            delete *value;
-        }
-        *value = m;
-        roleIndex = role.index;
+void ListModel::move(int from, int to, int n)
+{
+    if (n <= 0 || from == to)
+        return;
+
+    ListChunk moved;
+    for (int i = 0; i < n; ) {
+        int row;
+        const ListChunk *chunk = chunkAt(from + i, &row);
+        const int count = qMin(n - i, chunk->rowCount() - row);
+        moved.insertRows(i, chunk, row, count);
+        i += count;
     }
 
-    return roleIndex;
+    removeRows(from, n);
+    insertRows(to, &moved, 0, n);
+
+    updateCacheIndices(qMin(from, to), qMax(from, to) + n);
 }
 
-int ListElement::setQObjectProperty(const ListLayout::Role &role, QObject *o)
+void ListModel::reorder(const QVector<int> &newOrder)
 {
-    int roleIndex = -1;
-
-    if (role.type == ListLayout::Role::QObject) {
-        char *mem = getPropertyMemory(role);
-        QPointer<QObject> *g = reinterpret_cast<QPointer<QObject> *>(mem);
-        bool existingGuard = false;
-        for (size_t i=0 ; i < sizeof(QPointer<QObject>) ; ++i) {
-            if (mem[i] != 0) {
-                existingGuard = true;
-                break;
-            }
-        }
-        bool changed;
-        if (existingGuard) {
-            changed = g->data() != o;
-            g->~QPointer();
-        } else {
-            changed = true;
+    QVector<ChunkPointer> reordered;
+    reordered.reserve(newOrder.count() / ListChunk::MaxRows + 1);
+    ListChunk *chunk = 0;
+    for (int index : newOrder) {
+        if (!chunk || chunk->rowCount() == ListChunk::MaxRows) {
+            chunk = new ListChunk;
+            reordered.append(ChunkPointer(chunk));
         }
-        new (mem) QPointer<QObject>(o);
-        if (changed)
-            roleIndex = role.index;
+        int row;
+        const ListChunk *source = chunkAt(index, &row);
+        chunk->insertRows(chunk->rowCount(), source, row, 1);
     }
+    m_chunks = reordered;
 
-    return roleIndex;
+    updateChunkStarts();
+    updateCacheIndices();
 }
 
-int ListElement::setVariantMapProperty(const ListLayout::Role &role, QV4::Object *o)
+void ListModel::updateCacheIndices(int start, int end)
 {
-    int roleIndex = -1;
+    if (m_objectCaches.isEmpty())
+        return;
 
-    if (role.type == ListLayout::Role::VariantMap) {
-        char *mem = getPropertyMemory(role);
-        if (isMemoryUsed<QVariantMap>(mem)) {
-            QVariantMap *map = reinterpret_cast<QVariantMap *>(mem);
-            map->~QMap();
+    if (end < 0 || end > m_elementCount)
+        end = m_elementCount;
+
+    for (int i = start; i < end; ) {
+        int row;
+        const ListChunk *chunk = chunkAt(i, &row);
+        for (; row < chunk->rowCount() && i < end; ++row, ++i) {
+            if (ModelNodeMetaObject *mo = objectCache(chunk->uids.at(row)))
+                mo->m_elementIndex = i;
         }
-        new (mem) QVariantMap(o->engine()->variantMapFromJS(o));
-        roleIndex = role.index;
     }
-
-    return roleIndex;
 }
 
-int ListElement::setVariantMapProperty(const ListLayout::Role &role, QVariantMap *m)
+QVariant ListModel::getProperty(int elementIndex, int roleIndex, const QQmlListModel *owner, QV4::ExecutionEngine *eng)
 {
-    int roleIndex = -1;
+    if (roleIndex >= m_layout->roleCount())
+        return QVariant();
+    int row;
+    const ListChunk *chunk = chunkAt(elementIndex, &row);
+    const ListLayout::Role &r = m_layout->getExistingRole(roleIndex);
+    if (r.type != ListLayout::Role::List)
+        return chunk->getProperty(row, r);
 
-    if (role.type == ListLayout::Role::VariantMap) {
-        char *mem = getPropertyMemory(role);
-        if (isMemoryUsed<QVariantMap>(mem)) {
-            QVariantMap *map = reinterpret_cast<QVariantMap *>(mem);
-            map->~QMap();
+    QVariant data;
+    if (ListModel *model = chunk->getListProperty(row, r)) {
+        if (model->m_modelCache == 0) {
+            model->m_modelCache = new QQmlListModel(owner, model, eng);
+            QQmlEngine::setContextForObject(model->m_modelCache, QQmlEngine::contextForObject(owner));
         }
-        if (m)
-            new (mem) QVariantMap(*m);
-        else
-            new (mem) QVariantMap;
-        roleIndex = role.index;
+
+        QObject *object = model->m_modelCache;
+        data = QVariant::fromValue(object);
     }
+    return data;
+}
 
-    return roleIndex;
+ListModel *ListModel::getListProperty(int elementIndex, const ListLayout::Role &role)
+{
+    int row;
+    const ListChunk *chunk = chunkAt(elementIndex, &row);
+    return chunk->getListProperty(row, role);
 }
 
-int ListElement::setDateTimeProperty(const ListLayout::Role &role, const QDateTime &dt)
+void ListModel::set(int elementIndex, QV4::Object *object, QVector<int> *roles)
 {
-    int roleIndex = -1;
+    int row;
+    ListChunk *e = writableChunkAt(elementIndex, &row);
+    const int uid = e->uids.at(row);
+    elementModified(uid);
 
-    if (role.type == ListLayout::Role::DateTime) {
-        char *mem = getPropertyMemory(role);
-        if (isMemoryUsed<QDateTime>(mem)) {
-            QDateTime *dt = reinterpret_cast<QDateTime *>(mem);
-            dt->~QDateTime();
+    QV4::ExecutionEngine *v4 = object->engine();
+    QV4::Scope scope(v4);
+
+    QV4::ObjectIterator it(scope, object, QV4::ObjectIterator::WithProtoChain|QV4::ObjectIterator::EnumerableOnly);
+    QV4::ScopedString propertyName(scope);
+    QV4::ScopedValue propertyValue(scope);
+    while (1) {
+        propertyName = it.nextPropertyNameAsString(propertyValue);
+        if (!propertyName)
+            break;
+
+        // Check if this key exists yet
+        int roleIndex = -1;
+
+        // Add the value now
+        if (const QV4::String *s = propertyValue->as<QV4::String>()) {
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::String);
+            roleIndex = e->setStringProperty(row, r, m_layout->internString(s->toQString()));
+        } else if (propertyValue->isNumber()) {
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Number);
+            roleIndex = e->setDoubleProperty(row, r, propertyValue->asDouble());
+        } else if (QV4::ArrayObject *a = propertyValue->as<QV4::ArrayObject>()) {
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::List);
+            ListModel *subModel = new ListModel(r.subLayout, 0, -1);
+            subModel->append(a);
+
+            roleIndex = e->setListProperty(row, r, subModel);
+        } else if (propertyValue->isBoolean()) {
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Bool);
+            roleIndex = e->setBoolProperty(row, r, propertyValue->booleanValue());
+        } else if (QV4::DateObject *dd = propertyValue->as<QV4::DateObject>()) {
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::DateTime);
+            QDateTime dt = dd->toQDateTime();
+            roleIndex = e->setDateTimeProperty(row, r, dt);
+        } else if (QV4::FunctionObject *f = propertyValue->as<QV4::FunctionObject>()) {
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Function);
+            QV4::ScopedFunctionObject func(scope, f);
+            QJSValue jsv;
+            QJSValuePrivate::setValue(&jsv, v4, func);
+            roleIndex = e->setFunctionProperty(row, r, jsv);
+        } else if (QV4::Object *o = propertyValue->as<QV4::Object>()) {
+            if (QV4::QObjectWrapper *wrapper = o->as<QV4::QObjectWrapper>()) {
+                QObject *o = wrapper->object();
+                const ListLayout::Role &role = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::QObject);
+                if (role.type == ListLayout::Role::QObject)
+                    roleIndex = e->setQObjectProperty(row, role, o);
+            } else {
+                const ListLayout::Role &role = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::VariantMap);
+                if (role.type == ListLayout::Role::VariantMap) {
+                    QV4::ScopedObject obj(scope, o);
+                    roleIndex = e->setVariantMapProperty(row, role, obj);
+                }
+            }
+        } else if (propertyValue->isNullOrUndefined()) {
+            const ListLayout::Role *r = m_layout->getExistingRole(propertyName);
+            if (r)
+                e->clearProperty(row, *r);
         }
-        new (mem) QDateTime(dt);
-        roleIndex = role.index;
+
+        if (roleIndex != -1)
+            roles->append(roleIndex);
     }
 
-    return roleIndex;
+    if (ModelNodeMetaObject *mo = objectCache(uid))
+        mo->updateValues(*roles);
 }
 
-int ListElement::setFunctionProperty(const ListLayout::Role &role, const QJSValue &f)
+/*
+  Sets the values of a new element. The element's columns are filled in
+  the order of the object's properties.
+*/
+void ListModel::set(int elementIndex, QV4::Object *object)
 {
-    int roleIndex = -1;
+    if (!object)
+        return;
 
-    if (role.type == ListLayout::Role::Function) {
-        char *mem = getPropertyMemory(role);
-        if (isMemoryUsed<QJSValue>(mem)) {
-            QJSValue *f = reinterpret_cast<QJSValue *>(mem);
-            f->~QJSValue();
+    int row;
+    ListChunk *e = writableChunkAt(elementIndex, &row);
+    elementModified(e->uids.at(row));
+
+    QV4::ExecutionEngine *v4 = object->engine();
+    QV4::Scope scope(v4);
+
+    QV4::ObjectIterator it(scope, object, QV4::ObjectIterator::WithProtoChain|QV4::ObjectIterator::EnumerableOnly);
+    QV4::ScopedString propertyName(scope);
+    QV4::ScopedValue propertyValue(scope);
+    while (1) {
+        propertyName = it.nextPropertyNameAsString(propertyValue);
+        if (!propertyName)
+            break;
+
+        // Add the value now
+        if (QV4::String *s = propertyValue->stringValue()) {
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::String);
+            if (r.type == ListLayout::Role::String)
+                e->setStringProperty(row, r, m_layout->internString(s->toQString()));
+        } else if (propertyValue->isNumber()) {
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Number);
+            if (r.type == ListLayout::Role::Number) {
+                e->setDoubleProperty(row, r, propertyValue->asDouble());
+            }
+        } else if (QV4::ArrayObject *a = propertyValue->as<QV4::ArrayObject>()) {
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::List);
+            if (r.type == ListLayout::Role::List) {
+                ListModel *subModel = new ListModel(r.subLayout, 0, -1);
+                subModel->append(a);
+
+                e->setListProperty(row, r, subModel);
+            }
+        } else if (propertyValue->isBoolean()) {
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::Bool);
+            if (r.type == ListLayout::Role::Bool) {
+                e->setBoolProperty(row, r, propertyValue->booleanValue());
+            }
+        } else if (QV4::DateObject *date = propertyValue->as<QV4::DateObject>()) {
+            const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::DateTime);
+            if (r.type == ListLayout::Role::DateTime) {
+                QDateTime dt = date->toQDateTime();;
+                e->setDateTimeProperty(row, r, dt);
+            }
+        } else if (QV4::Object *o = propertyValue->as<QV4::Object>()) {
+            if (QV4::QObjectWrapper *wrapper = o->as<QV4::QObjectWrapper>()) {
+                QObject *o = wrapper->object();
+                const ListLayout::Role &r = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::QObject);
+                if (r.type == ListLayout::Role::QObject)
+                    e->setQObjectProperty(row, r, o);
+            } else {
+                const ListLayout::Role &role = m_layout->getRoleOrCreate(propertyName, ListLayout::Role::VariantMap);
+                if (role.type == ListLayout::Role::VariantMap)
+                    e->setVariantMapProperty(row, role, o);
+            }
+        } else if (propertyValue->isNullOrUndefined()) {
+            const ListLayout::Role *r = m_layout->getExistingRole(propertyName);
+            if (r)
+                e->clearProperty(row, *r);
         }
-        new (mem) QJSValue(f);
-        roleIndex = role.index;
     }
-
-    return roleIndex;
-}
-
-
-void ListElement::setStringPropertyFast(const ListLayout::Role &role, const QString &s)
-{
-    char *mem = getPropertyMemory(role);
-    new (mem) QString(s);
 }
 
-void ListElement::setDoublePropertyFast(const ListLayout::Role &role, double d)
+QVector<std::function<void()>> ListModel::remove(int index, int count)
 {
-    char *mem = getPropertyMemory(role);
-    double *value = new (mem) double;
-    *value = d;
-}
+    // Nested models and object caches are destroyed by the caller once the
+    // removal has been reported.
+    QVector<std::function<void()>> toDestroy;
+    for (int i = 0; i < count; ) {
+        int row;
+        const ListChunk *chunk = chunkAt(index + i, &row);
+        const int n = qMin(count - i, chunk->rowCount() - row);
+        for (int c = 0; c < chunk->columns.count(); ++c) {
+            const ListColumn &column = chunk->columns.at(c);
+            if (column.type != ListLayout::Role::List)
+                continue;
+            for (int r = row; r < row + n; ++r) {
+                if (ListModel *model = column.lists.at(r)) {
+                    toDestroy.append([model](){
+                        model->destroy();
+                        delete model;
+                    });
+                }
+            }
+        }
+        if (m_tracksModifications) {
+            for (int r = row; r < row + n; ++r)
+                m_removedUids.insert(chunk->uids.at(r));
+        }
+        if (!m_objectCaches.isEmpty()) {
+            for (int r = row; r < row + n; ++r) {
+                if (QObject *object = m_objectCaches.take(chunk->uids.at(r))) {
+                    toDestroy.append([object](){
+                        delete object;
+                    });
+                }
+            }
+        }
+        i += n;
+    }
 
-void ListElement::setBoolPropertyFast(const ListLayout::Role &role, bool b)
-{
-    char *mem = getPropertyMemory(role);
-    bool *value = new (mem) bool;
-    *value = b;
+    removeRows(index, count);
+    updateCacheIndices(index);
+    return toDestroy;
 }
 
-void ListElement::setQObjectPropertyFast(const ListLayout::Role &role, QObject *o)
+void ListModel::insert(int elementIndex, QV4::Object *object)
 {
-    char *mem = getPropertyMemory(role);
-    new (mem) QPointer<QObject>(o);
+    insertElement(elementIndex);
+    set(elementIndex, object);
 }
 
-void ListElement::setListPropertyFast(const ListLayout::Role &role, ListModel *m)
+int ListModel::append(QV4::Object *object)
 {
-    char *mem = getPropertyMemory(role);
-    ListModel **value = new (mem) ListModel *;
-    *value = m;
+    int elementIndex = appendElement();
+    set(elementIndex, object);
+    return elementIndex;
 }
 
-void ListElement::setVariantMapFast(const ListLayout::Role &role, QV4::Object *o)
+/*
+  Inserts one element for each object in \a objects, making room for all of them
+  at once and updating the cached indices of the elements after them only once.
+*/
+void ListModel::insert(int elementIndex, QV4::ArrayObject *objects)
 {
-    char *mem = getPropertyMemory(role);
-    QVariantMap *map = new (mem) QVariantMap;
-    *map = o->engine()->variantMapFromJS(o);
-}
+    QV4::Scope scope(objects->engine());
+    QV4::ScopedObject o(scope);
 
-void ListElement::setDateTimePropertyFast(const ListLayout::Role &role, const QDateTime &dt)
-{
-    char *mem = getPropertyMemory(role);
-    new (mem) QDateTime(dt);
-}
+    const int objectCount = objects->getLength();
+    if (objectCount <= 0)
+        return;
 
-void ListElement::setFunctionPropertyFast(const ListLayout::Role &role, const QJSValue &f)
-{
-    char *mem = getPropertyMemory(role);
-    new (mem) QJSValue(f);
-}
+    insertRows(elementIndex, 0, 0, objectCount);
 
-void ListElement::clearProperty(const ListLayout::Role &role)
-{
-    switch (role.type) {
-    case ListLayout::Role::String:
-        setStringProperty(role, QString());
-        break;
-    case ListLayout::Role::Number:
-        setDoubleProperty(role, 0.0);
-        break;
-    case ListLayout::Role::Bool:
-        setBoolProperty(role, false);
-        break;
-    case ListLayout::Role::List:
-        setListProperty(role, 0);
-        break;
-    case ListLayout::Role::QObject:
-        setQObjectProperty(role, 0);
-        break;
-    case ListLayout::Role::DateTime:
-        setDateTimeProperty(role, QDateTime());
-        break;
-    case ListLayout::Role::VariantMap:
-        setVariantMapProperty(role, (QVariantMap *)0);
-        break;
-    case ListLayout::Role::Function:
-        setFunctionProperty(role, QJSValue());
-        break;
-    default:
-        break;
+    for (int i = 0; i < objectCount; ++i) {
+        o = objects->getIndexed(i);
+        set(elementIndex + i, o);
     }
-}
 
-ListElement::ListElement()
-{
-    m_objectCache = 0;
-    uid = uidCounter.fetchAndAddOrdered(1);
-    next = 0;
-    memset(data, 0, sizeof(data));
-}
-
-ListElement::ListElement(int existingUid)
-{
-    m_objectCache = 0;
-    uid = existingUid;
-    next = 0;
-    memset(data, 0, sizeof(data));
+    updateCacheIndices(elementIndex + objectCount);
 }
 
-ListElement::~ListElement()
+int ListModel::append(QV4::ArrayObject *objects)
 {
-    delete next;
+    int elementIndex = m_elementCount;
+    insert(elementIndex, objects);
+    return elementIndex;
 }
 
-void ListElement::sync(ListElement *src, ListLayout *srcLayout, ListElement *target, ListLayout *targetLayout, QHash<int, ListModel *> *targetModelHash)
+int ListModel::setOrCreateProperty(int elementIndex, const QString &key, const QVariant &data)
 {
-    for (int i=0 ; i < srcLayout->roleCount() ; ++i) {
-        const ListLayout::Role &srcRole = srcLayout->getExistingRole(i);
-        const ListLayout::Role &targetRole = targetLayout->getExistingRole(i);
+    int roleIndex = -1;
 
-        switch (srcRole.type) {
-            case ListLayout::Role::List:
-                {
-                    ListModel *srcSubModel = src->getListProperty(srcRole);
-                    ListModel *targetSubModel = target->getListProperty(targetRole);
+    if (elementIndex >= 0 && elementIndex < m_elementCount) {
+        int row;
+        ListChunk *e = writableChunkAt(elementIndex, &row);
+        const int uid = e->uids.at(row);
+        elementModified(uid);
 
-                    if (srcSubModel) {
-                        if (targetSubModel == 0) {
-                            targetSubModel = new ListModel(targetRole.subLayout, 0, srcSubModel->getUid());
-                            target->setListPropertyFast(targetRole, targetSubModel);
-                        }
-                        ListModel::sync(srcSubModel, targetSubModel, targetModelHash);
-                    }
-                }
-                break;
-            case ListLayout::Role::QObject:
-                {
-                    QObject *object = src->getQObjectProperty(srcRole);
-                    target->setQObjectProperty(targetRole, object);
-                }
-                break;
-            case ListLayout::Role::String:
-            case ListLayout::Role::Number:
-            case ListLayout::Role::Bool:
-            case ListLayout::Role::DateTime:
-            case ListLayout::Role::Function:
-                {
-                    QVariant v = src->getProperty(srcRole, 0, 0);
-                    target->setVariantProperty(targetRole, v);
-                }
-                break;
-            case ListLayout::Role::VariantMap:
-                {
-                    QVariantMap *map = src->getVariantMapProperty(srcRole);
-                    target->setVariantMapProperty(targetRole, map);
-                }
-                break;
-            default:
-                break;
-        }
-    }
+        const ListLayout::Role *r = m_layout->getRoleOrCreate(key, data);
+        if (r) {
+            if (data.type() == QVariant::String)
+                roleIndex = e->setStringProperty(row, *r, m_layout->internString(data.toString()));
+            else
+                roleIndex = e->setVariantProperty(row, *r, data);
 
-}
+            ModelNodeMetaObject *cache = objectCache(uid);
 
-void ListElement::destroy(ListLayout *layout)
-{
-    if (layout) {
-        for (int i=0 ; i < layout->roleCount() ; ++i) {
-            const ListLayout::Role &r = layout->getExistingRole(i);
-
-            switch (r.type) {
-                case ListLayout::Role::String:
-                    {
-                        QString *string = getStringProperty(r);
-                        if (string)
-                            string->~QString();
-                    }
-                    break;
-                case ListLayout::Role::List:
-                    {
-                        ListModel *model = getListProperty(r);
-                        if (model) {
-                            model->destroy();
-                            delete model;
-                        }
-                    }
-                    break;
-                case ListLayout::Role::QObject:
-                    {
-                        QPointer<QObject> *guard = getGuardProperty(r);
-                        if (guard)
-                            guard->~QPointer();
-                    }
-                    break;
-                case ListLayout::Role::VariantMap:
-                    {
-                        QVariantMap *map = getVariantMapProperty(r);
-                        if (map)
-                            map->~QMap();
-                    }
-                    break;
-                case ListLayout::Role::DateTime:
-                    {
-                        QDateTime *dt = getDateTimeProperty(r);
-                        if (dt)
-                            dt->~QDateTime();
-                    }
-                    break;
-                case ListLayout::Role::Function:
-                    {
-                        QJSValue *f = getFunctionProperty(r);
-                        if (f)
-                            f->~QJSValue();
-                    }
-                    break;
-                default:
-                    // other types don't need explicit cleanup.
-                    break;
-            }
+            if (roleIndex != -1 && cache)
+                cache->updateValues(QVector<int>(1, roleIndex));
         }
-
-        delete m_objectCache;
-    }
-
-    if (next)
-        next->destroy(0);
-    uid = -1;
-}
-
-int ListElement::setVariantProperty(const ListLayout::Role &role, const QVariant &d)
-{
-    int roleIndex = -1;
-
-    switch (role.type) {
-        case ListLayout::Role::Number:
-            roleIndex = setDoubleProperty(role, d.toDouble());
-            break;
-        case ListLayout::Role::String:
-            roleIndex = setStringProperty(role, d.toString());
-            break;
-        case ListLayout::Role::Bool:
-            roleIndex = setBoolProperty(role, d.toBool());
-            break;
-        case ListLayout::Role::List:
-            roleIndex = setListProperty(role, d.value<ListModel *>());
-            break;
-        case ListLayout::Role::VariantMap: {
-                QVariantMap map = d.toMap();
-                roleIndex = setVariantMapProperty(role, &map);
-            }
-            break;
-        case ListLayout::Role::DateTime:
-            roleIndex = setDateTimeProperty(role, d.toDateTime());
-            break;
-        case ListLayout::Role::Function:
-            roleIndex = setFunctionProperty(role, d.value<QJSValue>());
-            break;
-        default:
-            break;
     }
 
     return roleIndex;
 }
 
-int ListElement::setJsProperty(const ListLayout::Role &role, const QV4::Value &d, QV4::ExecutionEngine *eng)
+int ListModel::setExistingProperty(int elementIndex, const QString &key, const QV4::Value &data, QV4::ExecutionEngine *eng)
 {
-    // Check if this key exists yet
     int roleIndex = -1;
 
-    QV4::Scope scope(eng);
-
-    // Add the value now
-    if (d.isString()) {
-        QString qstr = d.toQString();
-        roleIndex = setStringProperty(role, qstr);
-    } else if (d.isNumber()) {
-        roleIndex = setDoubleProperty(role, d.asDouble());
-    } else if (d.as<QV4::ArrayObject>()) {
-        QV4::ScopedArrayObject a(scope, d);
-        if (role.type == ListLayout::Role::List) {
-            QV4::Scope scope(a->engine());
-            QV4::ScopedObject o(scope);
-
-            ListModel *subModel = new ListModel(role.subLayout, 0, -1);
-            int arrayLength = a->getLength();
-            for (int j=0 ; j < arrayLength ; ++j) {
-                o = a->getIndexed(j);
-                subModel->append(o);
-            }
-            roleIndex = setListProperty(role, subModel);
-        } else {
-            qmlWarning(0) << QStringLiteral("Can't assign to existing role '%1' of different type [%2 -> %3]").arg(role.name).arg(roleTypeName(role.type)).arg(roleTypeName(ListLayout::Role::List));
-        }
-    } else if (d.isBoolean()) {
-        roleIndex = setBoolProperty(role, d.booleanValue());
-    } else if (d.as<QV4::DateObject>()) {
-        QV4::Scoped<QV4::DateObject> dd(scope, d);
-        QDateTime dt = dd->toQDateTime();
-        roleIndex = setDateTimeProperty(role, dt);
-    } else if (d.as<QV4::FunctionObject>()) {
-        QV4::ScopedFunctionObject f(scope, d);
-        QJSValue jsv;
-        QJSValuePrivate::setValue(&jsv, eng, f);
-        roleIndex = setFunctionProperty(role, jsv);
-    } else if (d.isObject()) {
-        QV4::ScopedObject o(scope, d);
-        QV4::QObjectWrapper *wrapper = o->as<QV4::QObjectWrapper>();
-        if (role.type == ListLayout::Role::QObject && wrapper) {
-            QObject *o = wrapper->object();
-            roleIndex = setQObjectProperty(role, o);
-        } else if (role.type == ListLayout::Role::VariantMap) {
-            roleIndex = setVariantMapProperty(role, o);
+    if (elementIndex >= 0 && elementIndex < m_elementCount) {
+        const ListLayout::Role *r = m_layout->getExistingRole(key);
+        if (r) {
+            int row;
+            ListChunk *e = writableChunkAt(elementIndex, &row);
+            elementModified(e->uids.at(row));
+            roleIndex = e->setJsProperty(row, *r, data, eng, m_layout);
         }
-    } else if (d.isNullOrUndefined()) {
-        clearProperty(role);
     }
 
     return roleIndex;
@@ -1759,6 +1832,7 @@ QQmlListModel::QQmlListModel(QQmlListModel *orig, QQmlListModelWorkerAgent *agen
 
     m_layout = new ListLayout(orig->m_layout);
     m_listModel = new ListModel(m_layout, this, orig->m_listModel->getUid());
+    m_listModel->setTracksModifications(true);
 
     if (m_dynamicRoles)
         sync(orig, this, 0);
@@ -1852,11 +1926,8 @@ void QQmlListModel::sync(QQmlListModel *src, QQmlListModel *target, QHash<int, Q
     QHash<int, ElementSync>::iterator end = elementHash.end();
     while (it != end) {
         const ElementSync &s = it.value();
-        if (s.src == 0) {
-            int targetIndex = target->m_modelObjects.indexOf(s.target);
-            target->m_modelObjects.remove(targetIndex, 1);
+        if (s.src == 0)
             delete s.target;
-        }
         ++it;
     }
 
@@ -1955,6 +2026,36 @@ void QQmlListModel::emitItemsMoved(int from, int to, int n)
     }
 }
 
+void QQmlListModel::emitLayoutAboutToBeChanged(QAbstractItemModel::LayoutChangeHint hint)
+{
+    if (m_mainThread)
+        emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(), hint);
+}
+
+/*
+  \a newRows holds the new row of each old row.
+*/
+void QQmlListModel::emitLayoutChanged(const QVector<int> &newRows, QAbstractItemModel::LayoutChangeHint hint)
+{
+    if (m_mainThread) {
+        changePersistentRows(newRows);
+        emit layoutChanged(QList<QPersistentModelIndex>(), hint);
+    } else {
+        int uid = m_dynamicRoles ? getUid() : m_listModel->getUid();
+        m_agent->data.layoutChange(uid, newRows, hint);
+    }
+}
+
+void QQmlListModel::changePersistentRows(const QVector<int> &newRows)
+{
+    const QModelIndexList oldPersistent = persistentIndexList();
+    QModelIndexList newPersistent;
+    newPersistent.reserve(oldPersistent.count());
+    for (const QModelIndex &index : oldPersistent)
+        newPersistent.append(createIndex(newRows.at(index.row()), 0));
+    changePersistentIndexList(oldPersistent, newPersistent);
+}
+
 QQmlListModelWorkerAgent *QQmlListModel::agent()
 {
     if (m_agent)
@@ -1964,6 +2065,18 @@ QQmlListModelWorkerAgent *QQmlListModel::agent()
     return m_agent;
 }
 
+/*
+  Returns how many chunks of rows this model shares with the copy of it
+  used by a WorkerScript. Used by autotests.
+*/
+int QQmlListModel::sharedChunkCount() const
+{
+    if (!m_agent || m_dynamicRoles)
+        return 0;
+
+    return m_listModel->sharedChunkCount(m_agent->m_copy->m_listModel);
+}
+
 QModelIndex QQmlListModel::index(int row, int column, const QModelIndex &parent) const
 {
     return row >= 0 && row < count() && column == 0 && !parent.isValid()
@@ -2188,14 +2301,13 @@ void QQmlListModel::insert(QQmlV4Function *args)
 
             int objectArrayLength = objectArray->getLength();
             emitItemsAboutToBeInserted(index, objectArrayLength);
-            for (int i=0 ; i < objectArrayLength ; ++i) {
-                argObject = objectArray->getIndexed(i);
-
-                if (m_dynamicRoles) {
+            if (m_dynamicRoles) {
+                for (int i=0 ; i < objectArrayLength ; ++i) {
+                    argObject = objectArray->getIndexed(i);
                     m_modelObjects.insert(index+i, DynamicRoleModelNode::create(scope.engine->variantMapFromJS(argObject), this));
-                } else {
-                    m_listModel->insert(index+i, argObject);
                 }
+            } else {
+                m_listModel->insert(index, objectArray);
             }
             emitItemsInserted(index, objectArrayLength);
         } else if (argObject) {
@@ -2271,6 +2383,267 @@ void QQmlListModel::move(int from, int to, int n)
     emitItemsMoved(from, to, n);
 }
 
+/*
+  Orders role values the way sort() and find() expect: numbers, dates and
+  booleans by value, everything else by its string representation. Elements
+  which don't have the role at all come first.
+*/
+static int compareRoleValues(const QVariant &lhs, const QVariant &rhs)
+{
+    if (!lhs.isValid() || !rhs.isValid())
+        return int(lhs.isValid()) - int(rhs.isValid());
+
+    const auto isNumber = [](const QVariant &v) {
+        switch (v.userType()) {
+        case QMetaType::Double:
+        case QMetaType::Float:
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+            return true;
+        default:
+            return false;
+        }
+    };
+
+    if (isNumber(lhs) && isNumber(rhs)) {
+        const double l = lhs.toDouble();
+        const double r = rhs.toDouble();
+        return l < r ? -1 : (r < l ? 1 : 0);
+    }
+    if (lhs.userType() == QMetaType::QDateTime && rhs.userType() == QMetaType::QDateTime) {
+        const QDateTime l = lhs.toDateTime();
+        const QDateTime r = rhs.toDateTime();
+        return l < r ? -1 : (r < l ? 1 : 0);
+    }
+    if (lhs.userType() == QMetaType::Bool && rhs.userType() == QMetaType::Bool)
+        return int(lhs.toBool()) - int(rhs.toBool());
+
+    return QString::compare(lhs.toString(), rhs.toString());
+}
+
+int QQmlListModel::roleIndex(const QString &role) const
+{
+    if (m_dynamicRoles)
+        return m_roles.indexOf(role);
+
+    const ListLayout::Role *r = m_listModel->getExistingRole(role);
+    return r ? r->index : -1;
+}
+
+/*
+  Rearranges the elements so that the element currently at newOrder[i] ends up
+  at index i.
+
+  The change is reported as moves of contiguous blocks, so views keep and move
+  the delegates they already have. If that takes more than a few moves, views
+  are instead told that the rows were sorted in place and rebind their existing
+  delegates, which is cheaper than moving them block by block.
+*/
+void QQmlListModel::reorder(const QVector<int> &newOrder)
+{
+    enum { MaxReorderMoves = 64 };
+
+    struct Move { int from; int to; int count; };
+    QVector<Move> moves;
+
+    const int elementCount = newOrder.count();
+    QVector<int> current(elementCount);
+    std::iota(current.begin(), current.end(), 0);
+
+    for (int i = 0; i < elementCount; ++i) {
+        if (current.at(i) == newOrder.at(i))
+            continue;
+
+        if (moves.count() == MaxReorderMoves) {
+            moves.clear();
+            break;
+        }
+
+        int from = i + 1;
+        while (current.at(from) != newOrder.at(i))
+            ++from;
+        int n = 1;
+        while (from + n < elementCount && current.at(from + n) == newOrder.at(i + n))
+            ++n;
+
+        std::rotate(current.begin() + i, current.begin() + from, current.begin() + from + n);
+        moves.append({ from, i, n });
+        i += n - 1;
+    }
+
+    if (!moves.isEmpty() || current == newOrder) {
+        for (const Move &move : qAsConst(moves)) {
+            emitItemsAboutToBeMoved(move.from, move.to, move.count);
+            if (m_dynamicRoles)
+                std::rotate(m_modelObjects.begin() + move.to, m_modelObjects.begin() + move.from, m_modelObjects.begin() + move.from + move.count);
+            else
+                m_listModel->move(move.from, move.to, move.count);
+            emitItemsMoved(move.from, move.to, move.count);
+        }
+        return;
+    }
+
+    emitLayoutAboutToBeChanged(QAbstractItemModel::VerticalSortHint);
+
+    if (m_dynamicRoles) {
+        QVector<DynamicRoleModelNode *> reordered;
+        reordered.reserve(elementCount);
+        for (int index : newOrder)
+            reordered.append(m_modelObjects.at(index));
+        m_modelObjects = reordered;
+    } else {
+        m_listModel->reorder(newOrder);
+    }
+
+    QVector<int> newRows(elementCount);
+    for (int i = 0; i < elementCount; ++i)
+        newRows[newOrder.at(i)] = i;
+    emitLayoutChanged(newRows, QAbstractItemModel::VerticalSortHint);
+}
+
+/*!
+    \qmlmethod ListModel::sort(string role, enumeration order = Qt.AscendingOrder)
+    \since 5.11
+
+    Sorts the items in the list model by the value of \a role, in the given
+    \a order. The sort is stable; items with equal values keep their relative
+    order.
+
+    \code
+        fruitModel.sort("cost", Qt.DescendingOrder)
+    \endcode
+
+    Numbers, dates and booleans are compared by value, other values by their
+    string representation. The items are moved, not recreated, so delegates
+    showing them in a view are kept.
+
+    \sa find(), filter(), move()
+*/
+void QQmlListModel::sort(const QString &role, Qt::SortOrder order)
+{
+    const int index = roleIndex(role);
+    if (index == -1) {
+        qmlWarning(this) << tr("sort: no role named %1").arg(role);
+        return;
+    }
+
+    const int elementCount = count();
+    QVector<QVariant> values;
+    values.reserve(elementCount);
+    for (int i = 0; i < elementCount; ++i)
+        values.append(data(i, index));
+
+    QVector<int> newOrder(elementCount);
+    std::iota(newOrder.begin(), newOrder.end(), 0);
+    std::stable_sort(newOrder.begin(), newOrder.end(), [&values, order](int lhs, int rhs) {
+        const int c = compareRoleValues(values.at(lhs), values.at(rhs));
+        return order == Qt::AscendingOrder ? c < 0 : c > 0;
+    });
+
+    reorder(newOrder);
+}
+
+/*!
+    \qmlmethod ListModel::filter(function predicate)
+    \qmlmethod ListModel::filter(string role, variant value)
+    \since 5.11
+
+    Removes the items for which \a predicate returns \c false, or, when given
+    a \a role and \a value, the items whose \a role does not equal \a value.
+    The predicate is called with the item, as returned by get().
+
+    \code
+        fruitModel.filter(function(fruit) { return fruit.cost < 5 })
+        fruitModel.filter("color", "red")
+    \endcode
+
+    Each run of adjacent removed items is reported as one removal, so
+    delegates showing the remaining items in a view are kept.
+
+    \sa sort(), remove()
+*/
+void QQmlListModel::filter(QQmlV4Function *args)
+{
+    QV4::Scope scope(args->v4engine());
+    const int elementCount = count();
+    QVector<bool> keep(elementCount);
+
+    QV4::ScopedFunctionObject predicate(scope);
+    if (args->length() == 1)
+        predicate = (*args)[0];
+
+    if (predicate) {
+        QV4::ScopedValue result(scope);
+        for (int i = 0; i < elementCount; ++i) {
+            QV4::JSCallData jsCall(scope, 1);
+            jsCall->args[0] = QV4::ReturnedValue(get(i));
+            *jsCall->thisObject = scope.engine->globalObject;
+            result = predicate->call(jsCall);
+            if (scope.hasException())
+                return;
+            keep[i] = result->toBoolean();
+        }
+    } else if (args->length() == 2) {
+        QV4::ScopedValue role(scope, (*args)[0]);
+        QV4::ScopedValue value(scope, (*args)[1]);
+        const int index = roleIndex(role->toQString());
+        const QVariant variant = scope.engine->toVariant(value, -1);
+        for (int i = 0; i < elementCount; ++i)
+            keep[i] = index != -1 && compareRoleValues(data(i, index), variant) == 0;
+    } else {
+        qmlWarning(this) << tr("filter: expected a function, or a role and a value");
+        return;
+    }
+
+    // Remove the runs from the back, so that the rows of the runs before them
+    // stay valid and every removal only shifts the items after it.
+    int end = elementCount;
+    while (end > 0) {
+        while (end > 0 && keep.at(end - 1))
+            --end;
+        int start = end;
+        while (start > 0 && !keep.at(start - 1))
+            --start;
+        if (start < end)
+            removeElements(start, end - start);
+        end = start;
+    }
+}
+
+/*!
+    \qmlmethod int ListModel::find(string role, variant value, enumeration order = Qt.AscendingOrder)
+    \since 5.11
+
+    Returns the index of the first item whose \a role equals \a value, or -1
+    if there is none. The items must already be sorted by \a role in the given
+    \a order, for example with sort(); they are searched by bisection.
+
+    \sa sort()
+*/
+int QQmlListModel::find(const QString &role, const QVariant &value, Qt::SortOrder order) const
+{
+    const int index = roleIndex(role);
+    if (index == -1)
+        return -1;
+
+    int low = 0;
+    int high = count();
+    while (low < high) {
+        const int middle = low + (high - low) / 2;
+        const int c = compareRoleValues(data(middle, index), value);
+        if (order == Qt::AscendingOrder ? c < 0 : c > 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    if (low < count() && compareRoleValues(data(low, index), value) == 0)
+        return low;
+    return -1;
+}
+
 /*!
     \qmlmethod ListModel::append(jsobject dict)
 
@@ -2298,14 +2671,13 @@ void QQmlListModel::append(QQmlV4Function *args)
             int index = count();
             emitItemsAboutToBeInserted(index, objectArrayLength);
 
-            for (int i=0 ; i < objectArrayLength ; ++i) {
-                argObject = objectArray->getIndexed(i);
-
-                if (m_dynamicRoles) {
+            if (m_dynamicRoles) {
+                for (int i=0 ; i < objectArrayLength ; ++i) {
+                    argObject = objectArray->getIndexed(i);
                     m_modelObjects.append(DynamicRoleModelNode::create(scope.engine->variantMapFromJS(argObject), this));
-                } else {
-                    m_listModel->append(argObject);
                 }
+            } else {
+                m_listModel->append(objectArray);
             }
 
             emitItemsInserted(index, objectArrayLength);
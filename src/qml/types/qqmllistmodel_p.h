@@ -91,6 +91,8 @@ public:
     bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
     QHash<int,QByteArray> roleNames() const override;
 
+    using QAbstractListModel::sort;
+
     QVariant data(int index, int role) const;
     int count() const;
 
@@ -102,9 +104,13 @@ public:
     Q_INVOKABLE void set(int index, const QQmlV4Handle &);
     Q_INVOKABLE void setProperty(int index, const QString& property, const QVariant& value);
     Q_INVOKABLE void move(int from, int to, int count);
+    Q_INVOKABLE void sort(const QString &role, Qt::SortOrder order = Qt::AscendingOrder);
+    Q_INVOKABLE void filter(QQmlV4Function *args);
+    Q_INVOKABLE int find(const QString &role, const QVariant &value, Qt::SortOrder order = Qt::AscendingOrder) const;
     Q_INVOKABLE void sync();
 
     QQmlListModelWorkerAgent *agent();
+    int sharedChunkCount() const;
 
     bool dynamicRoles() const { return m_dynamicRoles; }
     void setDynamicRoles(bool enableDynamicRoles);
@@ -119,7 +125,6 @@ private:
     friend struct QV4::ModelObject;
     friend class ModelNodeMetaObject;
     friend class ListModel;
-    friend class ListElement;
     friend class DynamicRoleModelNode;
     friend class DynamicRoleModelNodeMetaObject;
 
@@ -165,8 +170,14 @@ private:
     void emitItemsInserted(int index, int count);
     void emitItemsAboutToBeMoved(int from, int to, int n);
     void emitItemsMoved(int from, int to, int n);
+    void emitLayoutAboutToBeChanged(QAbstractItemModel::LayoutChangeHint hint);
+    void emitLayoutChanged(const QVector<int> &newRows, QAbstractItemModel::LayoutChangeHint hint);
+    void changePersistentRows(const QVector<int> &newRows);
 
     void removeElements(int index, int removeCount);
+
+    int roleIndex(const QString &role) const;
+    void reorder(const QVector<int> &newOrder);
 };
 
 // ### FIXME
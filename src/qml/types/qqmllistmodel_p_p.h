@@ -56,6 +56,9 @@
 #include <private/qqmlopenmetaobject_p.h>
 #include <private/qv4qobjectwrapper_p.h>
 #include <qqml.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qset.h>
+#include <QtCore/qshareddata.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -192,7 +195,7 @@ struct ModelObject : public QObjectWrapper
 class ListLayout
 {
 public:
-    ListLayout() : currentBlock(0), currentBlockOffset(0) {}
+    ListLayout() {}
     ListLayout(const ListLayout *other);
     ~ListLayout();
 
@@ -200,7 +203,7 @@ public:
     {
     public:
 
-        Role() : type(Invalid), blockIndex(-1), blockOffset(-1), index(-1), subLayout(0) {}
+        Role() : type(Invalid), index(-1), subLayout(0) {}
         explicit Role(const Role *other);
         ~Role();
 
@@ -223,8 +226,6 @@ public:
 
         QString name;
         DataType type;
-        int blockIndex;
-        int blockOffset;
         int index;
         ListLayout *subLayout;
     };
@@ -239,86 +240,93 @@ public:
 
     int roleCount() const { return roles.count(); }
 
+    QString internString(const QString &s);
+
     static void sync(ListLayout *src, ListLayout *target);
 
 private:
     const Role &createRole(const QString &key, Role::DataType type);
 
-    int currentBlock;
-    int currentBlockOffset;
+    enum { InternedStringCount = 256 };
+
     QVector<Role *> roles;
     QStringHash<Role *> roleHash;
+    QVector<QString> internedStrings;
 };
 
 /*!
 \internal
+
+The values of one role for the rows of a ListChunk. Numbers, booleans,
+strings, nested models and objects are kept in a vector of their own type,
+the remaining role types as variants. Only the vector matching the role
+type is used.
 */
-class ListElement
+class ListColumn
 {
 public:
+    ListColumn() : type(ListLayout::Role::Invalid) {}
+
+    void insertRows(int at, const ListColumn *source, int from, int count);
+    void removeRows(int at, int count);
+
+    ListLayout::Role::DataType type;
+    QVector<double> numbers;
+    QVector<bool> bools;
+    QVector<QString> strings;
+    QVector<ListModel *> lists;
+    QVector<QPointer<QObject> > objects;
+    QVector<QVariant> variants;
+};
 
-    ListElement();
-    ListElement(int existingUid);
-    ~ListElement();
-
-    static void sync(ListElement *src, ListLayout *srcLayout, ListElement *target, ListLayout *targetLayout, QHash<int, ListModel *> *targetModelHash);
-
-    enum
-    {
-        BLOCK_SIZE = 64 - sizeof(int) - sizeof(ListElement *) - sizeof(ModelNodeMetaObject *)
-    };
-
-private:
-
-    void destroy(ListLayout *layout);
-
-    int setVariantProperty(const ListLayout::Role &role, const QVariant &d);
-
-    int setJsProperty(const ListLayout::Role &role, const QV4::Value &d, QV4::ExecutionEngine *eng);
+Q_DECLARE_TYPEINFO(ListColumn, Q_MOVABLE_TYPE);
 
-    int setStringProperty(const ListLayout::Role &role, const QString &s);
-    int setDoubleProperty(const ListLayout::Role &role, double n);
-    int setBoolProperty(const ListLayout::Role &role, bool b);
-    int setListProperty(const ListLayout::Role &role, ListModel *m);
-    int setQObjectProperty(const ListLayout::Role &role, QObject *o);
-    int setVariantMapProperty(const ListLayout::Role &role, QV4::Object *o);
-    int setVariantMapProperty(const ListLayout::Role &role, QVariantMap *m);
-    int setDateTimeProperty(const ListLayout::Role &role, const QDateTime &dt);
-    int setFunctionProperty(const ListLayout::Role &role, const QJSValue &f);
+/*!
+\internal
 
-    void setStringPropertyFast(const ListLayout::Role &role, const QString &s);
-    void setDoublePropertyFast(const ListLayout::Role &role, double n);
-    void setBoolPropertyFast(const ListLayout::Role &role, bool b);
-    void setQObjectPropertyFast(const ListLayout::Role &role, QObject *o);
-    void setListPropertyFast(const ListLayout::Role &role, ListModel *m);
-    void setVariantMapFast(const ListLayout::Role &role, QV4::Object *o);
-    void setDateTimePropertyFast(const ListLayout::Role &role, const QDateTime &dt);
-    void setFunctionPropertyFast(const ListLayout::Role &role, const QJSValue &f);
+A run of consecutive rows of a ListModel, stored one column per role.
+Columns for roles that were created after the rows were added are missing
+until a value is set for them. A model shares its chunks with the copy a
+WorkerScript works on, so they have to be detached before they are changed.
+*/
+class ListChunk : public QSharedData
+{
+public:
+    enum { MaxRows = 256 };
 
-    void clearProperty(const ListLayout::Role &role);
+    int rowCount() const { return uids.count(); }
 
-    QVariant getProperty(const ListLayout::Role &role, const QQmlListModel *owner, QV4::ExecutionEngine *eng);
-    ListModel *getListProperty(const ListLayout::Role &role);
-    QString *getStringProperty(const ListLayout::Role &role);
-    QObject *getQObjectProperty(const ListLayout::Role &role);
-    QPointer<QObject> *getGuardProperty(const ListLayout::Role &role);
-    QVariantMap *getVariantMapProperty(const ListLayout::Role &role);
-    QDateTime *getDateTimeProperty(const ListLayout::Role &role);
-    QJSValue *getFunctionProperty(const ListLayout::Role &role);
+    void insertRows(int at, const ListChunk *source, int from, int count);
+    void removeRows(int at, int count);
 
-    inline char *getPropertyMemory(const ListLayout::Role &role);
+    const ListColumn *column(int roleIndex) const
+    {
+        return roleIndex < columns.count() && columns.at(roleIndex).type != ListLayout::Role::Invalid
+                ? &columns.at(roleIndex) : 0;
+    }
+    ListColumn &column(const ListLayout::Role &role);
 
-    int getUid() const { return uid; }
+    QVariant getProperty(int row, const ListLayout::Role &role) const;
+    ListModel *getListProperty(int row, const ListLayout::Role &role) const;
+    QObject *getQObjectProperty(int row, const ListLayout::Role &role) const;
 
-    ModelNodeMetaObject *objectCache();
+    int setVariantProperty(int row, const ListLayout::Role &role, const QVariant &d);
+    int setJsProperty(int row, const ListLayout::Role &role, const QV4::Value &d, QV4::ExecutionEngine *eng, ListLayout *layout);
 
-    char data[BLOCK_SIZE];
-    ListElement *next;
+    int setStringProperty(int row, const ListLayout::Role &role, const QString &s);
+    int setDoubleProperty(int row, const ListLayout::Role &role, double n);
+    int setBoolProperty(int row, const ListLayout::Role &role, bool b);
+    int setListProperty(int row, const ListLayout::Role &role, ListModel *m);
+    int setQObjectProperty(int row, const ListLayout::Role &role, QObject *o);
+    int setVariantMapProperty(int row, const ListLayout::Role &role, QV4::Object *o);
+    int setVariantMapProperty(int row, const ListLayout::Role &role, QVariantMap *m);
+    int setDateTimeProperty(int row, const ListLayout::Role &role, const QDateTime &dt);
+    int setFunctionProperty(int row, const ListLayout::Role &role, const QJSValue &f);
 
-    int uid;
-    QObject *m_objectCache;
+    void clearProperty(int row, const ListLayout::Role &role);
 
-    friend class ListModel;
+    QVector<int> uids;
+    QVector<ListColumn> columns;
 };
 
 /*!
@@ -354,6 +362,11 @@ public:
         return m_layout->getExistingRole(key);
     }
 
+    const ListLayout::Role *getExistingRole(const QString &key) const
+    {
+        return m_layout->getExistingRole(key);
+    }
+
     const ListLayout::Role &getOrCreateListRole(const QString &name)
     {
         return m_layout->getRoleOrCreate(name, ListLayout::Role::List);
@@ -361,7 +374,7 @@ public:
 
     int elementCount() const
     {
-        return elements.count();
+        return m_elementCount;
     }
 
     void set(int elementIndex, QV4::Object *object, QVector<int> *roles);
@@ -370,39 +383,71 @@ public:
     int append(QV4::Object *object);
     void insert(int elementIndex, QV4::Object *object);
 
+    int append(QV4::ArrayObject *objects);
+    void insert(int elementIndex, QV4::ArrayObject *objects);
+
     Q_REQUIRED_RESULT QVector<std::function<void()>> remove(int index, int count);
 
     int appendElement();
     void insertElement(int index);
 
     void move(int from, int to, int n);
+    void reorder(const QVector<int> &newOrder);
 
     int getUid() const { return m_uid; }
 
     static void sync(ListModel *src, ListModel *target, QHash<int, ListModel *> *srcModelHash);
 
+    // Remember which elements are modified or removed, so that syncing from this
+    // model only refreshes or deletes the object caches of those.
+    void setTracksModifications(bool track) { m_tracksModifications = track; }
+
+    int sharedChunkCount(const ListModel *other) const;
+
     QObject *getOrCreateModelObject(QQmlListModel *model, int elementIndex);
 
 private:
-    QPODVector<ListElement *, 4> elements;
+    typedef QExplicitlySharedDataPointer<ListChunk> ChunkPointer;
+
+    QVector<ChunkPointer> m_chunks;
+    QVector<int> m_chunkStarts;
+    int m_elementCount;
+
     ListLayout *m_layout;
     int m_uid;
 
+    bool m_tracksModifications;
+    QSet<int> m_modifiedUids;
+    QSet<int> m_removedUids;
+
+    QHash<int, QObject *> m_objectCaches;
+
     QQmlListModel *m_modelCache;
 
-    struct ElementSync
-    {
-        ElementSync() : src(0), target(0) {}
+    int findChunk(int elementIndex) const;
+    const ListChunk *chunkAt(int elementIndex, int *row) const;
+    ListChunk *writableChunkAt(int elementIndex, int *row);
+    void updateChunkStarts(int firstChunk = 0);
 
-        ListElement *src;
-        ListElement *target;
-    };
+    void insertRows(int index, const ListChunk *source, int from, int count);
+    void removeRows(int index, int count);
+    int uidAt(int elementIndex) const;
+
+    ModelNodeMetaObject *objectCache(int uid) const;
+
+    void elementModified(int uid)
+    {
+        if (m_tracksModifications)
+            m_modifiedUids.insert(uid);
+    }
+    bool hasListRoles() const;
+    bool canShareChunks() const;
 
-    void newElement(int index);
+    void copyChunks(const ListModel *src, QHash<int, ListModel *> *targetModelHash);
+    void removeStaleObjectCaches();
 
     void updateCacheIndices(int start = 0, int end = -1);
 
-    friend class ListElement;
     friend class QQmlListModelWorkerAgent;
     friend class QQmlListModelParser;
 };
@@ -85,6 +85,12 @@ void QQmlListModelWorkerAgent::Data::changedChange(int uid, int index, int count
     changes << c;
 }
 
+void QQmlListModelWorkerAgent::Data::layoutChange(int uid, const QVector<int> &rows, QAbstractItemModel::LayoutChangeHint hint)
+{
+    Change c = { uid, Change::LayoutChanged, 0, 0, 0, QVector<int>(), rows, hint };
+    changes << c;
+}
+
 QQmlListModelWorkerAgent::QQmlListModelWorkerAgent(QQmlListModel *model)
 : m_ref(1), m_orig(model), m_copy(new QQmlListModel(model, this))
 {
@@ -165,6 +171,21 @@ void QQmlListModelWorkerAgent::move(int from, int to, int count)
     m_copy->move(from, to, count);
 }
 
+void QQmlListModelWorkerAgent::sort(const QString &role, Qt::SortOrder order)
+{
+    m_copy->sort(role, order);
+}
+
+void QQmlListModelWorkerAgent::filter(QQmlV4Function *args)
+{
+    m_copy->filter(args);
+}
+
+int QQmlListModelWorkerAgent::find(const QString &role, const QVariant &value, Qt::SortOrder order) const
+{
+    return m_copy->find(role, value, order);
+}
+
 void QQmlListModelWorkerAgent::sync()
 {
     Sync *s = new Sync(data, m_copy);
@@ -235,6 +256,11 @@ bool QQmlListModelWorkerAgent::event(QEvent *e)
                                     model->createIndex(change.index + change.count - 1, 0),
                                     change.roles);
                         break;
+                    case Change::LayoutChanged:
+                        emit model->layoutAboutToBeChanged(QList<QPersistentModelIndex>(), change.hint);
+                        model->changePersistentRows(change.rows);
+                        emit model->layoutChanged(QList<QPersistentModelIndex>(), change.hint);
+                        break;
                     }
                 }
             }
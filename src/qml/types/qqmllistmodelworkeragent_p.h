@@ -53,6 +53,7 @@
 
 #include <qqml.h>
 
+#include <QAbstractItemModel>
 #include <QEvent>
 #include <QMutex>
 #include <QWaitCondition>
@@ -87,6 +88,9 @@ public:
     Q_INVOKABLE void set(int index, const QQmlV4Handle &);
     Q_INVOKABLE void setProperty(int index, const QString& property, const QVariant& value);
     Q_INVOKABLE void move(int from, int to, int count);
+    Q_INVOKABLE void sort(const QString &role, Qt::SortOrder order = Qt::AscendingOrder);
+    Q_INVOKABLE void filter(QQmlV4Function *args);
+    Q_INVOKABLE int find(const QString &role, const QVariant &value, Qt::SortOrder order = Qt::AscendingOrder) const;
     Q_INVOKABLE void sync();
 
     struct VariantRef
@@ -117,11 +121,13 @@ private:
     struct Change
     {
         int modelUid;
-        enum { Inserted, Removed, Moved, Changed } type;
+        enum { Inserted, Removed, Moved, Changed, LayoutChanged } type;
         int index; // Inserted/Removed/Moved/Changed
         int count; // Inserted/Removed/Moved/Changed
         int to;    // Moved
         QVector<int> roles;
+        QVector<int> rows; // LayoutChanged: the new row of each old row
+        QAbstractItemModel::LayoutChangeHint hint; // LayoutChanged
     };
 
     struct Data
@@ -133,6 +139,7 @@ private:
         void removeChange(int uid, int index, int count);
         void moveChange(int uid, int index, int count, int to);
         void changedChange(int uid, int index, int count, const QVector<int> &roles);
+        void layoutChange(int uid, const QVector<int> &rows, QAbstractItemModel::LayoutChangeHint hint);
     };
     Data data;
 
@@ -185,6 +185,7 @@ public:
     QV4::ReturnedValue getWorker(WorkerScript *);
 
     int m_nextId;
+    int m_scriptCount;
 
     static QV4::ReturnedValue method_sendMessage(const QV4::BuiltinFunction *, QV4::CallData *callData);
 
@@ -232,8 +233,8 @@ void QQuickWorkerScriptEnginePrivate::WorkerEngine::init()
 #define SEND_MESSAGE_CREATE_SCRIPT \
     "(function(method, engine) { "\
         "return (function(id) { "\
-            "return (function(message) { "\
-                "if (arguments.length) method(engine, id, message); "\
+            "return (function(message, transfer) { "\
+                "if (arguments.length) method(engine, id, message, transfer); "\
             "}); "\
         "}); "\
     "})"
@@ -289,7 +290,7 @@ QNetworkAccessManager *QQuickWorkerScriptEnginePrivate::WorkerEngine::networkAcc
 #endif
 
 QQuickWorkerScriptEnginePrivate::QQuickWorkerScriptEnginePrivate(QQmlEngine *engine)
-: workerEngine(0), qmlengine(engine), m_nextId(0)
+: workerEngine(0), qmlengine(engine), m_nextId(0), m_scriptCount(0)
 {
 }
 
@@ -302,7 +303,8 @@ QV4::ReturnedValue QQuickWorkerScriptEnginePrivate::method_sendMessage(const QV4
     int id = callData->argc() > 1 ? callData->args[1].toInt32() : 0;
 
     QV4::ScopedValue v(scope, callData->argument(2));
-    QByteArray data = QV4::Serialize::serialize(v, scope.engine);
+    QV4::ScopedValue transfer(scope, callData->argument(3));
+    QByteArray data = QV4::Serialize::serialize(v, transfer, scope.engine);
 
     QMutexLocker locker(&engine->p->m_lock);
     WorkerScript *script = engine->p->workers.value(id);
@@ -537,6 +539,7 @@ int QQuickWorkerScriptEngine::registerWorkerScript(QQuickWorkerScript *owner)
     d->m_lock.lock();
     d->workers.insert(script->id, script);
     d->m_lock.unlock();
+    ++d->m_scriptCount;
 
     return script->id;
 }
@@ -546,6 +549,7 @@ void QQuickWorkerScriptEngine::removeWorkerScript(int id)
     QQuickWorkerScriptEnginePrivate::WorkerScript* script = d->workers.value(id);
     if (script) {
         script->owner = 0;
+        --d->m_scriptCount;
         QCoreApplication::postEvent(d, new WorkerRemoveEvent(id));
     }
 }
@@ -560,6 +564,15 @@ void QQuickWorkerScriptEngine::sendMessage(int id, const QByteArray &data)
     QCoreApplication::postEvent(d, new WorkerDataEvent(id, data));
 }
 
+/*
+  Returns the number of WorkerScripts registered and not yet removed. Only
+  accessed from the thread that owns the QQmlEngine.
+*/
+int QQuickWorkerScriptEngine::workerScriptCount() const
+{
+    return d->m_scriptCount;
+}
+
 void QQuickWorkerScriptEngine::run()
 {
     d->m_lock.lock();
@@ -623,6 +636,19 @@ void QQuickWorkerScriptEngine::run()
 
     Worker script can not use \l {qtqml-javascript-imports.html}{.import} syntax.
 
+    \section3 Worker Threads
+
+    By default, all WorkerScripts of a QML engine share a single thread. If the
+    \c QML_WORKER_SCRIPT_POOL environment variable is set, they are instead spread
+    over a pool of threads, one per processor core. Each new WorkerScript is
+    assigned to the thread running the fewest scripts and stays on that thread
+    for its lifetime, so messages to and from one WorkerScript are still handled
+    in order.
+
+    With the pool enabled, a ListModel must only be passed to a single
+    WorkerScript. The worker copy of a ListModel is not synchronized between threads, so
+    WorkerScripts on different threads would modify it concurrently.
+
     \sa {Qt Quick Examples - Threading},
         {Threaded ListModel Example}
 */
@@ -661,7 +687,7 @@ void QQuickWorkerScript::setSource(const QUrl &source)
 }
 
 /*!
-    \qmlmethod WorkerScript::sendMessage(jsobject message)
+    \qmlmethod WorkerScript::sendMessage(jsobject message, array transfer)
 
     Sends the given \a message to a worker script handler in another
     thread. The other worker script handler can receive this message
@@ -674,11 +700,18 @@ void QQuickWorkerScript::setSource(const QUrl &source)
     \li boolean, number, string
     \li JavaScript objects and arrays
     \li ListModel objects (any other type of QObject* is not allowed)
+    \li ArrayBuffer objects
     \endlist
 
     All objects and arrays are copied to the \c message. With the exception
     of ListModel objects, any modifications by the other thread to an object
     passed in \c message will not be reflected in the original object.
+
+    The contents of an ArrayBuffer are copied as well. ArrayBuffers listed in
+    the optional \a transfer array are instead moved to the other thread
+    without a copy and left empty in the sender.
+    The same \c transfer argument is accepted by \c WorkerScript.sendMessage()
+    inside the worker script. This argument was introduced in Qt 5.11.
 */
 void QQuickWorkerScript::sendMessage(QQmlV4Function *args)
 {
@@ -689,10 +722,13 @@ void QQuickWorkerScript::sendMessage(QQmlV4Function *args)
 
     QV4::Scope scope(args->v4engine());
     QV4::ScopedValue argument(scope, QV4::Primitive::undefinedValue());
+    QV4::ScopedValue transfer(scope, QV4::Primitive::undefinedValue());
     if (args->length() != 0)
         argument = (*args)[0];
+    if (args->length() > 1)
+        transfer = (*args)[1];
 
-    m_engine->sendMessage(m_scriptId, QV4::Serialize::serialize(argument, scope.engine));
+    m_engine->sendMessage(m_scriptId, QV4::Serialize::serialize(argument, transfer, scope.engine));
 }
 
 void QQuickWorkerScript::classBegin()
@@ -75,6 +75,8 @@ public:
     void executeUrl(int, const QUrl &);
     void sendMessage(int, const QByteArray &);
 
+    int workerScriptCount() const;
+
 protected:
     void run() override;
 
@@ -102,9 +102,12 @@ public:
 
     virtual QVariant value(int role) const = 0;
     virtual void setValue(int role, const QVariant &value) = 0;
+    virtual void invalidateValues(const QVector<int> &roles) { Q_UNUSED(roles); }
 
     void setValue(const QString &role, const QVariant &value) override;
     bool resolveIndex(const QQmlAdaptorModel &model, int idx) override;
+    bool isRebindable() const override { return true; }
+    void rebindIndex(const QQmlAdaptorModel &model, int idx) override;
 
     static QV4::ReturnedValue get_property(const QV4::BuiltinFunction *, QV4::CallData *);
     static QV4::ReturnedValue set_property(const QV4::BuiltinFunction *, QV4::CallData *);
@@ -126,6 +129,7 @@ public:
         , propertyOffset(0)
         , signalOffset(0)
         , hasModelData(false)
+        , prefetchItemData(false)
     {
     }
 
@@ -175,6 +179,8 @@ public:
             QQmlDelegateModelItem *item = items.at(i);
             const int idx = item->modelIndex();
             if (idx >= index && idx < index + count) {
+                if (prefetchItemData && QObjectPrivate::get(item)->metaObject == this)
+                    static_cast<QQmlDMCachedModelData *>(item)->invalidateValues(roles);
                 for (int i = 0; i < signalIndexes.count(); ++i)
                     QMetaObject::activate(item, signalIndexes.at(i), 0);
             }
@@ -260,6 +266,7 @@ public:
     int propertyOffset;
     int signalOffset;
     bool hasModelData;
+    bool prefetchItemData;
 };
 
 QQmlDMCachedModelData::QQmlDMCachedModelData(
@@ -326,23 +333,31 @@ void QQmlDMCachedModelData::setValue(const QString &role, const QVariant &value)
     }
 }
 
-bool QQmlDMCachedModelData::resolveIndex(const QQmlAdaptorModel &, int idx)
+bool QQmlDMCachedModelData::resolveIndex(const QQmlAdaptorModel &model, int idx)
 {
     if (index == -1) {
         Q_ASSERT(idx >= 0);
-        index = idx;
-        cachedData.clear();
-        emit modelIndexChanged();
-        const QMetaObject *meta = metaObject();
-        const int propertyCount = type->propertyRoles.count();
-        for (int i = 0; i < propertyCount; ++i)
-            QMetaObject::activate(this, meta, i, 0);
+        rebindIndex(model, idx);
         return true;
     } else {
         return false;
     }
 }
 
+void QQmlDMCachedModelData::rebindIndex(const QQmlAdaptorModel &, int idx)
+{
+    index = idx;
+    cachedData.clear();
+    // Pooled items miss the dataChanged notifications of their old row, so nothing prefetched
+    // for it can be trusted, even if the item is rebound to the same row.
+    invalidateValues(QVector<int>());
+    emit modelIndexChanged();
+    const QMetaObject *meta = metaObject();
+    const int propertyCount = type->propertyRoles.count();
+    for (int i = 0; i < propertyCount; ++i)
+        QMetaObject::activate(this, meta, i, 0);
+}
+
 QV4::ReturnedValue QQmlDMCachedModelData::get_property(const QV4::BuiltinFunction *b, QV4::CallData *callData)
 {
     QV4::Scope scope(b);
@@ -421,15 +436,41 @@ public:
 
     QVariant value(int role) const override
     {
-        return type->model->aim()->index(index, 0, type->model->rootIndex).data(role);
+        const QModelIndex modelIndex = type->model->aim()->index(index, 0, type->model->rootIndex);
+        if (!type->prefetchItemData)
+            return modelIndex.data(role);
+
+        // Fetch all the roles of the row in one call the first time any is read, and then serve
+        // reads from that until the model signals a change.  Roles itemData() doesn't return
+        // are fetched and cached individually.
+        if (cachedIndex != modelIndex) {
+            cachedIndex = modelIndex;
+            cachedValues = type->model->aim()->itemData(modelIndex);
+        }
+        QMap<int, QVariant>::const_iterator it = cachedValues.constFind(role);
+        if (it == cachedValues.constEnd())
+            it = cachedValues.insert(role, modelIndex.data(role));
+        return *it;
     }
 
     void setValue(int role, const QVariant &value) override
     {
+        cachedValues.remove(role);
         type->model->aim()->setData(
                 type->model->aim()->index(index, 0, type->model->rootIndex), value, role);
     }
 
+    void invalidateValues(const QVector<int> &roles) override
+    {
+        if (roles.isEmpty()) {
+            cachedIndex = QPersistentModelIndex();
+            cachedValues.clear();
+        } else {
+            for (int role : roles)
+                cachedValues.remove(role);
+        }
+    }
+
     QV4::ReturnedValue get() override
     {
         if (type->prototype.isUndefined()) {
@@ -443,6 +484,10 @@ public:
         ++scriptRef;
         return o.asReturnedValue();
     }
+
+private:
+    mutable QPersistentModelIndex cachedIndex;
+    mutable QMap<int, QVariant> cachedValues;
 };
 
 class VDMAbstractItemModelDataType : public VDMModelDelegateDataType
@@ -476,6 +521,7 @@ public:
                                 vdm, SLOT(_q_modelReset()));
             QObject::disconnect(aim, SIGNAL(layoutChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)),
                                 vdm, SLOT(_q_layoutChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)));
+            QObject::disconnect(aim, 0, vdm, SLOT(_q_flushDataChanges()));
         }
 
         const_cast<VDMAbstractItemModelDataType *>(this)->release();
@@ -552,6 +598,13 @@ public:
             addProperty(&builder, 1, propertyName, propertyType);
         }
 
+        // Models backed by an expensive store can declare Q_CLASSINFO("QmlPrefetchItemData", "true")
+        // and reimplement itemData() to return all the roles of a row in one call.
+        const QMetaObject *modelMetaObject = model.aim()->metaObject();
+        const int prefetchInfo = modelMetaObject->indexOfClassInfo("QmlPrefetchItemData");
+        prefetchItemData = prefetchInfo != -1
+                && qstrcmp(modelMetaObject->classInfo(prefetchInfo).value(), "true") == 0;
+
         metaObject = builder.toMetaObject();
         *static_cast<QMetaObject *>(this) = *metaObject;
         propertyCache = new QQmlPropertyCache(metaObject);
@@ -629,16 +682,23 @@ public:
     bool resolveIndex(const QQmlAdaptorModel &model, int idx) override
     {
         if (index == -1) {
-            index = idx;
-            cachedData = model.list.at(idx);
-            emit modelIndexChanged();
-            emit modelDataChanged();
+            rebindIndex(model, idx);
             return true;
         } else {
             return false;
         }
     }
 
+    bool isRebindable() const override { return true; }
+
+    void rebindIndex(const QQmlAdaptorModel &model, int idx) override
+    {
+        index = idx;
+        cachedData = model.list.at(idx);
+        emit modelIndexChanged();
+        emit modelDataChanged();
+    }
+
 
 Q_SIGNALS:
     void modelDataChanged();
@@ -929,6 +989,19 @@ void QQmlAdaptorModel::setModel(const QVariant &variant, QQmlDelegateModel *vdm,
                               vdm, QQmlDelegateModel, SLOT(_q_modelReset()));
             qmlobject_connect(model, QAbstractItemModel, SIGNAL(layoutChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)),
                               vdm, QQmlDelegateModel, SLOT(_q_layoutChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)));
+
+            if (QQmlDelegateModelPrivate::get(vdm)->m_coalesceDataChanges) {
+                // Coalesced data changes refer to the current rows, so deliver them before the
+                // model changes its structure.
+                QObject::connect(model, SIGNAL(rowsAboutToBeInserted(QModelIndex,int,int)),
+                                 vdm, SLOT(_q_flushDataChanges()));
+                QObject::connect(model, SIGNAL(rowsAboutToBeMoved(QModelIndex,int,int,QModelIndex,int)),
+                                 vdm, SLOT(_q_flushDataChanges()));
+                QObject::connect(model, SIGNAL(modelAboutToBeReset()),
+                                 vdm, SLOT(_q_flushDataChanges()));
+                QObject::connect(model, SIGNAL(layoutAboutToBeChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)),
+                                 vdm, SLOT(_q_flushDataChanges()));
+            }
         } else {
             accessors = new VDMObjectDelegateDataType;
         }
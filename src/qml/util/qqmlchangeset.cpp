@@ -111,6 +111,18 @@ QQmlChangeSet &QQmlChangeSet::operator =(const QQmlChangeSet &changeSet)
 
 void QQmlChangeSet::insert(int index, int count)
 {
+    // Inserts made in ascending order are coalesced with the last insert in constant time,
+    // instead of being merged with a walk over every notification in the set.
+    if (count > 0 && m_changes.isEmpty()
+            && (m_inserts.isEmpty() || index >= m_inserts.constLast().end())) {
+        if (!m_inserts.isEmpty() && index == m_inserts.constLast().end() && !m_inserts.constLast().isMove())
+            m_inserts.last().count += count;
+        else
+            m_inserts.append(Change(index, count));
+        m_difference += count;
+        return;
+    }
+
     insert(QVector<Change>() << Change(index, count));
 }
 
@@ -120,6 +132,18 @@ void QQmlChangeSet::insert(int index, int count)
 
 void QQmlChangeSet::remove(int index, int count)
 {
+    // As with inserts, removes made in ascending order, or repeatedly at the same index, are
+    // coalesced with the last remove directly while there are no inserts or changes to adjust.
+    if (count > 0 && m_inserts.isEmpty() && m_changes.isEmpty()
+            && (m_removes.isEmpty() || index >= m_removes.constLast().index)) {
+        if (!m_removes.isEmpty() && index == m_removes.constLast().index && !m_removes.constLast().isMove())
+            m_removes.last().count += count;
+        else
+            m_removes.append(Change(index, count));
+        m_difference -= count;
+        return;
+    }
+
     QVector<Change> removes;
     removes.append(Change(index, count));
     remove(&removes, 0);
@@ -148,6 +172,19 @@ void QQmlChangeSet::move(int from, int to, int count, int moveId)
 
 void QQmlChangeSet::change(int index, int count)
 {
+    // Changes made in ascending order which don't intersect an insert are coalesced with the
+    // last change directly.
+    if (count > 0 && (m_inserts.isEmpty() || m_inserts.constLast().end() < index)) {
+        if (m_changes.isEmpty() || m_changes.constLast().end() < index) {
+            m_changes.append(Change(index, count));
+            return;
+        } else if (m_changes.constLast().index <= index) {
+            Change &last = m_changes.last();
+            last.count = qMax(last.end(), index + count) - last.index;
+            return;
+        }
+    }
+
     QVector<Change> changes;
     changes.append(Change(index, count));
     change(changes);
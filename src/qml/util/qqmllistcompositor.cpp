@@ -41,6 +41,8 @@
 
 #include <QtCore/qvarlengtharray.h>
 
+#include <algorithm>
+
 //#define QT_QML_VERIFY_MINIMAL
 //#define QT_QML_VERIFY_INTEGRITY
 
@@ -96,8 +98,17 @@ QT_BEGIN_NAMESPACE
     for a specific index, each time a lookup is done the range and its indexes are cached and the
     next lookup is done relative to this.   This works out to near constant time in most relevant
     use cases because successive index lookups are most frequently adjacent.  The total number of
-    ranges is often quite small, which helps as well. If there is a need for faster random access
-    then a skip list like index may be an appropriate addition.
+    ranges is often quite small, which helps as well.
+
+    For random access into compositors with many ranges, such as heavily filtered groups over a
+    large model, the ranges are also divided into blocks of around IndexStride ranges, each with
+    the number of items it holds in every group.  The counts are kept in a binary indexed tree, so
+    a lookup far from the cached position finds the block holding an index and the group indexes
+    at its start in logarithmic time, and then walks at most a block's ranges.  The index is built
+    by the first lookup that would otherwise have to walk a significant fraction of the ranges.
+    After that, each modification only recounts the blocks holding the ranges it touched and
+    splits blocks that have grown too large.  Notifications of changes to the source lists, which
+    walk all ranges anyway, discard it.
 
     \sa VisualDataModel
 */
@@ -287,10 +298,12 @@ QQmlListCompositor::insert_iterator &QQmlListCompositor::insert_iterator::operat
 QQmlListCompositor::QQmlListCompositor()
     : m_end(m_ranges.next, 0, Default, 2)
     , m_cacheIt(m_end)
+    , m_rangeCount(0)
     , m_groupCount(2)
     , m_defaultFlags(PrependFlag | DefaultFlag)
     , m_removeFlags(AppendFlag | PrependFlag | GroupMask)
     , m_moveId(0)
+    , m_indexValid(false)
 {
 }
 
@@ -314,6 +327,7 @@ QQmlListCompositor::~QQmlListCompositor()
 inline QQmlListCompositor::Range *QQmlListCompositor::insert(
         Range *before, void *list, int index, int count, uint flags)
 {
+    ++m_rangeCount;
     return new Range(before, list, index, count, flags);
 }
 
@@ -329,7 +343,25 @@ inline QQmlListCompositor::Range *QQmlListCompositor::erase(
     Range *next = range->next;
     next->previous = range->previous;
     next->previous->next = range->next;
+
+    if (m_indexValid) {
+        // Move the start of the range's index block to the next range, or leave the block empty
+        // if it had no other ranges.
+        const QHash<Range *, int>::iterator start = m_indexBlockStarts.find(range);
+        if (start != m_indexBlockStarts.end()) {
+            const int block = *start;
+            m_indexBlockStarts.erase(start);
+            if (next != &m_ranges && !m_indexBlockStarts.contains(next)) {
+                m_indexBlocks[block].start = next;
+                m_indexBlockStarts.insert(next, block);
+            } else {
+                m_indexBlocks[block].start = 0;
+            }
+        }
+    }
+
     delete range;
+    --m_rangeCount;
     return next;
 }
 
@@ -342,6 +374,7 @@ void QQmlListCompositor::setGroupCount(int count)
     m_groupCount = count;
     m_end = iterator(&m_ranges, 0, Default, m_groupCount);
     m_cacheIt = m_end;
+    invalidateIndex();
 }
 
 /*!
@@ -363,14 +396,8 @@ QQmlListCompositor::iterator QQmlListCompositor::find(Group group, int index)
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< group << index)
     Q_ASSERT(index >=0 && index < count(group));
-    if (m_cacheIt == m_end) {
-        m_cacheIt = iterator(m_ranges.next, 0, group, m_groupCount);
-        m_cacheIt += index;
-    } else {
-        const int offset = index - m_cacheIt.index[group];
-        m_cacheIt.setGroup(group);
-        m_cacheIt += offset;
-    }
+    m_cacheIt = seekStart(group, index);
+    m_cacheIt += index - m_cacheIt.index[group];
     Q_ASSERT(m_cacheIt.index[group] == index);
     Q_ASSERT(m_cacheIt->inGroup(group));
     QT_QML_VERIFY_LISTCOMPOSITOR
@@ -404,20 +431,309 @@ QQmlListCompositor::insert_iterator QQmlListCompositor::findInsertPosition(Group
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< group << index)
     Q_ASSERT(index >=0 && index <= count(group));
-    insert_iterator it;
-    if (m_cacheIt == m_end) {
-        it = iterator(m_ranges.next, 0, group, m_groupCount);
-        it += index;
-    } else {
-        const int offset = index - m_cacheIt.index[group];
+    insert_iterator it = seekStart(group, index);
+    it += index - it.index[group];
+    Q_ASSERT(it.index[group] == index);
+    return it;
+}
+
+/*!
+    Returns the iterator in \a group from which the item at \a index can be reached in the fewest
+    steps.
+
+    This is the cached iterator of the last lookup if the index is near it, otherwise the start of
+    the index block holding the item, or the start of the compositor if it has few ranges.
+*/
+
+QQmlListCompositor::iterator QQmlListCompositor::seekStart(Group group, int index)
+{
+    const bool cached = m_cacheIt != m_end;
+    const int groupCount = m_end.index[group];
+    const qint64 distance = cached ? qAbs(index - m_cacheIt.index[group]) : index;
+
+    // Estimate the number of ranges a walk would cover assuming items are evenly distributed,
+    // and only use the index if that is more than a lookup in it costs.  Building the index
+    // costs a full walk, so only do that for lookups which would walk a good part of it anyway.
+    bool useIndex = false;
+    if (m_rangeCount >= 2 * IndexStride && groupCount > 0 && distance > 0) {
+        useIndex = m_indexValid
+                ? distance * m_rangeCount > qint64(IndexStride) * groupCount
+                : distance * 4 > groupCount;
+    }
+
+    iterator it;
+    if (useIndex) {
+        if (!m_indexValid)
+            buildIndex();
+        int block = qMin(findIndexBlock(group, index), m_indexBlocks.count() - 1);
+        while (!m_indexBlocks.at(block).start)
+            --block;
+        Range *start = m_indexBlocks.at(block).start;
+        it = iterator(start == &m_ranges ? m_ranges.next : start, 0, group, m_groupCount);
+        for (int i = 0; i < m_groupCount; ++i)
+            it.index[i] = indexCountBefore(block, i);
+    } else if (cached) {
         it = m_cacheIt;
-        it.setGroup(group);
-        it += offset;
+    } else {
+        it = iterator(m_ranges.next, 0, group, m_groupCount);
     }
-    Q_ASSERT(it.index[group] == index);
+    it.setGroup(group);
     return it;
 }
 
+/*!
+    Builds the index used to speed up lookups in compositors with many ranges.
+
+    The first block starts at the list head so that ranges inserted in front of all others
+    always have a block to belong to.  The other blocks start every IndexStride'th range.
+*/
+
+void QQmlListCompositor::buildIndex()
+{
+    m_indexBlocks.clear();
+    m_indexBlocks.reserve(m_rangeCount / IndexStride + 1);
+    m_indexBlockStarts.clear();
+    m_indexBlockStarts.reserve(m_rangeCount / IndexStride + 1);
+
+    IndexBlock block(&m_ranges);
+    for (Range *range = m_ranges.next; range != &m_ranges; range = range->next) {
+        if (block.rangeCount == IndexStride) {
+            m_indexBlocks.append(block);
+            m_indexBlockStarts.insert(range, m_indexBlocks.count());
+            block = IndexBlock(range);
+        }
+        ++block.rangeCount;
+        for (int i = 0; i < m_groupCount; ++i) {
+            if (range->inGroup(i))
+                block.counts[i] += range->count;
+        }
+    }
+    m_indexBlocks.append(block);
+
+    buildIndexTree();
+    m_indexValid = true;
+}
+
+/*!
+    Discards the index, it is built again by the next lookup that needs it.
+*/
+
+void QQmlListCompositor::invalidateIndex()
+{
+    m_indexValid = false;
+    m_indexBlocks.clear();
+    m_indexTree.clear();
+    m_indexBlockStarts.clear();
+}
+
+/*!
+    Builds the binary indexed tree of the group counts of the index blocks.
+
+    There is one tree for each group, each with an unused first element.
+*/
+
+void QQmlListCompositor::buildIndexTree()
+{
+    const int blockCount = m_indexBlocks.count();
+    m_indexTree.fill(0, m_groupCount * (blockCount + 1));
+    for (int i = 0; i < m_groupCount; ++i) {
+        int *tree = m_indexTree.data() + i * (blockCount + 1);
+        for (int j = 1; j <= blockCount; ++j) {
+            tree[j] += m_indexBlocks.at(j - 1).counts[i];
+            const int parent = j + (j & -j);
+            if (parent <= blockCount)
+                tree[parent] += tree[j];
+        }
+    }
+}
+
+/*!
+    Returns the number of items in \a group held by the index blocks before \a block.
+*/
+
+int QQmlListCompositor::indexCountBefore(int block, int group) const
+{
+    const int *tree = m_indexTree.constData() + group * (m_indexBlocks.count() + 1);
+    int count = 0;
+    for (; block > 0; block -= block & -block)
+        count += tree[block];
+    return count;
+}
+
+/*!
+    Returns the last index block in which the items of \a group before it number no more than
+    \a index.  This is the block holding the item at \a index, or the block count if \a index
+    is the count of \a group.
+*/
+
+int QQmlListCompositor::findIndexBlock(int group, int index) const
+{
+    const int blockCount = m_indexBlocks.count();
+    const int *tree = m_indexTree.constData() + group * (blockCount + 1);
+
+    int step = 1;
+    while (step * 2 <= blockCount)
+        step *= 2;
+
+    int block = 0;
+    for (; step > 0; step /= 2) {
+        if (block + step <= blockCount && tree[block + step] <= index) {
+            block += step;
+            index -= tree[block];
+        }
+    }
+    return block;
+}
+
+/*!
+    Returns the index block \a range belongs to.  That is the block started by the closest
+    preceding block start.
+*/
+
+int QQmlListCompositor::indexBlockOf(Range *range) const
+{
+    for (; range != &m_ranges; range = range->previous) {
+        const QHash<Range *, int>::const_iterator start = m_indexBlockStarts.constFind(range);
+        if (start != m_indexBlockStarts.constEnd())
+            return *start;
+    }
+    return 0;
+}
+
+/*!
+    Returns the index block of the range following \a range, or the last block if there is none.
+    Blocks after that of the last range may have been left empty by the removal of their ranges,
+    so they still need to be counted again.
+*/
+
+int QQmlListCompositor::indexBlockAfter(Range *range) const
+{
+    return range != &m_ranges && range->next != &m_ranges
+            ? indexBlockOf(range->next)
+            : m_indexBlocks.count() - 1;
+}
+
+/*!
+    Counts the ranges and items of the index blocks from \a firstBlock to \a lastBlock again,
+    and updates the index tree with the differences.
+
+    Returns true if any of the blocks has grown large enough to be split.
+*/
+
+bool QQmlListCompositor::recountIndexBlocks(int firstBlock, int lastBlock)
+{
+    if (firstBlock > lastBlock)
+        qSwap(firstBlock, lastBlock);
+
+    QVarLengthArray<IndexBlock, 8> counted;
+    for (int i = firstBlock; i <= lastBlock; ++i)
+        counted.append(IndexBlock(m_indexBlocks.at(i).start));
+
+    int block = firstBlock;
+    Range *range = m_indexBlocks.at(block).start;
+    while (!range && block < lastBlock)
+        range = m_indexBlocks.at(++block).start;
+    if (range == &m_ranges)
+        range = m_ranges.next;
+
+    for (; range && range != &m_ranges; range = range->next) {
+        const QHash<Range *, int>::const_iterator start = m_indexBlockStarts.constFind(range);
+        if (start != m_indexBlockStarts.constEnd()) {
+            if (*start > lastBlock)
+                break;
+            block = *start;
+        }
+        IndexBlock &counts = counted[block - firstBlock];
+        ++counts.rangeCount;
+        for (int i = 0; i < m_groupCount; ++i) {
+            if (range->inGroup(i))
+                counts.counts[i] += range->count;
+        }
+    }
+
+    const int blockCount = m_indexBlocks.count();
+    bool split = false;
+    for (int i = firstBlock; i <= lastBlock; ++i) {
+        IndexBlock &indexBlock = m_indexBlocks[i];
+        const IndexBlock &counts = counted.at(i - firstBlock);
+        for (int j = 0; j < m_groupCount; ++j) {
+            const int difference = counts.counts[j] - indexBlock.counts[j];
+            if (difference == 0)
+                continue;
+            int *tree = m_indexTree.data() + j * (blockCount + 1);
+            for (int k = i + 1; k <= blockCount; k += k & -k)
+                tree[k] += difference;
+        }
+        indexBlock = counts;
+        split |= indexBlock.rangeCount > 2 * IndexStride;
+    }
+    return split;
+}
+
+/*!
+    Splits index blocks which have grown to more than twice IndexStride ranges, and drops the
+    blocks left empty by the removal of their ranges.
+*/
+
+void QQmlListCompositor::splitIndexBlocks()
+{
+    QVector<IndexBlock> blocks;
+    blocks.reserve(m_rangeCount / IndexStride + 1);
+    for (const IndexBlock &indexBlock : qAsConst(m_indexBlocks)) {
+        if (!indexBlock.start) {
+            continue;
+        } else if (indexBlock.rangeCount <= 2 * IndexStride) {
+            blocks.append(indexBlock);
+            continue;
+        }
+        IndexBlock block(indexBlock.start);
+        Range *range = block.start == &m_ranges ? m_ranges.next : block.start;
+        for (int i = 0; i < indexBlock.rangeCount; ++i, range = range->next) {
+            if (block.rangeCount == IndexStride) {
+                blocks.append(block);
+                block = IndexBlock(range);
+            }
+            ++block.rangeCount;
+            for (int j = 0; j < m_groupCount; ++j) {
+                if (range->inGroup(j))
+                    block.counts[j] += range->count;
+            }
+        }
+        blocks.append(block);
+    }
+    m_indexBlocks = blocks;
+
+    m_indexBlockStarts.clear();
+    for (int i = 1; i < m_indexBlocks.count(); ++i)
+        m_indexBlockStarts.insert(m_indexBlocks.at(i).start, i);
+
+    buildIndexTree();
+}
+
+/*!
+    Updates the index after the ranges of the index blocks from \a firstBlock to \a lastBlock
+    have been modified.
+*/
+
+void QQmlListCompositor::updateIndex(int firstBlock, int lastBlock)
+{
+    if (m_indexValid)
+        balanceIndex(recountIndexBlocks(firstBlock, lastBlock));
+}
+
+/*!
+    Splits the index blocks that have grown too large if \a split is true.  If removals have
+    left many more blocks than the ranges need, the index is built again instead.
+*/
+
+void QQmlListCompositor::balanceIndex(bool split)
+{
+    if (m_indexBlocks.count() > 2 * (m_rangeCount / IndexStride + 1))
+        buildIndex();
+    else if (split)
+        splitIndexBlocks();
+}
+
 /*!
     Appends a range of \a count indexes starting at \a index from a \a list into a compositor
     with the given \a flags.
@@ -460,6 +776,7 @@ QQmlListCompositor::iterator QQmlListCompositor::insert(
         iterator before, void *list, int index, int count, uint flags, QVector<Insert> *inserts)
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< before << list << index << count << flags)
+    const int firstIndexBlock = m_indexValid ? indexBlockOf(before->previous) : 0;
     if (inserts) {
         inserts->append(Insert(before, count, flags & GroupMask));
     }
@@ -498,6 +815,8 @@ QQmlListCompositor::iterator QQmlListCompositor::insert(
     }
 
     m_end.incrementIndexes(count, flags);
+    if (m_indexValid)
+        updateIndex(firstIndexBlock, indexBlockAfter(*before));
     m_cacheIt = before;
     QT_QML_VERIFY_LISTCOMPOSITOR
     return before;
@@ -531,6 +850,8 @@ void QQmlListCompositor::setFlags(
     if (!flags || !count)
         return;
 
+    const int firstIndexBlock = m_indexValid ? indexBlockOf(from->previous) : 0;
+
     if (from != group) {
         // Skip to the next full range if the start one is not a member of the target group.
         from.incrementIndexes(from->count - from.offset);
@@ -609,6 +930,8 @@ void QQmlListCompositor::setFlags(
         from->previous->flags = from->flags;
         *from = erase(*from)->previous;
     }
+    if (m_indexValid)
+        updateIndex(firstIndexBlock, indexBlockAfter(*from));
     m_cacheIt = from;
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
@@ -641,6 +964,7 @@ void QQmlListCompositor::clearFlags(
     if (!flags || !count)
         return;
 
+    const int firstIndexBlock = m_indexValid ? indexBlockOf(from->previous) : 0;
     const bool clearCache = flags & CacheFlag;
 
     if (from != group) {
@@ -724,6 +1048,8 @@ void QQmlListCompositor::clearFlags(
         from->previous->flags = from->flags;
         *from = erase(*from)->previous;
     }
+    if (m_indexValid)
+        updateIndex(firstIndexBlock, indexBlockAfter(*from));
     m_cacheIt = from;
     QT_QML_VERIFY_LISTCOMPOSITOR
 }
@@ -780,6 +1106,7 @@ void QQmlListCompositor::move(
 
     // Find the position of the first item to move.
     iterator fromIt = find(fromGroup, from);
+    const int fromIndexBlock = m_indexValid ? indexBlockOf(fromIt->previous) : 0;
 
     if (fromIt != moveGroup) {
         // If the range at the from index doesn't contain items from the move group; skip
@@ -872,6 +1199,8 @@ void QQmlListCompositor::move(
         *fromIt = erase(*fromIt)->previous;
     }
 
+    const int fromIndexBlockEnd = m_indexValid ? indexBlockAfter(*fromIt) : 0;
+
     // Find the destination position of the move.
     insert_iterator toIt = fromIt;
     toIt.setGroup(toGroup);
@@ -879,6 +1208,16 @@ void QQmlListCompositor::move(
     const int difference = to - toIt.index[toGroup];
     toIt += difference;
 
+    // The moved ranges are inserted before the range at the destination, which may be split or
+    // grown, so the index needs updating from the block of the range before to the block of
+    // the one at the destination.
+    const int toIndexBlock = m_indexValid ? indexBlockOf(toIt->previous) : 0;
+    const int toIndexBlockEnd = !m_indexValid
+            ? 0
+            : *toIt != &m_ranges
+            ? indexBlockOf(*toIt)
+            : m_indexBlocks.count() - 1;
+
     // If the insert position is part way through a range; split it and move the iterator to the
     // start of the second range.
     if (toIt.offset > 0) {
@@ -929,6 +1268,14 @@ void QQmlListCompositor::move(
         delete range;
     }
 
+    if (m_indexValid) {
+        // Only the ranges around the source and the destination have changed, the ones in
+        // between are just shifted.
+        const bool splitTo = recountIndexBlocks(toIndexBlock, toIndexBlockEnd);
+        const bool splitFrom = recountIndexBlocks(fromIndexBlock, fromIndexBlockEnd);
+        balanceIndex(splitTo || splitFrom);
+    }
+
     m_cacheIt = toIt;
 
     QT_QML_VERIFY_LISTCOMPOSITOR
@@ -941,6 +1288,7 @@ void QQmlListCompositor::move(
 void QQmlListCompositor::clear()
 {
     QT_QML_TRACE_LISTCOMPOSITOR("")
+    invalidateIndex();
     for (Range *range = m_ranges.next; range != &m_ranges; range = erase(range)) {}
     m_end = iterator(m_ranges.next, 0, Default, m_groupCount);
     m_cacheIt = m_end;
@@ -953,6 +1301,7 @@ void QQmlListCompositor::listItemsInserted(
         const QVector<MovedFlags> *movedFlags)
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< list << insertions)
+    invalidateIndex();
     for (iterator it(m_ranges.next, 0, Default, m_groupCount); *it != &m_ranges; *it = it->next) {
         if (it->list != list || it->flags == CacheFlag) {
             // Skip ranges that don't reference list.
@@ -1076,6 +1425,7 @@ void QQmlListCompositor::listItemsRemoved(
         QVector<MovedFlags> *movedFlags)
 {
     QT_QML_TRACE_LISTCOMPOSITOR(<< list << *removals)
+    invalidateIndex();
 
     for (iterator it(m_ranges.next, 0, Default, m_groupCount); *it != &m_ranges; *it = it->next) {
         if (it->list != list || it->flags == CacheFlag) {
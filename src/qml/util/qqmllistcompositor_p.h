@@ -52,6 +52,7 @@
 //
 
 #include <QtCore/qglobal.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qvector.h>
 
 #include <private/qqmlchangeset_p.h>
@@ -265,17 +266,49 @@ public:
             QVector<QQmlChangeSet::Change> *inserts);
 
 private:
+    enum { IndexStride = 32 };
+
+    struct IndexBlock
+    {
+        IndexBlock(Range *start = 0) : start(start), rangeCount(0) {
+            for (int i = 0; i < MaximumGroupCount; ++i)
+                counts[i] = 0;
+        }
+
+        Range *start;
+        int rangeCount;
+        int counts[MaximumGroupCount];
+    };
+
     Range m_ranges;
     iterator m_end;
     iterator m_cacheIt;
+    QVector<IndexBlock> m_indexBlocks;
+    QVector<int> m_indexTree;
+    QHash<Range *, int> m_indexBlockStarts;
+    int m_rangeCount;
     int m_groupCount;
     int m_defaultFlags;
     int m_removeFlags;
     int m_moveId;
+    bool m_indexValid;
 
     inline Range *insert(Range *before, void *list, int index, int count, uint flags);
     inline Range *erase(Range *range);
 
+    iterator seekStart(Group group, int index);
+    void buildIndex();
+    void invalidateIndex();
+    void buildIndexTree();
+    int indexCountBefore(int block, int group) const;
+    int findIndexBlock(int group, int index) const;
+    int indexBlockOf(Range *range) const;
+    int indexBlockAfter(Range *range) const;
+    bool recountIndexBlocks(int firstBlock, int lastBlock);
+    void splitIndexBlocks();
+    void updateIndex(int firstBlock, int lastBlock);
+    void balanceIndex(bool split);
+
     struct MovedFlags
     {
         MovedFlags() {}
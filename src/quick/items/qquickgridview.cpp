@@ -182,7 +182,8 @@ public:
     bool addVisibleItems(qreal fillFrom, qreal fillTo, qreal bufferFrom, qreal bufferTo, bool doBuffer) override;
     bool removeNonVisibleItems(qreal bufferFrom, qreal bufferTo) override;
 
-    void removeItem(FxViewItem *item);
+    void removeItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
+    QQuickItemViewAttached *getAttachedObject(const QObject *object) const override;
 
     FxViewItem *newViewItem(int index, QQuickItem *item) override;
     void initializeViewItem(FxViewItem *item) override;
@@ -566,14 +567,19 @@ bool QQuickGridViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
     return changed;
 }
 
-void QQuickGridViewPrivate::removeItem(FxViewItem *item)
+QQuickItemViewAttached *QQuickGridViewPrivate::getAttachedObject(const QObject *object) const
+{
+    return static_cast<QQuickItemViewAttached *>(qmlAttachedPropertiesObject<QQuickGridView>(object, false));
+}
+
+void QQuickGridViewPrivate::removeItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (item->transitionScheduledOrRunning()) {
         qCDebug(lcItemViewDelegateLifecycle) << "\tnot releasing animating item:" << item->index << item->item->objectName();
         item->releaseAfterTransition = true;
         releasePendingTransition.append(item);
     } else {
-        releaseItem(item);
+        releaseItem(item, reusableFlag);
     }
 }
 
@@ -591,7 +597,7 @@ bool QQuickGridViewPrivate::removeNonVisibleItems(qreal bufferFrom, qreal buffer
         if (item->index != -1)
             visibleIndex++;
         visibleItems.removeFirst();
-        removeItem(item);
+        removeItem(item, reusableFlag());
         changed = true;
     }
     while (visibleItems.count() > 1
@@ -601,7 +607,7 @@ bool QQuickGridViewPrivate::removeNonVisibleItems(qreal bufferFrom, qreal buffer
             break;
         qCDebug(lcItemViewDelegateLifecycle) << "refill: remove last" << visibleIndex+visibleItems.count()-1;
         visibleItems.removeLast();
-        removeItem(item);
+        removeItem(item, reusableFlag());
         changed = true;
     }
 
@@ -1307,6 +1313,25 @@ void QQuickGridView::setHighlightFollowsCurrentItem(bool autoHighlight)
     The corresponding handler is \c onRemove.
 */
 
+/*!
+    \qmlattachedsignal QtQuick::GridView::pooled()
+    \since QtQuick 2.11
+    This attached signal is emitted after an item has been moved to the pool of
+    reusable delegates.  It is only emitted when \l reuseItems is \c true.
+
+    The corresponding handler is \c onPooled.
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::GridView::reused()
+    \since QtQuick 2.11
+    This attached signal is emitted after a pooled item has been bound to a new
+    index and is about to be shown again.  It is only emitted when \l reuseItems
+    is \c true.
+
+    The corresponding handler is \c onReused.
+*/
+
 
 /*!
   \qmlproperty model QtQuick::GridView::model
@@ -1524,6 +1549,25 @@ void QQuickGridView::setHighlightFollowsCurrentItem(bool autoHighlight)
     \sa {Flickable::}{interactive}
 */
 
+/*!
+    \qmlproperty bool QtQuick::GridView::reuseItems
+    \since QtQuick 2.11
+
+    This property enables reuse of delegate instances.
+
+    When \c true, delegates scrolled out of the view are not destroyed but kept
+    in a pool, and are bound to the data of another index when the view needs a
+    new delegate.  This avoids creating and destroying delegates while scrolling
+    through a long model.  Delegates which hold state that does not derive from
+    the model should reset it from the \l pooled() or \l reused() attached
+    signal handlers.
+
+    Delegates are only reused when the model is a QAbstractItemModel, a
+    \l ListModel or a list of plain values.
+
+    The default value is \c false.
+*/
+
 /*!
     \qmlproperty int QtQuick::GridView::cacheBuffer
     This property determines whether delegates are retained outside the
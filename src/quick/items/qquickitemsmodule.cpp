@@ -406,6 +406,18 @@ static void qt_quickitems_defineModule(const char *uri, int major, int minor)
 #if QT_CONFIG(quick_path)
     qmlRegisterType<QQuickPathAngleArc>(uri, 2, 11, "PathAngleArc");
 #endif
+#if QT_CONFIG(quick_listview)
+    qmlRegisterType<QQuickListView, 11>(uri, 2, 11, "ListView");
+#endif
+#if QT_CONFIG(quick_gridview)
+    qmlRegisterType<QQuickGridView, 11>(uri, 2, 11, "GridView");
+#endif
+#if QT_CONFIG(quick_pathview)
+    qmlRegisterType<QQuickPathView, 11>(uri, 2, 11, "PathView");
+#endif
+#if QT_CONFIG(quick_itemview)
+    qmlRegisterUncreatableType<QQuickItemView, 11>(uri, 2, 11, itemViewName, itemViewMessage);
+#endif
 }
 
 static void initResources()
@@ -299,6 +299,8 @@ void QQuickItemView::setModel(const QVariant &m)
         disconnect(d->model, SIGNAL(initItem(int,QObject*)), this, SLOT(initItem(int,QObject*)));
         disconnect(d->model, SIGNAL(createdItem(int,QObject*)), this, SLOT(createdItem(int,QObject*)));
         disconnect(d->model, SIGNAL(destroyingItem(QObject*)), this, SLOT(destroyingItem(QObject*)));
+        disconnect(d->model, SIGNAL(itemPooled(int,QObject*)), this, SLOT(onItemPooled(int,QObject*)));
+        disconnect(d->model, SIGNAL(itemReused(int,QObject*)), this, SLOT(onItemReused(int,QObject*)));
     }
 
     QQmlInstanceModel *oldModel = d->model;
@@ -334,6 +336,8 @@ void QQuickItemView::setModel(const QVariant &m)
         connect(d->model, SIGNAL(createdItem(int,QObject*)), this, SLOT(createdItem(int,QObject*)));
         connect(d->model, SIGNAL(initItem(int,QObject*)), this, SLOT(initItem(int,QObject*)));
         connect(d->model, SIGNAL(destroyingItem(QObject*)), this, SLOT(destroyingItem(QObject*)));
+        connect(d->model, SIGNAL(itemPooled(int,QObject*)), this, SLOT(onItemPooled(int,QObject*)));
+        connect(d->model, SIGNAL(itemReused(int,QObject*)), this, SLOT(onItemReused(int,QObject*)));
         if (isComponentComplete()) {
             d->updateSectionCriteria();
             d->refill();
@@ -499,6 +503,24 @@ void QQuickItemView::setCacheBuffer(int b)
     }
 }
 
+bool QQuickItemView::reuseItems() const
+{
+    Q_D(const QQuickItemView);
+    return d->reuseItems;
+}
+
+void QQuickItemView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickItemView);
+    if (d->reuseItems == reuse)
+        return;
+
+    d->reuseItems = reuse;
+    if (!reuse && d->model)
+        d->model->drainReusableItemsPool(0);
+    emit reuseItemsChanged();
+}
+
 int QQuickItemView::displayMarginBeginning() const
 {
     Q_D(const QQuickItemView);
@@ -1554,14 +1576,15 @@ QQuickItemViewPrivate::QQuickItemViewPrivate()
     , highlightMoveDuration(150)
     , headerComponent(0), header(0), footerComponent(0), footer(0)
     , transitioner(0)
-    , minExtent(0), maxExtent(0)
+    , minExtent(0), maxExtent(0), previousRefillFrom(0)
     , ownModel(false), wrap(false)
     , keyNavigationEnabled(true)
     , explicitKeyNavigationEnabled(false)
     , inLayout(false), inViewportMoved(false), forceLayout(false), currentIndexCleared(false)
     , haveHighlightRange(false), autoHighlight(true), highlightRangeStartValid(false), highlightRangeEndValid(false)
     , fillCacheBuffer(false), inRequest(false)
-    , runDelayedRemoveTransition(false), delegateValidated(false)
+    , runDelayedRemoveTransition(false), delegateValidated(false), reuseItems(false)
+    , movingBackwards(false)
 {
     bufferPause.addAnimationChangeListener(this, QAbstractAnimationJob::Completion);
     bufferPause.setLoopCount(1);
@@ -1806,6 +1829,11 @@ void QQuickItemViewPrivate::refill(qreal from, qreal to)
     qreal fillFrom = from;
     qreal fillTo = to;
 
+    if (from != previousRefillFrom) {
+        movingBackwards = from < previousRefillFrom;
+        previousRefillFrom = from;
+    }
+
     bool added = addVisibleItems(fillFrom, fillTo, bufferFrom, bufferTo, false);
     bool removed = removeNonVisibleItems(bufferFrom, bufferTo);
 
@@ -1819,10 +1847,25 @@ void QQuickItemViewPrivate::refill(qreal from, qreal to)
                 fillTo = bufferTo;
             if (bufferMode & BufferBefore)
                 fillFrom = bufferFrom;
-            added |= addVisibleItems(fillFrom, fillTo, bufferFrom, bufferTo, true);
+            // addVisibleItems() fills the buffer after the view before the one in
+            // front of it; when moving backwards, request the delegates which are
+            // about to scroll into view first.
+            if (movingBackwards && (bufferMode & BufferBefore)) {
+                added |= addVisibleItems(fillFrom, to, bufferFrom, bufferTo, true);
+                // Only one delegate is requested at a time.
+                if (requestedIndex == -1)
+                    added |= addVisibleItems(fillFrom, fillTo, bufferFrom, bufferTo, true);
+            } else {
+                added |= addVisibleItems(fillFrom, fillTo, bufferFrom, bufferTo, true);
+            }
         }
     }
 
+    // Delegates pooled by a previous refill which were not picked up again
+    // by this one are no longer needed.
+    if (reuseItems && model)
+        model->drainReusableItemsPool(1);
+
     if (added || removed) {
         markExtentsDirty();
         updateBeginningEnd();
@@ -2342,6 +2385,13 @@ FxViewItem *QQuickItemViewPrivate::createItem(int modelIndex, bool asynchronous)
                 QObject* delegate = q->delegate();
                 qmlWarning(delegate ? delegate : q) << QQuickItemView::tr("Delegate must be of Item type");
             }
+        } else if (asynchronous) {
+            // Buffered delegates the view is moving towards are incubated ahead of
+            // other asynchronous work, those it is moving away from after it.
+            const bool leading = (modelIndex < visibleIndex) == movingBackwards;
+            model->setIncubationPriority(modelIndex, leading
+                    ? QQmlInstanceModel::HighIncubationPriority
+                    : QQmlInstanceModel::LowIncubationPriority);
         }
         inRequest = false;
         return 0;
@@ -2402,7 +2452,23 @@ void QQuickItemView::destroyingItem(QObject *object)
     }
 }
 
-bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
+void QQuickItemView::onItemPooled(int modelIndex, QObject *object)
+{
+    Q_UNUSED(modelIndex);
+    Q_D(QQuickItemView);
+    if (QQuickItemViewAttached *attached = d->getAttachedObject(object))
+        emit attached->pooled();
+}
+
+void QQuickItemView::onItemReused(int modelIndex, QObject *object)
+{
+    Q_UNUSED(modelIndex);
+    Q_D(QQuickItemView);
+    if (QQuickItemViewAttached *attached = d->getAttachedObject(object))
+        emit attached->reused();
+}
+
+bool QQuickItemViewPrivate::releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     Q_Q(QQuickItemView);
     if (!item || !model)
@@ -2411,12 +2477,15 @@ bool QQuickItemViewPrivate::releaseItem(FxViewItem *item)
         trackedItem = 0;
     item->trackGeometry(false);
 
-    QQmlInstanceModel::ReleaseFlags flags = model->release(item->item);
+    QQmlInstanceModel::ReleaseFlags flags = model->release(item->item, reusableFlag);
     if (item->item) {
         if (flags == 0) {
             // item was not destroyed, and we no longer reference it.
             QQuickItemPrivate::get(item->item)->setCulled(true);
             unrequestedItems.insert(item->item, model->indexOf(item->item, q));
+        } else if (flags & QQmlInstanceModel::Pooled) {
+            // item is kept by the model until it is reused for another index.
+            QQuickItemPrivate::get(item->item)->setCulled(true);
         } else if (flags & QQmlInstanceModel::Destroyed) {
             item->item->setParentItem(0);
         }
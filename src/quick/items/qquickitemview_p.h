@@ -110,6 +110,8 @@ class Q_QUICK_PRIVATE_EXPORT QQuickItemView : public QQuickFlickable
     Q_PROPERTY(qreal preferredHighlightEnd READ preferredHighlightEnd WRITE setPreferredHighlightEnd NOTIFY preferredHighlightEndChanged RESET resetPreferredHighlightEnd)
     Q_PROPERTY(int highlightMoveDuration READ highlightMoveDuration WRITE setHighlightMoveDuration NOTIFY highlightMoveDurationChanged)
 
+    Q_PROPERTY(bool reuseItems READ reuseItems WRITE setReuseItems NOTIFY reuseItemsChanged REVISION 11)
+
 public:
     // this holds all layout enum values so they can be referred to by other enums
     // to ensure consistent values - e.g. QML references to GridView.TopToBottom flow
@@ -153,6 +155,9 @@ public:
     int cacheBuffer() const;
     void setCacheBuffer(int);
 
+    bool reuseItems() const;
+    void setReuseItems(bool reuse);
+
     int displayMarginBeginning() const;
     void setDisplayMarginBeginning(int);
 
@@ -249,6 +254,7 @@ Q_SIGNALS:
     void cacheBufferChanged();
     void displayMarginBeginningChanged();
     void displayMarginEndChanged();
+    Q_REVISION(11) void reuseItemsChanged();
 
     void layoutDirectionChanged();
     void effectiveLayoutDirectionChanged();
@@ -291,6 +297,8 @@ protected Q_SLOTS:
     virtual void initItem(int index, QObject *item);
     void modelUpdated(const QQmlChangeSet &changeSet, bool reset);
     void destroyingItem(QObject *item);
+    void onItemPooled(int modelIndex, QObject *object);
+    void onItemReused(int modelIndex, QObject *object);
     void animStopped();
     void trackedPositionChanged();
 
@@ -389,6 +397,8 @@ Q_SIGNALS:
 
     void add();
     void remove();
+    void pooled();
+    void reused();
 
     void sectionChanged();
     void prevSectionChanged();
@@ -213,7 +213,10 @@ public:
     void mirrorChange() override;
 
     FxViewItem *createItem(int modelIndex, bool asynchronous = false);
-    virtual bool releaseItem(FxViewItem *item);
+    virtual bool releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
+    virtual QQuickItemViewAttached *getAttachedObject(const QObject *object) const = 0;
+    QQmlInstanceModel::ReusableFlag reusableFlag() const {
+        return reuseItems ? QQmlInstanceModel::Reusable : QQmlInstanceModel::NotReusable; }
 
     QQuickItem *createHighlightItem() const;
     QQuickItem *createComponentItem(QQmlComponent *component, qreal zValue, bool createDefault = false) const;
@@ -330,6 +333,7 @@ public:
 
     mutable qreal minExtent;
     mutable qreal maxExtent;
+    qreal previousRefillFrom;
 #ifndef Q_OS_HTML5
     bool ownModel : 1;
     bool wrap : 1;
@@ -347,6 +351,8 @@ public:
     bool inRequest : 1;
     bool runDelayedRemoveTransition : 1;
     bool delegateValidated : 1;
+    bool reuseItems : 1;
+    bool movingBackwards : 1;
 #else
 
     bool ownModel = 1;
@@ -365,6 +371,8 @@ public:
     bool inRequest = 1;
     bool runDelayedRemoveTransition = 1;
     bool delegateValidated = 1;
+    bool reuseItems = 1;
+    bool movingBackwards = 1;
 #endif
 
 protected:
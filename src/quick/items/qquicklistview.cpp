@@ -87,11 +87,12 @@ public:
     bool removeNonVisibleItems(qreal bufferFrom, qreal bufferTo) override;
     void visibleItemsChanged() override;
 
-    void removeItem(FxViewItem *item);
+    void removeItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable);
 
     FxViewItem *newViewItem(int index, QQuickItem *item) override;
     void initializeViewItem(FxViewItem *item) override;
-    bool releaseItem(FxViewItem *item) override;
+    bool releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag = QQmlInstanceModel::NotReusable) override;
+    QQuickItemViewAttached *getAttachedObject(const QObject *object) const override;
     void repositionItemAt(FxViewItem *item, int index, qreal sizeBuffer) override;
     void repositionPackageItemAt(QQuickItem *item, int index) override;
     void resetFirstItemPosition(qreal pos = 0.0) override;
@@ -613,7 +614,7 @@ void QQuickListViewPrivate::initializeViewItem(FxViewItem *item)
     }
 }
 
-bool QQuickListViewPrivate::releaseItem(FxViewItem *item)
+bool QQuickListViewPrivate::releaseItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (!item || !model)
         return true;
@@ -621,7 +622,7 @@ bool QQuickListViewPrivate::releaseItem(FxViewItem *item)
     QPointer<QQuickItem> it = item->item;
     QQuickListViewAttached *att = static_cast<QQuickListViewAttached*>(item->attached);
 
-    bool released = QQuickItemViewPrivate::releaseItem(item);
+    bool released = QQuickItemViewPrivate::releaseItem(item, reusableFlag);
     if (released && it && att && att->m_sectionItem) {
         // We hold no more references to this item
         int i = 0;
@@ -706,7 +707,12 @@ bool QQuickListViewPrivate::addVisibleItems(qreal fillFrom, qreal fillTo, qreal
     return changed;
 }
 
-void QQuickListViewPrivate::removeItem(FxViewItem *item)
+QQuickItemViewAttached *QQuickListViewPrivate::getAttachedObject(const QObject *object) const
+{
+    return static_cast<QQuickItemViewAttached *>(qmlAttachedPropertiesObject<QQuickListView>(object, false));
+}
+
+void QQuickListViewPrivate::removeItem(FxViewItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (item->transitionScheduledOrRunning()) {
         qCDebug(lcItemViewDelegateLifecycle) << "\tnot releasing animating item" << item->index << (QObject *)(item->item);
@@ -714,7 +720,7 @@ void QQuickListViewPrivate::removeItem(FxViewItem *item)
         releasePendingTransition.append(item);
     } else {
         qCDebug(lcItemViewDelegateLifecycle) << "\treleasing stationary item" << item->index << (QObject *)(item->item);
-        releaseItem(item);
+        releaseItem(item, reusableFlag);
     }
 }
 
@@ -740,7 +746,7 @@ bool QQuickListViewPrivate::removeNonVisibleItems(qreal bufferFrom, qreal buffer
                 if (item->index != -1)
                     visibleIndex++;
                 visibleItems.removeAt(index);
-                removeItem(item);
+                removeItem(item, reusableFlag());
                 if (index == 0)
                     break;
                 item = visibleItems.at(--index);
@@ -756,7 +762,7 @@ bool QQuickListViewPrivate::removeNonVisibleItems(qreal bufferFrom, qreal buffer
             break;
         qCDebug(lcItemViewDelegateLifecycle) << "refill: remove last" << visibleIndex+visibleItems.count()-1 << item->position() << (QObject *)(item->item);
         visibleItems.removeLast();
-        removeItem(item);
+        removeItem(item, reusableFlag());
         changed = true;
     }
 
@@ -1972,6 +1978,25 @@ QQuickListView::~QQuickListView()
     The corresponding handler is \c onRemove.
 */
 
+/*!
+    \qmlattachedsignal QtQuick::ListView::pooled()
+    \since QtQuick 2.11
+    This attached signal is emitted after an item has been moved to the pool of
+    reusable delegates.  It is only emitted when \l reuseItems is \c true.
+
+    The corresponding handler is \c onPooled.
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::ListView::reused()
+    \since QtQuick 2.11
+    This attached signal is emitted after a pooled item has been bound to a new
+    index and is about to be shown again.  It is only emitted when \l reuseItems
+    is \c true.
+
+    The corresponding handler is \c onReused.
+*/
+
 /*!
     \qmlproperty model QtQuick::ListView::model
     This property holds the model providing data for the list.
@@ -2278,6 +2303,25 @@ void QQuickListView::setOrientation(QQuickListView::Orientation orientation)
 */
 
 
+/*!
+    \qmlproperty bool QtQuick::ListView::reuseItems
+    \since QtQuick 2.11
+
+    This property enables reuse of delegate instances.
+
+    When \c true, delegates scrolled out of the view are not destroyed but kept
+    in a pool, and are bound to the data of another index when the view needs a
+    new delegate.  This avoids creating and destroying delegates while scrolling
+    through a long model.  Delegates which hold state that does not derive from
+    the model should reset it from the \l pooled() or \l reused() attached
+    signal handlers.
+
+    Delegates are only reused when the model is a QAbstractItemModel, a
+    \l ListModel or a list of plain values.
+
+    The default value is \c false.
+*/
+
 /*!
     \qmlproperty int QtQuick::ListView::cacheBuffer
     This property determines whether delegates are retained outside the
@@ -96,6 +96,7 @@ QQuickPathViewPrivate::QQuickPathViewPrivate()
     , autoHighlight(true), highlightUp(false), layoutScheduled(false)
     , moving(false), flicking(false), dragging(false), inRequest(false), delegateValidated(false)
     , inRefill(false)
+    , reuseItems(false)
     , dragMargin(0), deceleration(100), maximumFlickVelocity(QML_FLICK_DEFAULTMAXVELOCITY)
     , moveOffset(this, &QQuickPathViewPrivate::setAdjustedOffset), flickDuration(0)
     , pathItems(-1), requestedIndex(-1), cacheSize(0), requestedZ(0)
@@ -195,18 +196,20 @@ void QQuickPathView::initItem(int index, QObject *object)
     }
 }
 
-void QQuickPathViewPrivate::releaseItem(QQuickItem *item)
+void QQuickPathViewPrivate::releaseItem(QQuickItem *item, QQmlInstanceModel::ReusableFlag reusableFlag)
 {
     if (!item || !model)
         return;
     qCDebug(lcItemViewDelegateLifecycle) << "release" << item;
     QQuickItemPrivate *itemPrivate = QQuickItemPrivate::get(item);
     itemPrivate->removeItemChangeListener(this, QQuickItemPrivate::Geometry);
-    QQmlInstanceModel::ReleaseFlags flags = model->release(item);
-    if (!flags) {
+    QQmlInstanceModel::ReleaseFlags flags = model->release(item, reusableFlag);
+    if (!flags || (flags & QQmlInstanceModel::Pooled)) {
         // item was not destroyed, and we no longer reference it.
         if (QQuickPathViewAttached *att = attached(item))
             att->setOnPath(false);
+        if (flags & QQmlInstanceModel::Pooled)
+            itemPrivate->setCulled(true);
     } else if (flags & QQmlInstanceModel::Destroyed) {
         // but we still reference it
         item->setParentItem(nullptr);
@@ -579,6 +582,25 @@ QQuickPathView::~QQuickPathView()
     It is attached to each instance of the delegate.
 */
 
+/*!
+    \qmlattachedsignal QtQuick::PathView::pooled()
+    \since QtQuick 2.11
+    This attached signal is emitted after an item has been moved to the pool of
+    reusable delegates.  It is only emitted when \l reuseItems is \c true.
+
+    The corresponding handler is \c onPooled.
+*/
+
+/*!
+    \qmlattachedsignal QtQuick::PathView::reused()
+    \since QtQuick 2.11
+    This attached signal is emitted after a pooled item has been bound to a new
+    index and is about to be shown again.  It is only emitted when \l reuseItems
+    is \c true.
+
+    The corresponding handler is \c onReused.
+*/
+
 /*!
     \qmlattachedproperty bool QtQuick::PathView::isCurrentItem
     This attached property is true if this delegate is the current item; otherwise false.
@@ -625,6 +647,10 @@ void QQuickPathView::setModel(const QVariant &m)
                              this, QQuickPathView, SLOT(createdItem(int,QObject*)));
         qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(initItem(int,QObject*)),
                              this, QQuickPathView, SLOT(initItem(int,QObject*)));
+        qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(itemPooled(int,QObject*)),
+                             this, QQuickPathView, SLOT(onItemPooled(int,QObject*)));
+        qmlobject_disconnect(d->model, QQmlInstanceModel, SIGNAL(itemReused(int,QObject*)),
+                             this, QQuickPathView, SLOT(onItemReused(int,QObject*)));
         d->clear();
     }
 
@@ -656,6 +682,10 @@ void QQuickPathView::setModel(const QVariant &m)
                           this, QQuickPathView, SLOT(createdItem(int,QObject*)));
         qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(initItem(int,QObject*)),
                           this, QQuickPathView, SLOT(initItem(int,QObject*)));
+        qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(itemPooled(int,QObject*)),
+                          this, QQuickPathView, SLOT(onItemPooled(int,QObject*)));
+        qmlobject_connect(d->model, QQmlInstanceModel, SIGNAL(itemReused(int,QObject*)),
+                          this, QQuickPathView, SLOT(onItemReused(int,QObject*)));
         d->modelCount = d->model->count();
     }
     if (isComponentComplete()) {
@@ -1342,6 +1372,40 @@ void QQuickPathView::setCacheItemCount(int i)
     emit cacheItemCountChanged();
 }
 
+/*!
+    \qmlproperty bool QtQuick::PathView::reuseItems
+    \since QtQuick 2.11
+
+    This property enables reuse of delegate instances.
+
+    When \c true, delegates which leave the path and the cache are not
+    destroyed but kept in a pool, and are bound to the data of another index
+    when the view needs a new delegate.  Delegates which hold state that does
+    not derive from the model should reset it from the \l pooled() or
+    \l reused() attached signal handlers.
+
+    The default value is \c false.
+
+    \sa cacheItemCount
+*/
+bool QQuickPathView::reuseItems() const
+{
+    Q_D(const QQuickPathView);
+    return d->reuseItems;
+}
+
+void QQuickPathView::setReuseItems(bool reuse)
+{
+    Q_D(QQuickPathView);
+    if (d->reuseItems == reuse)
+        return;
+
+    d->reuseItems = reuse;
+    if (!reuse && d->model)
+        d->model->drainReusableItemsPool(0);
+    emit reuseItemsChanged();
+}
+
 /*!
     \qmlproperty enumeration QtQuick::PathView::snapMode
 
@@ -1974,7 +2038,7 @@ void QQuickPathView::refill()
                 att->setOnPath(pos < 1.0);
             if (!d->isInBound(pos, d->mappedRange - d->mappedCache, 1.0 + d->mappedCache)) {
                 qCDebug(lcItemViewDelegateLifecycle) << "release" << idx << "@" << pos << ", !isInBound: lower" << (d->mappedRange - d->mappedCache) << "upper" << (1.0 + d->mappedCache);
-                d->releaseItem(item);
+                d->releaseItem(item, d->reuseItems ? QQmlInstanceModel::Reusable : QQmlInstanceModel::NotReusable);
                 it = d->items.erase(it);
             } else {
                 ++it;
@@ -2160,6 +2224,11 @@ void QQuickPathView::refill()
         d->releaseItem(item);
     d->itemCache.clear();
 
+    // Delegates pooled by a previous refill which were not picked up again
+    // by this one are no longer needed.
+    if (d->reuseItems && d->model)
+        d->model->drainReusableItemsPool(1);
+
     d->inRefill = false;
     if (currentChanged)
         emit currentItemChanged();
@@ -2269,6 +2338,20 @@ void QQuickPathView::destroyingItem(QObject *item)
     Q_UNUSED(item);
 }
 
+void QQuickPathView::onItemPooled(int modelIndex, QObject *object)
+{
+    Q_UNUSED(modelIndex);
+    if (QQuickPathViewAttached *att = static_cast<QQuickPathViewAttached *>(qmlAttachedPropertiesObject<QQuickPathView>(object, false)))
+        emit att->pooled();
+}
+
+void QQuickPathView::onItemReused(int modelIndex, QObject *object)
+{
+    Q_UNUSED(modelIndex);
+    if (QQuickPathViewAttached *att = static_cast<QQuickPathViewAttached *>(qmlAttachedPropertiesObject<QQuickPathView>(object, false)))
+        emit att->reused();
+}
+
 void QQuickPathView::ticked()
 {
     Q_D(QQuickPathView);
@@ -100,6 +100,7 @@ class Q_QUICK_PRIVATE_EXPORT QQuickPathView : public QQuickItem
     Q_PROPERTY(MovementDirection movementDirection READ movementDirection WRITE setMovementDirection NOTIFY movementDirectionChanged REVISION 7)
 
     Q_PROPERTY(int cacheItemCount READ cacheItemCount WRITE setCacheItemCount NOTIFY cacheItemCountChanged)
+    Q_PROPERTY(bool reuseItems READ reuseItems WRITE setReuseItems NOTIFY reuseItemsChanged REVISION 11)
 
 public:
     QQuickPathView(QQuickItem *parent = nullptr);
@@ -165,6 +166,9 @@ public:
     int cacheItemCount() const;
     void setCacheItemCount(int);
 
+    bool reuseItems() const;
+    void setReuseItems(bool reuse);
+
     enum SnapMode { NoSnap, SnapToItem, SnapOneItem };
     Q_ENUM(SnapMode)
     SnapMode snapMode() const;
@@ -219,6 +223,7 @@ Q_SIGNALS:
     void dragEnded();
     void snapModeChanged();
     void cacheItemCountChanged();
+    Q_REVISION(11) void reuseItemsChanged();
 
 protected:
     void updatePolish() override;
@@ -238,6 +243,8 @@ private Q_SLOTS:
     void createdItem(int index, QObject *item);
     void initItem(int index, QObject *item);
     void destroyingItem(QObject *item);
+    void onItemPooled(int modelIndex, QObject *object);
+    void onItemReused(int modelIndex, QObject *object);
     void pathUpdated();
 
 private:
@@ -284,6 +291,8 @@ public:
 Q_SIGNALS:
     void currentItemChanged();
     void pathChanged();
+    void pooled();
+    void reused();
 
 private:
     friend class QQuickPathViewPrivate;
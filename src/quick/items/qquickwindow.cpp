@@ -67,11 +67,13 @@
 #include <QtCore/qabstractanimation.h>
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QRunnable>
+#include <QtCore/qelapsedtimer.h>
 #include <QtQml/qqmlincubator.h>
 
 #include <QtQuick/private/qquickpixmapcache_p.h>
 
 #include <private/qqmlmemoryprofiler_p.h>
+#include <private/qqmlengine_p.h>
 #include <private/qqmldebugserviceinterfaces_p.h>
 #include <private/qqmldebugconnector_p.h>
 #if QT_CONFIG(opengl)
@@ -118,17 +120,19 @@ class QQuickWindowIncubationController : public QObject, public QQmlIncubationCo
     Q_OBJECT
 
 public:
-    QQuickWindowIncubationController(QSGRenderLoop *loop)
+    QQuickWindowIncubationController(QSGRenderLoop *loop, QQuickWindow *window)
         : m_renderLoop(loop), m_timer(0)
     {
         // Allow incubation for 1/3 of a frame.
-        m_incubation_time = qMax(1, int(1000 / QGuiApplication::primaryScreen()->refreshRate()) / 3);
+        m_frame_time = qMax(1, int(1000 / QGuiApplication::primaryScreen()->refreshRate()));
+        m_incubation_time = qMax(1, m_frame_time / 3);
 
         QAnimationDriver *animationDriver = m_renderLoop->animationDriver();
         if (animationDriver) {
             connect(animationDriver, SIGNAL(stopped()), this, SLOT(animationStopped()));
             connect(m_renderLoop, SIGNAL(timeToIncubate()), this, SLOT(incubate()));
         }
+        connect(window, SIGNAL(afterAnimating()), this, SLOT(frameStarted()));
     }
 
 protected:
@@ -151,7 +155,7 @@ public slots:
     void incubate() {
         if (incubatingObjectCount()) {
             if (m_renderLoop->interleaveIncubation()) {
-                incubateFor(m_incubation_time);
+                incubateFor(interleavedIncubationTime());
             } else {
                 incubateFor(m_incubation_time * 2);
                 if (incubatingObjectCount())
@@ -162,6 +166,8 @@ public slots:
 
     void animationStopped() { incubate(); }
 
+    void frameStarted() { m_frame_timer.start(); }
+
 protected:
     void incubatingObjectCountChanged(int count) override
     {
@@ -170,7 +176,19 @@ protected:
     }
 
 private:
+    // Never exceed the usual slice, but don't let incubation push a frame which
+    // has already used most of its time past the next vsync either.
+    int interleavedIncubationTime() const
+    {
+        if (!m_frame_timer.isValid())
+            return m_incubation_time;
+        const int remaining = m_frame_time - int(m_frame_timer.elapsed());
+        return qBound(1, remaining, m_incubation_time);
+    }
+
     QSGRenderLoop *m_renderLoop;
+    QElapsedTimer m_frame_timer;
+    int m_frame_time;
     int m_incubation_time;
     int m_timer;
 };
@@ -285,6 +303,19 @@ static bool transformDirtyOnItemOrAncestor(const QQuickItem *item)
 
 void QQuickWindowPrivate::polishItems()
 {
+    QElapsedTimer statisticsTimer;
+    const bool recordStatistics = isRecordingFrameStatistics();
+    if (recordStatistics)
+        statisticsTimer.start();
+
+    // Settle batched binding updates first, so that items are polished with their final
+    // values rather than polished again once the pending bindings have run.
+    QQmlEngine *engine = qmlEngine(q_func());
+    if (!engine && !itemsToPolish.isEmpty())
+        engine = qmlEngine(itemsToPolish.last());
+    if (engine)
+        QQmlEnginePrivate::get(engine)->flushPendingBindingUpdates();
+
     // An item can trigger polish on another item, or itself for that matter,
     // during its updatePolish() call. Because of this, we cannot simply
     // iterate through the set, we must continue pulling items out until it
@@ -315,6 +346,9 @@ void QQuickWindowPrivate::polishItems()
             updateFocusItemTransform();
     }
 #endif
+
+    if (recordStatistics)
+        guiFrameStatistics.polishTime += statisticsTimer.nsecsElapsed();
 }
 
 /*!
@@ -411,6 +445,11 @@ void QQuickWindowPrivate::syncSceneGraph()
     QML_MEMORY_SCOPE_STRING("SceneGraph");
     Q_Q(QQuickWindow);
 
+    QElapsedTimer statisticsTimer;
+    const bool recordStatistics = isRecordingFrameStatistics();
+    if (recordStatistics)
+        statisticsTimer.start();
+
     animationController->beforeNodeSync();
 
     emit q->beforeSynchronizing();
@@ -439,6 +478,15 @@ void QQuickWindowPrivate::syncSceneGraph()
 
     emit q->afterSynchronizing();
     runAndClearJobs(&afterSynchronizingJobs);
+
+    if (recordStatistics) {
+        // The GUI thread is blocked while we sync, so this is the one place
+        // where its part of the frame can be picked up by the render thread.
+        renderFrameStatistics.polishTime += guiFrameStatistics.polishTime;
+        renderFrameStatistics.animationTime += guiFrameStatistics.animationTime;
+        renderFrameStatistics.syncTime += statisticsTimer.nsecsElapsed();
+        guiFrameStatistics = QQuickFrameStatisticsData();
+    }
 }
 
 void QQuickWindowPrivate::renderSceneGraph(const QSize &size)
@@ -448,9 +496,20 @@ void QQuickWindowPrivate::renderSceneGraph(const QSize &size)
     if (!renderer)
         return;
 
+    QElapsedTimer statisticsTimer;
+    const bool recordStatistics = isRecordingFrameStatistics();
+    if (recordStatistics)
+        statisticsTimer.start();
+
     animationController->advance();
+
+    if (recordStatistics)
+        renderFrameStatistics.animationTime += statisticsTimer.restart();
+    renderer->setRecordStatistics(recordStatistics);
+
     emit q->beforeRendering();
     runAndClearJobs(&beforeRenderingJobs);
+    bool renderedScene = false;
     if (!customRenderStage || !customRenderStage->render()) {
         int fboId = 0;
         const qreal devicePixelRatio = q->effectiveDevicePixelRatio();
@@ -475,9 +534,56 @@ void QQuickWindowPrivate::renderSceneGraph(const QSize &size)
         }
 
         context->renderNextFrame(renderer, fboId);
+        renderedScene = true;
     }
     emit q->afterRendering();
     runAndClearJobs(&afterRenderingJobs);
+
+    if (recordStatistics) {
+        renderFrameStatistics.renderTime += statisticsTimer.nsecsElapsed();
+        // The renderer's statistics are stale when a custom render stage
+        // rendered the frame instead.
+        if (renderedScene) {
+            const QSGRenderer::Statistics &stats = renderer->statistics();
+            renderFrameStatistics.renderPreprocessTime += stats.preprocessTime;
+            renderFrameStatistics.renderUpdateTime += stats.updateTime;
+            renderFrameStatistics.renderBindTime += stats.bindTime;
+            renderFrameStatistics.renderRenderTime += stats.renderTime;
+            renderFrameStatistics.nodeCount = stats.nodeCount;
+            renderFrameStatistics.batchCount = stats.batchCount;
+            renderFrameStatistics.uploadCount += stats.uploadCount;
+        }
+        frameStatisticsSwapTimer.start();
+    }
+}
+
+/*
+    Called from fireFrameSwapped() on the render thread once a frame has been
+    presented. Completes the statistics gathered for the frame and stores them
+    in the ring.
+*/
+void QQuickWindowPrivate::recordFrameStatistics()
+{
+    QQuickFrameStatisticsData stats = renderFrameStatistics;
+    renderFrameStatistics = QQuickFrameStatisticsData();
+    if (frameStatisticsSwapTimer.isValid()) {
+        stats.swapTime = frameStatisticsSwapTimer.nsecsElapsed();
+        frameStatisticsSwapTimer.invalidate();
+    }
+
+    QMutexLocker locker(&frameStatisticsMutex);
+    const int capacity = frameStatisticsCapacity.load();
+    if (capacity <= 0)
+        return;
+    // setFrameStatisticsCapacity() resets the ring, so it never holds more
+    // than capacity frames.
+    stats.frameNumber = frameStatisticsFrameNumber++;
+    if (frameStatisticsRing.size() < capacity) {
+        frameStatisticsRing.append(stats);
+    } else {
+        frameStatisticsRing[frameStatisticsNext] = stats;
+        frameStatisticsNext = (frameStatisticsNext + 1) % capacity;
+    }
 }
 
 QQuickWindowPrivate::QQuickWindowPrivate()
@@ -513,6 +619,9 @@ QQuickWindowPrivate::QQuickWindowPrivate()
     , renderTargetId(0)
     , vaoHelper(0)
     , incubationController(0)
+    , frameStatisticsCapacity(0)
+    , frameStatisticsNext(0)
+    , frameStatisticsFrameNumber(0)
 {
 #if QT_CONFIG(draganddrop)
     dragGrabber = new QQuickDragGrabber;
@@ -3837,7 +3946,7 @@ QQmlIncubationController *QQuickWindow::incubationController() const
         return 0; // TODO: make sure that this is safe
 
     if (!d->incubationController)
-        d->incubationController = new QQuickWindowIncubationController(d->windowManager);
+        d->incubationController = new QQuickWindowIncubationController(d->windowManager, const_cast<QQuickWindow *>(this));
     return d->incubationController;
 }
 
@@ -4946,6 +5055,232 @@ void QQuickWindow::setTextRenderType(QQuickWindow::TextRenderType renderType)
     QQuickWindowPrivate::textRenderType = renderType;
 }
 
+/*!
+    \class QQuickFrameStatistics
+    \inmodule QtQuick
+    \since 5.11
+
+    \brief The QQuickFrameStatistics class describes the work done for one
+    frame of a QQuickWindow.
+
+    All times are in nanoseconds. Values that do not apply to the render
+    loop or scene graph backend in use are zero.
+
+    \sa QQuickWindow::frameStatistics()
+ */
+
+/*!
+    Constructs statistics of an empty frame, with all values zero.
+ */
+QQuickFrameStatistics::QQuickFrameStatistics()
+    : d(new QQuickFrameStatisticsData)
+{
+}
+
+/*!
+    \internal
+ */
+QQuickFrameStatistics::QQuickFrameStatistics(const QQuickFrameStatisticsData &data)
+    : d(new QQuickFrameStatisticsData(data))
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+ */
+QQuickFrameStatistics::QQuickFrameStatistics(const QQuickFrameStatistics &other)
+    : d(new QQuickFrameStatisticsData(*other.d))
+{
+}
+
+/*!
+    Assigns \a other to these statistics.
+ */
+QQuickFrameStatistics &QQuickFrameStatistics::operator=(const QQuickFrameStatistics &other)
+{
+    *d = *other.d;
+    return *this;
+}
+
+/*!
+    Destroys the statistics.
+ */
+QQuickFrameStatistics::~QQuickFrameStatistics()
+{
+    delete d;
+}
+
+/*!
+    Returns the number of the frame, counted from when recording was enabled.
+ */
+qint64 QQuickFrameStatistics::frameNumber() const
+{
+    return d->frameNumber;
+}
+
+/*!
+    Returns the time spent polishing items.
+ */
+qint64 QQuickFrameStatistics::polishTime() const
+{
+    return d->polishTime;
+}
+
+/*!
+    Returns the time spent advancing animations and animators.
+ */
+qint64 QQuickFrameStatistics::animationTime() const
+{
+    return d->animationTime;
+}
+
+/*!
+    Returns the time spent synchronizing the items with the scene graph.
+ */
+qint64 QQuickFrameStatistics::syncTime() const
+{
+    return d->syncTime;
+}
+
+/*!
+    Returns the time spent rendering the scene graph. The default OpenGL
+    renderer splits this further into renderPreprocessTime(),
+    renderUpdateTime(), renderBindTime() and renderRenderTime().
+ */
+qint64 QQuickFrameStatistics::renderTime() const
+{
+    return d->renderTime;
+}
+
+/*!
+    Returns the part of renderTime() spent preprocessing nodes.
+ */
+qint64 QQuickFrameStatistics::renderPreprocessTime() const
+{
+    return d->renderPreprocessTime;
+}
+
+/*!
+    Returns the part of renderTime() spent updating the renderer's state
+    from the scene graph.
+ */
+qint64 QQuickFrameStatistics::renderUpdateTime() const
+{
+    return d->renderUpdateTime;
+}
+
+/*!
+    Returns the part of renderTime() spent binding the render target.
+ */
+qint64 QQuickFrameStatistics::renderBindTime() const
+{
+    return d->renderBindTime;
+}
+
+/*!
+    Returns the part of renderTime() spent issuing draw calls.
+ */
+qint64 QQuickFrameStatistics::renderRenderTime() const
+{
+    return d->renderRenderTime;
+}
+
+/*!
+    Returns the time between the end of rendering and the frame being swapped.
+ */
+qint64 QQuickFrameStatistics::swapTime() const
+{
+    return d->swapTime;
+}
+
+/*!
+    Returns the number of nodes rendered.
+ */
+int QQuickFrameStatistics::nodeCount() const
+{
+    return d->nodeCount;
+}
+
+/*!
+    Returns the number of batches rendered. With the software backend, which
+    does not batch, this is the number of nodes painted.
+ */
+int QQuickFrameStatistics::batchCount() const
+{
+    return d->batchCount;
+}
+
+/*!
+    Returns the number of vertex buffer uploads. Always zero with the
+    software backend.
+ */
+int QQuickFrameStatistics::uploadCount() const
+{
+    return d->uploadCount;
+}
+
+/*!
+    \since 5.11
+
+    Enables recording of per-frame statistics, keeping the statistics of the
+    last \a frames frames. A value of 0, which is the default, disables the
+    recording.
+
+    Frames are recorded when they have been swapped, so frames rendered
+    through QQuickRenderControl are not included. Changing the capacity
+    discards the statistics recorded so far.
+
+    \sa frameStatistics(), frameStatisticsCapacity()
+ */
+void QQuickWindow::setFrameStatisticsCapacity(int frames)
+{
+    Q_D(QQuickWindow);
+    frames = qMax(0, frames);
+    QMutexLocker locker(&d->frameStatisticsMutex);
+    if (d->frameStatisticsCapacity.load() == frames)
+        return;
+    d->frameStatisticsCapacity.store(frames);
+    d->frameStatisticsRing.clear();
+    d->frameStatisticsRing.reserve(frames);
+    d->frameStatisticsNext = 0;
+    d->frameStatisticsFrameNumber = 0;
+}
+
+/*!
+    \since 5.11
+
+    Returns the number of frames for which statistics are kept.
+
+    \sa setFrameStatisticsCapacity()
+ */
+int QQuickWindow::frameStatisticsCapacity() const
+{
+    Q_D(const QQuickWindow);
+    return d->frameStatisticsCapacity.load();
+}
+
+/*!
+    \since 5.11
+
+    Returns the statistics of the most recently swapped frames, oldest first.
+    At most frameStatisticsCapacity() frames are returned.
+
+    This function can be called from any thread.
+
+    \sa setFrameStatisticsCapacity()
+ */
+QVector<QQuickFrameStatistics> QQuickWindow::frameStatistics() const
+{
+    Q_D(const QQuickWindow);
+    QMutexLocker locker(&d->frameStatisticsMutex);
+    QVector<QQuickFrameStatistics> result;
+    const int count = d->frameStatisticsRing.size();
+    result.reserve(count);
+    for (int i = 0; i < count; ++i)
+        result.append(QQuickFrameStatistics(d->frameStatisticsRing.at((d->frameStatisticsNext + i) % count)));
+    return result;
+}
+
 #include "moc_qquickwindow.cpp"
 
 QT_END_NAMESPACE
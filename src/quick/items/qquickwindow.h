@@ -43,6 +43,7 @@
 #include <QtQuick/qtquickglobal.h>
 #include <QtQuick/qsgrendererinterface.h>
 #include <QtCore/qmetatype.h>
+#include <QtCore/qvector.h>
 #include <QtGui/qopengl.h>
 #include <QtGui/qwindow.h>
 #include <QtGui/qevent.h>
@@ -66,6 +67,36 @@ class QQuickRenderControl;
 class QSGRectangleNode;
 class QSGImageNode;
 class QSGNinePatchNode;
+class QQuickFrameStatisticsData;
+
+class Q_QUICK_EXPORT QQuickFrameStatistics
+{
+public:
+    QQuickFrameStatistics();
+    QQuickFrameStatistics(const QQuickFrameStatistics &other);
+    QQuickFrameStatistics &operator=(const QQuickFrameStatistics &other);
+    ~QQuickFrameStatistics();
+
+    qint64 frameNumber() const;
+    qint64 polishTime() const;
+    qint64 animationTime() const;
+    qint64 syncTime() const;
+    qint64 renderTime() const;
+    qint64 renderPreprocessTime() const;
+    qint64 renderUpdateTime() const;
+    qint64 renderBindTime() const;
+    qint64 renderRenderTime() const;
+    qint64 swapTime() const;
+    int nodeCount() const;
+    int batchCount() const;
+    int uploadCount() const;
+
+private:
+    explicit QQuickFrameStatistics(const QQuickFrameStatisticsData &data);
+    friend class QQuickWindow;
+
+    QQuickFrameStatisticsData *d;
+};
 
 class Q_QUICK_EXPORT QQuickWindow : public QWindow
 {
@@ -180,6 +211,10 @@ public:
     static TextRenderType textRenderType();
     static void setTextRenderType(TextRenderType renderType);
 
+    void setFrameStatisticsCapacity(int frames);
+    int frameStatisticsCapacity() const;
+    QVector<QQuickFrameStatistics> frameStatistics() const;
+
 Q_SIGNALS:
     void frameSwapped();
     Q_REVISION(2) void openglContextCreated(QOpenGLContext *context);
@@ -242,6 +277,8 @@ private:
     Q_DISABLE_COPY(QQuickWindow)
 };
 
+Q_DECLARE_TYPEINFO(QQuickFrameStatistics, Q_MOVABLE_TYPE);
+
 QT_END_NAMESPACE
 
 Q_DECLARE_METATYPE(QQuickWindow *)
@@ -59,6 +59,8 @@
 
 #include <QtCore/qthread.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qwaitcondition.h>
 #include <QtCore/qrunnable.h>
 #include <private/qwindow_p.h>
@@ -94,6 +96,27 @@ public Q_SLOTS:
     void setHeight(int h) {QQuickItem::setHeight(qreal(h));}
 };
 
+// The data behind QQuickFrameStatistics, accumulated while a frame is produced
+class QQuickFrameStatisticsData
+{
+public:
+    qint64 frameNumber = 0;
+    qint64 polishTime = 0;
+    qint64 animationTime = 0;
+    qint64 syncTime = 0;
+    qint64 renderTime = 0;
+    qint64 renderPreprocessTime = 0;
+    qint64 renderUpdateTime = 0;
+    qint64 renderBindTime = 0;
+    qint64 renderRenderTime = 0;
+    qint64 swapTime = 0;
+    int nodeCount = 0;
+    int batchCount = 0;
+    int uploadCount = 0;
+};
+
+Q_DECLARE_TYPEINFO(QQuickFrameStatisticsData, Q_PRIMITIVE_TYPE);
+
 class Q_QUICK_PRIVATE_EXPORT QQuickCustomRenderStage
 {
 public:
@@ -241,7 +264,11 @@ public:
     void updateEffectiveOpacityRoot(QQuickItem *, qreal);
     void updateDirtyNode(QQuickItem *);
 
-    void fireFrameSwapped() { Q_EMIT q_func()->frameSwapped(); }
+    void fireFrameSwapped() {
+        if (isRecordingFrameStatistics())
+            recordFrameStatistics();
+        Q_EMIT q_func()->frameSwapped();
+    }
     void fireOpenGLContextCreated(QOpenGLContext *context) { Q_EMIT q_func()->openglContextCreated(context); }
     void fireAboutToStop() { Q_EMIT q_func()->sceneGraphAboutToStop(); }
 
@@ -292,6 +319,22 @@ public:
 
     mutable QQuickWindowIncubationController *incubationController;
 
+    // Per-frame statistics, see QQuickWindow::setFrameStatisticsCapacity().
+    // guiFrameStatistics is written on the GUI thread and handed over to the
+    // render thread in syncSceneGraph(), renderFrameStatistics is only touched
+    // on the render thread. The ring is shared and guarded by the mutex.
+    bool isRecordingFrameStatistics() const { return frameStatisticsCapacity.load() > 0; }
+    void recordFrameStatistics();
+
+    QAtomicInt frameStatisticsCapacity;
+    mutable QMutex frameStatisticsMutex;
+    QVector<QQuickFrameStatisticsData> frameStatisticsRing;
+    int frameStatisticsNext;
+    qint64 frameStatisticsFrameNumber;
+    QQuickFrameStatisticsData guiFrameStatistics;
+    QQuickFrameStatisticsData renderFrameStatistics;
+    QElapsedTimer frameStatisticsSwapTimer;
+
     static bool defaultAlphaBuffer;
     static QQuickWindow::TextRenderType textRenderType;
 
@@ -43,8 +43,17 @@
 #include "qsgsoftwarerenderlistbuilder_p.h"
 #include "qsgsoftwarecontext_p.h"
 #include "qsgsoftwarerenderablenode_p.h"
+#include "qsgsoftwaresubtreecache_p.h"
+#include "qsgsoftwareblitter_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVector>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
 #include <QtGui/QWindow>
 #include <QtQuick/QSGSimpleRectNode>
 
@@ -52,11 +61,243 @@ Q_LOGGING_CATEGORY(lc2DRender, "qt.scenegraph.softwarecontext.abstractrenderer")
 
 QT_BEGIN_NAMESPACE
 
+// Shared by all software renderers, sized by the first one that renders in tiles
+Q_GLOBAL_STATIC(QThreadPool, qsgSoftwareRenderThreadPool)
+
+/*
+    Accumulates a region in a uniform grid of cells covering the rendering
+    area, so that the dirty and obscured regions built up while walking the
+    render list can be queried for one node's bounds without touching the
+    parts of the region that lie elsewhere in the scene. Whatever falls
+    outside of the grid is kept in a single overflow region.
+*/
+class QSGSoftwareRegionGrid
+{
+public:
+    enum { CellSize = 64 };
+
+    explicit QSGSoftwareRegionGrid(const QRect &bounds)
+        : m_bounds(bounds)
+        , m_columns(bounds.isEmpty() ? 0 : (bounds.width() + CellSize - 1) / CellSize)
+        , m_rows(bounds.isEmpty() ? 0 : (bounds.height() + CellSize - 1) / CellSize)
+        , m_cells(m_columns * m_rows)
+    {
+    }
+
+    bool isEmpty() const { return m_usedCells == 0 && m_outside.isEmpty(); }
+
+    void add(const QRegion &region)
+    {
+        for (const QRect &rect : region)
+            add(rect);
+    }
+
+    void add(const QRect &rect)
+    {
+        if (rect.isEmpty())
+            return;
+        if (!m_bounds.contains(rect))
+            m_outside += QRegion(rect).subtracted(m_bounds);
+        const QRect r = rect & m_bounds;
+        int x0, y0, x1, y1;
+        if (!cellRange(r, &x0, &y0, &x1, &y1))
+            return;
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                QRegion &cell = m_cells[y * m_columns + x];
+                const QRect cr = cellRect(x, y);
+                const bool wasEmpty = cell.isEmpty();
+                if (r.contains(cr))
+                    cell = cr;
+                else
+                    cell += r & cr;
+                if (wasEmpty)
+                    ++m_usedCells;
+            }
+        }
+    }
+
+    void subtract(const QRect &rect)
+    {
+        if (rect.isEmpty() || isEmpty())
+            return;
+        if (!m_outside.isEmpty() && !m_bounds.contains(rect))
+            m_outside -= rect;
+        int x0, y0, x1, y1;
+        if (!cellRange(rect & m_bounds, &x0, &y0, &x1, &y1))
+            return;
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                QRegion &cell = m_cells[y * m_columns + x];
+                if (cell.isEmpty())
+                    continue;
+                if (rect.contains(cellRect(x, y)))
+                    cell = QRegion();
+                else
+                    cell -= rect;
+                if (cell.isEmpty())
+                    --m_usedCells;
+            }
+        }
+    }
+
+    QRegion intersected(const QRect &rect) const
+    {
+        QRegion result;
+        if (rect.isEmpty() || isEmpty())
+            return result;
+        if (!m_outside.isEmpty() && !m_bounds.contains(rect))
+            result = m_outside.intersected(rect);
+        int x0, y0, x1, y1;
+        if (!cellRange(rect & m_bounds, &x0, &y0, &x1, &y1))
+            return result;
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                const QRegion &cell = m_cells.at(y * m_columns + x);
+                if (!cell.isEmpty() && cell.intersects(rect))
+                    result += cell.intersected(rect);
+            }
+        }
+        return result;
+    }
+
+    QRegion toRegion() const
+    {
+        QRegion result = m_outside;
+        if (m_usedCells > 0) {
+            for (const QRegion &cell : m_cells)
+                result += cell;
+        }
+        return result;
+    }
+
+private:
+    bool cellRange(const QRect &rect, int *x0, int *y0, int *x1, int *y1) const
+    {
+        if (rect.isEmpty())
+            return false;
+        *x0 = (rect.left() - m_bounds.left()) / CellSize;
+        *y0 = (rect.top() - m_bounds.top()) / CellSize;
+        *x1 = (rect.right() - m_bounds.left()) / CellSize;
+        *y1 = (rect.bottom() - m_bounds.top()) / CellSize;
+        return true;
+    }
+
+    QRect cellRect(int x, int y) const
+    {
+        return QRect(m_bounds.left() + x * CellSize, m_bounds.top() + y * CellSize,
+                     CellSize, CellSize) & m_bounds;
+    }
+
+    const QRect m_bounds;
+    const int m_columns;
+    const int m_rows;
+    QVector<QRegion> m_cells;
+    int m_usedCells = 0;
+    QRegion m_outside;
+};
+
+/*
+    Rasterizes a set of tiles of the target image. Each tile gets its own
+    QImage sharing the target's pixels and its own QPainter, so tiles can
+    be painted concurrently as long as they do not overlap. The calling
+    thread and the pool threads take tiles from the same list until it is
+    exhausted.
+*/
+class QSGSoftwareTileRasterizer
+{
+public:
+    QSGSoftwareTileRasterizer(QImage *target, QPainter::RenderHints hints)
+        : bits(target->bits())
+        , bytesPerLine(target->bytesPerLine())
+        , bytesPerPixel(target->depth() / 8)
+        , format(target->format())
+        , devicePixelRatio(int(target->devicePixelRatioF()))
+        , renderHints(hints)
+    {
+    }
+
+    void rasterizeTiles()
+    {
+        for (int i = nextTile.fetchAndAddRelaxed(1); i < tiles.count(); i = nextTile.fetchAndAddRelaxed(1))
+            rasterizeTile(tiles.at(i));
+    }
+
+    void rasterizeTile(const QRect &tile)
+    {
+        const QRect deviceRect(tile.topLeft() * devicePixelRatio, tile.size() * devicePixelRatio);
+        QImage tileImage(bits + deviceRect.y() * bytesPerLine + deviceRect.x() * bytesPerPixel,
+                         deviceRect.width(), deviceRect.height(), bytesPerLine, format);
+        tileImage.setDevicePixelRatio(devicePixelRatio);
+
+        QPainter painter(&tileImage);
+        painter.setRenderHints(renderHints);
+        painter.translate(-tile.topLeft());
+
+        const QRegion tileRegion(tile);
+        for (int i = 0; i < nodes.count(); ++i) {
+            QSGSoftwareRenderableNode *node = nodes.at(i);
+            const QRegion clip = node->dirtyRegion().intersected(tileRegion);
+            if (clip.isEmpty())
+                continue;
+            // Glyph rasterization goes through font engine caches that are
+            // shared between threads.
+            if (node->type() == QSGSoftwareRenderableNode::Glyph) {
+                QMutexLocker locker(&glyphMutex);
+                node->paint(&painter, clip);
+            } else {
+                node->paint(&painter, clip, i == 0 && hasBackground);
+            }
+        }
+    }
+
+    QVector<QSGSoftwareRenderableNode *> nodes;
+    QVector<QRect> tiles;
+    bool hasBackground = false;
+    QAtomicInt nextTile;
+    QSemaphore finished;
+
+private:
+    uchar *bits;
+    const int bytesPerLine;
+    const int bytesPerPixel;
+    const QImage::Format format;
+    const int devicePixelRatio;
+    const QPainter::RenderHints renderHints;
+
+    static QMutex glyphMutex;
+};
+
+QMutex QSGSoftwareTileRasterizer::glyphMutex;
+
+class QSGSoftwareTileRunnable : public QRunnable
+{
+public:
+    QSGSoftwareTileRunnable(QSGSoftwareTileRasterizer *rasterizer) : m_rasterizer(rasterizer) { }
+
+    void run() override
+    {
+        m_rasterizer->rasterizeTiles();
+        m_rasterizer->finished.release();
+    }
+
+private:
+    QSGSoftwareTileRasterizer *m_rasterizer;
+};
+
 QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *context)
     : QSGRenderer(context)
     , m_background(new QSGSimpleRectNode)
     , m_nodeUpdater(new QSGSoftwareRenderableNodeUpdater(this))
+    , m_renderThreadCount(qEnvironmentVariableIntValue("QSG_SOFTWARE_RENDER_THREADS"))
+    , m_subtreeCache(nullptr)
 {
+    QSGSoftwareBlitter::setEnabled(qEnvironmentVariableIntValue("QSG_SOFTWARE_BLITTER"));
+
+    const int subtreeCacheFrames = qEnvironmentVariableIntValue("QSG_SOFTWARE_SUBTREE_CACHE");
+    if (subtreeCacheFrames > 0)
+        m_subtreeCache = new QSGSoftwareSubtreeCacheManager(subtreeCacheFrames);
+
     // Setup special background node
     auto backgroundRenderable = new QSGSoftwareRenderableNode(QSGSoftwareRenderableNode::SimpleRect, m_background);
     addNodeMapping(m_background, backgroundRenderable);
@@ -65,6 +306,7 @@ QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *conte
 QSGAbstractSoftwareRenderer::~QSGAbstractSoftwareRenderer()
 {
     // Cleanup RenderableNodes
+    delete m_subtreeCache;
     delete m_background;
 
     qDeleteAll(m_nodes);
@@ -85,6 +327,26 @@ void QSGAbstractSoftwareRenderer::addNodeMapping(QSGNode *node, QSGSoftwareRende
 void QSGAbstractSoftwareRenderer::appendRenderableNode(QSGSoftwareRenderableNode *node)
 {
     m_renderableNodes.append(node);
+    if (m_subtreeCache)
+        m_subtreeCache->nodeAppended(node);
+}
+
+bool QSGAbstractSoftwareRenderer::beginSubtree(QSGNode *node)
+{
+    if (!m_subtreeCache)
+        return true;
+    return m_subtreeCache->beginSubtree(node, &m_renderableNodes);
+}
+
+void QSGAbstractSoftwareRenderer::endSubtree(QSGNode *node)
+{
+    if (m_subtreeCache)
+        m_subtreeCache->endSubtree(node, &m_renderableNodes);
+}
+
+int QSGAbstractSoftwareRenderer::subtreeCacheCount() const
+{
+    return m_subtreeCache ? m_subtreeCache->cacheCount() : 0;
 }
 
 void QSGAbstractSoftwareRenderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
@@ -123,6 +385,18 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     if (m_renderableNodes.isEmpty())
         return dirtyRegion;
 
+    if (recordsStatistics()) {
+        // There is no batching here; report the nodes that get painted.
+        m_statistics.nodeCount = m_renderableNodes.count();
+        for (QSGSoftwareRenderableNode *node : qAsConst(m_renderableNodes)) {
+            if (node->needsPainting())
+                ++m_statistics.batchCount;
+        }
+    }
+
+    if (m_renderThreadCount > 1)
+        return renderNodesInTiles(painter);
+
     auto iterator = m_renderableNodes.begin();
     // First node is the background and needs to painted without blending
     auto backgroundNode = *iterator;
@@ -137,6 +411,89 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     return dirtyRegion;
 }
 
+/*
+    Renders the dirty parts of the render list split into tiles, with the
+    tiles rasterized in parallel on a thread pool. This is enabled by
+    setting QSG_SOFTWARE_RENDER_THREADS to the number of threads to use.
+    It only applies when painting into a QImage (which includes raster
+    backing stores) without a transformation, with an integer device pixel
+    ratio, and without QSGRenderNodes, falling back to painting serially
+    otherwise or when the update is too small to be worth splitting.
+*/
+QRegion QSGAbstractSoftwareRenderer::renderNodesInTiles(QPainter *painter)
+{
+    enum { TileSize = 128 };
+
+    QPaintDevice *device = painter->device();
+    const qreal ratio = device->devicePixelRatioF();
+    bool canUseTiles = device->devType() == QInternal::Image
+            && !painter->viewTransformEnabled()
+            && painter->transform().isIdentity()
+            && qFuzzyCompare(ratio, qreal(qRound(ratio)))
+            && static_cast<QImage *>(device)->depth() >= 8
+            && static_cast<QImage *>(device)->depth() % 8 == 0;
+
+    QRegion updateRegion;
+    for (QSGSoftwareRenderableNode *node : qAsConst(m_renderableNodes)) {
+        if (!canUseTiles)
+            break;
+        if (node->type() == QSGSoftwareRenderableNode::RenderNode && node->isDirty())
+            canUseTiles = false;
+        else if (node->needsPainting())
+            updateRegion += node->dirtyRegion();
+    }
+
+    const QRect bounds = updateRegion.boundingRect()
+            & QRect(QPoint(0, 0), static_cast<QImage *>(device)->size() / qRound(ratio));
+    QVector<QRect> tiles;
+    if (canUseTiles) {
+        for (int y = bounds.top(); y <= bounds.bottom(); y += TileSize) {
+            for (int x = bounds.left(); x <= bounds.right(); x += TileSize) {
+                const QRect tile = QRect(x, y, TileSize, TileSize) & bounds;
+                if (updateRegion.intersects(tile))
+                    tiles.append(tile);
+            }
+        }
+    }
+
+    if (tiles.count() < 2) {
+        // Paint serially
+        QRegion dirtyRegion;
+        auto iterator = m_renderableNodes.begin();
+        dirtyRegion += (*iterator)->renderNode(painter, /*force opaque painting*/ true);
+        for (++iterator; iterator != m_renderableNodes.end(); ++iterator)
+            dirtyRegion += (*iterator)->renderNode(painter);
+        return dirtyRegion;
+    }
+
+    QSGSoftwareTileRasterizer rasterizer(static_cast<QImage *>(device), painter->renderHints());
+    rasterizer.tiles = tiles;
+    for (QSGSoftwareRenderableNode *node : qAsConst(m_renderableNodes)) {
+        if (node->needsPainting()) {
+            node->prepareForPainting(painter);
+            if (node == m_renderableNodes.first())
+                rasterizer.hasBackground = true;
+            rasterizer.nodes.append(node);
+        } else {
+            node->discardDirtyRegion();
+        }
+    }
+
+    QThreadPool *pool = qsgSoftwareRenderThreadPool();
+    if (pool->maxThreadCount() != m_renderThreadCount - 1)
+        pool->setMaxThreadCount(m_renderThreadCount - 1);
+    const int helpers = qMin(m_renderThreadCount - 1, tiles.count() - 1);
+    for (int i = 0; i < helpers; ++i)
+        pool->start(new QSGSoftwareTileRunnable(&rasterizer));
+    rasterizer.rasterizeTiles();
+    rasterizer.finished.acquire(helpers);
+
+    QRegion dirtyRegion;
+    for (QSGSoftwareRenderableNode *node : qAsConst(rasterizer.nodes))
+        dirtyRegion += node->finishPainting();
+    return dirtyRegion;
+}
+
 void QSGAbstractSoftwareRenderer::buildRenderList()
 {
     // Clear the previous renderlist
@@ -144,35 +501,49 @@ void QSGAbstractSoftwareRenderer::buildRenderList()
     // Add the background renderable (always first)
     m_renderableNodes.append(renderableNode(m_background));
     // Build the renderlist
+    if (m_subtreeCache)
+        m_subtreeCache->beginFrame();
     QSGSoftwareRenderListBuilder(this).visitChildren(rootNode());
+    if (m_subtreeCache)
+        m_subtreeCache->endFrame(&m_renderableNodes, m_background->rect().toRect());
 }
 
 QRegion QSGAbstractSoftwareRenderer::optimizeRenderList()
 {
+    const QRect renderArea = m_background->rect().toRect();
+    QSGSoftwareRegionGrid dirty(renderArea);
+    QSGSoftwareRegionGrid obscured(renderArea);
+    dirty.add(m_dirtyRegion);
+
     // Iterate through the renderlist from front to back
     // Objective is to update the dirty status and rects.
     for (auto i = m_renderableNodes.rbegin(); i != m_renderableNodes.rend(); ++i) {
         auto node = *i;
-        if (!m_dirtyRegion.isEmpty()) {
+        const QRect boundingRectMax = node->boundingRectMax();
+        if (!dirty.isEmpty()) {
             // See if the current dirty regions apply to the current node
-            node->addDirtyRegion(m_dirtyRegion, true);
+            const QRegion nodeDirty = dirty.intersected(boundingRectMax);
+            if (!nodeDirty.isEmpty())
+                node->addDirtyRegion(nodeDirty, true);
         }
 
-        if (!m_obscuredRegion.isEmpty()) {
+        if (!obscured.isEmpty() && node->isDirty()) {
             // Don't try to paint things that are covered by opaque objects
-            node->subtractDirtyRegion(m_obscuredRegion);
+            const QRect area = boundingRectMax.united(node->dirtyRegion().boundingRect());
+            const QRegion nodeObscured = obscured.intersected(area);
+            if (!nodeObscured.isEmpty())
+                node->subtractDirtyRegion(nodeObscured);
         }
 
         // Keep up with obscured regions
         if (node->isOpaque()) {
-            m_obscuredRegion += node->boundingRectMin();
+            obscured.add(node->boundingRectMin());
         }
 
         if (node->isDirty()) {
             // Don't paint things outside of the rendering area
-            if (!m_background->rect().toRect().contains(node->boundingRectMax(), /*proper*/ true)) {
+            if (!renderArea.contains(boundingRectMax, /*proper*/ true)) {
                 // Some part(s) of node is(are) outside of the rendering area
-                QRegion renderArea(m_background->rect().toRect());
                 QRegion outsideRegions = node->dirtyRegion().subtracted(renderArea);
                 if (!outsideRegions.isEmpty())
                     node->subtractDirtyRegion(outsideRegions);
@@ -180,43 +551,39 @@ QRegion QSGAbstractSoftwareRenderer::optimizeRenderList()
 
             // Get the dirty region's to pass to the next nodes
             if (node->isOpaque()) {
-                // if isOpaque, subtract node's dirty rect from m_dirtyRegion
-                m_dirtyRegion -= node->boundingRectMin();
+                // if isOpaque, subtract node's dirty rect from the dirty region
+                dirty.subtract(node->boundingRectMin());
             } else {
-                // if isAlpha, add node's dirty rect to m_dirtyRegion
-                m_dirtyRegion += node->dirtyRegion();
+                // if isAlpha, add node's dirty rect to the dirty region
+                dirty.add(node->dirtyRegion());
             }
-            // if previousDirtyRegion has content outside of boundingRect add to m_dirtyRegion
+            // if previousDirtyRegion has content outside of boundingRect add to the dirty region
             QRegion prevDirty = node->previousDirtyRegion();
             if (!prevDirty.isNull())
-                m_dirtyRegion += prevDirty;
+                dirty.add(prevDirty);
         }
     }
 
-    // Empty dirtyRegion (for second pass)
-    m_dirtyRegion = QRegion();
-    m_obscuredRegion = QRegion();
-
     // Iterate through the renderlist from back to front
     // Objective is to make sure all non-opaque items are painted when an item under them is dirty
+    QSGSoftwareRegionGrid updateRegion(renderArea);
     for (auto j = m_renderableNodes.begin(); j != m_renderableNodes.end(); ++j) {
         auto node = *j;
 
-        if (!node->isOpaque() && !m_dirtyRegion.isEmpty()) {
+        if (!node->isOpaque() && !updateRegion.isEmpty()) {
             // Only blended nodes need to be updated
-            node->addDirtyRegion(m_dirtyRegion, true);
+            const QRegion nodeDirty = updateRegion.intersected(node->boundingRectMax());
+            if (!nodeDirty.isEmpty())
+                node->addDirtyRegion(nodeDirty, true);
         }
 
-        m_dirtyRegion += node->dirtyRegion();
+        updateRegion.add(node->dirtyRegion());
     }
 
-    QRegion updateRegion = m_dirtyRegion;
-
     // Empty dirtyRegion
     m_dirtyRegion = QRegion();
-    m_obscuredRegion = QRegion();
 
-    return updateRegion;
+    return updateRegion.toRegion();
 }
 
 void QSGAbstractSoftwareRenderer::setBackgroundColor(const QColor &color)
@@ -233,6 +600,9 @@ void QSGAbstractSoftwareRenderer::setBackgroundSize(const QSize &size)
         return;
     m_background->setRect(0.0f, 0.0f, size.width(), size.height());
     renderableNode(m_background)->markGeometryDirty();
+    // Cached subtrees are clipped to the background
+    if (m_subtreeCache)
+        m_subtreeCache->clear();
     // Invalidate the whole scene when the background is resized
     markDirty();
 }
@@ -251,6 +621,8 @@ void QSGAbstractSoftwareRenderer::nodeAdded(QSGNode *node)
 {
     qCDebug(lc2DRender) << "nodeAdded" << (void*)node;
 
+    if (m_subtreeCache)
+        m_subtreeCache->nodeAdded(node);
     m_nodeUpdater->updateNodes(node);
 }
 
@@ -259,6 +631,8 @@ void QSGAbstractSoftwareRenderer::nodeRemoved(QSGNode *node)
     qCDebug(lc2DRender) << "nodeRemoved" << (void*)node;
 
     auto renderable = renderableNode(node);
+    if (m_subtreeCache)
+        m_subtreeCache->nodeRemoved(node, renderable);
     // remove mapping
     if (renderable != nullptr) {
         // Need to mark this region dirty in the other nodes
@@ -62,6 +62,7 @@ class QSGSimpleRectNode;
 
 class QSGSoftwareRenderableNode;
 class QSGSoftwareRenderableNodeUpdater;
+class QSGSoftwareSubtreeCacheManager;
 
 class Q_QUICK_PRIVATE_EXPORT QSGAbstractSoftwareRenderer : public QSGRenderer
 {
@@ -72,11 +73,16 @@ public:
     QSGSoftwareRenderableNode *renderableNode(QSGNode *node) const;
     void addNodeMapping(QSGNode *node, QSGSoftwareRenderableNode *renderableNode);
     void appendRenderableNode(QSGSoftwareRenderableNode *node);
+    bool beginSubtree(QSGNode *node);
+    void endSubtree(QSGNode *node);
 
     void nodeChanged(QSGNode *node, QSGNode::DirtyState state) override;
 
     void markDirty();
 
+    // For testing
+    int subtreeCacheCount() const;
+
 protected:
     QRegion renderNodes(QPainter *painter);
     void buildRenderList();
@@ -95,15 +101,20 @@ private:
     void nodeMatrixUpdated(QSGNode *node);
     void nodeOpacityUpdated(QSGNode *node);
 
+    QRegion renderNodesInTiles(QPainter *painter);
+
     QHash<QSGNode*, QSGSoftwareRenderableNode*> m_nodes;
     QLinkedList<QSGSoftwareRenderableNode*> m_renderableNodes;
 
     QSGSimpleRectNode *m_background;
 
     QRegion m_dirtyRegion;
-    QRegion m_obscuredRegion;
 
     QSGSoftwareRenderableNodeUpdater *m_nodeUpdater;
+
+    int m_renderThreadCount;
+
+    QSGSoftwareSubtreeCacheManager *m_subtreeCache;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,523 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsgsoftwareblitter_p.h"
+
+#include <QtCore/QVarLengthArray>
+#include <QtCore/qatomic.h>
+#include <QtGui/QImage>
+#include <QtGui/QPaintEngine>
+#include <QtGui/QPixmap>
+#include <private/qsimd_p.h>
+
+#include <string.h>
+
+#if defined(__ARM_NEON__) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+#define QSG_SOFTWARE_BLITTER_NEON
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// Multiplies each channel of x with a / 255, rounding like the raster engine does
+inline uint byteMul(uint x, uint a)
+{
+    uint t = (x & 0xff00ff) * a;
+    t = (t + ((t >> 8) & 0xff00ff) + 0x800080) >> 8;
+    t &= 0xff00ff;
+
+    x = ((x >> 8) & 0xff00ff) * a;
+    x = (x + ((x >> 8) & 0xff00ff) + 0x800080);
+    x &= 0xff00ff00;
+    return x | t;
+}
+
+// (x * a + y * b) / 256 for each channel, a + b must be 256
+inline uint interpolate256(uint x, uint a, uint y, uint b)
+{
+    uint t = (x & 0xff00ff) * a + (y & 0xff00ff) * b;
+    t >>= 8;
+    t &= 0xff00ff;
+
+    x = ((x >> 8) & 0xff00ff) * a + ((y >> 8) & 0xff00ff) * b;
+    x &= 0xff00ff00;
+    return x | t;
+}
+
+#if defined(__SSE2__)
+// Same as byteMul() on the 16-bit lanes of x
+inline __m128i byteMul_sse2(__m128i x, __m128i a)
+{
+    const __m128i half = _mm_set1_epi16(0x80);
+    x = _mm_mullo_epi16(x, a);
+    x = _mm_add_epi16(x, _mm_srli_epi16(x, 8));
+    x = _mm_add_epi16(x, half);
+    return _mm_srli_epi16(x, 8);
+}
+#endif
+
+#if defined(QSG_SOFTWARE_BLITTER_NEON)
+// Same as byteMul() on each byte of x
+inline uint8x8_t byteMul_neon(uint8x8_t x, uint8x8_t a)
+{
+    const uint16x8_t t = vmull_u8(x, a);
+    return vraddhn_u16(t, vrshrq_n_u16(t, 8));
+}
+#endif
+
+void fillSpan(uint *dst, uint pixel, int count)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i value = _mm_set1_epi32(int(pixel));
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), value);
+#elif defined(QSG_SOFTWARE_BLITTER_NEON)
+    const uint32x4_t value = vdupq_n_u32(pixel);
+    for (; i + 4 <= count; i += 4)
+        vst1q_u32(dst + i, value);
+#endif
+    for (; i < count; ++i)
+        dst[i] = pixel;
+}
+
+// Source over of a premultiplied color
+void blendSpan(uint *dst, uint pixel, int count)
+{
+    const uint inverseAlpha = 255 - qAlpha(pixel);
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ia = _mm_set1_epi16(short(inverseAlpha));
+    const __m128i color = _mm_set1_epi32(int(pixel));
+    for (; i + 4 <= count; i += 4) {
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        const __m128i lo = byteMul_sse2(_mm_unpacklo_epi8(d, zero), ia);
+        const __m128i hi = byteMul_sse2(_mm_unpackhi_epi8(d, zero), ia);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_add_epi8(_mm_packus_epi16(lo, hi), color));
+    }
+#elif defined(QSG_SOFTWARE_BLITTER_NEON)
+    const uint8x8_t ia = vdup_n_u8(inverseAlpha);
+    uint8x8_t color[4];
+    for (int c = 0; c < 4; ++c)
+        color[c] = vdup_n_u8((pixel >> (8 * c)) & 0xff);
+    for (; i + 8 <= count; i += 8) {
+        uint8x8x4_t d = vld4_u8(reinterpret_cast<const uint8_t *>(dst + i));
+        for (int c = 0; c < 4; ++c)
+            d.val[c] = vadd_u8(byteMul_neon(d.val[c], ia), color[c]);
+        vst4_u8(reinterpret_cast<uint8_t *>(dst + i), d);
+    }
+#endif
+    for (; i < count; ++i)
+        dst[i] = pixel + byteMul(dst[i], inverseAlpha);
+}
+
+// Source over of premultiplied pixels, scaled by a constant alpha
+void blendSpan(uint *dst, const uint *src, int count, uint constAlpha)
+{
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ca = _mm_set1_epi16(short(constAlpha));
+    const __m128i full = _mm_set1_epi32(255);
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        if (constAlpha != 255) {
+            const __m128i lo = byteMul_sse2(_mm_unpacklo_epi8(s, zero), ca);
+            const __m128i hi = byteMul_sse2(_mm_unpackhi_epi8(s, zero), ca);
+            s = _mm_packus_epi16(lo, hi);
+        }
+        // Inverse source alpha, spread over the four 16-bit channels of each pixel
+        __m128i ia = _mm_sub_epi32(full, _mm_srli_epi32(s, 24));
+        ia = _mm_or_si128(ia, _mm_slli_epi32(ia, 16));
+        const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        const __m128i lo = byteMul_sse2(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi32(ia, ia));
+        const __m128i hi = byteMul_sse2(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi32(ia, ia));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_add_epi8(_mm_packus_epi16(lo, hi), s));
+    }
+#elif defined(QSG_SOFTWARE_BLITTER_NEON)
+    const uint8x8_t ca = vdup_n_u8(constAlpha);
+    for (; i + 8 <= count; i += 8) {
+        uint8x8x4_t s = vld4_u8(reinterpret_cast<const uint8_t *>(src + i));
+        if (constAlpha != 255) {
+            for (int c = 0; c < 4; ++c)
+                s.val[c] = byteMul_neon(s.val[c], ca);
+        }
+        const uint8x8_t ia = vmvn_u8(s.val[3]);
+        uint8x8x4_t d = vld4_u8(reinterpret_cast<const uint8_t *>(dst + i));
+        for (int c = 0; c < 4; ++c)
+            d.val[c] = vadd_u8(byteMul_neon(d.val[c], ia), s.val[c]);
+        vst4_u8(reinterpret_cast<uint8_t *>(dst + i), d);
+    }
+#endif
+    for (; i < count; ++i) {
+        uint s = src[i];
+        if (constAlpha != 255)
+            s = byteMul(s, constAlpha);
+        const uint alpha = qAlpha(s);
+        if (alpha == 255)
+            dst[i] = s;
+        else if (alpha != 0)
+            dst[i] = s + byteMul(dst[i], 255 - alpha);
+    }
+}
+
+// Premultiplied color at pos, interpolating between stops like QGradient::ColorInterpolation
+uint gradientPixel(const QGradientStops &stops, int *stop, qreal pos)
+{
+    const int last = stops.count() - 1;
+    while (*stop < last && stops.at(*stop + 1).first <= pos)
+        ++*stop;
+
+    const QGradientStop &from = stops.at(*stop);
+    if (*stop == last || pos <= from.first)
+        return qPremultiply(from.second.rgba());
+
+    const QGradientStop &to = stops.at(*stop + 1);
+    const uint t = uint(qBound(0, qRound((pos - from.first) / (to.first - from.first) * 256), 256));
+    return qPremultiply(interpolate256(from.second.rgba(), 256 - t, to.second.rgba(), t));
+}
+
+bool isSupportedFormat(const QImage &image)
+{
+    return image.format() == QImage::Format_ARGB32_Premultiplied
+            || image.format() == QImage::Format_ARGB32
+            || image.format() == QImage::Format_RGB32;
+}
+
+QBasicAtomicInt qsg_software_blitter_enabled = Q_BASIC_ATOMIC_INITIALIZER(0);
+
+} // namespace
+
+void QSGSoftwareBlitter::setEnabled(bool enabled)
+{
+    qsg_software_blitter_enabled.store(enabled);
+}
+
+bool QSGSoftwareBlitter::isEnabled()
+{
+    return qsg_software_blitter_enabled.load();
+}
+
+QSGSoftwareBlitter::QSGSoftwareBlitter(QPainter *painter)
+    : m_bits(nullptr)
+    , m_bytesPerLine(0)
+    , m_constAlpha(255)
+    , m_sourceMode(false)
+    , m_opaqueTarget(false)
+    , m_smooth(false)
+    , m_antialiasing(false)
+{
+    if (!isEnabled())
+        return;
+
+    QPaintDevice *device = painter->device();
+    if (!device || device->devType() != QInternal::Image)
+        return;
+    if (!painter->paintEngine() || painter->paintEngine()->type() != QPaintEngine::Raster)
+        return;
+
+    QImage *image = static_cast<QImage *>(device);
+    if (image->format() != QImage::Format_ARGB32_Premultiplied && image->format() != QImage::Format_RGB32)
+        return;
+
+    // Mirroring scales are left to QPainter
+    const QTransform transform = painter->deviceTransform();
+    if (transform.type() > QTransform::TxScale || transform.m11() <= 0 || transform.m22() <= 0)
+        return;
+
+    const QPainter::CompositionMode mode = painter->compositionMode();
+    const uint constAlpha = uint(qBound(0, qRound(painter->opacity() * 255), 255));
+    if (mode == QPainter::CompositionMode_Source) {
+        if (constAlpha != 255)
+            return;
+    } else if (mode != QPainter::CompositionMode_SourceOver) {
+        return;
+    }
+
+    const QRegion bounds(0, 0, image->width(), image->height());
+    m_clip = painter->hasClipping() ? transform.map(painter->clipRegion()).intersected(bounds) : bounds;
+    m_transform = transform;
+    m_constAlpha = constAlpha;
+    m_sourceMode = mode == QPainter::CompositionMode_Source;
+    m_opaqueTarget = image->format() == QImage::Format_RGB32;
+    m_smooth = painter->testRenderHint(QPainter::SmoothPixmapTransform);
+    m_antialiasing = painter->testRenderHint(QPainter::Antialiasing);
+    m_bytesPerLine = image->bytesPerLine();
+    m_bits = image->bits();
+}
+
+// Pixel aligned device rect covered by an aliased fill of rect
+QRect QSGSoftwareBlitter::deviceRect(const QRectF &rect) const
+{
+    const QRectF mapped = m_transform.mapRect(rect);
+    const int left = qRound(mapped.left());
+    const int top = qRound(mapped.top());
+    return QRect(left, top, qRound(mapped.right()) - left, qRound(mapped.bottom()) - top);
+}
+
+bool QSGSoftwareBlitter::isPixelAligned(const QRectF &rect) const
+{
+    const QRectF mapped = m_transform.mapRect(rect);
+    return QRectF(deviceRect(rect)) == mapped;
+}
+
+bool QSGSoftwareBlitter::fillRect(const QRectF &rect, const QColor &color)
+{
+    if (!isValid() || m_antialiasing)
+        return false;
+
+    uint pixel = qPremultiply(color.rgba());
+    if (m_constAlpha != 255)
+        pixel = byteMul(pixel, m_constAlpha);
+    const bool opaque = m_sourceMode || qAlpha(pixel) == 255;
+    if (m_opaqueTarget && qAlpha(pixel) != 255 && m_sourceMode)
+        return false;
+    if (!opaque && qAlpha(pixel) == 0)
+        return true;
+
+    const QRect target = deviceRect(rect);
+    if (target.isEmpty())
+        return true;
+
+    for (const QRect &clipRect : m_clip) {
+        const QRect r = clipRect & target;
+        if (r.isEmpty())
+            continue;
+        for (int y = r.top(); y <= r.bottom(); ++y) {
+            if (opaque)
+                fillSpan(scanLine(y) + r.left(), pixel, r.width());
+            else
+                blendSpan(scanLine(y) + r.left(), pixel, r.width());
+        }
+    }
+    return true;
+}
+
+bool QSGSoftwareBlitter::fillGradient(const QRectF &rect, const QGradientStops &stops, Qt::Orientation orientation)
+{
+    if (!isValid() || m_antialiasing || stops.isEmpty())
+        return false;
+
+    const QRectF mapped = m_transform.mapRect(rect);
+    const QRect target = deviceRect(rect);
+    if (target.isEmpty())
+        return true;
+
+    // One color per device row of a vertical gradient, or per column of a horizontal one
+    const bool vertical = orientation == Qt::Vertical;
+    const int length = vertical ? target.height() : target.width();
+    const int first = vertical ? target.top() : target.left();
+    const qreal start = vertical ? mapped.top() : mapped.left();
+    const qreal extent = vertical ? mapped.height() : mapped.width();
+
+    QVarLengthArray<uint, 512> colors(length);
+    bool opaque = true;
+    int stop = 0;
+    for (int i = 0; i < length; ++i) {
+        uint pixel = gradientPixel(stops, &stop, (first + i + 0.5 - start) / extent);
+        if (m_constAlpha != 255)
+            pixel = byteMul(pixel, m_constAlpha);
+        opaque &= qAlpha(pixel) == 255;
+        colors[i] = pixel;
+    }
+    if (m_opaqueTarget && m_sourceMode && !opaque)
+        return false;
+    opaque |= m_sourceMode;
+
+    for (const QRect &clipRect : m_clip) {
+        const QRect r = clipRect & target;
+        if (r.isEmpty())
+            continue;
+        for (int y = r.top(); y <= r.bottom(); ++y) {
+            uint *dst = scanLine(y) + r.left();
+            if (vertical) {
+                const uint pixel = colors.at(y - first);
+                if (m_sourceMode || qAlpha(pixel) == 255)
+                    fillSpan(dst, pixel, r.width());
+                else if (qAlpha(pixel) != 0)
+                    blendSpan(dst, pixel, r.width());
+            } else {
+                const uint *src = colors.constData() + r.left() - first;
+                if (opaque)
+                    memcpy(dst, src, r.width() * sizeof(uint));
+                else
+                    blendSpan(dst, src, r.width(), 255);
+            }
+        }
+    }
+    return true;
+}
+
+bool QSGSoftwareBlitter::drawPixmap(const QRectF &targetRect, const QPixmap &pixmap, const QRect &sourceRect)
+{
+    // Antialiased edges of fractional rects are left to QPainter
+    if (!isValid() || (m_antialiasing && !isPixelAligned(targetRect)))
+        return false;
+
+    const QImage image = pixmap.toImage();
+    if (!isSupportedFormat(image) || !image.rect().contains(sourceRect))
+        return false;
+    if (m_opaqueTarget && m_sourceMode && image.hasAlphaChannel())
+        return false;
+
+    drawImage(targetRect, image, sourceRect);
+    return true;
+}
+
+/*
+    Stretches the nine sections of the pixmap into the target rect, the
+    equivalent of QSGSoftwareHelpers::qDrawBorderPixmap() with
+    Qt::StretchTile in both directions.
+*/
+bool QSGSoftwareBlitter::drawBorderPixmap(const QRect &targetRect, const QMargins &targetMargins,
+                                          const QPixmap &pixmap, const QMargins &sourceMargins)
+{
+    if (!isValid() || (m_antialiasing && !isPixelAligned(targetRect)))
+        return false;
+
+    const QImage image = pixmap.toImage();
+    if (!isSupportedFormat(image))
+        return false;
+    if (m_opaqueTarget && m_sourceMode && image.hasAlphaChannel())
+        return false;
+
+    const int xTarget[4] = { targetRect.left(), targetRect.left() + qMax(0, targetMargins.left()),
+                             targetRect.left() + targetRect.width() - qMax(0, targetMargins.right()),
+                             targetRect.left() + targetRect.width() };
+    const int yTarget[4] = { targetRect.top(), targetRect.top() + qMax(0, targetMargins.top()),
+                             targetRect.top() + targetRect.height() - qMax(0, targetMargins.bottom()),
+                             targetRect.top() + targetRect.height() };
+    const int xSource[4] = { 0, qMax(0, sourceMargins.left()),
+                             image.width() - qMax(0, sourceMargins.right()), image.width() };
+    const int ySource[4] = { 0, qMax(0, sourceMargins.top()),
+                             image.height() - qMax(0, sourceMargins.bottom()), image.height() };
+
+    for (int row = 0; row < 3; ++row) {
+        for (int column = 0; column < 3; ++column) {
+            const QRect target(xTarget[column], yTarget[row],
+                               xTarget[column + 1] - xTarget[column], yTarget[row + 1] - yTarget[row]);
+            const QRect source(xSource[column], ySource[row],
+                               xSource[column + 1] - xSource[column], ySource[row + 1] - ySource[row]);
+            if (target.isEmpty() || source.isEmpty() || !image.rect().contains(source))
+                continue;
+            drawImage(target, image, source);
+        }
+    }
+    return true;
+}
+
+/*
+    Scales sourceRect of the image into targetRect, sampling the nearest
+    source pixel or, with SmoothPixmapTransform, interpolating bilinearly.
+    Samples never reach outside of sourceRect so the sections of a border
+    image do not bleed into each other. Each row is sampled into a line
+    buffer that is then composited onto the target in one go.
+*/
+void QSGSoftwareBlitter::drawImage(const QRectF &targetRect, const QImage &image, const QRect &sourceRect)
+{
+    const QRectF mapped = m_transform.mapRect(targetRect);
+    const QRect target = deviceRect(targetRect);
+    if (target.isEmpty() || sourceRect.isEmpty())
+        return;
+
+    const bool premultiply = image.format() == QImage::Format_ARGB32;
+    const bool copy = m_sourceMode || (!image.hasAlphaChannel() && m_constAlpha == 255);
+
+    const qreal scaleX = sourceRect.width() / mapped.width();
+    const qreal scaleY = sourceRect.height() / mapped.height();
+    const int stepX = qRound(scaleX * 65536);
+    const int offset = m_smooth ? 32768 : 0;
+    const int minX = sourceRect.left();
+    const int maxX = sourceRect.right();
+    const int minY = sourceRect.top();
+    const int maxY = sourceRect.bottom();
+
+    QVarLengthArray<uint, 1024> buffer;
+    for (const QRect &clipRect : m_clip) {
+        const QRect r = clipRect & target;
+        if (r.isEmpty())
+            continue;
+        buffer.resize(r.width());
+        uint *out = buffer.data();
+        // 16.16 fixed point source coordinates of the first pixel center
+        const int startX = qRound((minX + (r.left() + 0.5 - mapped.left()) * scaleX) * 65536) - offset;
+
+        for (int y = r.top(); y <= r.bottom(); ++y) {
+            const int sy = qRound((minY + (y + 0.5 - mapped.top()) * scaleY) * 65536) - offset;
+            int sx = startX;
+            if (m_smooth) {
+                const uint distY = uint(sy & 0xffff) >> 8;
+                const uint *top = reinterpret_cast<const uint *>(image.constScanLine(qBound(minY, sy >> 16, maxY)));
+                const uint *bottom = reinterpret_cast<const uint *>(image.constScanLine(qBound(minY, (sy >> 16) + 1, maxY)));
+                for (int x = 0; x < r.width(); ++x, sx += stepX) {
+                    const uint distX = uint(sx & 0xffff) >> 8;
+                    const int x1 = qBound(minX, sx >> 16, maxX);
+                    const int x2 = qBound(minX, (sx >> 16) + 1, maxX);
+                    uint tl = top[x1], tr = top[x2], bl = bottom[x1], br = bottom[x2];
+                    if (premultiply) {
+                        tl = qPremultiply(tl);
+                        tr = qPremultiply(tr);
+                        bl = qPremultiply(bl);
+                        br = qPremultiply(br);
+                    }
+                    const uint t = interpolate256(tl, 256 - distX, tr, distX);
+                    const uint b = interpolate256(bl, 256 - distX, br, distX);
+                    out[x] = interpolate256(t, 256 - distY, b, distY);
+                }
+            } else {
+                const uint *line = reinterpret_cast<const uint *>(image.constScanLine(qBound(minY, sy >> 16, maxY)));
+                for (int x = 0; x < r.width(); ++x, sx += stepX) {
+                    const uint pixel = line[qBound(minX, sx >> 16, maxX)];
+                    out[x] = premultiply ? qPremultiply(pixel) : pixel;
+                }
+            }
+
+            uint *dst = scanLine(y) + r.left();
+            if (copy)
+                memcpy(dst, out, r.width() * sizeof(uint));
+            else
+                blendSpan(dst, out, r.width(), m_constAlpha);
+        }
+    }
+}
+
+QT_END_NAMESPACE
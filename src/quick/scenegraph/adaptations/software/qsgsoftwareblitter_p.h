@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSGSOFTWAREBLITTER_P_H
+#define QSGSOFTWAREBLITTER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtquickglobal_p.h>
+
+#include <QtCore/QMargins>
+#include <QtCore/QRect>
+#include <QtGui/QBrush>
+#include <QtGui/QPainter>
+#include <QtGui/QRegion>
+#include <QtGui/QTransform>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Paints the most common scene graph primitives straight into the pixels
+    of the raster image a painter is active on, bypassing the QPainter
+    pipeline. This is only possible when the painter targets a 32-bit
+    QImage through a transform that is a pure translation or scale, in
+    which case isValid() returns true. Every painting function returns
+    false when it cannot handle its arguments, callers then fall back to
+    QPainter. The painter's clip, opacity and transform are captured on
+    construction and must not change while the blitter is used.
+
+    The blitter is only used when enabled, which the software renderer does
+    when QSG_SOFTWARE_BLITTER is set.
+*/
+class Q_QUICK_PRIVATE_EXPORT QSGSoftwareBlitter
+{
+public:
+    explicit QSGSoftwareBlitter(QPainter *painter);
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    bool isValid() const { return m_bits != nullptr; }
+
+    bool fillRect(const QRectF &rect, const QColor &color);
+    bool fillGradient(const QRectF &rect, const QGradientStops &stops, Qt::Orientation orientation);
+    bool drawPixmap(const QRectF &targetRect, const QPixmap &pixmap, const QRect &sourceRect);
+    bool drawBorderPixmap(const QRect &targetRect, const QMargins &targetMargins,
+                          const QPixmap &pixmap, const QMargins &sourceMargins);
+
+private:
+    void drawImage(const QRectF &targetRect, const QImage &image, const QRect &sourceRect);
+    QRect deviceRect(const QRectF &rect) const;
+    bool isPixelAligned(const QRectF &rect) const;
+    uint *scanLine(int y) const { return reinterpret_cast<uint *>(m_bits + y * m_bytesPerLine); }
+
+    uchar *m_bits;
+    int m_bytesPerLine;
+    QTransform m_transform;
+    QRegion m_clip;
+    uint m_constAlpha;
+    bool m_sourceMode;
+    bool m_opaqueTarget;
+    bool m_smooth;
+    bool m_antialiasing;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGSOFTWAREBLITTER_P_H
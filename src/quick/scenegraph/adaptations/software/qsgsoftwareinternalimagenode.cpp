@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qsgsoftwareinternalimagenode_p.h"
+#include "qsgsoftwareblitter_p.h"
 
 #include "qsgsoftwarepixmaptexture_p.h"
 #include "qsgsoftwarelayer_p.h"
@@ -461,6 +462,10 @@ void QSGSoftwareInternalImageNode::paint(QPainter *painter)
         QMargins margins(m_innerTargetRect.left() - m_targetRect.left(), m_innerTargetRect.top() - m_targetRect.top(),
                          m_targetRect.right() - m_innerTargetRect.right(), m_targetRect.bottom() - m_innerTargetRect.bottom());
         QSGSoftwareHelpers::QTileRules tilerules(getTileRule(m_subSourceRect.width()), getTileRule(m_subSourceRect.height()));
+        if (tilerules.horizontal == Qt::StretchTile && tilerules.vertical == Qt::StretchTile
+                && QSGSoftwareBlitter(painter).drawBorderPixmap(m_targetRect.toRect(), margins, pm, margins)) {
+            return;
+        }
         QSGSoftwareHelpers::qDrawBorderPixmap(painter, m_targetRect.toRect(), margins, pm, QRect(0, 0, pm.width(), pm.height()),
                                               margins, tilerules, QSGSoftwareHelpers::QDrawBorderPixmap::DrawingHints(0));
         return;
@@ -488,6 +493,16 @@ QRectF QSGSoftwareInternalImageNode::rect() const
     return m_targetRect;
 }
 
+bool QSGSoftwareInternalImageNode::isOpaque() const
+{
+    // Border images may leave parts of the target rect unpainted
+    if (!m_texture || m_innerTargetRect != m_targetRect)
+        return false;
+    if (QSGSoftwarePixmapTexture *pt = qobject_cast<QSGSoftwarePixmapTexture*>(m_texture))
+        return pt->isOpaque();
+    return !m_texture->hasAlphaChannel();
+}
+
 const QPixmap &QSGSoftwareInternalImageNode::pixmap() const
 {
     if (QSGSoftwarePixmapTexture *pt = qobject_cast<QSGSoftwarePixmapTexture*>(m_texture)) {
@@ -123,6 +123,7 @@ public:
     void paint(QPainter *painter);
 
     QRectF rect() const;
+    bool isOpaque() const;
 
 private:
     const QPixmap &pixmap() const;
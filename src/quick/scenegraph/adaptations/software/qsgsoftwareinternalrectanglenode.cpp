@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qsgsoftwareinternalrectanglenode_p.h"
+#include "qsgsoftwareblitter_p.h"
 #include <qmath.h>
 
 #include <QtGui/QPainter>
@@ -227,10 +228,7 @@ void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
 {
     //We can only check for a device pixel ratio change when we know what
     //paint device is being used.
-    if (painter->device()->devicePixelRatio() != m_devicePixelRatio) {
-        m_devicePixelRatio = painter->device()->devicePixelRatio();
-        generateCornerPixmap();
-    }
+    setDevicePixelRatio(painter->device()->devicePixelRatio());
 
     if (painter->transform().isRotating()) {
         //Rotated rectangles lose the benefits of direct rendering, and have poor rendering
@@ -289,6 +287,12 @@ QRectF QSGSoftwareInternalRectangleNode::rect() const
     return m_rect;
 }
 
+static inline void fillRect(QPainter *painter, QSGSoftwareBlitter *blitter, const QRectF &rect, const QColor &color)
+{
+    if (!blitter->fillRect(rect, color))
+        painter->fillRect(rect, color);
+}
+
 void QSGSoftwareInternalRectangleNode::paintRectangle(QPainter *painter, const QRect &rect)
 {
     //Radius should never exceeds half of the width or half of the height
@@ -297,6 +301,8 @@ void QSGSoftwareInternalRectangleNode::paintRectangle(QPainter *painter, const Q
     QPainter::RenderHints previousRenderHints = painter->renderHints();
     painter->setRenderHint(QPainter::Antialiasing, false);
 
+    QSGSoftwareBlitter blitter(painter);
+
     if (m_penWidth > 0) {
         //Fill border Rects
 
@@ -318,13 +324,13 @@ void QSGSoftwareInternalRectangleNode::paintRectangle(QPainter *painter, const Q
                                       QPointF(rect.x() + rect.width() - borderWidth, rect.y() + rect.height() - radius));
 
             if (borderTopOutside.isValid())
-                painter->fillRect(borderTopOutside, m_penColor);
+                fillRect(painter, &blitter, borderTopOutside, m_penColor);
             if (borderTopInside.isValid())
-                painter->fillRect(borderTopInside, m_penColor);
+                fillRect(painter, &blitter, borderTopInside, m_penColor);
             if (borderBottomOutside.isValid())
-                painter->fillRect(borderBottomOutside, m_penColor);
+                fillRect(painter, &blitter, borderBottomOutside, m_penColor);
             if (borderBottomInside.isValid())
-                painter->fillRect(borderBottomInside, m_penColor);
+                fillRect(painter, &blitter, borderBottomInside, m_penColor);
 
         } else {
             //2 Rects
@@ -333,18 +339,18 @@ void QSGSoftwareInternalRectangleNode::paintRectangle(QPainter *painter, const Q
             QRectF borderBottom(QPointF(rect.x() + radius, rect.y() + rect.height() - borderHeight),
                                 QPointF(rect.x() + rect.width() - radius, rect.y() + rect.height()));
             if (borderTop.isValid())
-                painter->fillRect(borderTop, m_penColor);
+                fillRect(painter, &blitter, borderTop, m_penColor);
             if (borderBottom.isValid())
-                painter->fillRect(borderBottom, m_penColor);
+                fillRect(painter, &blitter, borderBottom, m_penColor);
         }
         QRectF borderLeft(QPointF(rect.x(), rect.y() + radius),
                           QPointF(rect.x() + borderWidth, rect.y() + rect.height() - radius));
         QRectF borderRight(QPointF(rect.x() + rect.width() - borderWidth, rect.y() + radius),
                            QPointF(rect.x() + rect.width(), rect.y() + rect.height() - radius));
         if (borderLeft.isValid())
-            painter->fillRect(borderLeft, m_penColor);
+            fillRect(painter, &blitter, borderLeft, m_penColor);
         if (borderRight.isValid())
-            painter->fillRect(borderRight, m_penColor);
+            fillRect(painter, &blitter, borderRight, m_penColor);
     }
 
 
@@ -389,13 +395,13 @@ void QSGSoftwareInternalRectangleNode::paintRectangle(QPainter *painter, const Q
                 //Rounded Rects without gradient need 3 blits
                 QRectF centerRect(QPointF(brushRect.x() + innerRectRadius, brushRect.y()),
                                   QPointF(brushRect.x() + brushRect.width() - innerRectRadius, brushRect.y() + brushRect.height()));
-                painter->fillRect(centerRect, m_color);
+                fillRect(painter, &blitter, centerRect, m_color);
                 QRectF leftRect(QPointF(brushRect.x(), brushRect.y() + innerRectRadius),
                                 QPointF(brushRect.x() + innerRectRadius, brushRect.y() + brushRect.height() - innerRectRadius));
-                painter->fillRect(leftRect, m_color);
+                fillRect(painter, &blitter, leftRect, m_color);
                 QRectF rightRect(QPointF(brushRect.x() + brushRect.width() - innerRectRadius, brushRect.y() + innerRectRadius),
                                  QPointF(brushRect.x() + brushRect.width(), brushRect.y() + brushRect.height() - innerRectRadius));
-                painter->fillRect(rightRect, m_color);
+                fillRect(painter, &blitter, rightRect, m_color);
             } else {
                 //Rounded Rect with gradient (slow)
                 painter->setPen(Qt::NoPen);
@@ -404,13 +410,24 @@ void QSGSoftwareInternalRectangleNode::paintRectangle(QPainter *painter, const Q
             }
         } else {
             //non-rounded rects only need 1 blit
-            painter->fillRect(brushRect, m_brush);
+            if (m_stops.empty())
+                fillRect(painter, &blitter, brushRect, m_color);
+            else if (!blitter.fillGradient(brushRect, m_stops, Qt::Vertical))
+                painter->fillRect(brushRect, m_brush);
         }
     }
 
     painter->setRenderHints(previousRenderHints);
 }
 
+void QSGSoftwareInternalRectangleNode::setDevicePixelRatio(int ratio)
+{
+    if (ratio == m_devicePixelRatio)
+        return;
+    m_devicePixelRatio = ratio;
+    generateCornerPixmap();
+}
+
 void QSGSoftwareInternalRectangleNode::generateCornerPixmap()
 {
     //Generate new corner Pixmap
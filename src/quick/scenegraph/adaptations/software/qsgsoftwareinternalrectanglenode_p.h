@@ -76,6 +76,7 @@ public:
     void update() override;
 
     void paint(QPainter *);
+    void setDevicePixelRatio(int ratio);
 
     bool isOpaque() const;
     QRectF rect() const;
@@ -42,6 +42,7 @@
 QT_BEGIN_NAMESPACE
 
 QSGSoftwarePixmapTexture::QSGSoftwarePixmapTexture(const QImage &image, uint flags)
+    : m_opaque(-1)
 {
     // Prevent pixmap format conversion to reduce memory consumption
     // and surprises in calling code. (See QTBUG-47328)
@@ -56,6 +57,7 @@ QSGSoftwarePixmapTexture::QSGSoftwarePixmapTexture(const QImage &image, uint fla
 
 QSGSoftwarePixmapTexture::QSGSoftwarePixmapTexture(const QPixmap &pixmap)
     : m_pixmap(pixmap)
+    , m_opaque(-1)
 {
 }
 
@@ -75,6 +77,40 @@ bool QSGSoftwarePixmapTexture::hasAlphaChannel() const
     return m_pixmap.hasAlphaChannel();
 }
 
+/*
+    Returns true when every pixel of the texture is fully opaque. Images
+    loaded with an alpha channel frequently do not use it, and knowing that
+    lets the renderer skip painting whatever lies below the texture. The
+    result is computed on first use and cached, the pixmap does not change
+    over the lifetime of the texture.
+*/
+bool QSGSoftwarePixmapTexture::isOpaque() const
+{
+    if (m_opaque < 0) {
+        if (!m_pixmap.hasAlphaChannel()) {
+            m_opaque = 1;
+        } else {
+            const QImage image = m_pixmap.toImage();
+            if (image.format() != QImage::Format_ARGB32
+                    && image.format() != QImage::Format_ARGB32_Premultiplied) {
+                m_opaque = 0;
+            } else {
+                m_opaque = 1;
+                for (int y = 0; y < image.height() && m_opaque; ++y) {
+                    const QRgb *line = reinterpret_cast<const QRgb *>(image.constScanLine(y));
+                    for (int x = 0; x < image.width(); ++x) {
+                        if (qAlpha(line[x]) != 255) {
+                            m_opaque = 0;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return m_opaque == 1;
+}
+
 bool QSGSoftwarePixmapTexture::hasMipmaps() const
 {
     return false;
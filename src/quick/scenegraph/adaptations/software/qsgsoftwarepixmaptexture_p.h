@@ -69,9 +69,11 @@ public:
     void bind() override;
 
     const QPixmap &pixmap() const { return m_pixmap; }
+    bool isOpaque() const;
 
 private:
     QPixmap m_pixmap;
+    mutable int m_opaque;
 };
 
 QT_END_NAMESPACE
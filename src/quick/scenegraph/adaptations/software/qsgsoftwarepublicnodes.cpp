@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qsgsoftwarepublicnodes_p.h"
+#include "qsgsoftwareblitter_p.h"
 #include "qsgsoftwarepixmaptexture_p.h"
 #include "qsgsoftwareinternalimagenode_p.h"
 
@@ -94,8 +95,7 @@ void QSGSoftwareImageNode::setTextureCoordinatesTransform(QSGImageNode::TextureC
 
 void QSGSoftwareImageNode::paint(QPainter *painter)
 {
-    if (m_cachedMirroredPixmapIsDirty)
-        updateCachedMirroredPixmap();
+    prepareCachedPixmap();
 
     painter->setRenderHint(QPainter::SmoothPixmapTransform, (m_filtering == QSGTexture::Linear));
 
@@ -110,6 +110,12 @@ void QSGSoftwareImageNode::paint(QPainter *painter)
     }
 }
 
+void QSGSoftwareImageNode::prepareCachedPixmap()
+{
+    if (m_cachedMirroredPixmapIsDirty)
+        updateCachedMirroredPixmap();
+}
+
 void QSGSoftwareImageNode::updateCachedMirroredPixmap()
 {
     if (m_transformMode == NoTransform) {
@@ -184,11 +190,14 @@ void QSGSoftwareNinePatchNode::update()
 
 void QSGSoftwareNinePatchNode::paint(QPainter *painter)
 {
-    if (m_margins.isNull())
-        painter->drawPixmap(m_bounds, m_pixmap, QRectF(0, 0, m_pixmap.width(), m_pixmap.height()));
-    else
+    QSGSoftwareBlitter blitter(painter);
+    if (m_margins.isNull()) {
+        if (!blitter.drawPixmap(m_bounds, m_pixmap, m_pixmap.rect()))
+            painter->drawPixmap(m_bounds, m_pixmap, QRectF(0, 0, m_pixmap.width(), m_pixmap.height()));
+    } else if (!blitter.drawBorderPixmap(m_bounds.toRect(), m_margins, m_pixmap, m_margins)) {
         QSGSoftwareHelpers::qDrawBorderPixmap(painter, m_bounds.toRect(), m_margins, m_pixmap, QRect(0, 0, m_pixmap.width(), m_pixmap.height()),
                                               m_margins, Qt::StretchTile, QSGSoftwareHelpers::QDrawBorderPixmap::DrawingHints(0));
+    }
 }
 
 QRectF QSGSoftwareNinePatchNode::bounds() const
@@ -104,6 +104,7 @@ public:
     bool ownsTexture() const override { return m_owns; }
 
     void paint(QPainter *painter);
+    void prepareCachedPixmap();
 
 private:
     void updateCachedMirroredPixmap();
@@ -45,6 +45,7 @@
 #include "qsgsoftwarepublicnodes_p.h"
 #include "qsgsoftwarepainternode_p.h"
 #include "qsgsoftwarepixmaptexture_p.h"
+#include "qsgsoftwaresubtreecache_p.h"
 #if QT_CONFIG(quick_sprite)
 #include "qsgsoftwarespritenode_p.h"
 #endif
@@ -76,10 +77,20 @@ inline QRect toRectMax(const QRectF & r)
     return r.toAlignedRect();
 }
 
+// Textures with an alpha channel may still not have any translucent pixels
+static bool isOpaqueTexture(QSGTexture *texture)
+{
+    if (QSGSoftwarePixmapTexture *pt = qobject_cast<QSGSoftwarePixmapTexture *>(texture))
+        return pt->isOpaque();
+    return !texture->hasAlphaChannel();
+}
+
 QSGSoftwareRenderableNode::QSGSoftwareRenderableNode(NodeType type, QSGNode *node)
     : m_nodeType(type)
     , m_isOpaque(true)
     , m_isDirty(true)
+    , m_updated(true)
+    , m_cachedBy(nullptr)
     , m_hasClipRegion(false)
     , m_opacity(1.0f)
 {
@@ -119,12 +130,25 @@ QSGSoftwareRenderableNode::QSGSoftwareRenderableNode(NodeType type, QSGNode *nod
     case QSGSoftwareRenderableNode::RenderNode:
         m_handle.renderNode = static_cast<QSGRenderNode*>(node);
         break;
+    case QSGSoftwareRenderableNode::SubtreeCache:
     case QSGSoftwareRenderableNode::Invalid:
         m_handle.simpleRectNode = nullptr;
         break;
     }
 }
 
+QSGSoftwareRenderableNode::QSGSoftwareRenderableNode(QSGSoftwareSubtreeCache *cache)
+    : m_nodeType(SubtreeCache)
+    , m_isOpaque(false)
+    , m_isDirty(true)
+    , m_updated(true)
+    , m_cachedBy(nullptr)
+    , m_hasClipRegion(false)
+    , m_opacity(1.0f)
+{
+    m_handle.subtreeCache = cache;
+}
+
 QSGSoftwareRenderableNode::~QSGSoftwareRenderableNode()
 {
 
@@ -134,6 +158,9 @@ void QSGSoftwareRenderableNode::update()
 {
     // Update the Node properties
     m_isDirty = true;
+    m_updated = true;
+    if (m_cachedBy)
+        m_cachedBy->invalidate();
 
     QRectF boundingRect;
 
@@ -147,7 +174,7 @@ void QSGSoftwareRenderableNode::update()
         boundingRect = m_handle.simpleRectNode->rect();
         break;
     case QSGSoftwareRenderableNode::SimpleTexture:
-        if (!m_handle.simpleTextureNode->texture()->hasAlphaChannel() && !m_transform.isRotating())
+        if (isOpaqueTexture(m_handle.simpleTextureNode->texture()) && !m_transform.isRotating())
             m_isOpaque = true;
         else
             m_isOpaque = false;
@@ -155,8 +182,10 @@ void QSGSoftwareRenderableNode::update()
         boundingRect = m_handle.simpleTextureNode->rect();
         break;
     case QSGSoftwareRenderableNode::Image:
-        // There isn't a way to tell, so assume it's not
-        m_isOpaque = false;
+        if (m_handle.imageNode->isOpaque() && !m_transform.isRotating())
+            m_isOpaque = true;
+        else
+            m_isOpaque = false;
 
         boundingRect = m_handle.imageNode->rect().toRect();
         break;
@@ -197,7 +226,7 @@ void QSGSoftwareRenderableNode::update()
         boundingRect = m_handle.simpleRectangleNode->rect();
         break;
     case QSGSoftwareRenderableNode::SimpleImage:
-        if (!m_handle.simpleImageNode->texture()->hasAlphaChannel() && !m_transform.isRotating())
+        if (isOpaqueTexture(m_handle.simpleImageNode->texture()) && !m_transform.isRotating())
             m_isOpaque = true;
         else
             m_isOpaque = false;
@@ -218,6 +247,12 @@ void QSGSoftwareRenderableNode::update()
 
         boundingRect = m_handle.renderNode->rect();
         break;
+    case QSGSoftwareRenderableNode::SubtreeCache:
+        // Already in world coordinates, with opacity and clipping applied
+        m_isOpaque = false;
+
+        boundingRect = m_handle.subtreeCache->rect();
+        break;
     default:
         break;
     }
@@ -262,9 +297,8 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
 
     // Check for don't paint conditions
     if (m_nodeType != RenderNode) {
-        if (!m_isDirty || qFuzzyIsNull(m_opacity) || m_dirtyRegion.isEmpty()) {
-            m_isDirty = false;
-            m_dirtyRegion = QRegion();
+        if (!needsPainting()) {
+            discardDirtyRegion();
             return QRegion();
         }
     } else {
@@ -299,16 +333,49 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
         }
     }
 
+    paint(painter, m_dirtyRegion, forceOpaquePainting);
+    return finishPainting();
+}
+
+bool QSGSoftwareRenderableNode::needsPainting() const
+{
+    return m_isDirty && !qFuzzyIsNull(m_opacity) && !m_dirtyRegion.isEmpty();
+}
+
+/*
+    Updates state that the nodes otherwise compute lazily while painting,
+    so that paint() can be called for several tiles concurrently.
+*/
+void QSGSoftwareRenderableNode::prepareForPainting(QPainter *painter)
+{
+    QPaintDevice *device = painter->device();
+    switch (m_nodeType) {
+    case QSGSoftwareRenderableNode::Rectangle:
+        m_handle.rectangleNode->setDevicePixelRatio(device->devicePixelRatio());
+        break;
+    case QSGSoftwareRenderableNode::SimpleImage:
+        static_cast<QSGSoftwareImageNode *>(m_handle.simpleImageNode)->prepareCachedPixmap();
+        break;
+    case QSGSoftwareRenderableNode::SubtreeCache:
+        m_handle.subtreeCache->prepare(painter);
+        break;
+    default:
+        break;
+    }
+}
+
+void QSGSoftwareRenderableNode::paint(QPainter *painter, const QRegion &clipRegion, bool forceOpaquePainting)
+{
     painter->save();
     painter->setOpacity(m_opacity);
 
-    // Set clipRegion to m_dirtyRegion (in world coordinates, so must be done before the setTransform below)
+    // Set clipRegion to clipRegion (in world coordinates, so must be done before the setTransform below)
     // as m_dirtyRegion already accounts for clipRegion
-    painter->setClipRegion(m_dirtyRegion, Qt::ReplaceClip);
+    painter->setClipRegion(clipRegion, Qt::ReplaceClip);
     if (m_clipRegion.rectCount() > 1)
         painter->setClipRegion(m_clipRegion, Qt::IntersectClip);
 
-    painter->setTransform(m_transform, false); //precalculated worldTransform
+    painter->setTransform(m_transform, true); //precalculated worldTransform, on top of a tile offset if any
     if (forceOpaquePainting || m_isOpaque)
         painter->setCompositionMode(QPainter::CompositionMode_Source);
 
@@ -354,12 +421,18 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
         static_cast<QSGSoftwareSpriteNode *>(m_handle.spriteNode)->paint(painter);
         break;
 #endif
+    case QSGSoftwareRenderableNode::SubtreeCache:
+        m_handle.subtreeCache->paint(painter);
+        break;
     default:
         break;
     }
 
     painter->restore();
+}
 
+QRegion QSGSoftwareRenderableNode::finishPainting()
+{
     QRegion areaToBeFlushed = m_dirtyRegion;
     m_previousDirtyRegion = QRegion(m_boundingRectMax);
     m_isDirty = false;
@@ -368,6 +441,23 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
     return areaToBeFlushed;
 }
 
+void QSGSoftwareRenderableNode::discardDirtyRegion()
+{
+    m_isDirty = false;
+    m_dirtyRegion = QRegion();
+}
+
+/*
+    Returns whether update() was called since the last time this function
+    was called, which tells the subtree cache whether the node changed.
+*/
+bool QSGSoftwareRenderableNode::takeUpdated()
+{
+    const bool updated = m_updated;
+    m_updated = false;
+    return updated;
+}
+
 bool QSGSoftwareRenderableNode::isDirtyRegionEmpty() const
 {
     return m_dirtyRegion.isEmpty();
@@ -71,6 +71,7 @@ class QSGSoftwareGlyphNode;
 class QSGSoftwareNinePatchNode;
 class QSGSoftwareSpriteNode;
 class QSGRenderNode;
+class QSGSoftwareSubtreeCache;
 
 class QSGSoftwareRenderableNode
 {
@@ -89,21 +90,35 @@ public:
 #if QT_CONFIG(quick_sprite)
         SpriteNode,
 #endif
-        RenderNode
+        RenderNode,
+        SubtreeCache
     };
 
     QSGSoftwareRenderableNode(NodeType type, QSGNode *node);
+    explicit QSGSoftwareRenderableNode(QSGSoftwareSubtreeCache *cache);
     ~QSGSoftwareRenderableNode();
 
     void update();
 
     QRegion renderNode(QPainter *painter, bool forceOpaquePainting = false);
+
+    // Split up version of renderNode(), used when rendering in tiles
+    bool needsPainting() const;
+    void prepareForPainting(QPainter *painter);
+    void paint(QPainter *painter, const QRegion &clipRegion, bool forceOpaquePainting = false);
+    QRegion finishPainting();
+    void discardDirtyRegion();
     QRect boundingRectMin() const { return m_boundingRectMin; }
     QRect boundingRectMax() const { return m_boundingRectMax; }
     NodeType type() const { return m_nodeType; }
     bool isOpaque() const { return m_isOpaque; }
     bool isDirty() const { return m_isDirty; }
     bool isDirtyRegionEmpty() const;
+    bool takeUpdated();
+    QSGSoftwareSubtreeCache *subtreeCache() const { return m_nodeType == SubtreeCache ? m_handle.subtreeCache : nullptr; }
+    // The subtree cache this node is drawn into, if any
+    QSGSoftwareSubtreeCache *cachedBy() const { return m_cachedBy; }
+    void setCachedBy(QSGSoftwareSubtreeCache *cache) { m_cachedBy = cache; }
 
     void setTransform(const QTransform &transform);
     void setClipRegion(const QRegion &clipRegion, bool hasClipRegion = true);
@@ -134,6 +149,7 @@ private:
         QSGImageNode *simpleImageNode;
         QSGSoftwareSpriteNode *spriteNode;
         QSGRenderNode *renderNode;
+        QSGSoftwareSubtreeCache *subtreeCache;
     };
 
     const NodeType m_nodeType;
@@ -142,6 +158,8 @@ private:
     bool m_isOpaque;
 
     bool m_isDirty;
+    bool m_updated;
+    QSGSoftwareSubtreeCache *m_cachedBy;
     QRegion m_dirtyRegion;
     QRegion m_previousDirtyRegion;
 
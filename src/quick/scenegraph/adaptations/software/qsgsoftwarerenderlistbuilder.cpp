@@ -60,13 +60,14 @@ QSGSoftwareRenderListBuilder::QSGSoftwareRenderListBuilder(QSGAbstractSoftwareRe
 
 }
 
-bool QSGSoftwareRenderListBuilder::visit(QSGTransformNode *)
+bool QSGSoftwareRenderListBuilder::visit(QSGTransformNode *node)
 {
-    return true;
+    return m_renderer->beginSubtree(node);
 }
 
-void QSGSoftwareRenderListBuilder::endVisit(QSGTransformNode *)
+void QSGSoftwareRenderListBuilder::endVisit(QSGTransformNode *node)
 {
+    m_renderer->endSubtree(node);
 }
 
 bool QSGSoftwareRenderListBuilder::visit(QSGClipNode *)
@@ -0,0 +1,288 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsgsoftwaresubtreecache_p.h"
+#include "qsgsoftwarerenderablenode_p.h"
+
+#include <QtGui/QPainter>
+#include <QtQuick/qsgnode.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+QSGSoftwareSubtreeCache::QSGSoftwareSubtreeCache(QSGNode *node, const QVector<QSGSoftwareRenderableNode *> &nodes, const QRect &rect)
+    : lastUsedFrame(0)
+    , m_node(node)
+    , m_nodes(nodes)
+    , m_renderableNode(new QSGSoftwareRenderableNode(this))
+    , m_rect(rect)
+    , m_valid(true)
+{
+    for (QSGSoftwareRenderableNode *cached : qAsConst(m_nodes))
+        cached->setCachedBy(this);
+    m_renderableNode->update();
+    // What the cache shows is on screen already, so there is nothing to paint yet
+    m_renderableNode->finishPainting();
+}
+
+QSGSoftwareSubtreeCache::~QSGSoftwareSubtreeCache()
+{
+    for (QSGSoftwareRenderableNode *cached : qAsConst(m_nodes))
+        cached->setCachedBy(nullptr);
+    delete m_renderableNode;
+}
+
+/*
+    Renders the cached nodes into the image, unless that happened already
+    for the device pixel ratio and render hints of painter. Each node is
+    painted with its own transform, clip and opacity, exactly as it would
+    be on screen.
+*/
+void QSGSoftwareSubtreeCache::prepare(QPainter *painter)
+{
+    const qreal ratio = painter->device()->devicePixelRatioF();
+    const QPainter::RenderHints hints = painter->renderHints();
+    if (!m_image.isNull() && qFuzzyCompare(m_image.devicePixelRatioF(), ratio) && m_renderHints == hints)
+        return;
+
+    m_image = QImage(m_rect.size() * ratio, QImage::Format_ARGB32_Premultiplied);
+    m_image.setDevicePixelRatio(ratio);
+    m_image.fill(Qt::transparent);
+    m_renderHints = hints;
+
+    QPainter imagePainter(&m_image);
+    imagePainter.setRenderHints(hints);
+    imagePainter.translate(-m_rect.topLeft());
+    for (QSGSoftwareRenderableNode *node : qAsConst(m_nodes)) {
+        const QRect bounds = node->boundingRectMax() & m_rect;
+        if (bounds.isEmpty() || qFuzzyIsNull(node->opacity()))
+            continue;
+        node->prepareForPainting(&imagePainter);
+        node->paint(&imagePainter, QRegion(bounds));
+    }
+}
+
+void QSGSoftwareSubtreeCache::paint(QPainter *painter)
+{
+    prepare(painter);
+    painter->drawImage(m_rect.topLeft(), m_image);
+}
+
+QSGSoftwareSubtreeCacheManager::QSGSoftwareSubtreeCacheManager(int staticFrames)
+    : m_staticFrames(staticFrames)
+    , m_frame(0)
+{
+}
+
+QSGSoftwareSubtreeCacheManager::~QSGSoftwareSubtreeCacheManager()
+{
+    clear();
+}
+
+void QSGSoftwareSubtreeCacheManager::beginFrame()
+{
+    ++m_frame;
+    m_previousUnchangedFrames.swap(m_unchangedFrames);
+    m_unchangedFrames.clear();
+    m_stack.clear();
+    m_candidates.clear();
+}
+
+/*
+    Called when the render list builder enters node. Returns false when the
+    subtree is cached and unchanged, in which case the cache has been
+    appended to the render list and the subtree does not need to be visited.
+*/
+bool QSGSoftwareSubtreeCacheManager::beginSubtree(QSGNode *node, RenderList *renderList)
+{
+    bool changed = false;
+    if (QSGSoftwareSubtreeCache *cache = m_caches.value(node)) {
+        if (cache->isValid()) {
+            cache->lastUsedFrame = m_frame;
+            m_unchangedFrames.insert(node, m_previousUnchangedFrames.value(node) + 1);
+            renderList->append(cache->renderableNode());
+            return false;
+        }
+        removeCache(cache);
+        changed = true;
+    }
+
+    // The render list always starts with the background
+    RenderList::iterator before = renderList->end();
+    --before;
+    const Subtree subtree = { node, before, renderList->size(), 0, changed };
+    m_stack.append(subtree);
+    return true;
+}
+
+void QSGSoftwareSubtreeCacheManager::endSubtree(QSGNode *node, RenderList *renderList)
+{
+    // Cached subtrees were not entered
+    if (m_stack.isEmpty() || m_stack.constLast().node != node)
+        return;
+
+    Subtree subtree = m_stack.takeLast();
+    subtree.count = renderList->size() - subtree.start;
+    if (!m_stack.isEmpty() && subtree.changed)
+        m_stack.last().changed = true;
+
+    if (subtree.count < MinimumNodes)
+        return;
+
+    const int frames = subtree.changed ? 0 : m_previousUnchangedFrames.value(node) + 1;
+    m_unchangedFrames.insert(node, frames);
+    if (frames >= m_staticFrames)
+        m_candidates.append(subtree);
+}
+
+void QSGSoftwareSubtreeCacheManager::nodeAppended(QSGSoftwareRenderableNode *node)
+{
+    // Render nodes paint whatever they like, so they are never cached
+    const bool changed = node->takeUpdated() || node->type() == QSGSoftwareRenderableNode::RenderNode;
+    if (changed && !m_stack.isEmpty())
+        m_stack.last().changed = true;
+}
+
+/*
+    Drops the caches that were not used for this frame and replaces the
+    outermost subtrees that have been unchanged for long enough by caches.
+*/
+void QSGSoftwareSubtreeCacheManager::endFrame(RenderList *renderList, const QRect &renderArea)
+{
+    QVector<QSGSoftwareSubtreeCache *> unused;
+    for (QSGSoftwareSubtreeCache *cache : qAsConst(m_caches)) {
+        if (cache->lastUsedFrame != m_frame)
+            unused.append(cache);
+    }
+    for (QSGSoftwareSubtreeCache *cache : qAsConst(unused))
+        removeCache(cache);
+
+    if (m_candidates.isEmpty())
+        return;
+
+    // Candidates were collected children first
+    std::sort(m_candidates.begin(), m_candidates.end(), [](const Subtree &a, const Subtree &b) {
+        return a.start < b.start || (a.start == b.start && a.count > b.count);
+    });
+    QVector<Subtree> selected;
+    int end = 0;
+    for (const Subtree &subtree : qAsConst(m_candidates)) {
+        if (subtree.start < end)
+            continue;
+        selected.append(subtree);
+        end = subtree.start + subtree.count;
+    }
+
+    // Replace from the back, so that the iterators of the other subtrees stay valid
+    for (int i = selected.count() - 1; i >= 0; --i) {
+        const Subtree &subtree = selected.at(i);
+
+        QVector<QSGSoftwareRenderableNode *> nodes;
+        QVector<QSGSoftwareSubtreeCache *> nestedCaches;
+        nodes.reserve(subtree.count);
+        QRect rect;
+        RenderList::iterator it = subtree.before;
+        ++it;
+        for (int n = 0; n < subtree.count; ++n, ++it) {
+            if (QSGSoftwareSubtreeCache *nested = (*it)->subtreeCache()) {
+                nodes += nested->nodes();
+                nestedCaches.append(nested);
+            } else {
+                nodes.append(*it);
+            }
+            rect |= (*it)->boundingRectMax();
+        }
+        rect &= renderArea;
+        if (rect.isEmpty())
+            continue;
+
+        it = subtree.before;
+        ++it;
+        for (int n = 0; n < subtree.count; ++n)
+            it = renderList->erase(it);
+        for (QSGSoftwareSubtreeCache *nested : qAsConst(nestedCaches))
+            removeCache(nested);
+
+        QSGSoftwareSubtreeCache *cache = new QSGSoftwareSubtreeCache(subtree.node, nodes, rect);
+        cache->lastUsedFrame = m_frame;
+        m_caches.insert(subtree.node, cache);
+        renderList->insert(it, cache->renderableNode());
+    }
+}
+
+void QSGSoftwareSubtreeCacheManager::nodeAdded(QSGNode *node)
+{
+    if (m_caches.isEmpty())
+        return;
+
+    for (QSGNode *parent = node; parent; parent = parent->parent()) {
+        if (QSGSoftwareSubtreeCache *cache = m_caches.value(parent)) {
+            removeCache(cache);
+            return;
+        }
+    }
+}
+
+void QSGSoftwareSubtreeCacheManager::nodeRemoved(QSGNode *node, QSGSoftwareRenderableNode *renderable)
+{
+    if (m_caches.isEmpty())
+        return;
+
+    if (QSGSoftwareSubtreeCache *cache = m_caches.value(node))
+        removeCache(cache);
+    if (QSGSoftwareSubtreeCache *cache = renderable ? renderable->cachedBy() : nullptr)
+        removeCache(cache);
+}
+
+void QSGSoftwareSubtreeCacheManager::clear()
+{
+    qDeleteAll(m_caches);
+    m_caches.clear();
+    m_unchangedFrames.clear();
+}
+
+void QSGSoftwareSubtreeCacheManager::removeCache(QSGSoftwareSubtreeCache *cache)
+{
+    m_caches.remove(cache->node());
+    delete cache;
+}
+
+QT_END_NAMESPACE
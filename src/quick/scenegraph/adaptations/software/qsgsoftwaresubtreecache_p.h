@@ -0,0 +1,155 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtQuick module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSGSOFTWARESUBTREECACHE_P_H
+#define QSGSOFTWARESUBTREECACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/QHash>
+#include <QtCore/QLinkedList>
+#include <QtCore/QRect>
+#include <QtCore/QVector>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
+
+QT_BEGIN_NAMESPACE
+
+class QSGNode;
+class QSGSoftwareRenderableNode;
+
+/*
+    A rasterized copy of a contiguous run of the render list, belonging to
+    one subtree of the scene graph. The image is rendered on first use and
+    drawn by a renderable node of type SubtreeCache in place of the nodes
+    it was made from. Updating any of these nodes invalidates the cache.
+*/
+class QSGSoftwareSubtreeCache
+{
+public:
+    QSGSoftwareSubtreeCache(QSGNode *node, const QVector<QSGSoftwareRenderableNode *> &nodes, const QRect &rect);
+    ~QSGSoftwareSubtreeCache();
+
+    QSGNode *node() const { return m_node; }
+    const QVector<QSGSoftwareRenderableNode *> &nodes() const { return m_nodes; }
+    QSGSoftwareRenderableNode *renderableNode() const { return m_renderableNode; }
+    QRect rect() const { return m_rect; }
+
+    bool isValid() const { return m_valid; }
+    void invalidate() { m_valid = false; }
+
+    void prepare(QPainter *painter);
+    void paint(QPainter *painter);
+
+    int lastUsedFrame;
+
+private:
+    QSGNode *m_node;
+    QVector<QSGSoftwareRenderableNode *> m_nodes;
+    QSGSoftwareRenderableNode *m_renderableNode;
+    QRect m_rect;
+    QImage m_image;
+    QPainter::RenderHints m_renderHints;
+    bool m_valid;
+};
+
+/*
+    Tracks which subtrees of the scene have not changed for a number of
+    frames while the render list is built, and replaces the render list
+    entries of such subtrees by a single cached image.
+*/
+class QSGSoftwareSubtreeCacheManager
+{
+public:
+    typedef QLinkedList<QSGSoftwareRenderableNode *> RenderList;
+
+    explicit QSGSoftwareSubtreeCacheManager(int staticFrames);
+    ~QSGSoftwareSubtreeCacheManager();
+
+    void beginFrame();
+    bool beginSubtree(QSGNode *node, RenderList *renderList);
+    void endSubtree(QSGNode *node, RenderList *renderList);
+    void nodeAppended(QSGSoftwareRenderableNode *node);
+    void endFrame(RenderList *renderList, const QRect &renderArea);
+
+    void nodeAdded(QSGNode *node);
+    void nodeRemoved(QSGNode *node, QSGSoftwareRenderableNode *renderable);
+    void clear();
+
+    int cacheCount() const { return m_caches.count(); }
+
+private:
+    enum { MinimumNodes = 8 };
+
+    struct Subtree {
+        QSGNode *node;
+        RenderList::iterator before;
+        int start;
+        int count;
+        bool changed;
+    };
+
+    void removeCache(QSGSoftwareSubtreeCache *cache);
+
+    const int m_staticFrames;
+    int m_frame;
+
+    QHash<QSGNode *, QSGSoftwareSubtreeCache *> m_caches;
+
+    // Number of consecutive frames each large enough subtree was unchanged for
+    QHash<QSGNode *, int> m_unchangedFrames;
+    QHash<QSGNode *, int> m_previousUnchangedFrames;
+
+    QVector<Subtree> m_stack;
+    QVector<Subtree> m_candidates;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGSOFTWARESUBTREECACHE_P_H
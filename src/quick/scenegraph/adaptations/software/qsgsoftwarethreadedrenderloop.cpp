@@ -500,9 +500,15 @@ void QSGSoftwareRenderThread::syncAndRender()
     qCDebug(QSG_RASTER_LOG_RENDERLOOP, "RT - rendering started");
 
     if (rtAnim->isRunning()) {
+        QElapsedTimer statisticsTimer;
+        const bool recordStatistics = wd->isRecordingFrameStatistics();
+        if (recordStatistics)
+            statisticsTimer.start();
         wd->animationController->lock();
         rtAnim->advance();
         wd->animationController->unlock();
+        if (recordStatistics)
+            wd->renderFrameStatistics.animationTime += statisticsTimer.nsecsElapsed();
     }
 
     bool canRender = wd->renderer != nullptr;
@@ -989,7 +995,13 @@ void QSGSoftwareThreadedRenderLoop::polishAndSync(QSGSoftwareThreadedRenderLoop:
 
     if (!animationTimer && m_anim->isRunning()) {
         qCDebug(QSG_RASTER_LOG_RENDERLOOP, "polishAndSync - advancing animations");
+        QElapsedTimer statisticsTimer;
+        const bool recordStatistics = wd->isRecordingFrameStatistics();
+        if (recordStatistics)
+            statisticsTimer.start();
         m_anim->advance();
+        if (recordStatistics)
+            wd->guiFrameStatistics.animationTime += statisticsTimer.nsecsElapsed();
         // We need to trigger another sync to keep animations running...
         w->window->requestUpdate();
         emit timeToIncubate();
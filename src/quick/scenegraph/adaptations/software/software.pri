@@ -5,6 +5,7 @@ QT += gui-private core-private qml-private
 SOURCES += \
     $$PWD/qsgsoftwarecontext.cpp \
     $$PWD/qsgabstractsoftwarerenderer.cpp \
+    $$PWD/qsgsoftwareblitter.cpp \
     $$PWD/qsgsoftwareglyphnode.cpp \
     $$PWD/qsgsoftwareinternalimagenode.cpp \
     $$PWD/qsgsoftwarepublicnodes.cpp \
@@ -17,6 +18,7 @@ SOURCES += \
     $$PWD/qsgsoftwarerenderer.cpp \
     $$PWD/qsgsoftwarerenderlistbuilder.cpp \
     $$PWD/qsgsoftwarerenderloop.cpp \
+    $$PWD/qsgsoftwaresubtreecache.cpp \
     $$PWD/qsgsoftwarelayer.cpp \
     $$PWD/qsgsoftwareadaptation.cpp \
     $$PWD/qsgsoftwarethreadedrenderloop.cpp
@@ -24,6 +26,7 @@ SOURCES += \
 HEADERS += \
     $$PWD/qsgsoftwarecontext_p.h \
     $$PWD/qsgabstractsoftwarerenderer_p.h \
+    $$PWD/qsgsoftwareblitter_p.h \
     $$PWD/qsgsoftwareglyphnode_p.h \
     $$PWD/qsgsoftwareinternalimagenode_p.h \
     $$PWD/qsgsoftwarepublicnodes_p.h \
@@ -36,6 +39,7 @@ HEADERS += \
     $$PWD/qsgsoftwarerenderer_p.h \
     $$PWD/qsgsoftwarerenderlistbuilder_p.h \
     $$PWD/qsgsoftwarerenderloop_p.h \
+    $$PWD/qsgsoftwaresubtreecache_p.h \
     $$PWD/qsgsoftwarelayer_p.h \
     $$PWD/qsgsoftwareadaptation_p.h \
     $$PWD/qsgsoftwarethreadedrenderloop_p.h
@@ -46,7 +46,11 @@
 
 #include <qmath.h>
 
+#include <QtCore/QAtomicInt>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThreadPool>
 #include <QtCore/QtNumeric>
 
 #include <QtGui/QGuiApplication>
@@ -60,6 +64,7 @@
 #include "qsgmaterialshader_p.h"
 
 #include <algorithm>
+#include <functional>
 
 #ifndef GL_DOUBLE
    #define GL_DOUBLE 0x140A
@@ -93,6 +98,67 @@ static QElapsedTimer qsg_renderer_timer;
 #define QSGNODE_TRAVERSE(NODE) for (QSGNode *child = NODE->firstChild(); child; child = child->nextSibling())
 #define SHADOWNODE_TRAVERSE(NODE) for (Node *child = NODE->firstChild(); child; child = child->sibling())
 
+Q_GLOBAL_STATIC(QThreadPool, qsg_renderer_thread_pool)
+
+class ParallelJob : public QRunnable
+{
+public:
+    ParallelJob(const std::function<void (int)> &job, int count, QAtomicInt *next, QSemaphore *finished)
+        : m_job(job)
+        , m_count(count)
+        , m_next(next)
+        , m_finished(finished)
+    {
+    }
+
+    void run() override
+    {
+        work(m_job, m_count, m_next);
+        m_finished->release();
+    }
+
+    static void work(const std::function<void (int)> &job, int count, QAtomicInt *next)
+    {
+        int i;
+        while ((i = next->fetchAndAddRelaxed(1)) < count)
+            job(i);
+    }
+
+private:
+    const std::function<void (int)> &m_job;
+    int m_count;
+    QAtomicInt *m_next;
+    QSemaphore *m_finished;
+};
+
+/*
+ * Calls job for every index in [0, count), spreading the calls over the
+ * calling thread and up to threadCount - 1 threads from the renderer's
+ * thread pool. Returns once all calls have completed.
+ */
+static void qsg_runInParallel(int threadCount, int count, const std::function<void (int)> &job)
+{
+    if (count <= 0)
+        return;
+
+    QThreadPool *pool = qsg_renderer_thread_pool();
+    if (pool->maxThreadCount() < threadCount - 1)
+        pool->setMaxThreadCount(threadCount - 1);
+
+    QAtomicInt next(0);
+    QSemaphore finished;
+    const int helpers = qMin(threadCount - 1, count - 1);
+    for (int i = 0; i < helpers; ++i)
+        pool->start(new ParallelJob(job, count, &next, &finished));
+    ParallelJob::work(job, count, &next);
+    finished.acquire(helpers);
+}
+
+static inline int qsg_alignUploadSize(int size)
+{
+    return (size + 15) & ~15;
+}
+
 static inline int size_of_type(GLenum type)
 {
     static int sizes[] = {
@@ -756,7 +822,6 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx)
     , m_alphaRenderList(64)
     , m_nextRenderOrder(0)
     , m_partialRebuild(false)
-    , m_partialRebuildRoot(0)
     , m_useDepthBuffer(true)
     , m_opaqueBatches(16)
     , m_alphaBatches(16)
@@ -778,6 +843,7 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx)
 #ifdef QSG_SEPARATE_INDEX_BUFFER
     , m_indexUploadPool(64)
 #endif
+    , m_pendingUploads(16)
     , m_vao(0)
     , m_visualizeMode(VisualizeNothing)
 {
@@ -800,12 +866,18 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx)
         else if (strategy == "stream")
             m_bufferStrategy = GL_STREAM_DRAW;
     }
+    // Buffers that are expected to be modified can be updated in place.
+    m_partialUploads = m_bufferStrategy != GL_STATIC_DRAW;
 
     m_batchNodeThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_NODE_THRESHOLD", 64);
     m_batchVertexThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_VERTEX_THRESHOLD", 1024);
+    m_threadCount = qt_sg_envInt("QSG_RENDERER_THREADS", 1);
+    m_overlapGridThreshold = qt_sg_envInt("QSG_RENDERER_OVERLAP_GRID_THRESHOLD", OverlapGrid::MinimumElements);
 
     if (Q_UNLIKELY(debug_build() || debug_render())) {
-        qDebug() << "Batch thresholds: nodes:" << m_batchNodeThreshold << " vertices:" << m_batchVertexThreshold;
+        qDebug() << "Batch thresholds: nodes:" << m_batchNodeThreshold << " vertices:" << m_batchVertexThreshold
+                 << " overlap grid:" << m_overlapGridThreshold;
+        qDebug() << "Threads used for building render lists and uploading batches:" << qMax(m_threadCount, 1);
         qDebug() << "Using buffer strategy:" << (m_bufferStrategy == GL_STATIC_DRAW ? "static" : (m_bufferStrategy == GL_DYNAMIC_DRAW ? "dynamic" : "stream"));
     }
 
@@ -1004,6 +1076,7 @@ void Renderer::nodeWasTransformed(Node *node, int *vertexCount)
                     invalidateBatchAndOverlappingRenderOrders(e->batch);
                 } else if (e->batch->merged) {
                     e->batch->needsUpload = true;
+                    e->vertexDataDirty = true;
                 }
             }
         }
@@ -1076,6 +1149,7 @@ void Renderer::nodeWasRemoved(Node *node)
             }
             if (e->batch) {
                 e->batch->needsUpload = true;
+                e->batch->hasElementOffsets = false;
             }
 
         }
@@ -1223,6 +1297,7 @@ void Renderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
                     invalidateBatchAndOverlappingRenderOrders(e->batch);
                 } else {
                     b->needsUpload = true;
+                    e->vertexDataDirty = true;
                 }
             }
         }
@@ -1285,7 +1360,7 @@ void Renderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
  * is important and they are not preserved in the shadow tree, so we must
  * use the actual QSGNode tree.
  */
-void Renderer::buildRenderLists(QSGNode *node)
+void Renderer::buildRenderLists(QSGNode *node, RenderLists *lists)
 {
     if (node->isSubtreeBlocked())
         return;
@@ -1301,11 +1376,11 @@ void Renderer::buildRenderLists(QSGNode *node)
 
         bool opaque = gn->inheritedOpacity() > OPAQUE_LIMIT && !(gn->activeMaterial()->flags() & QSGMaterial::Blending);
         if (opaque && m_useDepthBuffer)
-            m_opaqueRenderList << e;
+            lists->opaque->add(e);
         else
-            m_alphaRenderList << e;
+            lists->alpha->add(e);
 
-        e->order = ++m_nextRenderOrder;
+        e->order = ++lists->nextRenderOrder;
         // Used while rebuilding partial roots.
         if (m_partialRebuild)
             e->orphaned = false;
@@ -1313,31 +1388,69 @@ void Renderer::buildRenderLists(QSGNode *node)
     } else if (node->type() == QSGNode::ClipNodeType || shadowNode->isBatchRoot) {
         Q_ASSERT(m_nodes.contains(node));
         BatchRootInfo *info = batchRootInfo(shadowNode);
-        if (node == m_partialRebuildRoot) {
-            m_nextRenderOrder = info->firstOrder;
+        if (node == lists->partialRebuildRoot) {
+            lists->nextRenderOrder = info->firstOrder;
             QSGNODE_TRAVERSE(node)
-                    buildRenderLists(child);
-            m_nextRenderOrder = info->lastOrder + 1;
+                    buildRenderLists(child, lists);
+            lists->nextRenderOrder = info->lastOrder + 1;
         } else {
-            int currentOrder = m_nextRenderOrder;
+            int currentOrder = lists->nextRenderOrder;
             QSGNODE_TRAVERSE(node)
-                buildRenderLists(child);
-            int padding = (m_nextRenderOrder - currentOrder) >> 2;
+                buildRenderLists(child, lists);
+            int padding = (lists->nextRenderOrder - currentOrder) >> 2;
             info->firstOrder = currentOrder;
             info->availableOrders = padding;
-            info->lastOrder = m_nextRenderOrder + padding;
-            m_nextRenderOrder = info->lastOrder;
+            info->lastOrder = lists->nextRenderOrder + padding;
+            lists->nextRenderOrder = info->lastOrder;
         }
         return;
     } else if (node->type() == QSGNode::RenderNodeType) {
         RenderNodeElement *e = shadowNode->renderNodeElement();
-        m_alphaRenderList << e;
-        e->order = ++m_nextRenderOrder;
+        lists->alpha->add(e);
+        e->order = ++lists->nextRenderOrder;
         Q_ASSERT(e);
     }
 
     QSGNODE_TRAVERSE(node)
-        buildRenderLists(child);
+        buildRenderLists(child, lists);
+}
+
+/*
+ * Builds the render lists for several tagged roots at once. The roots are
+ * disjoint subtrees whose render orders were assigned in a previous frame,
+ * so each can be traversed on its own thread into its own lists. The lists
+ * are concatenated afterwards and sorted by the caller.
+ */
+void Renderer::buildRenderListsInParallel(const QVector<Node *> &roots)
+{
+    struct RootLists {
+        RootLists() : opaque(16), alpha(16), lists(&opaque, &alpha) { }
+        QDataBuffer<Element *> opaque;
+        QDataBuffer<Element *> alpha;
+        RenderLists lists;
+    };
+
+    QVector<RootLists *> rootLists;
+    rootLists.reserve(roots.size());
+    for (Node *root : roots) {
+        RootLists *l = new RootLists;
+        l->lists.nextRenderOrder = batchRootInfo(root)->firstOrder;
+        l->lists.partialRebuildRoot = root->sgNode;
+        rootLists << l;
+    }
+
+    qsg_runInParallel(m_threadCount, roots.size(), [&](int i) {
+        buildRenderLists(roots.at(i)->sgNode, &rootLists.at(i)->lists);
+    });
+
+    for (RootLists *l : qAsConst(rootLists)) {
+        for (int i=0; i<l->opaque.size(); ++i)
+            m_opaqueRenderList.add(l->opaque.at(i));
+        for (int i=0; i<l->alpha.size(); ++i)
+            m_alphaRenderList.add(l->alpha.at(i));
+        m_nextRenderOrder = qMax(m_nextRenderOrder, l->lists.nextRenderOrder);
+    }
+    qDeleteAll(rootLists);
 }
 
 void Renderer::tagSubRoots(Node *node)
@@ -1423,19 +1536,28 @@ void Renderer::buildRenderListsForTaggedRoots()
     int maxRenderOrder = m_nextRenderOrder;
     m_partialRebuild = true;
     // Traverse each root, assigning it
+    QVector<Node *> topmostRoots;
     for (QSet<Node *>::const_iterator it = m_taggedRoots.constBegin();
          it != m_taggedRoots.constEnd(); ++it) {
         Node *root = *it;
         BatchRootInfo *i = batchRootInfo(root);
         if ((!i->parentRoot || !m_taggedRoots.contains(i->parentRoot))
              && !nodeUpdater()->isNodeBlocked(root->sgNode, rootNode())) {
-            m_nextRenderOrder = i->firstOrder;
-            m_partialRebuildRoot = root->sgNode;
-            buildRenderLists(root->sgNode);
+            topmostRoots << root;
+        }
+    }
+    if (m_threadCount > 1 && topmostRoots.size() > 1) {
+        buildRenderListsInParallel(topmostRoots);
+    } else {
+        for (Node *root : qAsConst(topmostRoots)) {
+            RenderLists lists(&m_opaqueRenderList, &m_alphaRenderList);
+            lists.nextRenderOrder = batchRootInfo(root)->firstOrder;
+            lists.partialRebuildRoot = root->sgNode;
+            buildRenderLists(root->sgNode, &lists);
+            m_nextRenderOrder = lists.nextRenderOrder;
         }
     }
     m_partialRebuild = false;
-    m_partialRebuildRoot = 0;
     m_taggedRoots.clear();
     m_nextRenderOrder = qMax(m_nextRenderOrder, maxRenderOrder);
 
@@ -1462,9 +1584,9 @@ void Renderer::buildRenderListsFromScratch()
     m_opaqueBatches.reset();
     m_alphaBatches.reset();
 
-    m_nextRenderOrder = 0;
-
-    buildRenderLists(rootNode());
+    RenderLists lists(&m_opaqueRenderList, &m_alphaRenderList);
+    buildRenderLists(rootNode(), &lists);
+    m_nextRenderOrder = lists.nextRenderOrder;
 }
 
 void Renderer::invalidateBatchAndOverlappingRenderOrders(Batch *batch)
@@ -1555,8 +1677,145 @@ void Renderer::prepareOpaqueBatches()
     }
 }
 
+OverlapGrid::OverlapGrid()
+    : m_cellWidth(0)
+    , m_cellHeight(0)
+    , m_columns(0)
+    , m_rows(0)
+    , m_cellStart(64)
+    , m_indices(256)
+    , m_large(16)
+{
+}
+
+void OverlapGrid::cellRange(const Rect &bounds, int *x0, int *y0, int *x1, int *y1) const
+{
+    // Compare in float before converting, as the bounds can be far outside
+    // the range of int.
+    const float left = qBound(0.0f, (bounds.tl.x - m_bounds.tl.x) / m_cellWidth, float(m_columns - 1));
+    const float top = qBound(0.0f, (bounds.tl.y - m_bounds.tl.y) / m_cellHeight, float(m_rows - 1));
+    const float right = qBound(0.0f, (bounds.br.x - m_bounds.tl.x) / m_cellWidth, float(m_columns - 1));
+    const float bottom = qBound(0.0f, (bounds.br.y - m_bounds.tl.y) / m_cellHeight, float(m_rows - 1));
+    *x0 = int(left);
+    *y0 = int(top);
+    *x1 = int(right);
+    *y1 = int(bottom);
+}
+
+int OverlapGrid::cellCount(const Rect &bounds) const
+{
+    int x0, y0, x1, y1;
+    cellRange(bounds, &x0, &y0, &x1, &y1);
+    return (x1 - x0 + 1) * (y1 - y0 + 1);
+}
+
+void OverlapGrid::build(const QDataBuffer<Element *> &renderList, int minimumElements)
+{
+    m_columns = 0;
+    m_large.reset();
+
+    int count = 0;
+    m_bounds.set(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (int i=0; i<renderList.size(); ++i) {
+        const Element *e = renderList.at(i);
+        if (!e || e->batch || e->isRenderNode || e->boundsOutsideFloatRange)
+            continue;
+        m_bounds |= e->bounds;
+        ++count;
+    }
+    if (count < minimumElements)
+        return;
+
+    // Aim for a handful of elements per cell.
+    const int cells = qBound(1, int(qSqrt(count / 4.0)), int(MaximumCellsPerAxis));
+    m_columns = cells;
+    m_rows = cells;
+    m_cellWidth = qMax((m_bounds.br.x - m_bounds.tl.x) / cells, 1.0f);
+    m_cellHeight = qMax((m_bounds.br.y - m_bounds.tl.y) / cells, 1.0f);
+
+    // Count the entries in each cell, then turn the counts into offsets and
+    // fill in the indices. Visiting the render list in order leaves the
+    // indices in each cell sorted.
+    m_cellStart.resize(m_columns * m_rows + 1);
+    memset(m_cellStart.data(), 0, m_cellStart.size() * sizeof(int));
+    int entries = 0;
+    for (int i=0; i<renderList.size(); ++i) {
+        const Element *e = renderList.at(i);
+        if (!e || e->batch || e->isRenderNode)
+            continue;
+        int x0, y0, x1, y1;
+        cellRange(e->bounds, &x0, &y0, &x1, &y1);
+        if (e->boundsOutsideFloatRange || (x1 - x0 + 1) * (y1 - y0 + 1) > MaximumCellsPerElement) {
+            m_large.add(i);
+            continue;
+        }
+        for (int y=y0; y<=y1; ++y) {
+            for (int x=x0; x<=x1; ++x)
+                ++m_cellStart.data()[y * m_columns + x + 1];
+        }
+        entries += (x1 - x0 + 1) * (y1 - y0 + 1);
+    }
+    for (int c=1; c<m_cellStart.size(); ++c)
+        m_cellStart.data()[c] += m_cellStart.at(c - 1);
+
+    m_indices.resize(entries);
+    int *fill = m_indices.data();
+    for (int i=0; i<renderList.size(); ++i) {
+        const Element *e = renderList.at(i);
+        if (!e || e->batch || e->isRenderNode || e->boundsOutsideFloatRange)
+            continue;
+        int x0, y0, x1, y1;
+        cellRange(e->bounds, &x0, &y0, &x1, &y1);
+        if ((x1 - x0 + 1) * (y1 - y0 + 1) > MaximumCellsPerElement)
+            continue;
+        for (int y=y0; y<=y1; ++y) {
+            for (int x=x0; x<=x1; ++x)
+                fill[m_cellStart.data()[y * m_columns + x]++] = i;
+        }
+    }
+    // Filling advanced each offset to the start of the next cell, shift them back.
+    for (int c=m_cellStart.size() - 1; c>0; --c)
+        m_cellStart.data()[c] = m_cellStart.at(c - 1);
+    m_cellStart.data()[0] = 0;
+}
+
+static bool qsg_overlapsInRange(const QDataBuffer<Element *> &renderList, const int *begin, const int *end,
+                                int first, int last, const Rect &bounds)
+{
+    for (const int *i = std::lower_bound(begin, end, first); i != end && *i <= last; ++i) {
+        Element *e = renderList.at(*i);
+        if (!e->batch && e->bounds.intersects(bounds))
+            return true;
+    }
+    return false;
+}
+
+bool OverlapGrid::overlaps(const QDataBuffer<Element *> &renderList, int first, int last, const Rect &bounds) const
+{
+    if (qsg_overlapsInRange(renderList, m_large.data(), m_large.data() + m_large.size(), first, last, bounds))
+        return true;
+
+    int x0, y0, x1, y1;
+    cellRange(bounds, &x0, &y0, &x1, &y1);
+    const int *indices = m_indices.data();
+    for (int y=y0; y<=y1; ++y) {
+        for (int x=x0; x<=x1; ++x) {
+            const int c = y * m_columns + x;
+            if (qsg_overlapsInRange(renderList, indices + m_cellStart.at(c), indices + m_cellStart.at(c + 1),
+                                    first, last, bounds))
+                return true;
+        }
+    }
+    return false;
+}
+
 bool Renderer::checkOverlap(int first, int last, const Rect &bounds)
 {
+    // Looking up a few cells in the grid is cheaper than scanning a long
+    // range of the render list, but not the other way around.
+    if (m_overlapGrid.isValid() && m_overlapGrid.cellCount(bounds) < last - first)
+        return m_overlapGrid.overlaps(m_alphaRenderList, first, last, bounds);
+
     for (int i=first; i<=last; ++i) {
         Element *e = m_alphaRenderList.at(i);
         if (!e || e->batch)
@@ -1577,6 +1836,10 @@ bool Renderer::checkOverlap(int first, int last, const Rect &bounds)
  * to checkOverlap what-so-ever. This also ensures that when all consecutive
  * items are matching (such as a table of text), we don't build up an
  * overlap bounds and thus do not require full overlap checks.
+ *
+ * When the checks do happen, for instance with many interleaved text and
+ * rectangle elements, the overlap grid limits each of them to the elements
+ * near the bounds in question.
  */
 
 void Renderer::prepareAlphaBatches()
@@ -1589,6 +1852,16 @@ void Renderer::prepareAlphaBatches()
         e->ensureBoundsValid();
     }
 
+    QElapsedTimer timer;
+    qint64 timeGrid = 0;
+    if (Q_UNLIKELY(debug_render()))
+        timer.start();
+
+    m_overlapGrid.build(m_alphaRenderList, m_overlapGridThreshold);
+
+    if (Q_UNLIKELY(debug_render()))
+        timeGrid = timer.nsecsElapsed();
+
     for (int i=0; i<m_alphaRenderList.size(); ++i) {
         Element *ei = m_alphaRenderList.at(i);
         if (!ei || ei->batch)
@@ -1664,7 +1937,12 @@ void Renderer::prepareAlphaBatches()
         batch->lastOrderInBatch = next->order;
     }
 
-
+    if (Q_UNLIKELY(debug_render())) {
+        qDebug(" -> alpha merge: %d elements, overlap grid: %s, build: %dus, merge: %dus",
+               m_alphaRenderList.size(), m_overlapGrid.isValid() ? "yes" : "no",
+               int(timeGrid / 1000), int((timer.nsecsElapsed() - timeGrid) / 1000));
+    }
+    m_overlapGrid.clear();
 }
 
 static inline int qsg_fixIndexCount(int iCount, GLenum drawMode) {
@@ -1778,239 +2056,496 @@ static QMatrix4x4 qsg_matrixForRoot(Node *node)
     return *c->matrix();
 }
 
-void Renderer::uploadBatch(Batch *b)
+/*
+ * Decides whether the batch can be merged and calculates the size of its
+ * vertex and index data. Returns false if the batch has nothing to upload.
+ *
+ * Unless QSG_SEPARATE_INDEX_BUFFER is defined, the index data is part of
+ * the vertex buffer and indexBufferSize is 0.
+ */
+bool Renderer::prepareBatchUpload(Batch *b, int *vertexBufferSize, int *indexBufferSize)
 {
-        // Early out if nothing has changed in this batch..
-        if (!b->needsUpload) {
-            if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "already uploaded...";
-            return;
-        }
-
-        if (!b->first) {
-            if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "is invalid...";
-            return;
-        }
-
-        if (b->isRenderNode) {
-            if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch: " << b << "is a render node...";
-            return;
-        }
-
-        // Figure out if we can merge or not, if not, then just render the batch as is..
-        Q_ASSERT(b->first);
-        Q_ASSERT(b->first->node);
-
-        QSGGeometryNode *gn = b->first->node;
-        QSGGeometry *g =  gn->geometry();
-        QSGMaterial::Flags flags = gn->activeMaterial()->flags();
-        bool canMerge = (g->drawingMode() == GL_TRIANGLES || g->drawingMode() == GL_TRIANGLE_STRIP ||
-                         g->drawingMode() == GL_LINES || g->drawingMode() == GL_POINTS)
-                        && b->positionAttribute >= 0
-                        && g->indexType() == GL_UNSIGNED_SHORT
-                        && (flags & (QSGMaterial::CustomCompileStep | QSGMaterial_FullMatrix)) == 0
-                        && ((flags & QSGMaterial::RequiresFullMatrixExceptTranslate) == 0 || b->isTranslateOnlyToRoot())
-                        && b->isSafeToBatch();
+    // Early out if nothing has changed in this batch..
+    if (!b->needsUpload) {
+        if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "already uploaded...";
+        return false;
+    }
 
-        b->merged = canMerge;
+    if (!b->first) {
+        if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "is invalid...";
+        return false;
+    }
 
-        // Figure out how much memory we need...
-        b->vertexCount = 0;
-        b->indexCount = 0;
-        int unmergedIndexSize = 0;
-        Element *e = b->first;
+    if (b->isRenderNode) {
+        if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch: " << b << "is a render node...";
+        return false;
+    }
 
-        while (e) {
-            QSGGeometry *eg = e->node->geometry();
-            b->vertexCount += eg->vertexCount();
-            int iCount = eg->indexCount();
-            if (b->merged) {
-                if (iCount == 0)
-                    iCount = eg->vertexCount();
-                iCount = qsg_fixIndexCount(iCount, g->drawingMode());
-            } else {
-                unmergedIndexSize += iCount * eg->sizeOfIndex();
-            }
-            b->indexCount += iCount;
-            e = e->nextInBatch;
-        }
+    // Figure out if we can merge or not, if not, then just render the batch as is..
+    Q_ASSERT(b->first);
+    Q_ASSERT(b->first->node);
 
-        // Abort if there are no vertices in this batch.. We abort this late as
-        // this is a broken usecase which we do not care to optimize for...
-        if (b->vertexCount == 0 || (b->merged && b->indexCount == 0))
-            return;
+    QSGGeometryNode *gn = b->first->node;
+    QSGGeometry *g =  gn->geometry();
+    QSGMaterial::Flags flags = gn->activeMaterial()->flags();
+    bool canMerge = (g->drawingMode() == GL_TRIANGLES || g->drawingMode() == GL_TRIANGLE_STRIP ||
+                     g->drawingMode() == GL_LINES || g->drawingMode() == GL_POINTS)
+                    && b->positionAttribute >= 0
+                    && g->indexType() == GL_UNSIGNED_SHORT
+                    && (flags & (QSGMaterial::CustomCompileStep | QSGMaterial_FullMatrix)) == 0
+                    && ((flags & QSGMaterial::RequiresFullMatrixExceptTranslate) == 0 || b->isTranslateOnlyToRoot())
+                    && b->isSafeToBatch();
+
+    b->merged = canMerge;
+
+    // Figure out how much memory we need...
+    b->vertexCount = 0;
+    b->indexCount = 0;
+    int unmergedIndexSize = 0;
+    Element *e = b->first;
 
-        /* Allocate memory for this batch. Merged batches are divided into three separate blocks
-           1. Vertex data for all elements, as they were in the QSGGeometry object, but
-              with the tranform relative to this batch's root applied. The vertex data
-              is otherwise unmodified.
-           2. Z data for all elements, derived from each elements "render order".
-              This is present for merged data only.
-           3. Indices for all elements, as they were in the QSGGeometry object, but
-              adjusted so that each index matches its.
-              And for TRIANGLE_STRIPs, we need to insert degenerate between each
-              primitive. These are unsigned shorts for merged and arbitrary for
-              non-merged.
-         */
-        int bufferSize =  b->vertexCount * g->sizeOfVertex();
-        int ibufferSize = 0;
+    while (e) {
+        QSGGeometry *eg = e->node->geometry();
+        b->vertexCount += eg->vertexCount();
+        int iCount = eg->indexCount();
         if (b->merged) {
-            ibufferSize = b->indexCount * sizeof(quint16);
-            if (m_useDepthBuffer)
-                bufferSize += b->vertexCount * sizeof(float);
+            if (iCount == 0)
+                iCount = eg->vertexCount();
+            iCount = qsg_fixIndexCount(iCount, g->drawingMode());
         } else {
-            ibufferSize = unmergedIndexSize;
+            unmergedIndexSize += iCount * eg->sizeOfIndex();
         }
+        b->indexCount += iCount;
+        e = e->nextInBatch;
+    }
+
+    // Abort if there are no vertices in this batch.. We abort this late as
+    // this is a broken usecase which we do not care to optimize for...
+    if (b->vertexCount == 0 || (b->merged && b->indexCount == 0))
+        return false;
+
+    /* Allocate memory for this batch. Merged batches are divided into three separate blocks
+       1. Vertex data for all elements, as they were in the QSGGeometry object, but
+          with the tranform relative to this batch's root applied. The vertex data
+          is otherwise unmodified.
+       2. Z data for all elements, derived from each elements "render order".
+          This is present for merged data only.
+       3. Indices for all elements, as they were in the QSGGeometry object, but
+          adjusted so that each index matches its.
+          And for TRIANGLE_STRIPs, we need to insert degenerate between each
+          primitive. These are unsigned shorts for merged and arbitrary for
+          non-merged.
+     */
+    int bufferSize =  b->vertexCount * g->sizeOfVertex();
+    int ibufferSize = 0;
+    if (b->merged) {
+        ibufferSize = b->indexCount * sizeof(quint16);
+        if (m_useDepthBuffer)
+            bufferSize += b->vertexCount * sizeof(float);
+    } else {
+        ibufferSize = unmergedIndexSize;
+    }
 
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-        map(&b->ibo, ibufferSize, true);
+    *indexBufferSize = ibufferSize;
 #else
-        bufferSize += ibufferSize;
+    bufferSize += ibufferSize;
+    *indexBufferSize = 0;
 #endif
-        map(&b->vbo, bufferSize);
+    *vertexBufferSize = bufferSize;
+    return true;
+}
 
-        if (Q_UNLIKELY(debug_upload())) qDebug() << " - batch" << b << " first:" << b->first << " root:"
-                                   << b->root << " merged:" << b->merged << " positionAttribute" << b->positionAttribute
-                                   << " vbo:" << b->vbo.id << ":" << b->vbo.size;
+/*
+ * Fills the mapped buffers of the batch with its vertex and index data.
+ *
+ * This only touches the batch itself and reads the geometry of its elements,
+ * so different batches can be filled concurrently.
+ */
+void Renderer::fillBatch(Batch *b)
+{
+    QSGGeometry *g = b->first->node->geometry();
 
-        if (b->merged) {
-            char *vertexData = b->vbo.data;
-            char *zData = vertexData + b->vertexCount * g->sizeOfVertex();
+    if (b->merged) {
+        char *vertexData = b->vbo.data;
+        char *zData = vertexData + b->vertexCount * g->sizeOfVertex();
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-            char *indexData = b->ibo.data;
+        char *indexData = b->ibo.data;
 #else
-            char *indexData = zData + (m_useDepthBuffer ? b->vertexCount * sizeof(float) : 0);
+        char *indexData = zData + (m_useDepthBuffer ? b->vertexCount * sizeof(float) : 0);
 #endif
+        const char *indexStart = indexData;
 
-            quint16 iOffset = 0;
-            e = b->first;
-            int verticesInSet = 0;
-            int indicesInSet = 0;
-            b->drawSets.reset();
+        quint16 iOffset = 0;
+        Element *e = b->first;
+        int verticesInSet = 0;
+        int indicesInSet = 0;
+        b->drawSets.reset();
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-            int drawSetIndices = 0;
+        int drawSetIndices = 0;
 #else
-            int drawSetIndices = indexData - vertexData;
+        int drawSetIndices = indexData - vertexData;
 #endif
-            b->drawSets << DrawSet(0, zData - vertexData, drawSetIndices);
-            while (e) {
-                verticesInSet  += e->node->geometry()->vertexCount();
-                if (verticesInSet > 0xffff) {
-                    b->drawSets.last().indexCount = indicesInSet;
-                    if (g->drawingMode() == GL_TRIANGLE_STRIP) {
-                        b->drawSets.last().indices += 1 * sizeof(quint16);
-                        b->drawSets.last().indexCount -= 2;
-                    }
+        b->drawSets << DrawSet(0, zData - vertexData, drawSetIndices);
+        while (e) {
+            verticesInSet  += e->node->geometry()->vertexCount();
+            if (verticesInSet > 0xffff) {
+                b->drawSets.last().indexCount = indicesInSet;
+                if (g->drawingMode() == GL_TRIANGLE_STRIP) {
+                    b->drawSets.last().indices += 1 * sizeof(quint16);
+                    b->drawSets.last().indexCount -= 2;
+                }
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-                    drawSetIndices = indexData - b->ibo.data;
+                drawSetIndices = indexData - b->ibo.data;
 #else
-                    drawSetIndices = indexData - b->vbo.data;
+                drawSetIndices = indexData - b->vbo.data;
 #endif
-                    b->drawSets << DrawSet(vertexData - b->vbo.data,
-                                           zData - b->vbo.data,
-                                           drawSetIndices);
-                    iOffset = 0;
-                    verticesInSet = e->node->geometry()->vertexCount();
-                    indicesInSet = 0;
-                }
-                uploadMergedElement(e, b->positionAttribute, &vertexData, &zData, &indexData, &iOffset, &indicesInSet);
-                e = e->nextInBatch;
-            }
-            b->drawSets.last().indexCount = indicesInSet;
-            // We skip the very first and very last degenerate triangles since they aren't needed
-            // and the first one would reverse the vertex ordering of the merged strips.
-            if (g->drawingMode() == GL_TRIANGLE_STRIP) {
-                b->drawSets.last().indices += 1 * sizeof(quint16);
-                b->drawSets.last().indexCount -= 2;
+                b->drawSets << DrawSet(vertexData - b->vbo.data,
+                                       zData - b->vbo.data,
+                                       drawSetIndices);
+                iOffset = 0;
+                verticesInSet = e->node->geometry()->vertexCount();
+                indicesInSet = 0;
             }
-        } else {
-            char *vboData = b->vbo.data;
+            e->vertexOffset = (vertexData - b->vbo.data) / g->sizeOfVertex();
+            e->indexOffset = (indexData - indexStart) / sizeof(quint16);
+            e->indexBase = iOffset;
+            const int indicesBefore = indicesInSet;
+            uploadMergedElement(e, b->positionAttribute, &vertexData, &zData, &indexData, &iOffset, &indicesInSet);
+            e->uploadedVertexCount = e->node->geometry()->vertexCount();
+            e->uploadedIndexCount = indicesInSet - indicesBefore;
+            e->vertexDataDirty = false;
+            e = e->nextInBatch;
+        }
+        b->hasElementOffsets = true;
+        b->uploadedZRange = m_zRange;
+        b->drawSets.last().indexCount = indicesInSet;
+        // We skip the very first and very last degenerate triangles since they aren't needed
+        // and the first one would reverse the vertex ordering of the merged strips.
+        if (g->drawingMode() == GL_TRIANGLE_STRIP) {
+            b->drawSets.last().indices += 1 * sizeof(quint16);
+            b->drawSets.last().indexCount -= 2;
+        }
+    } else {
+        char *vboData = b->vbo.data;
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-            char *iboData = b->ibo.data;
+        char *iboData = b->ibo.data;
 #else
-            char *iboData = vboData + b->vertexCount * g->sizeOfVertex();
+        char *iboData = vboData + b->vertexCount * g->sizeOfVertex();
 #endif
-            Element *e = b->first;
-            while (e) {
-                QSGGeometry *g = e->node->geometry();
-                int vbs = g->vertexCount() * g->sizeOfVertex();
-                memcpy(vboData, g->vertexData(), vbs);
-                vboData = vboData + vbs;
-                if (g->indexCount()) {
-                    int ibs = g->indexCount() * g->sizeOfIndex();
-                    memcpy(iboData, g->indexData(), ibs);
-                    iboData += ibs;
-                }
-                e = e->nextInBatch;
+        Element *e = b->first;
+        while (e) {
+            QSGGeometry *g = e->node->geometry();
+            int vbs = g->vertexCount() * g->sizeOfVertex();
+            memcpy(vboData, g->vertexData(), vbs);
+            vboData = vboData + vbs;
+            if (g->indexCount()) {
+                int ibs = g->indexCount() * g->sizeOfIndex();
+                memcpy(iboData, g->indexData(), ibs);
+                iboData += ibs;
             }
+            e->vertexDataDirty = false;
+            e = e->nextInBatch;
         }
+        b->hasElementOffsets = false;
+    }
 #ifndef QT_NO_DEBUG_OUTPUT
-        if (Q_UNLIKELY(debug_upload())) {
-            const char *vd = b->vbo.data;
-            qDebug() << "  -- Vertex Data, count:" << b->vertexCount << " - " << g->sizeOfVertex() << "bytes/vertex";
-            for (int i=0; i<b->vertexCount; ++i) {
-                QDebug dump = qDebug().nospace();
-                dump << "  --- " << i << ": ";
-                int offset = 0;
-                for (int a=0; a<g->attributeCount(); ++a) {
-                    const QSGGeometry::Attribute &attr = g->attributes()[a];
-                    dump << attr.position << ":(" << attr.tupleSize << ",";
-                    if (attr.type == GL_FLOAT) {
-                        dump << "float ";
-                        if (attr.isVertexCoordinate)
-                            dump << "* ";
-                        for (int t=0; t<attr.tupleSize; ++t)
-                            dump << *(const float *)(vd + offset + t * sizeof(float)) << " ";
-                    } else if (attr.type == GL_UNSIGNED_BYTE) {
-                        dump << "ubyte ";
-                        for (int t=0; t<attr.tupleSize; ++t)
-                            dump << *(const unsigned char *)(vd + offset + t * sizeof(unsigned char)) << " ";
-                    }
-                    dump << ") ";
-                    offset += attr.tupleSize * size_of_type(attr.type);
-                }
-                if (b->merged && m_useDepthBuffer) {
-                    float zorder = ((float*)(b->vbo.data + b->vertexCount * g->sizeOfVertex()))[i];
-                    dump << " Z:(" << zorder << ")";
+    if (Q_UNLIKELY(debug_upload())) {
+        const char *vd = b->vbo.data;
+        qDebug() << "  -- Vertex Data, count:" << b->vertexCount << " - " << g->sizeOfVertex() << "bytes/vertex";
+        for (int i=0; i<b->vertexCount; ++i) {
+            QDebug dump = qDebug().nospace();
+            dump << "  --- " << i << ": ";
+            int offset = 0;
+            for (int a=0; a<g->attributeCount(); ++a) {
+                const QSGGeometry::Attribute &attr = g->attributes()[a];
+                dump << attr.position << ":(" << attr.tupleSize << ",";
+                if (attr.type == GL_FLOAT) {
+                    dump << "float ";
+                    if (attr.isVertexCoordinate)
+                        dump << "* ";
+                    for (int t=0; t<attr.tupleSize; ++t)
+                        dump << *(const float *)(vd + offset + t * sizeof(float)) << " ";
+                } else if (attr.type == GL_UNSIGNED_BYTE) {
+                    dump << "ubyte ";
+                    for (int t=0; t<attr.tupleSize; ++t)
+                        dump << *(const unsigned char *)(vd + offset + t * sizeof(unsigned char)) << " ";
                 }
-                vd += g->sizeOfVertex();
+                dump << ") ";
+                offset += attr.tupleSize * size_of_type(attr.type);
             }
+            if (b->merged && m_useDepthBuffer) {
+                float zorder = ((float*)(b->vbo.data + b->vertexCount * g->sizeOfVertex()))[i];
+                dump << " Z:(" << zorder << ")";
+            }
+            vd += g->sizeOfVertex();
+        }
 
-            if (!b->drawSets.isEmpty()) {
-                const quint16 *id =
+        if (!b->drawSets.isEmpty()) {
+            const quint16 *id =
 # ifdef QSG_SEPARATE_INDEX_BUFFER
-                    (const quint16 *) (b->ibo.data);
+                (const quint16 *) (b->ibo.data);
 # else
-                    (const quint16 *) (b->vbo.data + b->drawSets.at(0).indices);
+                (const quint16 *) (b->vbo.data + b->drawSets.at(0).indices);
 # endif
-                {
-                    QDebug iDump = qDebug();
-                    iDump << "  -- Index Data, count:" << b->indexCount;
-                    for (int i=0; i<b->indexCount; ++i) {
-                        if ((i % 24) == 0)
-                           iDump << endl << "  --- ";
-                        iDump << id[i];
-                    }
+            {
+                QDebug iDump = qDebug();
+                iDump << "  -- Index Data, count:" << b->indexCount;
+                for (int i=0; i<b->indexCount; ++i) {
+                    if ((i % 24) == 0)
+                       iDump << endl << "  --- ";
+                    iDump << id[i];
                 }
+            }
 
-                for (int i=0; i<b->drawSets.size(); ++i) {
-                    const DrawSet &s = b->drawSets.at(i);
-                    qDebug() << "  -- DrawSet: indexCount:" << s.indexCount << " vertices:" << s.vertices << " z:" << s.zorders << " indices:" << s.indices;
-                }
+            for (int i=0; i<b->drawSets.size(); ++i) {
+                const DrawSet &s = b->drawSets.at(i);
+                qDebug() << "  -- DrawSet: indexCount:" << s.indexCount << " vertices:" << s.vertices << " z:" << s.zorders << " indices:" << s.indices;
             }
         }
+    }
 #endif // QT_NO_DEBUG_OUTPUT
+}
 
-        unmap(&b->vbo);
+void Renderer::finishBatchUpload(Batch *b)
+{
+    unmap(&b->vbo);
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-        unmap(&b->ibo, true);
+    unmap(&b->ibo, true);
 #endif
 
-        if (Q_UNLIKELY(debug_upload())) qDebug() << "  --- vertex/index buffers unmapped, batch upload completed...";
+    if (Q_UNLIKELY(debug_upload())) qDebug() << "  --- vertex/index buffers unmapped, batch upload completed...";
 
-        b->needsUpload = false;
+    b->needsUpload = false;
+    ++m_statistics.uploadCount;
 
-        if (Q_UNLIKELY(debug_render()))
-            b->uploadedThisFrame = true;
+    if (Q_UNLIKELY(debug_render()))
+        b->uploadedThisFrame = true;
+}
+
+/*
+ * Uploads only the data of the elements whose geometry or transform changed
+ * since the merged batch was last uploaded, leaving the rest of its buffers
+ * untouched. This requires every element to still have the same number of
+ * vertices and indices, so that the layout of the batch is unchanged.
+ * Returns false if the whole batch needs to be uploaded instead.
+ */
+bool Renderer::uploadDirtyElements(Batch *b, int vertexBufferSize, int indexBufferSize)
+{
+    if (!m_partialUploads || !b->merged || !b->hasElementOffsets || b->uploadedZRange != m_zRange)
+        return false;
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+    if (b->vbo.size != vertexBufferSize || b->ibo.size != indexBufferSize)
+        return false;
+#else
+    Q_UNUSED(indexBufferSize);
+    if (b->vbo.size != vertexBufferSize)
+        return false;
+#endif
+
+    QSGGeometry *g = b->first->node->geometry();
+    int dirtyVertices = 0;
+    for (Element *e = b->first; e; e = e->nextInBatch) {
+        if (!e->vertexDataDirty)
+            continue;
+        QSGGeometry *eg = e->node->geometry();
+        const int iCount = eg->indexCount() ? eg->indexCount() : eg->vertexCount();
+        if (eg->vertexCount() != e->uploadedVertexCount
+                || qsg_fixIndexCount(iCount, g->drawingMode()) != e->uploadedIndexCount)
+            return false;
+        dirtyVertices += e->uploadedVertexCount;
+    }
+
+    // When most of the batch changed, one upload of everything is cheaper.
+    if (dirtyVertices * 2 > b->vertexCount)
+        return false;
+
+    if (Q_UNLIKELY(debug_upload())) qDebug() << " - batch" << b << "partial upload of" << dirtyVertices
+                                             << "out of" << b->vertexCount << "vertices";
+
+    const bool usePool = !m_context->hasBrokenIndexBufferObjects() && m_visualizeMode == VisualizeNothing;
+    const int vSize = g->sizeOfVertex();
+    const int zStart = b->vertexCount * vSize;
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+    const int iStart = 0;
+#else
+    const int iStart = zStart + (m_useDepthBuffer ? b->vertexCount * sizeof(float) : 0);
+#endif
+
+    Element *e = b->first;
+    while (e) {
+        if (!e->vertexDataDirty) {
+            e = e->nextInBatch;
+            continue;
+        }
+
+        // Consecutive dirty elements are also consecutive in the buffers, so
+        // they can be uploaded together.
+        int runVertices = 0;
+        int runIndices = 0;
+        Element *runEnd = e;
+        while (runEnd && runEnd->vertexDataDirty) {
+            runVertices += runEnd->uploadedVertexCount;
+            runIndices += runEnd->uploadedIndexCount;
+            runEnd = runEnd->nextInBatch;
+        }
+
+        const int vertexBytes = runVertices * vSize;
+        const int zBytes = m_useDepthBuffer ? runVertices * sizeof(float) : 0;
+        const int indexBytes = runIndices * sizeof(quint16);
+        const int vertexOffset = e->vertexOffset;
+        const int indexOffset = e->indexOffset;
+
+        char *vertexData;
+        char *zData;
+        char *indexData;
+        if (usePool) {
+            if (vertexBytes + zBytes + indexBytes > m_vertexUploadPool.size())
+                m_vertexUploadPool.resize(vertexBytes + zBytes + indexBytes);
+            vertexData = m_vertexUploadPool.data();
+            zData = vertexData + vertexBytes;
+            indexData = zData + zBytes;
+        } else {
+            // The batch keeps its own copy of the data, update it in place.
+            vertexData = b->vbo.data + vertexOffset * vSize;
+            zData = b->vbo.data + zStart + vertexOffset * sizeof(float);
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+            indexData = b->ibo.data + indexOffset * sizeof(quint16);
+#else
+            indexData = b->vbo.data + iStart + indexOffset * sizeof(quint16);
+#endif
+        }
+
+        char *vd = vertexData;
+        char *zd = zData;
+        char *id = indexData;
+        for (; e != runEnd; e = e->nextInBatch) {
+            quint16 iBase = e->indexBase;
+            int indexCount = 0;
+            uploadMergedElement(e, b->positionAttribute, &vd, &zd, &id, &iBase, &indexCount);
+            e->vertexDataDirty = false;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, b->vbo.id);
+        glBufferSubData(GL_ARRAY_BUFFER, vertexOffset * vSize, vertexBytes, vertexData);
+        if (zBytes)
+            glBufferSubData(GL_ARRAY_BUFFER, zStart + vertexOffset * sizeof(float), zBytes, zData);
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, b->ibo.id);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, iStart + indexOffset * sizeof(quint16), indexBytes, indexData);
+#else
+        glBufferSubData(GL_ARRAY_BUFFER, iStart + indexOffset * sizeof(quint16), indexBytes, indexData);
+#endif
+    }
+
+    b->needsUpload = false;
+    ++m_statistics.uploadCount;
+
+    if (Q_UNLIKELY(debug_render()))
+        b->uploadedThisFrame = true;
+
+    return true;
+}
+
+void Renderer::uploadBatch(Batch *b)
+{
+    int bufferSize;
+    int ibufferSize;
+    if (!prepareBatchUpload(b, &bufferSize, &ibufferSize))
+        return;
+
+    if (uploadDirtyElements(b, bufferSize, ibufferSize))
+        return;
+
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+    map(&b->ibo, ibufferSize, true);
+#else
+    Q_UNUSED(ibufferSize);
+#endif
+    map(&b->vbo, bufferSize);
+
+    if (Q_UNLIKELY(debug_upload())) qDebug() << " - batch" << b << " first:" << b->first << " root:"
+                               << b->root << " merged:" << b->merged << " positionAttribute" << b->positionAttribute
+                               << " vbo:" << b->vbo.id << ":" << b->vbo.size;
+
+    fillBatch(b);
+    finishBatchUpload(b);
+}
+
+/*
+ * Uploads all opaque and alpha batches, merging their vertex data on
+ * multiple threads. Each batch gets its own region of the upload pools, so
+ * the batches can be filled concurrently. The buffer objects are then
+ * created and uploaded on the render thread.
+ */
+void Renderer::uploadBatchesInParallel()
+{
+    const bool usePool = !m_context->hasBrokenIndexBufferObjects() && m_visualizeMode == VisualizeNothing;
+    int vertexPoolSize = 0;
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+    int indexPoolSize = 0;
+#endif
+
+    m_pendingUploads.reset();
+    for (int i=0; i<m_opaqueBatches.size() + m_alphaBatches.size(); ++i) {
+        Batch *b = i < m_opaqueBatches.size()
+                 ? m_opaqueBatches.at(i)
+                 : m_alphaBatches.at(i - m_opaqueBatches.size());
+        int bufferSize;
+        int ibufferSize;
+        if (prepareBatchUpload(b, &bufferSize, &ibufferSize)
+                && !uploadDirtyElements(b, bufferSize, ibufferSize)) {
+            m_pendingUploads.add(b);
+            if (usePool) {
+                // Only batches with a pending upload get a region of the pools.
+                b->vbo.size = bufferSize;
+                vertexPoolSize += qsg_alignUploadSize(bufferSize);
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+                b->ibo.size = ibufferSize;
+                indexPoolSize += qsg_alignUploadSize(ibufferSize);
+#endif
+            } else {
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+                map(&b->ibo, ibufferSize, true);
+#endif
+                map(&b->vbo, bufferSize);
+            }
+        }
+    }
+
+    if (m_pendingUploads.size() == 0)
+        return;
+
+    if (usePool) {
+        // Size the pools to hold all pending batches at once and trim them when
+        // they have grown much larger than that, as render() does for
+        // the largest single batch.
+        if (vertexPoolSize > m_vertexUploadPool.size() || vertexPoolSize * 2 < m_vertexUploadPool.size())
+            m_vertexUploadPool.resize(vertexPoolSize);
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+        if (indexPoolSize > m_indexUploadPool.size() || indexPoolSize * 2 < m_indexUploadPool.size())
+            m_indexUploadPool.resize(indexPoolSize);
+        int indexOffset = 0;
+#endif
+        int vertexOffset = 0;
+        for (int i=0; i<m_pendingUploads.size(); ++i) {
+            Batch *b = m_pendingUploads.at(i);
+            b->vbo.data = m_vertexUploadPool.data() + vertexOffset;
+            vertexOffset += qsg_alignUploadSize(b->vbo.size);
+#ifdef QSG_SEPARATE_INDEX_BUFFER
+            b->ibo.data = m_indexUploadPool.data() + indexOffset;
+            indexOffset += qsg_alignUploadSize(b->ibo.size);
+#endif
+        }
+    }
+
+    qsg_runInParallel(m_threadCount, m_pendingUploads.size(), [this](int i) {
+        fillBatch(m_pendingUploads.at(i));
+    });
+
+    for (int i=0; i<m_pendingUploads.size(); ++i)
+        finishBatchUpload(m_pendingUploads.at(i));
+    m_pendingUploads.reset();
 }
 
 /*!
@@ -2726,43 +3261,56 @@ void Renderer::render()
 
     if (Q_UNLIKELY(debug_render())) timeSorting = timer.restart();
 
-    int largestVBO = 0;
+    if (m_threadCount > 1 && !debug_upload()) {
+        // The opaque and alpha batches are uploaded together, so the
+        // whole upload time is reported as opaque.
+        uploadBatchesInParallel();
+        if (Q_UNLIKELY(debug_render())) timeUploadOpaque = timer.restart();
+    } else {
+        int largestVBO = 0;
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-    int largestIBO = 0;
+        int largestIBO = 0;
 #endif
 
-    if (Q_UNLIKELY(debug_upload())) qDebug() << "Uploading Opaque Batches:";
-    for (int i=0; i<m_opaqueBatches.size(); ++i) {
-        Batch *b = m_opaqueBatches.at(i);
-        largestVBO = qMax(b->vbo.size, largestVBO);
+        if (Q_UNLIKELY(debug_upload())) qDebug() << "Uploading Opaque Batches:";
+        for (int i=0; i<m_opaqueBatches.size(); ++i) {
+            Batch *b = m_opaqueBatches.at(i);
+            largestVBO = qMax(b->vbo.size, largestVBO);
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-        largestIBO = qMax(b->ibo.size, largestIBO);
+            largestIBO = qMax(b->ibo.size, largestIBO);
 #endif
-        uploadBatch(b);
-    }
-    if (Q_UNLIKELY(debug_render())) timeUploadOpaque = timer.restart();
+            uploadBatch(b);
+        }
+        if (Q_UNLIKELY(debug_render())) timeUploadOpaque = timer.restart();
 
 
-    if (Q_UNLIKELY(debug_upload())) qDebug() << "Uploading Alpha Batches:";
-    for (int i=0; i<m_alphaBatches.size(); ++i) {
-        Batch *b = m_alphaBatches.at(i);
-        uploadBatch(b);
-        largestVBO = qMax(b->vbo.size, largestVBO);
+        if (Q_UNLIKELY(debug_upload())) qDebug() << "Uploading Alpha Batches:";
+        for (int i=0; i<m_alphaBatches.size(); ++i) {
+            Batch *b = m_alphaBatches.at(i);
+            uploadBatch(b);
+            largestVBO = qMax(b->vbo.size, largestVBO);
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-        largestIBO = qMax(b->ibo.size, largestIBO);
+            largestIBO = qMax(b->ibo.size, largestIBO);
 #endif
-    }
-    if (Q_UNLIKELY(debug_render())) timeUploadAlpha = timer.restart();
+        }
+        if (Q_UNLIKELY(debug_render())) timeUploadAlpha = timer.restart();
 
-    if (largestVBO * 2 < m_vertexUploadPool.size())
-        m_vertexUploadPool.resize(largestVBO * 2);
+        if (largestVBO * 2 < m_vertexUploadPool.size())
+            m_vertexUploadPool.resize(largestVBO * 2);
 #ifdef QSG_SEPARATE_INDEX_BUFFER
-    if (largestIBO * 2 < m_indexUploadPool.size())
-        m_indexUploadPool.resize(largestIBO * 2);
+        if (largestIBO * 2 < m_indexUploadPool.size())
+            m_indexUploadPool.resize(largestIBO * 2);
 #endif
+    }
 
     renderBatches();
 
+    if (recordsStatistics()) {
+        m_statistics.nodeCount = qsg_countNodesInBatches(m_opaqueBatches)
+                + qsg_countNodesInBatches(m_alphaBatches);
+        m_statistics.batchCount = m_opaqueBatches.size() + m_alphaBatches.size();
+    }
+
     if (Q_UNLIKELY(debug_render())) {
         qDebug(" -> times: build: %d, prepare(opaque/alpha): %d/%d, sorting: %d, upload(opaque/alpha): %d/%d, render: %d",
                (int) timeRenderLists,
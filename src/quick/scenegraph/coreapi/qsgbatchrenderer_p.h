@@ -311,6 +311,11 @@ struct Element {
         , nextInBatch(0)
         , root(0)
         , order(0)
+        , vertexOffset(0)
+        , indexOffset(0)
+        , uploadedVertexCount(0)
+        , uploadedIndexCount(0)
+        , indexBase(0)
         , boundsComputed(false)
         , boundsOutsideFloatRange(false)
         , translateOnlyToRoot(false)
@@ -318,6 +323,7 @@ struct Element {
         , orphaned(false)
         , isRenderNode(false)
         , isMaterialBlended(false)
+        , vertexDataDirty(false)
     {
     }
 
@@ -341,6 +347,14 @@ struct Element {
 
     int order;
 
+    // Where the element's data was placed in its merged batch at the last
+    // upload, used to upload only the elements that changed.
+    int vertexOffset;
+    int indexOffset;
+    int uploadedVertexCount;
+    int uploadedIndexCount;
+    quint16 indexBase;
+
     uint boundsComputed : 1;
     uint boundsOutsideFloatRange : 1;
     uint translateOnlyToRoot : 1;
@@ -348,6 +362,7 @@ struct Element {
     uint orphaned : 1;
     uint isRenderNode : 1;
     uint isMaterialBlended : 1;
+    uint vertexDataDirty : 1;
 };
 
 struct RenderNodeElement : public Element {
@@ -361,6 +376,44 @@ struct RenderNodeElement : public Element {
     QSGRenderNode *renderNode;
 };
 
+/*
+ * A uniform grid over the bounds of the unbatched elements in the alpha
+ * render list. Each cell holds the indices of the elements whose bounds
+ * touch it, in increasing order, so that a lookup can be limited to a
+ * range of the render list with a binary search. Elements that cover many
+ * cells, or have bounds outside the float range, are kept in a separate
+ * list instead.
+ */
+class OverlapGrid
+{
+public:
+    enum {
+        MinimumElements = 64,
+        MaximumCellsPerAxis = 64,
+        MaximumCellsPerElement = 16
+    };
+
+    OverlapGrid();
+
+    void build(const QDataBuffer<Element *> &renderList, int minimumElements);
+    void clear() { m_columns = 0; }
+    bool isValid() const { return m_columns > 0; }
+    int cellCount(const Rect &bounds) const;
+    bool overlaps(const QDataBuffer<Element *> &renderList, int first, int last, const Rect &bounds) const;
+
+private:
+    void cellRange(const Rect &bounds, int *x0, int *y0, int *x1, int *y1) const;
+
+    Rect m_bounds;
+    float m_cellWidth;
+    float m_cellHeight;
+    int m_columns;
+    int m_rows;
+    QDataBuffer<int> m_cellStart;
+    QDataBuffer<int> m_indices;
+    QDataBuffer<int> m_large;
+};
+
 struct BatchRootInfo {
     BatchRootInfo() : parentRoot(0), lastOrder(-1), firstOrder(-1), availableOrders(0) { }
     QSet<Node *> subRoots;
@@ -375,6 +428,17 @@ struct ClipBatchRootInfo : public BatchRootInfo
     QMatrix4x4 matrix;
 };
 
+// The lists and render order a traversal of buildRenderLists() appends to.
+struct RenderLists
+{
+    RenderLists(QDataBuffer<Element *> *opaqueList, QDataBuffer<Element *> *alphaList)
+        : opaque(opaqueList), alpha(alphaList), nextRenderOrder(0), partialRebuildRoot(0) { }
+    QDataBuffer<Element *> *opaque;
+    QDataBuffer<Element *> *alpha;
+    int nextRenderOrder;
+    QSGNode *partialRebuildRoot;
+};
+
 struct DrawSet
 {
     DrawSet(int v, int z, int i)
@@ -420,6 +484,8 @@ struct Batch
         positionAttribute = -1;
         uploadedThisFrame = false;
         isRenderNode = false;
+        hasElementOffsets = false;
+        uploadedZRange = 0;
     }
 
     Element *first;
@@ -436,9 +502,12 @@ struct Batch
     uint needsUpload : 1;
     uint merged : 1;
     uint isRenderNode : 1;
+    uint hasElementOffsets : 1;
 
     mutable uint uploadedThisFrame : 1; // solely for debugging purposes
 
+    qreal uploadedZRange;
+
     Buffer vbo;
     Buffer ibo;
 
@@ -655,7 +724,8 @@ private:
     void buildRenderListsFromScratch();
     void buildRenderListsForTaggedRoots();
     void tagSubRoots(Node *node);
-    void buildRenderLists(QSGNode *node);
+    void buildRenderLists(QSGNode *node, RenderLists *lists);
+    void buildRenderListsInParallel(const QVector<Node *> &roots);
 
     void deleteRemovedElements();
     void cleanupBatches(QDataBuffer<Batch *> *batches);
@@ -664,7 +734,12 @@ private:
     void prepareAlphaBatches();
     void invalidateBatchAndOverlappingRenderOrders(Batch *batch);
 
+    bool prepareBatchUpload(Batch *b, int *vertexBufferSize, int *indexBufferSize);
+    void fillBatch(Batch *b);
+    void finishBatchUpload(Batch *b);
+    bool uploadDirtyElements(Batch *b, int vertexBufferSize, int indexBufferSize);
     void uploadBatch(Batch *b);
+    void uploadBatchesInParallel();
     void uploadMergedElement(Element *e, int vaOffset, char **vertexData, char **zData, char **indexData, quint16 *iBase, int *indexCount);
 
     void renderBatches();
@@ -706,7 +781,6 @@ private:
     QDataBuffer<Element *> m_alphaRenderList;
     int m_nextRenderOrder;
     bool m_partialRebuild;
-    QSGNode *m_partialRebuildRoot;
 
     bool m_useDepthBuffer;
 
@@ -726,8 +800,11 @@ private:
     int m_renderOrderRebuildUpper;
 
     GLuint m_bufferStrategy;
+    bool m_partialUploads;
     int m_batchNodeThreshold;
     int m_batchVertexThreshold;
+    int m_threadCount;
+    int m_overlapGridThreshold;
 
     // Stuff used during rendering only...
     ShaderManager *m_shaderManager;
@@ -744,6 +821,8 @@ private:
 
     QDataBuffer<char> m_vertexUploadPool;
     QDataBuffer<char> m_indexUploadPool;
+    QDataBuffer<Batch *> m_pendingUploads;
+    OverlapGrid m_overlapGrid;
     // For minimal OpenGL core profile support
     QOpenGLVertexArrayObject *m_vao;
 
@@ -54,10 +54,6 @@ QT_BEGIN_NAMESPACE
 static const bool qsg_sanity_check = qEnvironmentVariableIntValue("QSG_SANITY_CHECK");
 #endif
 
-static QElapsedTimer frameTimer;
-static qint64 preprocessTime;
-static qint64 updatePassTime;
-
 int qt_sg_envInt(const char *name, int defaultValue)
 {
     if (Q_LIKELY(!qEnvironmentVariableIsSet(name)))
@@ -134,6 +130,9 @@ QSGRenderer::QSGRenderer(QSGRenderContext *context)
     , m_context(context)
     , m_node_updater(0)
     , m_bindable(0)
+    , m_preprocess_time(0)
+    , m_update_pass_time(0)
+    , m_record_statistics(false)
     , m_changed_emitted(false)
     , m_is_rendering(false)
     , m_is_preprocessing(false)
@@ -209,9 +208,11 @@ void QSGRenderer::renderScene(const QSGBindable &bindable)
     m_is_rendering = true;
 
 
-    bool profileFrames = QSG_LOG_TIME_RENDERER().isDebugEnabled();
+    m_statistics = Statistics();
+
+    bool profileFrames = QSG_LOG_TIME_RENDERER().isDebugEnabled() || m_record_statistics;
     if (profileFrames)
-        frameTimer.start();
+        m_frame_timer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphRendererFrame);
 
     qint64 bindTime = 0;
@@ -222,7 +223,7 @@ void QSGRenderer::renderScene(const QSGBindable &bindable)
 
     bindable.bind();
     if (profileFrames)
-        bindTime = frameTimer.nsecsElapsed();
+        bindTime = m_frame_timer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRendererFrame,
                               QQuickProfiler::SceneGraphRendererBinding);
 
@@ -243,7 +244,7 @@ void QSGRenderer::renderScene(const QSGBindable &bindable)
 
     render();
     if (profileFrames)
-        renderTime = frameTimer.nsecsElapsed();
+        renderTime = m_frame_timer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_END(QQuickProfiler::SceneGraphRendererFrame,
                            QQuickProfiler::SceneGraphRendererRender);
 
@@ -251,12 +252,19 @@ void QSGRenderer::renderScene(const QSGBindable &bindable)
     m_changed_emitted = false;
     m_bindable = 0;
 
+    if (m_record_statistics) {
+        m_statistics.preprocessTime = m_preprocess_time;
+        m_statistics.updateTime = m_update_pass_time - m_preprocess_time;
+        m_statistics.bindTime = bindTime - m_update_pass_time;
+        m_statistics.renderTime = renderTime - bindTime;
+    }
+
     qCDebug(QSG_LOG_TIME_RENDERER,
             "time in renderer: total=%dms, preprocess=%d, updates=%d, binding=%d, rendering=%d",
             int(renderTime / 1000000),
-            int(preprocessTime / 1000000),
-            int((updatePassTime - preprocessTime) / 1000000),
-            int((bindTime - updatePassTime) / 1000000),
+            int(m_preprocess_time / 1000000),
+            int((m_update_pass_time - m_preprocess_time) / 1000000),
+            int((bindTime - m_update_pass_time) / 1000000),
             int((renderTime - bindTime) / 1000000));
 }
 
@@ -313,16 +321,16 @@ void QSGRenderer::preprocess()
         }
     }
 
-    bool profileFrames = QSG_LOG_TIME_RENDERER().isDebugEnabled();
+    bool profileFrames = QSG_LOG_TIME_RENDERER().isDebugEnabled() || m_record_statistics;
     if (profileFrames)
-        preprocessTime = frameTimer.nsecsElapsed();
+        m_preprocess_time = m_frame_timer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRendererFrame,
                               QQuickProfiler::SceneGraphRendererPreprocess);
 
     nodeUpdater()->updateStates(root);
 
     if (profileFrames)
-        updatePassTime = frameTimer.nsecsElapsed();
+        m_update_pass_time = m_frame_timer.nsecsElapsed();
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphRendererFrame,
                               QQuickProfiler::SceneGraphRendererUpdate);
 
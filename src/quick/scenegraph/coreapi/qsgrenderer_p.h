@@ -57,6 +57,7 @@
 #include "qsgmaterial.h"
 
 #include <QtQuick/private/qsgcontext_p.h>
+#include <QtCore/qelapsedtimer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -97,6 +98,25 @@ public:
 
     void clearChangedFlag() { m_changed_emitted = false; }
 
+    struct Statistics {
+        Statistics()
+            : preprocessTime(0), updateTime(0), bindTime(0), renderTime(0)
+            , nodeCount(0), batchCount(0), uploadCount(0) { }
+
+        // Times are in nanoseconds.
+        qint64 preprocessTime;
+        qint64 updateTime;
+        qint64 bindTime;
+        qint64 renderTime;
+        int nodeCount;
+        int batchCount;
+        int uploadCount;
+    };
+
+    void setRecordStatistics(bool record) { m_record_statistics = record; }
+    bool recordsStatistics() const { return m_record_statistics; }
+    const Statistics &statistics() const { return m_statistics; }
+
 protected:
     virtual void render() = 0;
 
@@ -115,6 +135,8 @@ protected:
 
     QSGRenderContext *m_context;
 
+    Statistics m_statistics;
+
 private:
     QSGNodeUpdater *m_node_updater;
 
@@ -123,6 +145,11 @@ private:
 
     const QSGBindable *m_bindable;
 
+    QElapsedTimer m_frame_timer;
+    qint64 m_preprocess_time;
+    qint64 m_update_pass_time;
+    bool m_record_statistics;
+
 #ifndef QT_NO_BITFIELDS
     uint m_changed_emitted : 1;
     uint m_is_rendering : 1;
@@ -95,6 +95,8 @@ public:
     bool hasBrokenIndexBufferObjects() const { return m_brokenIBOs; }
     int maxTextureSize() const override { return m_maxTextureSize; }
 
+    QSGAtlasTexture::Manager *atlasManager() const { return m_atlasManager; }
+
 protected:
     static QString fontKey(const QRawFont &font);
 
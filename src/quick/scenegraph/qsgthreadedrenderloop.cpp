@@ -160,6 +160,10 @@ const QEvent::Type WM_Grab              = QEvent::Type(QEvent::User + 5);
 // Passed by the window when there is a render job to run
 const QEvent::Type WM_PostJob           = QEvent::Type(QEvent::User + 6);
 
+// Passed by the RT to the RL in pipelined mode when it is done with a frame
+// and the RL has deferred a sync because the RT was still rendering.
+const QEvent::Type WM_SyncReady         = QEvent::Type(QEvent::User + 7);
+
 template <typename T> T *windowFor(const QList<T> &list, QQuickWindow *window)
 {
     for (int i=0; i<list.size(); ++i) {
@@ -275,6 +279,8 @@ public:
         , pendingUpdate(0)
         , sleeping(false)
         , syncResultedInChanges(false)
+        , rendering(false)
+        , syncDeferred(false)
         , active(false)
         , window(0)
         , stopEventProcessing(false)
@@ -300,6 +306,7 @@ public:
 
     void syncAndRender();
     void sync(bool inExpose);
+    void finishPipelinedFrame(QQuickWindow *window);
 
     void requestRepaint()
     {
@@ -336,6 +343,10 @@ public:
     bool sleeping;
     bool syncResultedInChanges;
 
+    // Pipelined mode only, guarded by mutex.
+    bool rendering;
+    bool syncDeferred;
+
     volatile bool active;
 
     float vsyncDelta;
@@ -598,6 +609,17 @@ void QSGRenderThread::syncAndRender()
 
     syncResultedInChanges = false;
     QQuickWindowPrivate *d = QQuickWindowPrivate::get(window);
+    QQuickWindow *renderedWindow = window;
+
+    if (wm->m_pipelined) {
+        // Let the GUI thread know that we are busy so it prepares its next
+        // frame instead of blocking on us. If it already gave up on a sync,
+        // leave it to block as usual so it cannot be starved by render-only
+        // frames.
+        mutex.lock();
+        rendering = !syncDeferred;
+        mutex.unlock();
+    }
 
     bool repaintRequested = (pendingUpdate & RepaintRequest) || d->customRenderStage;
     bool syncRequested = pendingUpdate & SyncRequest;
@@ -620,6 +642,8 @@ void QSGRenderThread::syncAndRender()
         int waitTime = vsyncDelta - (int) waitTimer.elapsed();
         if (waitTime > 0)
             msleep(waitTime);
+        if (wm->m_pipelined)
+            finishPipelinedFrame(renderedWindow);
         return;
     }
 
@@ -627,9 +651,15 @@ void QSGRenderThread::syncAndRender()
 
 
     if (animatorDriver->isRunning()) {
+        QElapsedTimer statisticsTimer;
+        const bool recordStatistics = d->isRecordingFrameStatistics();
+        if (recordStatistics)
+            statisticsTimer.start();
         d->animationController->lock();
         animatorDriver->advance();
         d->animationController->unlock();
+        if (recordStatistics)
+            d->renderFrameStatistics.animationTime += statisticsTimer.nsecsElapsed();
     }
 
     bool current = false;
@@ -669,6 +699,9 @@ void QSGRenderThread::syncAndRender()
         mutex.unlock();
     }
 
+    if (wm->m_pipelined)
+        finishPipelinedFrame(renderedWindow);
+
     qCDebug(QSG_LOG_TIME_RENDERLOOP,
             "Frame rendered with 'threaded' renderloop in %dms, sync=%d, render=%d, swap=%d - (on render thread)",
             int(threadTimer.elapsed()),
@@ -683,6 +716,22 @@ void QSGRenderThread::syncAndRender()
 
 
 
+/*!
+    Used in pipelined mode. Marks the render thread as no longer rendering
+    and, if the GUI thread deferred a sync while we were busy, tells it
+    that the sync can now go ahead.
+ */
+void QSGRenderThread::finishPipelinedFrame(QQuickWindow *window)
+{
+    mutex.lock();
+    rendering = false;
+    if (syncDeferred) {
+        qCDebug(QSG_LOG_RENDERLOOP) << QSG_RT_PAD << "- frame done, waking deferred sync";
+        QCoreApplication::postEvent(wm, new WMWindowEvent(window, WM_SyncReady));
+    }
+    mutex.unlock();
+}
+
 void QSGRenderThread::postEvent(QEvent *e)
 {
     eventQueue.addEvent(e);
@@ -754,6 +803,7 @@ void QSGRenderThread::run()
 QSGThreadedRenderLoop::QSGThreadedRenderLoop()
     : sg(QSGContext::createDefaultContext())
     , m_animation_timer(0)
+    , m_pipelined(qEnvironmentVariableIntValue("QSG_RENDER_LOOP_PIPELINED"))
 {
 #if defined(QSG_RENDER_LOOP_DEBUG)
     qsgrl_timer.start();
@@ -937,6 +987,7 @@ void QSGThreadedRenderLoop::handleExposure(QQuickWindow *window)
         win.thread = new QSGRenderThread(this, QQuickWindowPrivate::get(window)->context);
         win.updateDuringSync = false;
         win.forceRenderPass = true; // also covered by polishAndSync(inExpose=true), but doesn't hurt
+        win.syncDeferred = false;
         m_windows << win;
         w = &m_windows.last();
     }
@@ -1194,10 +1245,34 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
 
     w->updateDuringSync = false;
 
+    if (m_pipelined && !inExpose) {
+        w->thread->mutex.lock();
+        const bool busy = w->thread->rendering;
+        if (busy) {
+            w->thread->syncDeferred = true;
+            w->syncDeferred = true;
+        }
+        w->thread->mutex.unlock();
+        if (busy) {
+            // The render thread is still busy with the previous frame. Go back
+            // to the event loop instead of blocking, the render thread posts
+            // WM_SyncReady once it can take the sync. afterAnimating() is left
+            // to that sync, as animations only advance once a sync completes.
+            qCDebug(QSG_LOG_RENDERLOOP) << "- render thread busy, deferring sync";
+            Q_QUICK_SG_PROFILE_SKIP(QQuickProfiler::SceneGraphPolishAndSync,
+                                    QQuickProfiler::SceneGraphPolishAndSyncPolish, 3);
+            Q_QUICK_SG_PROFILE_REPORT(QQuickProfiler::SceneGraphPolishAndSync,
+                                      QQuickProfiler::SceneGraphPolishAndSyncAnimations);
+            return;
+        }
+    }
+
     emit window->afterAnimating();
 
     qCDebug(QSG_LOG_RENDERLOOP) << "- lock for sync";
     w->thread->mutex.lock();
+    w->thread->syncDeferred = false;
+    w->syncDeferred = false;
     m_lockedForSync = true;
     w->thread->postEvent(new WMSyncEvent(window, inExpose, w->forceRenderPass));
     w->forceRenderPass = false;
@@ -1219,7 +1294,13 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
 
     if (m_animation_timer == 0 && m_animation_driver->isRunning()) {
         qCDebug(QSG_LOG_RENDERLOOP) << "- advancing animations";
+        QElapsedTimer statisticsTimer;
+        const bool recordStatistics = d->isRecordingFrameStatistics();
+        if (recordStatistics)
+            statisticsTimer.start();
         m_animation_driver->advance();
+        if (recordStatistics)
+            d->guiFrameStatistics.animationTime += statisticsTimer.nsecsElapsed();
         qCDebug(QSG_LOG_RENDERLOOP) << "- animations done..";
         // We need to trigger another sync to keep animations running...
         maybePostPolishRequest(w);
@@ -1244,6 +1325,13 @@ bool QSGThreadedRenderLoop::event(QEvent *e)
 {
     switch ((int) e->type()) {
 
+    case WM_SyncReady: {
+        qCDebug(QSG_LOG_RENDERLOOP) << "- render thread ready, doing deferred sync";
+        Window *w = windowFor(m_windows, static_cast<WMWindowEvent *>(e)->window);
+        if (w && w->syncDeferred)
+            polishAndSync(w);
+        return true; }
+
     case QEvent::Timer: {
         QTimerEvent *te = static_cast<QTimerEvent *>(e);
         if (te->timerId() == m_animation_timer) {
@@ -104,9 +104,11 @@ private:
 #ifndef QT_NO_BITFIELDS
         uint updateDuringSync : 1;
         uint forceRenderPass : 1;
+        uint syncDeferred : 1;
 #else
         uint updateDuringSync = 1;
         uint forceRenderPass = 1;
+        uint syncDeferred = 1;
 #endif
     };
 
@@ -135,6 +137,7 @@ private:
     int m_animation_timer;
 
     bool m_lockedForSync;
+    bool m_pipelined;
 };
 
 
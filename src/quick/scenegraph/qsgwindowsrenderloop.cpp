@@ -400,9 +400,20 @@ void QSGWindowsRenderLoop::render()
         RLDEBUG("advancing animations");
         QSG_LOG_TIME_SAMPLE(time_start);
         Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphWindowsAnimations);
+        QElapsedTimer statisticsTimer;
+        statisticsTimer.start();
         m_animationDriver->advance();
         RLDEBUG("animations advanced");
 
+        // Animations are shared by all windows, account them to each one
+        // that records frame statistics.
+        const qint64 animationTime = statisticsTimer.nsecsElapsed();
+        for (const WindowData &wd : qAsConst(m_windows)) {
+            QQuickWindowPrivate *d = QQuickWindowPrivate::get(wd.window);
+            if (d->isRecordingFrameStatistics())
+                d->guiFrameStatistics.animationTime += animationTime;
+        }
+
         qCDebug(QSG_LOG_TIME_RENDERLOOP,
                 "animations ticked in %dms",
                 int((qsg_render_timer.nsecsElapsed() - time_start)/1000000));
@@ -69,7 +69,7 @@ namespace QSGAtlasTexture
 {
 
 Manager::Manager()
-    : m_atlas(0)
+    : m_fallback_count(0)
 {
     QOpenGLContext *gl = QOpenGLContext::currentContext();
     Q_ASSERT(gl);
@@ -93,44 +93,161 @@ Manager::Manager()
     m_atlas_size_limit = qt_sg_envInt("QSG_ATLAS_SIZE_LIMIT", qMax(w, h) / 2);
     m_atlas_size = QSize(w, h);
 
+    m_atlas_max_pages = qMax(1, qt_sg_envInt("QSG_ATLAS_MAX_PAGES", 1));
+    m_atlas_retire_threshold = qBound(0, qt_sg_envInt("QSG_ATLAS_RETIRE_THRESHOLD", 50), 100);
+
     qCDebug(QSG_LOG_INFO, "texture atlas dimensions: %dx%d", w, h);
 }
 
 
 Manager::~Manager()
 {
-    Q_ASSERT(m_atlas == 0);
+    Q_ASSERT(m_atlases.isEmpty());
 }
 
 void Manager::invalidate()
 {
-    if (m_atlas) {
-        m_atlas->invalidate();
-        m_atlas->deleteLater();
-        m_atlas = 0;
+    releaseEmptiedAtlases();
+    for (Atlas *atlas : qAsConst(m_atlases)) {
+        atlas->detachFromManager();
+        atlas->invalidate();
+        atlas->deleteLater();
     }
+    m_atlases.clear();
 }
 
 QSGTexture *Manager::create(const QImage &image, bool hasAlphaChannel)
 {
+    releaseEmptiedAtlases();
+
     Texture *t = 0;
     if (image.width() < m_atlas_size_limit && image.height() < m_atlas_size_limit) {
-        if (!m_atlas)
-            m_atlas = new Atlas(m_atlas_size);
         // t may be null for atlas allocation failure
-        t = m_atlas->create(image);
-        if (t && !hasAlphaChannel && t->hasAlphaChannel())
+        for (Atlas *atlas : qAsConst(m_atlases)) {
+            if (atlas->isRetired())
+                continue;
+            t = atlas->create(image);
+            if (t)
+                break;
+        }
+
+        if (!t && (m_atlases.size() < pageLimit() || retireFragmentedAtlas())) {
+            Atlas *atlas = new Atlas(this, m_atlas_size);
+            m_atlases << atlas;
+            qCDebug(QSG_LOG_INFO, "texture atlas page added, %d pages in use", m_atlases.size());
+            t = atlas->create(image);
+        }
+
+        if (!t) {
+            ++m_fallback_count;
+            qCDebug(QSG_LOG_INFO, "texture atlas full, %dx%d image gets its own texture (%d so far)",
+                    image.width(), image.height(), m_fallback_count);
+        } else if (!hasAlphaChannel && t->hasAlphaChannel()) {
             t->setHasAlphaChannel(false);
+        }
     }
     return t;
 }
 
-Atlas::Atlas(const QSize &size)
-    : m_allocator(size)
+/*
+    Up to QSG_ATLAS_MAX_PAGES pages are used, plus one while a retired page
+    is draining.
+ */
+int Manager::pageLimit() const
+{
+    for (const Atlas *atlas : m_atlases) {
+        if (atlas->isRetired())
+            return m_atlas_max_pages + 1;
+    }
+    return m_atlas_max_pages;
+}
+
+/*
+    Called when an image no longer fits in any page and no more pages can be
+    added. As the area allocator has failed despite the free space, the pages
+    are fragmented. The emptiest page, if it is below the retire threshold,
+    stops taking new images so that it drains as its textures are released,
+    and a fresh page takes its place.
+
+    Live textures are never moved, as nodes bake their texture coordinates
+    into their geometry.
+ */
+bool Manager::retireFragmentedAtlas()
+{
+    Atlas *candidate = 0;
+    for (Atlas *atlas : qAsConst(m_atlases)) {
+        // Only drain one page at a time.
+        if (atlas->isRetired())
+            return false;
+        if (!candidate || atlas->usedArea() < candidate->usedArea())
+            candidate = atlas;
+    }
+
+    const qint64 area = qint64(m_atlas_size.width()) * m_atlas_size.height();
+    if (!candidate || candidate->usedArea() * 100 >= area * m_atlas_retire_threshold)
+        return false;
+
+    candidate->setRetired(true);
+    qCDebug(QSG_LOG_INFO, "texture atlas fragmented, retiring page at %d%% occupancy with %d textures",
+            int(candidate->usedArea() * 100 / area), candidate->textureCount());
+    return true;
+}
+
+/*
+    Called from the destructor of the last texture in \a atlas, which can run
+    without the atlas' context being current. The GL texture is deleted by the
+    next call to create() or invalidate() instead.
+ */
+void Manager::atlasEmptied(Atlas *atlas)
+{
+    // Keep the last page around, unless it was retired.
+    if (m_atlases.size() == 1 && !atlas->isRetired())
+        return;
+
+    m_atlases.removeOne(atlas);
+    m_emptied_atlases << atlas;
+}
+
+void Manager::releaseEmptiedAtlases()
+{
+    if (m_emptied_atlases.isEmpty())
+        return;
+
+    for (Atlas *atlas : qAsConst(m_emptied_atlases)) {
+        atlas->detachFromManager();
+        atlas->invalidate();
+        atlas->deleteLater();
+    }
+    m_emptied_atlases.clear();
+    qCDebug(QSG_LOG_INFO, "texture atlas pages released, %d pages in use", m_atlases.size());
+}
+
+Manager::Statistics Manager::statistics() const
+{
+    Statistics stats;
+    for (const Atlas *atlas : m_atlases) {
+        ++stats.pageCount;
+        if (atlas->isRetired())
+            ++stats.retiredPageCount;
+        stats.textureCount += atlas->textureCount();
+        stats.usedArea += atlas->usedArea();
+        stats.totalArea += qint64(atlas->size().width()) * atlas->size().height();
+    }
+    stats.emptiedPageCount = m_emptied_atlases.size();
+    stats.fallbackCount = m_fallback_count;
+    return stats;
+}
+
+Atlas::Atlas(Manager *manager, const QSize &size)
+    : m_manager(manager)
+    , m_allocator(size)
     , m_texture_id(0)
     , m_size(size)
     , m_atlas_transient_image_threshold(0)
+    , m_used_area(0)
+    , m_texture_count(0)
     , m_allocated(false)
+    , m_retired(false)
 {
 
     m_internalFormat = GL_RGBA;
@@ -205,6 +322,8 @@ Texture *Atlas::create(const QImage &image)
     if (rect.width() > 0 && rect.height() > 0) {
         Texture *t = new Texture(this, rect, image);
         m_pending_uploads << t;
+        m_used_area += qint64(rect.width()) * rect.height();
+        ++m_texture_count;
         return t;
     }
     return 0;
@@ -440,6 +559,10 @@ void Atlas::remove(Texture *t)
     QRect atlasRect = t->atlasSubRect();
     m_allocator.deallocate(atlasRect);
     m_pending_uploads.removeOne(t);
+
+    m_used_area -= qint64(atlasRect.width()) * atlasRect.height();
+    if (--m_texture_count == 0 && m_manager)
+        m_manager->atlasEmptied(this);
 }
 
 
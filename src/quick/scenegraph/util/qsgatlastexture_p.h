@@ -52,6 +52,7 @@
 //
 
 #include <QtCore/QSize>
+#include <QtCore/QVector>
 
 #include <QtGui/qopengl.h>
 
@@ -67,7 +68,7 @@ namespace QSGAtlasTexture
 class Texture;
 class Atlas;
 
-class Manager : public QObject
+class Q_QUICK_PRIVATE_EXPORT Manager : public QObject
 {
     Q_OBJECT
 
@@ -75,20 +76,46 @@ public:
     Manager();
     ~Manager();
 
+    struct Statistics {
+        Statistics()
+            : pageCount(0), retiredPageCount(0), emptiedPageCount(0), textureCount(0)
+            , usedArea(0), totalArea(0), fallbackCount(0) { }
+
+        int pageCount;
+        int retiredPageCount;
+        int emptiedPageCount; // No longer in use, released on the next create() or invalidate()
+        int textureCount;
+        qint64 usedArea;
+        qint64 totalArea;
+        int fallbackCount;
+    };
+
     QSGTexture *create(const QImage &image, bool hasAlphaChannel);
     void invalidate();
 
+    Statistics statistics() const;
+
 private:
-    Atlas *m_atlas;
+    friend class Atlas;
+    void atlasEmptied(Atlas *atlas);
+    void releaseEmptiedAtlases();
+    bool retireFragmentedAtlas();
+    int pageLimit() const;
+
+    QVector<Atlas *> m_atlases;
+    QVector<Atlas *> m_emptied_atlases;
 
     QSize m_atlas_size;
     int m_atlas_size_limit;
+    int m_atlas_max_pages;
+    int m_atlas_retire_threshold;
+    int m_fallback_count;
 };
 
 class Atlas : public QObject
 {
 public:
-    Atlas(const QSize &size);
+    Atlas(Manager *manager, const QSize &size);
     ~Atlas();
 
     void invalidate();
@@ -104,10 +131,18 @@ public:
 
     QSize size() const { return m_size; }
 
+    qint64 usedArea() const { return m_used_area; }
+    int textureCount() const { return m_texture_count; }
+
+    bool isRetired() const { return m_retired; }
+    void setRetired(bool retired) { m_retired = retired; }
+    void detachFromManager() { m_manager = 0; }
+
     uint internalFormat() const { return m_internalFormat; }
     uint externalFormat() const { return m_externalFormat; }
 
 private:
+    Manager *m_manager;
     QSGAreaAllocator m_allocator;
     unsigned int m_texture_id;
     QSize m_size;
@@ -118,7 +153,11 @@ private:
 
     int m_atlas_transient_image_threshold;
 
+    qint64 m_used_area;
+    int m_texture_count;
+
     uint m_allocated : 1;
+    uint m_retired : 1;
     uint m_use_bgra_fallback: 1;
 
     uint m_debug_overlay : 1;
@@ -39,6 +39,7 @@ PRIVATETESTS += \
 
 PRIVATETESTS += \
     animation \
+    qqmlarena \
     qqmlecmascript \
     qqmlcontext \
     qqmlexpression \
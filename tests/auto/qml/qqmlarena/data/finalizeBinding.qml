@@ -0,0 +1,7 @@
+import QtQml 2.0
+
+QtObject {
+    property int count: 3
+
+    Component.onCompleted: holder.value = Qt.binding(function() { return 42 })
+}
@@ -0,0 +1,17 @@
+import QtQml 2.0
+
+QtObject {
+    id: root
+
+    property int count: 3
+    property int doubled: count * 2
+    property string label: "instance"
+    signal activated(int index)
+
+    property QtObject child: QtObject {
+        property int value: root.count + 1
+        property string text: root.label + value
+    }
+
+    onActivated: count = index
+}
@@ -0,0 +1,174 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#include <qtest.h>
+#include <QtQml/qqmlengine.h>
+#include <QtQml/qqmlcomponent.h>
+#include <QtQml/qqmlcontext.h>
+#include <private/qqmlarena_p.h>
+#include "../../shared/util.h"
+
+class ArenaObject
+{
+public:
+    Q_QML_ARENA_ALLOCATED
+
+    ArenaObject() { ++instances; }
+    ~ArenaObject() { --instances; }
+
+    static int instances;
+    char payload[40];
+};
+
+int ArenaObject::instances = 0;
+
+class Holder : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int value MEMBER value NOTIFY valueChanged)
+public:
+    int value = 0;
+signals:
+    void valueChanged();
+};
+
+class tst_qqmlarena : public QQmlDataTest
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void release();
+    void releaseWithoutObjects();
+    void componentInstance();
+    void finalizeBindingsDontPin();
+};
+
+void tst_qqmlarena::initTestCase()
+{
+    QQmlDataTest::initTestCase();
+
+    // Decided on the first allocation of an arena allocated class, which no engine has done yet.
+    qputenv("QML_CREATION_ARENA", "1");
+    QVERIFY(QQmlArena::isEnabled());
+}
+
+void tst_qqmlarena::release()
+{
+    const int liveArenas = QQmlArena::liveArenaCount();
+
+    QQmlArena *arena = QQmlArena::create();
+    QCOMPARE(QQmlArena::liveArenaCount(), liveArenas + 1);
+
+    // Enough objects to fill several pages.
+    QVector<ArenaObject *> objects;
+    for (int i = 0; i < 500; ++i)
+        objects.append(new (arena) ArenaObject);
+    ArenaObject *heapObject = new ArenaObject;
+    QCOMPARE(ArenaObject::instances, 501);
+
+    // Objects outlive the owner's hold on the arena ...
+    arena->release();
+    QCOMPARE(QQmlArena::liveArenaCount(), liveArenas + 1);
+
+    // ... and the last one of them frees the pages.
+    while (objects.count() > 1)
+        delete objects.takeLast();
+    QCOMPARE(QQmlArena::liveArenaCount(), liveArenas + 1);
+    delete objects.takeLast();
+    QCOMPARE(QQmlArena::liveArenaCount(), liveArenas);
+
+    delete heapObject;
+    QCOMPARE(ArenaObject::instances, 0);
+}
+
+void tst_qqmlarena::releaseWithoutObjects()
+{
+    const int liveArenas = QQmlArena::liveArenaCount();
+
+    QQmlArena *arena = QQmlArena::create();
+    ArenaObject *object = new (arena) ArenaObject;
+    delete object;
+    QCOMPARE(QQmlArena::liveArenaCount(), liveArenas + 1);
+
+    arena->release();
+    QCOMPARE(QQmlArena::liveArenaCount(), liveArenas);
+}
+
+void tst_qqmlarena::componentInstance()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("instance.qml"));
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+    const int liveArenas = QQmlArena::liveArenaCount();
+
+    QScopedPointer<QObject> first(component.create());
+    QVERIFY(first);
+    QScopedPointer<QObject> second(component.create());
+    QVERIFY(second);
+    QCOMPARE(QQmlArena::liveArenaCount(), liveArenas + 2);
+    QCOMPARE(first->property("doubled").toInt(), 6);
+
+    // Each instance owns its arena, which goes away with the instance.
+    first.reset();
+    engine.collectGarbage();
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+    QCOMPARE(QQmlArena::liveArenaCount(), liveArenas + 1);
+    QCOMPARE(second->property("doubled").toInt(), 6);
+
+    second.reset();
+    engine.collectGarbage();
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+    QCOMPARE(QQmlArena::liveArenaCount(), liveArenas);
+}
+
+void tst_qqmlarena::finalizeBindingsDontPin()
+{
+    QQmlEngine engine;
+    Holder holder;
+    engine.rootContext()->setContextProperty("holder", &holder);
+
+    QQmlComponent component(&engine, testFileUrl("finalizeBinding.qml"));
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+    const int liveArenas = QQmlArena::liveArenaCount();
+
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(object);
+    QCOMPARE(holder.value, 42);
+
+    // The binding installed on the holder by Component.onCompleted outlives the instance,
+    // so it must not have been allocated from the instance's arena.
+    object.reset();
+    engine.collectGarbage();
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);
+    QCOMPARE(QQmlArena::liveArenaCount(), liveArenas);
+}
+
+QTEST_MAIN(tst_qqmlarena)
+
+#include "tst_qqmlarena.moc"
@@ -0,0 +1,16 @@
+import QtQml 2.0
+
+QtObject {
+    property bool deep: false
+    property int source: 0
+
+    property int p: source + 1
+    property int q: p + 1
+    property int s: q + 1
+
+    // Until deep is set these only depend on it, so they start out with a shallow dependency
+    // depth and are queued before the chain they switch to.
+    property int y: deep ? s + 1 : -1
+    property int x: deep ? y + 1 : -1
+    property int result: deep ? x + y + s : source
+}
@@ -0,0 +1,8 @@
+import QtQml 2.0
+
+QtObject {
+    property int source: 0
+    property int left: source + 1
+    property int right: source * 2
+    property int sum: left + right
+}
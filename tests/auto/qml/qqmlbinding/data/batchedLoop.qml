@@ -0,0 +1,8 @@
+import QtQml 2.0
+
+QtObject {
+    property int trigger: 0
+    property int a: trigger > 0 ? b + 1 : 0
+    property int b: trigger > 0 ? a + 1 : 0
+    property int c: trigger > 1 ? c + 1 : 0
+}
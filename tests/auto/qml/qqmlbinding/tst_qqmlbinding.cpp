@@ -28,7 +28,9 @@
 #include <qtest.h>
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
+#include <QtTest/QSignalSpy>
 #include <private/qqmlbind_p.h>
+#include <private/qqmlengine_p.h>
 #include <QtQuick/private/qquickrectangle_p.h>
 #include "../../shared/util.h"
 
@@ -51,6 +53,9 @@ private slots:
     void disabledOnReadonlyProperty();
     void delayed();
     void bindingOverwriting();
+    void batchedDiamond();
+    void batchedConditionalDependency();
+    void batchedLoop();
 
 private:
     QQmlEngine engine;
@@ -319,6 +324,91 @@ void tst_qqmlbinding::bindingOverwriting()
     QCOMPARE(messageHandler.messages().count(), 2);
 }
 
+// Creates the object in an engine that batches binding updates, as with QML_BATCHED_BINDINGS,
+// and collects the warnings of the engine instead of printing them.
+static QObject *createBatched(QQmlEngine *engine, const QUrl &url, QStringList *warnings)
+{
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(engine);
+    ep->batchedBindingUpdates = true;
+    engine->setOutputWarningsToStandardError(false);
+    QObject::connect(engine, &QQmlEngine::warnings, [warnings](const QList<QQmlError> &errors) {
+        for (const QQmlError &error : errors)
+            *warnings << error.toString();
+    });
+
+    QQmlComponent c(engine, url);
+    QObject *object = c.create();
+    ep->flushPendingBindingUpdates();
+    return object;
+}
+
+void tst_qqmlbinding::batchedDiamond()
+{
+    QQmlEngine engine;
+    QStringList warnings;
+    QScopedPointer<QObject> object(createBatched(&engine, testFileUrl("batchedDiamond.qml"), &warnings));
+    QVERIFY(object);
+    QCOMPARE(object->property("sum").toInt(), 1);
+
+    // The sum is only evaluated after both sides, so it never has an intermediate value
+    QSignalSpy sumSpy(object.data(), SIGNAL(sumChanged()));
+    object->setProperty("source", 5);
+    QQmlEnginePrivate::get(&engine)->flushPendingBindingUpdates();
+    QCOMPARE(sumSpy.count(), 1);
+    QCOMPARE(object->property("sum").toInt(), 6 + 10);
+    QVERIFY2(warnings.isEmpty(), qPrintable(warnings.join(QLatin1Char('\n'))));
+}
+
+void tst_qqmlbinding::batchedConditionalDependency()
+{
+    QQmlEngine engine;
+    QStringList warnings;
+    QScopedPointer<QObject> object(createBatched(&engine, testFileUrl("batchedConditional.qml"), &warnings));
+    QVERIFY(object);
+    QCOMPARE(object->property("result").toInt(), 0);
+
+    // The bindings switching to the deeper chain are evaluated with stale values first, and
+    // invalidated again as the chain settles. That is not a loop, and the last update wins.
+    object->setProperty("deep", true);
+    object->setProperty("source", 5);
+    QQmlEnginePrivate::get(&engine)->flushPendingBindingUpdates();
+    QCOMPARE(object->property("s").toInt(), 8);
+    QCOMPARE(object->property("y").toInt(), 9);
+    QCOMPARE(object->property("x").toInt(), 10);
+    QCOMPARE(object->property("result").toInt(), 10 + 9 + 8);
+    QVERIFY2(warnings.isEmpty(), qPrintable(warnings.join(QLatin1Char('\n'))));
+
+    object->setProperty("source", 1);
+    QQmlEnginePrivate::get(&engine)->flushPendingBindingUpdates();
+    QCOMPARE(object->property("result").toInt(), 6 + 5 + 4);
+    QVERIFY2(warnings.isEmpty(), qPrintable(warnings.join(QLatin1Char('\n'))));
+}
+
+void tst_qqmlbinding::batchedLoop()
+{
+    QQmlEngine engine;
+    QStringList warnings;
+    QScopedPointer<QObject> object(createBatched(&engine, testFileUrl("batchedLoop.qml"), &warnings));
+    QVERIFY(object);
+    QVERIFY(warnings.isEmpty());
+
+    // Two bindings invalidating each other are reported once the first one is invalidated
+    // again by the evaluation it caused, and the flush ends.
+    object->setProperty("trigger", 1);
+    QQmlEnginePrivate::get(&engine)->flushPendingBindingUpdates();
+    QCOMPARE(warnings.count(), 1);
+    QVERIFY2(warnings.first().contains(QLatin1String("Binding loop detected for property \"a\""))
+             || warnings.first().contains(QLatin1String("Binding loop detected for property \"b\"")),
+             qPrintable(warnings.first()));
+    QCOMPARE(qAbs(object->property("a").toInt() - object->property("b").toInt()), 1);
+
+    // A binding invalidated by its own evaluation is reported as well
+    warnings.clear();
+    object->setProperty("trigger", 2);
+    QQmlEnginePrivate::get(&engine)->flushPendingBindingUpdates();
+    QVERIFY(warnings.filter(QLatin1String("Binding loop detected for property \"c\"")).count() == 1);
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
@@ -0,0 +1,45 @@
+import QtQuick 2.0
+
+Item {
+    id: root
+
+    property int count: 3
+    property string label: "root"
+    property alias childWidth: child.width
+    default property alias content: container.data
+
+    signal activated(int index, string name)
+    function describe(prefix) { return prefix + label + count }
+
+    width: 100
+    height: 50
+
+    Item {
+        id: container
+        property real ratio: root.width / root.height
+        property var list: [1, 2, 3]
+    }
+
+    Rectangle {
+        id: child
+        property color tint: "red"
+        property bool on: root.count > 2
+        width: 40
+        height: width / 2
+        color: tint
+
+        Text {
+            property int size: 12
+            text: root.describe("x")
+            font.pixelSize: size
+        }
+    }
+
+    Repeater {
+        model: root.count
+        delegate: Item {
+            property int row: index
+            width: row * 10
+        }
+    }
+}
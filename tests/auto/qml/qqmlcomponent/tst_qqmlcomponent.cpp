@@ -40,6 +40,7 @@
 #include <private/qv4qmlcontext_p.h>
 #include <private/qv4scopedvalue_p.h>
 #include <private/qv4qmlcontext_p.h>
+#include <private/qqmlobjectcreator_p.h>
 #include <qcolor.h>
 #include "../../shared/util.h"
 #include "testhttpserver.h"
@@ -117,6 +118,7 @@ private slots:
     void recursion();
     void recursionContinuation();
     void callingContextForInitialProperties();
+    void parallelInstantiation();
 
 private:
     QQmlEngine engine;
@@ -581,6 +583,61 @@ void tst_qqmlcomponent::callingContextForInitialProperties()
     QVERIFY(checker->scopeObject->metaObject()->indexOfProperty("incubatedObject") != -1);
 }
 
+// Describes the properties, methods and class infos of every object in the tree, and the
+// values of the properties. Class names are left out as they are unique per engine.
+static void describeObjectTree(QObject *object, QStringList *description, int depth = 0)
+{
+    const QString indent(depth * 2, QLatin1Char(' '));
+    const QMetaObject *metaObject = object->metaObject();
+
+    for (int i = 0; i < metaObject->propertyCount(); ++i) {
+        const QMetaProperty property = metaObject->property(i);
+        const QVariant value = property.read(object);
+        description->append(indent + QString::fromLatin1("property %1 %2 = %3")
+                .arg(QString::fromLatin1(property.typeName()))
+                .arg(QString::fromLatin1(property.name()))
+                .arg(value.canConvert<QString>() ? value.toString() : QString()));
+    }
+    for (int i = 0; i < metaObject->methodCount(); ++i) {
+        description->append(indent + QString::fromLatin1("method %1")
+                .arg(QString::fromLatin1(metaObject->method(i).methodSignature())));
+    }
+    for (int i = 0; i < metaObject->classInfoCount(); ++i) {
+        const QMetaClassInfo classInfo = metaObject->classInfo(i);
+        description->append(indent + QString::fromLatin1("classinfo %1 = %2")
+                .arg(QString::fromLatin1(classInfo.name()))
+                .arg(QString::fromLatin1(classInfo.value())));
+    }
+
+    for (QObject *child : object->children())
+        describeObjectTree(child, description, depth + 1);
+}
+
+void tst_qqmlcomponent::parallelInstantiation()
+{
+    const auto create = [this](bool parallel) {
+        QQmlObjectCreatorPreparation::setEnabled(parallel);
+
+        // A new engine compiles the type again, which schedules the preparation.
+        QQmlEngine engine;
+        QQmlComponent component(&engine, testFileUrl("parallelInstantiation.qml"));
+        QScopedPointer<QObject> object(component.create());
+        QStringList description;
+        if (object)
+            describeObjectTree(object.data(), &description);
+        return description;
+    };
+
+    const QStringList serial = create(false);
+    const QStringList parallel = create(true);
+    const QStringList parallelAgain = create(true);
+    QQmlObjectCreatorPreparation::setEnabled(false);
+
+    QVERIFY(!serial.isEmpty());
+    QCOMPARE(parallel, serial);
+    QCOMPARE(parallelAgain, serial);
+}
+
 QTEST_MAIN(tst_qqmlcomponent)
 
 #include "tst_qqmlcomponent.moc"
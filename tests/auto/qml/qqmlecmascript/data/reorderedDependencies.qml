@@ -0,0 +1,12 @@
+import QtQml 2.0
+import Qt.test 1.0
+
+QtObject {
+    property bool swap: false
+    property QtObject first: ConnectNotifyCounter { value: 1 }
+    property QtObject second: ConnectNotifyCounter { value: 2 }
+    property QtObject third: ConnectNotifyCounter { value: 3 }
+
+    property int result: swap ? third.value * 100 + second.value * 10 + first.value
+                              : first.value * 100 + second.value * 10 + third.value
+}
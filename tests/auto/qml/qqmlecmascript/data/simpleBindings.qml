@@ -0,0 +1,21 @@
+import QtQml 2.0
+
+QtObject {
+    id: root
+    property int base: 10
+    property real factor: 1.5
+    property string name: "foo"
+    property bool flag: true
+    property var untyped: 3
+    property QtObject other: QtObject { id: inner; property int value: 4 }
+    property QtObject replacement: QtObject { property int value: 40 }
+
+    property int sum: base + 5
+    property real scaled: factor * base
+    property int halved: (base / 4)
+    property int fromId: inner.value - 1
+    property int chained: root.other.value * 2
+    property string joined: name + name
+    property bool copied: flag
+    property int fromVar: untyped + 1
+}
@@ -548,6 +548,7 @@ void registerTypes()
     qmlRegisterType<FloatingQObject>("Qt.test", 1, 0, "FloatingQObject");
 
     qmlRegisterType<ClashingNames>("Qt.test", 1, 0, "ClashingNames");
+    qmlRegisterType<ConnectNotifyCounter>("Qt.test", 1, 0, "ConnectNotifyCounter");
 }
 
 #include "testtypes.moc"
@@ -1727,6 +1727,45 @@ public:
     Q_INVOKABLE bool clashes() const { return true; }
 };
 
+// Counts how often bindings connect to and disconnect from valueChanged()
+class ConnectNotifyCounter : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int value READ value WRITE setValue NOTIFY valueChanged)
+public:
+    ConnectNotifyCounter() : connects(0), disconnects(0), m_value(0) {}
+
+    int value() const { return m_value; }
+    void setValue(int value)
+    {
+        if (value == m_value)
+            return;
+        m_value = value;
+        emit valueChanged();
+    }
+
+    int connects;
+    int disconnects;
+
+signals:
+    void valueChanged();
+
+protected:
+    void connectNotify(const QMetaMethod &signal) override
+    {
+        if (signal == QMetaMethod::fromSignal(&ConnectNotifyCounter::valueChanged))
+            ++connects;
+    }
+    void disconnectNotify(const QMetaMethod &signal) override
+    {
+        if (signal == QMetaMethod::fromSignal(&ConnectNotifyCounter::valueChanged))
+            ++disconnects;
+    }
+
+private:
+    int m_value;
+};
+
 void registerTypes();
 
 #endif // TESTTYPES_H
@@ -345,6 +345,8 @@ private slots:
     void qtbug_60547();
     void delayLoadingArgs();
     void manyArguments();
+    void reorderedDependencies();
+    void simpleBindings();
 
 private:
 //    static void propertyVarWeakRefCallback(v8::Persistent<v8::Value> object, void* parameter);
@@ -8394,6 +8396,92 @@ void tst_qqmlecmascript::manyArguments()
     engine.evaluate(testCase);
 }
 
+void tst_qqmlecmascript::reorderedDependencies()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("reorderedDependencies.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY(!object.isNull());
+    QCOMPARE(object->property("result").toInt(), 123);
+
+    ConnectNotifyCounter *first = qobject_cast<ConnectNotifyCounter *>(object->property("first").value<QObject *>());
+    ConnectNotifyCounter *second = qobject_cast<ConnectNotifyCounter *>(object->property("second").value<QObject *>());
+    ConnectNotifyCounter *third = qobject_cast<ConnectNotifyCounter *>(object->property("third").value<QObject *>());
+    QVERIFY(first && second && third);
+    const QList<ConnectNotifyCounter *> counters = { first, second, third };
+    for (ConnectNotifyCounter *counter : counters) {
+        QCOMPARE(counter->connects, 1);
+        QCOMPARE(counter->disconnects, 0);
+    }
+
+    // The dependencies are captured in reverse order now, but must all stay
+    // connected through the guards of the previous evaluation.
+    object->setProperty("swap", true);
+    QCOMPARE(object->property("result").toInt(), 321);
+    for (ConnectNotifyCounter *counter : counters) {
+        QCOMPARE(counter->connects, 1);
+        QCOMPARE(counter->disconnects, 0);
+    }
+    first->setProperty("value", 4);
+    QCOMPARE(object->property("result").toInt(), 324);
+    second->setProperty("value", 5);
+    QCOMPARE(object->property("result").toInt(), 354);
+    third->setProperty("value", 6);
+    QCOMPARE(object->property("result").toInt(), 654);
+
+    object->setProperty("swap", false);
+    QCOMPARE(object->property("result").toInt(), 456);
+    third->setProperty("value", 7);
+    QCOMPARE(object->property("result").toInt(), 457);
+    first->setProperty("value", 1);
+    QCOMPARE(object->property("result").toInt(), 157);
+    for (ConnectNotifyCounter *counter : counters) {
+        QCOMPARE(counter->connects, 1);
+        QCOMPARE(counter->disconnects, 0);
+    }
+}
+
+void tst_qqmlecmascript::simpleBindings()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine, testFileUrl("simpleBindings.qml"));
+    QScopedPointer<QObject> object(component.create());
+    QVERIFY2(!object.isNull(), qPrintable(component.errorString()));
+
+    QCOMPARE(object->property("sum").toInt(), 15);
+    QCOMPARE(object->property("scaled").toReal(), qreal(15));
+    QCOMPARE(object->property("halved").toInt(), 2);
+    QCOMPARE(object->property("fromId").toInt(), 3);
+    QCOMPARE(object->property("chained").toInt(), 8);
+    QCOMPARE(object->property("joined").toString(), QStringLiteral("foofoo"));
+    QCOMPARE(object->property("copied").toBool(), true);
+    QCOMPARE(object->property("fromVar").toInt(), 4);
+
+    object->setProperty("base", 20);
+    QCOMPARE(object->property("sum").toInt(), 25);
+    QCOMPARE(object->property("scaled").toReal(), qreal(30));
+    QCOMPARE(object->property("halved").toInt(), 5);
+
+    QObject *inner = object->property("other").value<QObject *>();
+    QVERIFY(inner);
+    inner->setProperty("value", 6);
+    QCOMPARE(object->property("fromId").toInt(), 5);
+    QCOMPARE(object->property("chained").toInt(), 12);
+
+    // Replacing an object in the middle of the path must update the dependencies
+    object->setProperty("other", object->property("replacement"));
+    QCOMPARE(object->property("fromId").toInt(), 5);
+    QCOMPARE(object->property("chained").toInt(), 80);
+    inner->setProperty("value", 7);
+    QCOMPARE(object->property("chained").toInt(), 80);
+
+    object->setProperty("name", QStringLiteral("bar"));
+    QCOMPARE(object->property("joined").toString(), QStringLiteral("barbar"));
+    object->setProperty("flag", false);
+    QCOMPARE(object->property("copied").toBool(), false);
+    object->setProperty("untyped", 9);
+    QCOMPARE(object->property("fromVar").toInt(), 10);
+}
 
 QTEST_MAIN(tst_qqmlecmascript)
 
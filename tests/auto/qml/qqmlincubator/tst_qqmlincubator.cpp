@@ -68,6 +68,7 @@ private slots:
     void chainedAsynchronousClear();
     void selfDelete();
     void contextDelete();
+    void priority();
 
 private:
     QQmlIncubationController controller;
@@ -1144,6 +1145,50 @@ void tst_qqmlincubator::contextDelete()
     }
 }
 
+void tst_qqmlincubator::priority()
+{
+    class MyIncubator : public QQmlIncubator
+    {
+    public:
+        MyIncubator(const QString &name, QStringList *ready)
+        : QQmlIncubator(QQmlIncubator::Asynchronous), name(name), ready(ready) {}
+
+    protected:
+        virtual void statusChanged(Status s) { if (s == Ready) *ready << name; }
+
+    private:
+        QString name;
+        QStringList *ready;
+    };
+
+    QQmlComponent component(&engine, testFileUrl("statusChanged.qml"));
+    QVERIFY(component.isReady());
+
+    QStringList ready;
+    MyIncubator a(QStringLiteral("a"), &ready);
+    MyIncubator b(QStringLiteral("b"), &ready);
+    MyIncubator c(QStringLiteral("c"), &ready);
+    component.create(a);
+    component.create(b);
+    component.create(c);
+    QVERIFY(a.isLoading());
+    QVERIFY(b.isLoading());
+    QVERIFY(c.isLoading());
+
+    QQmlIncubatorPrivate::get(&b)->setPriority(1);
+    QQmlIncubatorPrivate::get(&c)->setPriority(-1);
+
+    {
+    bool go = true;
+    controller.incubateWhile(&go);
+    }
+
+    QCOMPARE(ready, QStringList() << "b" << "a" << "c");
+    delete a.object();
+    delete b.object();
+    delete c.object();
+}
+
 QTEST_MAIN(tst_qqmlincubator)
 
 #include "tst_qqmlincubator.moc"
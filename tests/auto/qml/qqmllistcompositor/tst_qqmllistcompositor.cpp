@@ -26,6 +26,7 @@
 **
 ****************************************************************************/
 #include <qtest.h>
+#include <QtCore/qrandom.h>
 #include <private/qqmllistcompositor_p.h>
 
 template<typename T, int N> int lengthOf(const T (&)[N]) { return N; }
@@ -148,6 +149,7 @@ private slots:
     void move();
     void moveFromEnd();
     void clear();
+    void indexedFind();
     void listItemsInserted_data();
     void listItemsInserted();
     void listItemsRemoved_data();
@@ -1084,6 +1086,79 @@ void tst_qqmllistcompositor::clear()
     QCOMPARE(compositor.count(C::Cache), 0);
 }
 
+void tst_qqmllistcompositor::indexedFind()
+{
+    int listA; void *a = &listA;
+    int listB; void *b = &listB;
+
+    QQmlListCompositor compositor;
+    compositor.setGroupCount(4);
+    compositor.setDefaultGroups(VisibleFlag | C::DefaultFlag);
+
+    // Alternate the flags so no two ranges can be merged and lookups go through the range index.
+    for (int i = 0; i < 400; ++i) {
+        compositor.append(a, 4 * i, 4, C::DefaultFlag
+                | (i % 2 ? VisibleFlag : 0)
+                | (i % 3 ? 0 : SelectionFlag));
+    }
+
+    const C::Group groups[] = { C::Default, Visible, Selection };
+    QRandomGenerator random(1234);
+
+    for (int edit = 0; edit < 1000; ++edit) {
+        const int count = compositor.count(C::Default);
+        const int index = random.bounded(count);
+        const int length = 1 + random.bounded(qMin(count - index, 6));
+        const uint flag = random.bounded(2) ? VisibleFlag : SelectionFlag;
+
+        switch (random.bounded(4)) {
+        case 0:
+            compositor.insert(C::Default, random.bounded(count + 1), b, edit, length, C::DefaultFlag | flag);
+            break;
+        case 1:
+            compositor.setFlags(C::Default, index, length, flag);
+            break;
+        case 2:
+            compositor.clearFlags(C::Default, index, length, flag);
+            break;
+        default: {
+            const int to = random.bounded(count - length + 1);
+            if (compositor.verifyMoveTo(C::Default, index, C::Default, to, length, C::Default)) {
+                QVector<C::Remove> removes;
+                QVector<C::Insert> inserts;
+                compositor.move(C::Default, index, C::Default, to, length, C::Default, &removes, &inserts);
+            }
+            break;
+        }
+        }
+
+        // Compare lookups at random indexes and at both ends against a walk from the first range.
+        for (const C::Group group : groups) {
+            const int groupCount = compositor.count(group);
+            if (groupCount == 0)
+                continue;
+            const int indexes[] = { 0, groupCount - 1, random.bounded(groupCount), random.bounded(groupCount) };
+            for (int i : indexes) {
+                C::iterator expected(compositor.end()->next, 0, group, 4);
+                expected += i;
+                C::iterator it = compositor.find(group, i);
+                QCOMPARE(*it, *expected);
+                QCOMPARE(it.offset, expected.offset);
+                for (int j = 0; j < 4; ++j)
+                    QCOMPARE(it.index[j], expected.index[j]);
+
+                C::insert_iterator expectedInsert(compositor.end()->next, 0, group, 4);
+                expectedInsert += i + 1;
+                C::insert_iterator insertIt = compositor.findInsertPosition(group, i + 1);
+                QCOMPARE(*insertIt, *expectedInsert);
+                QCOMPARE(insertIt.offset, expectedInsert.offset);
+                for (int j = 0; j < 4; ++j)
+                    QCOMPARE(insertIt.index[j], expectedInsert.index[j]);
+            }
+        }
+    }
+}
+
 void tst_qqmllistcompositor::listItemsInserted_data()
 {
     QTest::addColumn<RangeList>("ranges");
@@ -124,6 +124,10 @@ private slots:
     void modify_through_delegate();
     void bindingsOnGetResult();
     void stringifyModelEntry();
+    void bulk_insert();
+    void chunked_storage();
+    void sort_filter_find();
+    void sort_filter_layoutChanged();
 };
 
 bool tst_qqmllistmodel::compareVariantList(const QVariantList &testList, QVariant object)
@@ -1505,6 +1509,205 @@ void tst_qqmllistmodel::stringifyModelEntry()
     QCOMPARE(v.toString(), expectedString);
 }
 
+void tst_qqmllistmodel::bulk_insert()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model,engine.rootContext());
+
+    RowTester tester(&model);
+
+    QQmlExpression e1(engine.rootContext(), &model,
+                      "{append([{'test':0}, {'test':3}, {'test':4, 'sub':[{'a':1}, {'a':2}]}])}");
+    e1.evaluate();
+    QVERIFY2(!e1.hasError(), QTest::toString(e1.error().toString()));
+
+    QCOMPARE(tester.rowsAboutToBeInsertedCalls, 1);
+    QCOMPARE(tester.rowsInsertedCalls, 1);
+    QCOMPARE(tester.rowsInsertedCount, 3);
+
+    QQmlExpression e2(engine.rootContext(), &model, "{insert(1, [{'test':1}, {'test':2}])}");
+    e2.evaluate();
+    QVERIFY2(!e2.hasError(), QTest::toString(e2.error().toString()));
+
+    QCOMPARE(tester.rowsAboutToBeInsertedCalls, 2);
+    QCOMPARE(tester.rowsInsertedCalls, 2);
+    QCOMPARE(tester.rowsInsertedCount, 5);
+
+    for (int i = 0; i < model.count(); ++i)
+        QCOMPARE(model.data(model.index(i, 0), 0).toInt(), i);
+
+    QQmlExpression e3(engine.rootContext(), &model, "get(4).sub.get(1).a");
+    QCOMPARE(e3.evaluate().toInt(), 2);
+
+    QQmlExpression e4(engine.rootContext(), &model, "get(2).test = 10; get(2).test");
+    QCOMPARE(e4.evaluate().toInt(), 10);
+}
+
+void tst_qqmllistmodel::chunked_storage()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model,engine.rootContext());
+
+    // Rows are stored in chunks of a few hundred, so these edits span
+    // several chunks. A plain array mirrors every edit.
+    QQmlExpression e1(engine.rootContext(), &model,
+                      "(function() {"
+                      " var mirror = [];"
+                      " var rows = [];"
+                      " for (var i = 0; i < 1000; ++i) {"
+                      "     rows.push({'id': i, 'name': 'n' + (i % 3), 'even': i % 2 == 0});"
+                      "     mirror.push(i);"
+                      " }"
+                      " append(rows);"
+                      " rows = [];"
+                      " for (var i = 1000; i < 1300; ++i) {"
+                      "     rows.push({'id': i, 'name': 'n' + (i % 3), 'even': i % 2 == 0});"
+                      " }"
+                      " insert(500, rows);"
+                      " Array.prototype.splice.apply(mirror, [500, 0].concat(rows.map(function(r) { return r.id; })));"
+                      " var cached = get(1100);"
+                      " move(10, 900, 300);"
+                      " mirror.splice.apply(mirror, [900, 0].concat(mirror.splice(10, 300)));"
+                      " move(1200, 5, 50);"
+                      " mirror.splice.apply(mirror, [5, 0].concat(mirror.splice(1200, 50)));"
+                      " remove(200, 600);"
+                      " mirror.splice(200, 600);"
+                      " insert(0, {'id': 2000, 'name': 'n2', 'extra': 'new role'});"
+                      " mirror.unshift(2000);"
+                      " if (count !== mirror.length) return 'count ' + count;"
+                      " for (var i = 0; i < count; ++i) {"
+                      "     var e = get(i);"
+                      "     if (e.id !== mirror[i]) return 'id at ' + i + ': ' + e.id;"
+                      "     if (e.name !== 'n' + (mirror[i] % 3)) return 'name at ' + i + ': ' + e.name;"
+                      "     if (mirror[i] < 2000 && e.even !== (mirror[i] % 2 == 0)) return 'even at ' + i;"
+                      "     if (i > 0 && e.extra !== undefined && e.extra !== '') return 'extra at ' + i + ': ' + e.extra;"
+                      " }"
+                      " var index = mirror.indexOf(cached.id);"
+                      " cached.name = 'changed';"
+                      " if (get(index).name !== 'changed') return 'cached object not moved with its row';"
+                      " return '';"
+                      "})()");
+    QVariant result = e1.evaluate();
+    QVERIFY2(!e1.hasError(), QTest::toString(e1.error().toString()));
+    QCOMPARE(result.toString(), QString());
+}
+
+void tst_qqmllistmodel::sort_filter_find()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model,engine.rootContext());
+
+    QQmlExpression e1(engine.rootContext(), &model,
+                      "{append([{'name':'c', 'cost':3}, {'name':'a', 'cost':1}, {'name':'d', 'cost':4},"
+                      " {'name':'b', 'cost':1}, {'name':'e', 'cost':2}])}");
+    e1.evaluate();
+    QCOMPARE(model.count(), 5);
+
+    const auto names = [&model]() {
+        QStringList result;
+        for (int i = 0; i < model.count(); ++i)
+            result << model.data(i, 0).toString();
+        return result;
+    };
+
+    RowTester tester(&model);
+
+    QQmlExpression e2(engine.rootContext(), &model, "sort('cost')");
+    e2.evaluate();
+    QVERIFY2(!e2.hasError(), QTest::toString(e2.error().toString()));
+    QCOMPARE(names(), QStringList() << "a" << "b" << "e" << "c" << "d");
+    QVERIFY(tester.rowsMovedCalls > 0);
+    QCOMPARE(tester.rowsInsertedCalls, 0);
+    QCOMPARE(tester.rowsRemovedCalls, 0);
+
+    QQmlExpression e3(engine.rootContext(), &model, "find('cost', 3)");
+    QCOMPARE(e3.evaluate().toInt(), 3);
+    QQmlExpression e4(engine.rootContext(), &model, "find('cost', 1)");
+    QCOMPARE(e4.evaluate().toInt(), 0);
+    QQmlExpression e5(engine.rootContext(), &model, "find('cost', 7)");
+    QCOMPARE(e5.evaluate().toInt(), -1);
+
+    QQmlExpression e6(engine.rootContext(), &model, "sort('name', Qt.DescendingOrder)");
+    e6.evaluate();
+    QCOMPARE(names(), QStringList() << "e" << "d" << "c" << "b" << "a");
+    QQmlExpression e7(engine.rootContext(), &model, "find('name', 'b', Qt.DescendingOrder)");
+    QCOMPARE(e7.evaluate().toInt(), 3);
+
+    tester.reset();
+    QQmlExpression e8(engine.rootContext(), &model, "filter(function(item) { return item.cost != 4 && item.cost != 3 })");
+    e8.evaluate();
+    QVERIFY2(!e8.hasError(), QTest::toString(e8.error().toString()));
+    QCOMPARE(names(), QStringList() << "e" << "b" << "a");
+    QCOMPARE(tester.rowsRemovedCalls, 1);
+
+    QQmlExpression e9(engine.rootContext(), &model, "filter('cost', 1)");
+    e9.evaluate();
+    QCOMPARE(names(), QStringList() << "b" << "a");
+}
+
+void tst_qqmllistmodel::sort_filter_layoutChanged()
+{
+    QQmlEngine engine;
+    QQmlListModel model;
+    QQmlEngine::setContextForObject(&model,engine.rootContext());
+
+    // Costs are a permutation of 0..199 which takes far more block moves to sort than
+    // the model is willing to report.
+    QQmlExpression e1(engine.rootContext(), &model,
+                      "{for (var i = 0; i < 200; ++i) append({'cost': (i * 37) % 200})}");
+    e1.evaluate();
+    QCOMPARE(model.count(), 200);
+
+    const auto costs = [&model]() {
+        QList<int> result;
+        for (int i = 0; i < model.count(); ++i)
+            result << model.data(i, 0).toInt();
+        return result;
+    };
+
+    RowTester tester(&model);
+    QSignalSpy layoutAboutToBeChangedSpy(&model, SIGNAL(layoutAboutToBeChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)));
+    QSignalSpy layoutChangedSpy(&model, SIGNAL(layoutChanged(QList<QPersistentModelIndex>,QAbstractItemModel::LayoutChangeHint)));
+    QSignalSpy countSpy(&model, SIGNAL(countChanged()));
+
+    QPersistentModelIndex cost37 = model.index(1, 0);
+    QPersistentModelIndex cost74 = model.index(2, 0);
+
+    QQmlExpression e2(engine.rootContext(), &model, "sort('cost')");
+    e2.evaluate();
+    QVERIFY2(!e2.hasError(), QTest::toString(e2.error().toString()));
+
+    QList<int> expected;
+    for (int i = 0; i < 200; ++i)
+        expected << i;
+    QCOMPARE(costs(), expected);
+    QCOMPARE(tester.rowsMovedCalls, 0);
+    QCOMPARE(layoutAboutToBeChangedSpy.count(), 1);
+    QCOMPARE(layoutChangedSpy.count(), 1);
+    QCOMPARE(layoutChangedSpy.at(0).at(1).value<QAbstractItemModel::LayoutChangeHint>(), QAbstractItemModel::VerticalSortHint);
+    QCOMPARE(cost37.row(), 37);
+    QCOMPARE(cost74.row(), 74);
+    QCOMPARE(countSpy.count(), 0);
+
+    // Removing many separate runs reports each run as a removal.
+    QQmlExpression e3(engine.rootContext(), &model, "filter(function(item) { return item.cost % 2 == 0 })");
+    e3.evaluate();
+    QVERIFY2(!e3.hasError(), QTest::toString(e3.error().toString()));
+
+    expected.clear();
+    for (int i = 0; i < 200; i += 2)
+        expected << i;
+    QCOMPARE(costs(), expected);
+    QCOMPARE(tester.rowsRemovedCalls, 100);
+    QCOMPARE(layoutChangedSpy.count(), 1);
+    QVERIFY(!cost37.isValid());
+    QCOMPARE(cost74.row(), 37);
+    QCOMPARE(countSpy.count(), 100);
+}
+
 QTEST_MAIN(tst_qqmllistmodel)
 
 #include "tst_qqmllistmodel.moc"
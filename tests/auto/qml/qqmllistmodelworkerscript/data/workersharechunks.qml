@@ -0,0 +1,34 @@
+import QtQuick 2.0
+
+Item {
+  id: item
+  property variant model
+  property bool done: false
+
+  WorkerScript {
+    id: worker
+    source: "workersharechunks.js"
+    onMessage: {
+      item.done = true
+    }
+  }
+
+  function addItems(count) {
+    var rows = []
+    for (var i = 0; i < count; ++i)
+      rows.push({ 'cost': i })
+    model.append(rows)
+  }
+
+  function setItemViaWorker(index, cost) {
+    done = false
+    var msg = { 'action': 'setItem', 'model': model, 'index': index, 'cost': cost }
+    worker.sendMessage(msg);
+  }
+
+  function doSync() {
+    done = false
+    var msg = { 'action': 'dosync', 'model': model }
+    worker.sendMessage(msg);
+  }
+}
@@ -98,8 +98,11 @@ private slots:
     void property_changes_worker_data();
     void worker_sync_data();
     void worker_sync();
+    void worker_sync_modified_data();
+    void worker_sync_modified();
     void worker_remove_element_data();
     void worker_remove_element();
+    void worker_share_chunks();
     void worker_remove_list_data();
     void worker_remove_list();
     void dynamic_role_data();
@@ -691,11 +694,92 @@ void tst_qqmllistmodelworkerscript::worker_sync()
     qApp->processEvents();
 }
 
+void tst_qqmllistmodelworkerscript::worker_sync_modified_data()
+{
+    worker_sync_data();
+}
+
+void tst_qqmllistmodelworkerscript::worker_sync_modified()
+{
+    QFETCH(bool, dynamicRoles);
+
+    QQmlListModel model;
+    model.setDynamicRoles(dynamicRoles);
+    QQmlEngine eng;
+    QQmlComponent component(&eng, testFileUrl("model.qml"));
+    QQuickItem *item = createWorkerTest(&eng, &component, &model);
+    QVERIFY(item != 0);
+
+    RUNEVAL(item, "model.append({name: 'c', cost: 3})");
+    RUNEVAL(item, "model.append({name: 'a', cost: 1})");
+    RUNEVAL(item, "model.append({name: 'b', cost: 2})");
+
+    // Only the modified element has its data copied back; the others keep theirs
+    QVERIFY(QMetaObject::invokeMethod(item, "evalExpressionViaWorker",
+            Q_ARG(QVariant, QStringList() << "get(2).cost = 5" << "sort('name')")));
+    waitForWorker(item);
+
+    const int name = roleFromName(&model, "name");
+    const int cost = roleFromName(&model, "cost");
+    QCOMPARE(model.count(), 3);
+    QCOMPARE(model.data(0, name).toString(), QStringLiteral("a"));
+    QCOMPARE(model.data(0, cost).toInt(), 1);
+    QCOMPARE(model.data(1, name).toString(), QStringLiteral("b"));
+    QCOMPARE(model.data(1, cost).toInt(), 5);
+    QCOMPARE(model.data(2, name).toString(), QStringLiteral("c"));
+    QCOMPARE(model.data(2, cost).toInt(), 3);
+
+    delete item;
+    qApp->processEvents();
+}
+
 void tst_qqmllistmodelworkerscript::worker_remove_element_data()
 {
     worker_sync_data();
 }
 
+void tst_qqmllistmodelworkerscript::worker_share_chunks()
+{
+    QQmlListModel model;
+    QQmlEngine eng;
+    QQmlComponent component(&eng, testFileUrl("workersharechunks.qml"));
+    QQuickItem *item = createWorkerTest(&eng, &component, &model);
+    QVERIFY(item != 0);
+
+    QVERIFY(QMetaObject::invokeMethod(item, "addItems", Q_ARG(QVariant, 2000)));
+    QCOMPARE(model.count(), 2000);
+    const int cost = roleFromName(&model, "cost");
+
+    // The worker's copy of the model starts out sharing all rows
+    QVERIFY(QMetaObject::invokeMethod(item, "doSync"));
+    waitForWorker(item);
+    const int chunkCount = model.sharedChunkCount();
+    QVERIFY(chunkCount > 1);
+
+    // Writing in the worker only copies the chunk holding the row
+    QVERIFY(QMetaObject::invokeMethod(item, "setItemViaWorker", Q_ARG(QVariant, 1500), Q_ARG(QVariant, -1)));
+    waitForWorker(item);
+    QCOMPARE(model.sharedChunkCount(), chunkCount - 1);
+    QCOMPARE(model.data(1500, cost).toInt(), 1500);
+
+    // Syncing hands that chunk over instead of copying the rows again
+    QVERIFY(QMetaObject::invokeMethod(item, "doSync"));
+    waitForWorker(item);
+    QCOMPARE(model.sharedChunkCount(), chunkCount);
+    QCOMPARE(model.count(), 2000);
+    QCOMPARE(model.data(1500, cost).toInt(), -1);
+    QCOMPARE(model.data(1499, cost).toInt(), 1499);
+    QCOMPARE(model.data(0, cost).toInt(), 0);
+
+    // Writing in the GUI thread doesn't change the worker's rows
+    model.setProperty(0, "cost", 7);
+    QCOMPARE(model.sharedChunkCount(), chunkCount - 1);
+    QCOMPARE(model.data(0, cost).toInt(), 7);
+
+    delete item;
+    qApp->processEvents();
+}
+
 void tst_qqmllistmodelworkerscript::worker_remove_element()
 {
     QFETCH(bool, dynamicRoles);
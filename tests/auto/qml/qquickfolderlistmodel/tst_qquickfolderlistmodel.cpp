@@ -31,6 +31,7 @@
 #include <QtQml/qqmlcomponent.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
 #include <QtCore/qabstractitemmodel.h>
 #include <QDebug>
 #include "../../shared/util.h"
@@ -71,6 +72,9 @@ private slots:
     void showDotAndDotDot_data();
     void sortReversed();
     void introspectQrc();
+    void streamedListing();
+    void incrementalUpdate();
+    void interleavedUpdate();
 
 private:
     void checkNoErrors(const QQmlComponent& component);
@@ -371,6 +375,110 @@ void tst_qquickfolderlistmodel::introspectQrc()
     QCOMPARE(flm->data(flm->index(0),FileNameRole).toString(), QLatin1String("hello.txt"));
 }
 
+void tst_qquickfolderlistmodel::streamedListing()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const int fileCount = 1000;
+    for (int i = 0; i < fileCount; ++i) {
+        QFile file(tempDir.path() + QString::asprintf("/file%04d.txt", fileCount - 1 - i));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+
+    QQmlComponent component(&engine, testFileUrl("resetFiltering.qml"));
+    checkNoErrors(component);
+    QAbstractListModel *flm = qobject_cast<QAbstractListModel*>(component.create());
+    QVERIFY(flm != 0);
+
+    QSignalSpy insertedSpy(flm, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy resetSpy(flm, SIGNAL(modelReset()));
+    flm->setProperty("folder", QUrl::fromLocalFile(tempDir.path()));
+    QTRY_COMPARE(flm->property("count").toInt(), fileCount);
+
+    // The listing arrives in several sorted batches which are merged into the model, either as
+    // insertions or, if a batch interleaves with many rows already listed, as a reset.
+    QVERIFY(insertedSpy.count() + resetSpy.count() > 1);
+    for (int i = 0; i < fileCount; ++i)
+        QCOMPARE(flm->data(flm->index(i), FileNameRole).toString(), QString::asprintf("file%04d.txt", i));
+}
+
+void tst_qquickfolderlistmodel::incrementalUpdate()
+{
+#if !QT_CONFIG(filesystemwatcher)
+    QSKIP("Test requires QFileSystemWatcher");
+#endif
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    {
+        QFile a(tempDir.path() + QLatin1String("/a.txt"));
+        QVERIFY(a.open(QIODevice::WriteOnly));
+        QFile c(tempDir.path() + QLatin1String("/c.txt"));
+        QVERIFY(c.open(QIODevice::WriteOnly));
+    }
+
+    QQmlComponent component(&engine, testFileUrl("resetFiltering.qml"));
+    checkNoErrors(component);
+    QAbstractListModel *flm = qobject_cast<QAbstractListModel*>(component.create());
+    QVERIFY(flm != 0);
+
+    flm->setProperty("folder", QUrl::fromLocalFile(tempDir.path()));
+    QTRY_COMPARE(flm->property("count").toInt(), 2);
+
+    QSignalSpy insertedSpy(flm, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    QSignalSpy removedSpy(flm, SIGNAL(rowsRemoved(QModelIndex,int,int)));
+
+    {
+        QFile b(tempDir.path() + QLatin1String("/b.txt"));
+        QVERIFY(b.open(QIODevice::WriteOnly));
+    }
+    QTRY_COMPARE(flm->property("count").toInt(), 3);
+    QCOMPARE(removedSpy.count(), 0);
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(insertedSpy.at(0).at(1).toInt(), 1);
+    QCOMPARE(insertedSpy.at(0).at(2).toInt(), 1);
+    QCOMPARE(flm->data(flm->index(1), FileNameRole).toString(), QLatin1String("b.txt"));
+
+    insertedSpy.clear();
+    QVERIFY(QFile::remove(tempDir.path() + QLatin1String("/a.txt")));
+    QTRY_COMPARE(flm->property("count").toInt(), 2);
+    QCOMPARE(insertedSpy.count(), 0);
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(removedSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(removedSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(flm->data(flm->index(0), FileNameRole).toString(), QLatin1String("b.txt"));
+}
+
+void tst_qquickfolderlistmodel::interleavedUpdate()
+{
+#if !QT_CONFIG(filesystemwatcher)
+    QSKIP("Test requires QFileSystemWatcher");
+#endif
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const int fileCount = 100;
+    for (int i = 0; i < fileCount; i += 2) {
+        QFile file(tempDir.path() + QString::asprintf("/file%03d.txt", i));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+
+    QQmlComponent component(&engine, testFileUrl("resetFiltering.qml"));
+    checkNoErrors(component);
+    QAbstractListModel *flm = qobject_cast<QAbstractListModel*>(component.create());
+    QVERIFY(flm != 0);
+
+    flm->setProperty("folder", QUrl::fromLocalFile(tempDir.path()));
+    QTRY_COMPARE(flm->property("count").toInt(), fileCount / 2);
+
+    // Every new file goes between two existing ones.
+    for (int i = 1; i < fileCount; i += 2) {
+        QFile file(tempDir.path() + QString::asprintf("/file%03d.txt", i));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+    QTRY_COMPARE(flm->property("count").toInt(), fileCount);
+    for (int i = 0; i < fileCount; ++i)
+        QCOMPARE(flm->data(flm->index(i), FileNameRole).toString(), QString::asprintf("file%03d.txt", i));
+}
+
 QTEST_MAIN(tst_qquickfolderlistmodel)
 
 #include "tst_qquickfolderlistmodel.moc"
@@ -0,0 +1,6 @@
+WorkerScript.onMessage = function(msg) {
+    var bytes = new Uint8Array(msg.buffer)
+    for (var i = 0; i < bytes.length; ++i)
+        bytes[i] *= 2
+    WorkerScript.sendMessage(msg, [msg.buffer])
+}
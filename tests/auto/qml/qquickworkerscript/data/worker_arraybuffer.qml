@@ -0,0 +1,72 @@
+import QtQuick 2.0
+
+WorkerScript {
+    id: worker
+    source: "script_arraybuffer.js"
+
+    property int sentLength: -1
+    property int receivedLength: -1
+    property int receivedSum: -1
+    property int senderSum: -1
+    property var sentBuffer
+    property int viewLength: -1
+    property int dataViewLength: -1
+    property bool viewWriteThrows: false
+    property bool dataViewReadThrows: false
+
+    signal done()
+
+    function testTransfer() {
+        var buffer = new ArrayBuffer(16)
+        var bytes = new Uint8Array(buffer)
+        for (var i = 0; i < bytes.length; ++i)
+            bytes[i] = i
+        var view = new DataView(buffer)
+        worker.sendMessage({ 'buffer': buffer }, [buffer])
+        worker.sentLength = buffer.byteLength
+
+        // Views created before the transfer are left empty with the buffer
+        worker.viewLength = bytes.length
+        worker.dataViewLength = view.byteLength
+        try {
+            bytes.set([1])
+        } catch (e) {
+            worker.viewWriteThrows = e instanceof RangeError
+        }
+        try {
+            view.getUint8(0)
+        } catch (e) {
+            worker.dataViewReadThrows = true
+        }
+    }
+
+    function testCopy() {
+        var buffer = new ArrayBuffer(16)
+        var bytes = new Uint8Array(buffer)
+        for (var i = 0; i < bytes.length; ++i)
+            bytes[i] = i
+        worker.sendMessage({ 'buffer': buffer })
+        // Both sides now write to their own copy of the bytes
+        for (i = 0; i < bytes.length; ++i)
+            bytes[i] = 100
+        worker.sentBuffer = buffer
+        worker.sentLength = buffer.byteLength
+    }
+
+    onMessage: {
+        var bytes = new Uint8Array(messageObject.buffer)
+        var sum = 0
+        for (var i = 0; i < bytes.length; ++i)
+            sum += bytes[i]
+        worker.receivedLength = messageObject.buffer.byteLength
+        worker.receivedSum = sum
+        if (worker.sentBuffer) {
+            var sent = new Uint8Array(worker.sentBuffer)
+            sum = 0
+            for (i = 0; i < sent.length; ++i)
+                sum += sent[i]
+            worker.senderSum = sum
+        }
+        worker.done()
+    }
+}
@@ -26,10 +26,12 @@
 **
 ****************************************************************************/
 #include <qtest.h>
+#include <QtTest/QSignalSpy>
 #include <QtCore/qdebug.h>
 #include <QtCore/qtimer.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qsharedpointer.h>
 #include <QtQml/qjsengine.h>
 
 #include <QtQml/qqmlcomponent.h>
@@ -51,6 +53,9 @@ private slots:
     void messaging_sendQObjectList();
     void messaging_sendJsObject();
     void messaging_sendExternalObject();
+    void messaging_transferArrayBuffer();
+    void messaging_copyArrayBuffer();
+    void messaging_pool();
     void script_with_pragma();
     void script_included();
     void scriptError_onLoad();
@@ -198,6 +203,105 @@ void tst_QQuickWorkerScript::messaging_sendExternalObject()
     delete obj;
 }
 
+void tst_QQuickWorkerScript::messaging_transferArrayBuffer()
+{
+    QQmlComponent component(&m_engine, testFileUrl("worker_arraybuffer.qml"));
+    QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(component.create());
+    QVERIFY(worker != 0);
+
+    QVERIFY(QMetaObject::invokeMethod(worker, "testTransfer"));
+    waitForEchoMessage(worker);
+
+    // The sender's buffer is emptied by the transfer; the worker doubles each byte
+    QCOMPARE(worker->property("sentLength").toInt(), 0);
+    QCOMPARE(worker->property("receivedLength").toInt(), 16);
+    QCOMPARE(worker->property("receivedSum").toInt(), 2 * (15 * 16 / 2));
+
+    // Views on the sender's buffer see it emptied and can no longer reach its old data
+    QCOMPARE(worker->property("viewLength").toInt(), 0);
+    QCOMPARE(worker->property("dataViewLength").toInt(), 0);
+    QVERIFY(worker->property("viewWriteThrows").toBool());
+    QVERIFY(worker->property("dataViewReadThrows").toBool());
+
+    qApp->processEvents();
+    delete worker;
+}
+
+void tst_QQuickWorkerScript::messaging_copyArrayBuffer()
+{
+    QQmlComponent component(&m_engine, testFileUrl("worker_arraybuffer.qml"));
+    QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(component.create());
+    QVERIFY(worker != 0);
+
+    QVERIFY(QMetaObject::invokeMethod(worker, "testCopy"));
+    waitForEchoMessage(worker);
+
+    // The sender keeps its buffer and overwrites it after posting; the worker
+    // doubles the bytes of its own copy. Neither sees the other's writes.
+    QCOMPARE(worker->property("sentLength").toInt(), 16);
+    QCOMPARE(worker->property("senderSum").toInt(), 16 * 100);
+    QCOMPARE(worker->property("receivedLength").toInt(), 16);
+    QCOMPARE(worker->property("receivedSum").toInt(), 2 * (15 * 16 / 2));
+
+    qApp->processEvents();
+    delete worker;
+}
+
+void tst_QQuickWorkerScript::messaging_pool()
+{
+    QQmlEngine engine;
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&engine);
+    ep->workerScriptPoolSize = 3;
+
+    QQmlComponent component(&engine, testFileUrl("worker.qml"));
+    QList<QQuickWorkerScript *> workers;
+    for (int i = 0; i < 5; ++i) {
+        QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(component.create());
+        QVERIFY(worker != 0);
+        workers << worker;
+    }
+
+    // The workers are spread evenly over the whole pool
+    QCOMPARE(ep->workerScriptEngines.count(), 3);
+    int scriptCount = 0;
+    for (QQuickWorkerScriptEngine *workerEngine : qAsConst(ep->workerScriptEngines)) {
+        QVERIFY(workerEngine->workerScriptCount() >= 1);
+        QVERIFY(workerEngine->workerScriptCount() <= 2);
+        scriptCount += workerEngine->workerScriptCount();
+    }
+    QCOMPARE(scriptCount, workers.count());
+
+    // Messages in flight on several threads at once each reach their own worker
+    QList<QSharedPointer<QSignalSpy> > spies;
+    for (int i = 0; i < workers.count(); ++i) {
+        spies << QSharedPointer<QSignalSpy>::create(workers.at(i), SIGNAL(done()));
+        QVERIFY(QMetaObject::invokeMethod(workers.at(i), "testSend", Q_ARG(QVariant, QVariant(i))));
+    }
+    for (int i = 0; i < workers.count(); ++i) {
+        QTRY_COMPARE(spies.at(i)->count(), 1);
+        QCOMPARE(workers.at(i)->property("response").toInt(), i);
+    }
+
+    // A removed worker frees its place for the next one
+    delete workers.takeFirst();
+    QQuickWorkerScript *worker = qobject_cast<QQuickWorkerScript*>(component.create());
+    QVERIFY(worker != 0);
+    workers << worker;
+    QCOMPARE(ep->workerScriptEngines.count(), 3);
+    for (QQuickWorkerScriptEngine *workerEngine : qAsConst(ep->workerScriptEngines)) {
+        QVERIFY(workerEngine->workerScriptCount() >= 1);
+        QVERIFY(workerEngine->workerScriptCount() <= 2);
+    }
+
+    QSignalSpy spy(worker, SIGNAL(done()));
+    QVERIFY(QMetaObject::invokeMethod(worker, "testSend", Q_ARG(QVariant, QVariant(42))));
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(worker->property("response").toInt(), 42);
+
+    qApp->processEvents();
+    qDeleteAll(workers);
+}
+
 void tst_QQuickWorkerScript::script_with_pragma()
 {
     QVariant value(100);
@@ -0,0 +1,7 @@
+CONFIG += testcase
+TARGET = tst_pipelinedrenderloop
+SOURCES += tst_pipelinedrenderloop.cpp
+
+macx:CONFIG -= app_bundle
+
+QT += core-private gui-private quick-private testlib
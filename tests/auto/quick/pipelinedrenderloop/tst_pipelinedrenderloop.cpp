@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtQuick/QQuickItem>
+#include <QtQuick/QQuickWindow>
+
+#include <private/qsgrenderloop_p.h>
+
+class PolishCounter : public QQuickItem
+{
+public:
+    int polishes = 0;
+
+protected:
+    void updatePolish() override { ++polishes; }
+};
+
+class tst_PipelinedRenderLoop : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void deferredSync();
+};
+
+void tst_PipelinedRenderLoop::initTestCase()
+{
+    // Both are read when the render loop is created.
+    qputenv("QSG_RENDER_LOOP", "threaded");
+    qputenv("QSG_RENDER_LOOP_PIPELINED", "1");
+    if (!QSGRenderLoop::instance()->inherits("QSGThreadedRenderLoop"))
+        QSKIP("The threaded render loop is not available on this platform");
+}
+
+// While the render thread is busy with a frame, a sync requested by the GUI
+// thread is deferred instead of blocking it. The render thread posts
+// WM_SyncReady when it is done, and the sync then goes through, emitting
+// afterAnimating() once.
+void tst_PipelinedRenderLoop::deferredSync()
+{
+    QQuickWindow window;
+    window.resize(100, 100);
+    PolishCounter *item = new PolishCounter;
+    item->setParentItem(window.contentItem());
+
+    QAtomicInt slowRendering;
+    QSemaphore renderingStarted;
+    QAtomicInt syncs;
+    int afterAnimating = 0;
+    connect(&window, &QQuickWindow::beforeRendering, this, [&]() {
+        if (slowRendering.load()) {
+            renderingStarted.release();
+            QThread::msleep(500);
+        }
+    }, Qt::DirectConnection);
+    connect(&window, &QQuickWindow::beforeSynchronizing, this, [&]() {
+        syncs.fetchAndAddRelaxed(1);
+    }, Qt::DirectConnection);
+    connect(&window, &QQuickWindow::afterAnimating, this, [&]() { ++afterAnimating; });
+
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QTRY_VERIFY(syncs.load() > 0);
+    QTest::qWait(50);
+
+    // Keep the render thread busy with the next frame.
+    slowRendering.store(1);
+    window.update();
+    QTRY_VERIFY(renderingStarted.tryAcquire());
+    slowRendering.store(0);
+
+    const int syncsBefore = syncs.load();
+    const int afterAnimatingBefore = afterAnimating;
+
+    // The GUI thread polishes, finds the render thread busy and returns to the
+    // event loop without syncing.
+    const int polishesBefore = item->polishes;
+    item->polish();
+    QTRY_VERIFY(item->polishes > polishesBefore);
+    QCOMPARE(syncs.load(), syncsBefore);
+    QCOMPARE(afterAnimating, afterAnimatingBefore);
+
+    // Once the frame is done, the deferred sync goes through.
+    QTRY_COMPARE(syncs.load(), syncsBefore + 1);
+    QTRY_COMPARE(afterAnimating, afterAnimatingBefore + 1);
+    QTest::qWait(50);
+    QCOMPARE(afterAnimating, afterAnimatingBefore + 1);
+}
+
+QTEST_MAIN(tst_PipelinedRenderLoop)
+
+#include "tst_pipelinedrenderloop.moc"
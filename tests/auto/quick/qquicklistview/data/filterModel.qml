@@ -0,0 +1,28 @@
+import QtQuick 2.11
+
+ListView {
+    id: list
+    width: 240
+    height: 400
+
+    property int createdCount: 0
+
+    function filterEven() {
+        model.filter(function(item) { return item.cost % 2 == 0 })
+    }
+
+    model: ListModel {
+        Component.onCompleted: {
+            for (var i = 0; i < 20; ++i)
+                append({ "cost": i })
+        }
+    }
+
+    delegate: Rectangle {
+        objectName: "wrapper"
+        width: list.width
+        height: 20
+        property int cost: model.cost
+        Component.onCompleted: list.createdCount++
+    }
+}
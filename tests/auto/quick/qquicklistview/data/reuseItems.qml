@@ -0,0 +1,25 @@
+import QtQuick 2.11
+
+ListView {
+    id: list
+    width: 400
+    height: 400
+    cacheBuffer: 0
+    reuseItems: true
+    model: 100
+
+    property int createdCount: 0
+    property int pooledCount: 0
+    property int reusedCount: 0
+
+    delegate: Rectangle {
+        objectName: "delegate"
+        property int modelIndex: index
+        height: 40; width: 400
+        color: index % 2 ? "lightsteelblue" : "lightgray"
+
+        Component.onCompleted: list.createdCount++
+        ListView.onPooled: list.pooledCount++
+        ListView.onReused: list.reusedCount++
+    }
+}
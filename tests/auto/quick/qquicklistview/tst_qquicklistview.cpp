@@ -132,6 +132,7 @@ private slots:
     void sectionDelegateChange();
     void sectionsItemInsertion();
     void cacheBuffer();
+    void cacheBufferIncubationOrder();
     void positionViewAtBeginningEnd();
     void positionViewAtIndex();
     void positionViewAtIndex_data();
@@ -257,6 +258,8 @@ private slots:
     void QTBUG_50097_stickyHeader_positionViewAtIndex();
     void itemFiltered();
     void releaseItems();
+    void reuseItems();
+    void filterListModel();
 
 private:
     template <class T> void items(const QUrl &source);
@@ -3120,6 +3123,81 @@ void tst_QQuickListView::cacheBuffer()
     delete testObject;
 }
 
+void tst_QQuickListView::cacheBufferIncubationOrder()
+{
+    QScopedPointer<QQuickView> window(createView());
+
+    QaimModel model;
+    for (int i = 0; i < 90; i++)
+        model.addItem("Item" + QString::number(i), "");
+
+    QQmlContext *ctxt = window->rootContext();
+    ctxt->setContextProperty("testModel", &model);
+
+    TestObject *testObject = new TestObject;
+    ctxt->setContextProperty("testObject", testObject);
+
+    window->setSource(testFileUrl("listviewtest.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = findItem<QQuickListView>(window->rootObject(), "list");
+    QTRY_VERIFY(listview != 0);
+    QQuickItem *contentItem = listview->contentItem();
+    QTRY_VERIFY(contentItem != 0);
+
+    QQmlIncubationController controller;
+    window->engine()->setIncubationController(&controller);
+
+    testObject->setCacheBuffer(200);
+    QTRY_COMPARE(listview->cacheBuffer(), 200);
+
+    // move the view forwards and let the buffer fill on both sides
+    listview->setContentY(1200);
+    for (int i : {50, 85}) {
+        QQuickItem *item = 0;
+        while (!item) {
+            qGuiApp->processEvents(); // allow refill to happen
+            bool b = false;
+            controller.incubateWhile(&b);
+            item = findItem<QQuickItem>(listview, "wrapper", i);
+        }
+    }
+
+    {
+        bool b = true;
+        controller.incubateWhile(&b);
+    }
+
+    // move backwards past the buffer: visible delegates are created immediately
+    listview->setContentY(400);
+    for (int i = 20; i < 36; ++i) {
+        QQuickItem *item = findItem<QQuickItem>(contentItem, "wrapper", i);
+        if (!item) qWarning() << "Item" << i << "not found";
+        QVERIFY(item);
+        QCOMPARE(item->y(), qreal(i*20));
+    }
+    QVERIFY(findItem<QQuickItem>(listview, "wrapper", 19) == 0);
+    QVERIFY(findItem<QQuickItem>(listview, "wrapper", 37) == 0);
+
+    // the buffer the view is moving towards is incubated before the one behind it
+    QQuickItem *item = 0;
+    while (!item) {
+        qGuiApp->processEvents(); // allow refill to happen
+        bool b = false;
+        controller.incubateWhile(&b);
+        item = findItem<QQuickItem>(listview, "wrapper", 19);
+    }
+    QVERIFY(findItem<QQuickItem>(listview, "wrapper", 37) == 0);
+
+    {
+        bool b = true;
+        controller.incubateWhile(&b);
+    }
+
+    delete testObject;
+}
+
 void tst_QQuickListView::positionViewAtBeginningEnd()
 {
     QScopedPointer<QQuickView> window(createView());
@@ -8575,6 +8653,82 @@ void tst_QQuickListView::releaseItems()
     listview->setModel(123);
 }
 
+void tst_QQuickListView::reuseItems()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("reuseItems.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listview);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+
+    const int initiallyCreated = listview->property("createdCount").toInt();
+    QVERIFY(initiallyCreated > 0);
+
+    // Scroll a page at a time; delegates leaving the view are rebound to the new indexes.
+    for (int y = 400; y <= 3600; y += 400) {
+        listview->setContentY(y);
+        QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    }
+
+    QVERIFY(listview->property("pooledCount").toInt() > 0);
+    QVERIFY(listview->property("reusedCount").toInt() > 0);
+    QVERIFY(listview->property("createdCount").toInt() < 3 * initiallyCreated);
+
+    // The rebound delegates show the data of their new index.
+    QQuickItem *contentItem = listview->contentItem();
+    const QList<QQuickItem *> delegates = findItems<QQuickItem>(contentItem, "delegate");
+    QVERIFY(!delegates.isEmpty());
+    for (QQuickItem *delegate : delegates) {
+        if (QQuickItemPrivate::get(delegate)->culled)
+            continue;
+        const int index = delegate->property("modelIndex").toInt();
+        QCOMPARE(delegate->y(), index * 40.0);
+    }
+
+    // Turning reuse off empties the pool.
+    listview->setReuseItems(false);
+    QCOMPARE(QQuickItemViewPrivate::get(listview)->model->poolSize(), 0);
+}
+
+// ListModel::filter() reports each run of removed items as a removal, so the
+// delegates of the remaining items are kept rather than recreated.
+void tst_QQuickListView::filterListModel()
+{
+    QScopedPointer<QQuickView> window(createView());
+    window->setSource(testFileUrl("filterModel.qml"));
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window.data()));
+
+    QQuickListView *listview = qobject_cast<QQuickListView *>(window->rootObject());
+    QVERIFY(listview);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+    QCOMPARE(listview->count(), 20);
+    QCOMPARE(listview->property("createdCount").toInt(), 20);
+
+    QQuickItem *contentItem = listview->contentItem();
+    QList<QPointer<QQuickItem> > kept;
+    for (int i = 0; i < 20; i += 2) {
+        QQuickItem *item = findItem<QQuickItem>(contentItem, "wrapper", i);
+        QVERIFY(item);
+        kept << item;
+    }
+
+    QMetaObject::invokeMethod(listview, "filterEven");
+    QCOMPARE(listview->count(), 10);
+    QTRY_COMPARE(QQuickItemPrivate::get(listview)->polishScheduled, false);
+
+    QCOMPARE(listview->property("createdCount").toInt(), 20);
+    for (int i = 0; i < kept.count(); ++i) {
+        QVERIFY(kept.at(i));
+        QCOMPARE(kept.at(i)->property("cost").toInt(), i * 2);
+        QCOMPARE(findItem<QQuickItem>(contentItem, "wrapper", i), kept.at(i).data());
+        QTRY_COMPARE(kept.at(i)->y(), i * 20.0);
+    }
+}
+
 QTEST_MAIN(tst_QQuickListView)
 
 #include "tst_qquicklistview.moc"
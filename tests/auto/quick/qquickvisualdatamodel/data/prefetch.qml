@@ -0,0 +1,10 @@
+import QtQuick 2.0
+
+VisualDataModel {
+    model: myModel
+    delegate: Item {
+        property string name: model.name
+        property int value: model.value
+        property string summary: model.name + ':' + model.value
+    }
+}
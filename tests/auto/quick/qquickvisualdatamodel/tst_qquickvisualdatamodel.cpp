@@ -40,6 +40,7 @@
 #include <private/qquicklistview_p.h>
 #include <QtQuick/private/qquicktext_p.h>
 #include <QtQml/private/qqmldelegatemodel_p.h>
+#include <QtQml/private/qqmldelegatemodel_p_p.h>
 #include <private/qqmlvaluetype_p.h>
 #include <private/qqmlchangeset_p.h>
 #include <private/qqmlengine_p.h>
@@ -239,6 +240,63 @@ private:
     Branch trunk;
 };
 
+class PrefetchModel : public QAbstractListModel
+{
+    Q_OBJECT
+    Q_CLASSINFO("QmlPrefetchItemData", "true")
+public:
+    enum { NameRole = Qt::UserRole, ValueRole };
+
+    PrefetchModel(QObject *parent = 0)
+        : QAbstractListModel(parent), dataCalls(0), itemDataCalls(0)
+    {
+        for (int i = 0; i < 3; ++i) {
+            names.append(QString::fromLatin1("item%1").arg(i));
+            values.append(i);
+        }
+    }
+
+    QHash<int, QByteArray> roleNames() const
+    {
+        QHash<int, QByteArray> roles;
+        roles.insert(NameRole, "name");
+        roles.insert(ValueRole, "value");
+        return roles;
+    }
+
+    int rowCount(const QModelIndex &) const { return names.count(); }
+
+    QVariant data(const QModelIndex &index, int role) const
+    {
+        ++dataCalls;
+        if (role == NameRole)
+            return names.at(index.row());
+        else if (role == ValueRole)
+            return values.at(index.row());
+        return QVariant();
+    }
+
+    QMap<int, QVariant> itemData(const QModelIndex &index) const
+    {
+        ++itemDataCalls;
+        QMap<int, QVariant> roles;
+        roles.insert(NameRole, names.at(index.row()));
+        roles.insert(ValueRole, values.at(index.row()));
+        return roles;
+    }
+
+    void setName(int row, const QString &name)
+    {
+        names[row] = name;
+        emit dataChanged(index(row), index(row), QVector<int>() << NameRole);
+    }
+
+    QStringList names;
+    QList<int> values;
+    mutable int dataCalls;
+    mutable int itemDataCalls;
+};
+
 class StandardItem : public QObject, public QStandardItem
 {
     Q_OBJECT
@@ -404,6 +462,8 @@ private slots:
     void watchedRoles();
     void hasModelChildren();
     void setValue();
+    void prefetchItemData();
+    void coalesceDataChanges();
     void remove_data();
     void remove();
     void move_data();
@@ -1369,6 +1429,98 @@ void tst_qquickvisualdatamodel::setValue()
     QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);  // Ensure released items are deleted before test exits.
 }
 
+void tst_qquickvisualdatamodel::prefetchItemData()
+{
+    PrefetchModel model;
+
+    QQmlEngine engine;
+    engine.rootContext()->setContextProperty("myModel", &model);
+
+    QQmlComponent component(&engine, testFileUrl("prefetch.qml"));
+
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *vdm = qobject_cast<QQmlDelegateModel*>(object.data());
+    QVERIFY(vdm);
+
+    QCOMPARE(vdm->count(), 3);
+
+    // All roles of the row are fetched with one itemData() call and shared by every binding.
+    QQuickItem *item = qobject_cast<QQuickItem*>(vdm->object(1));
+    QVERIFY(item);
+    QCOMPARE(item->property("name").toString(), QString("item1"));
+    QCOMPARE(item->property("value").toInt(), 1);
+    QCOMPARE(item->property("summary").toString(), QString("item1:1"));
+    QCOMPARE(model.itemDataCalls, 1);
+    QCOMPARE(model.dataCalls, 0);
+
+    // Only the changed role is fetched again.
+    model.setName(1, "renamed");
+    QCOMPARE(item->property("name").toString(), QString("renamed"));
+    QCOMPARE(item->property("summary").toString(), QString("renamed:1"));
+    QCOMPARE(model.itemDataCalls, 1);
+    QCOMPARE(model.dataCalls, 1);
+
+    vdm->release(item);
+
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);  // Ensure released items are deleted before test exits.
+}
+
+void tst_qquickvisualdatamodel::coalesceDataChanges()
+{
+    PrefetchModel model;
+
+    QQmlEngine engine;
+    engine.rootContext()->setContextProperty("myModel", &model);
+
+    QQmlComponent component(&engine, testFileUrl("prefetch.qml"));
+
+    QScopedPointer<QObject> object(component.create());
+    QQmlDelegateModel *vdm = qobject_cast<QQmlDelegateModel*>(object.data());
+    QVERIFY(vdm);
+
+    // Normally enabled with QML_COALESCE_DATA_CHANGES, which is only read once per process.
+    QQmlDelegateModelPrivate::get(vdm)->m_coalesceDataChanges = true;
+
+    QQuickItem *item0 = qobject_cast<QQuickItem*>(vdm->object(0));
+    QQuickItem *item1 = qobject_cast<QQuickItem*>(vdm->object(1));
+    QVERIFY(item0);
+    QVERIFY(item1);
+    QCOMPARE(item0->property("name").toString(), QString("item0"));
+    QCOMPARE(item1->property("name").toString(), QString("item1"));
+
+    // Changes are delivered together once control returns to the event loop.
+    model.setName(0, "first");
+    model.setName(1, "second");
+    model.setName(0, "third");
+    QCOMPARE(item0->property("name").toString(), QString("item0"));
+    QCOMPARE(item1->property("name").toString(), QString("item1"));
+
+    QCoreApplication::sendPostedEvents(vdm, QEvent::MetaCall);
+    QCOMPARE(item0->property("name").toString(), QString("third"));
+    QCOMPARE(item1->property("name").toString(), QString("second"));
+
+    // A change to the row of a pooled item is not delivered to it, so reusing the item for
+    // the same row must not serve the values prefetched before it was pooled.
+    vdm->release(item1, QQmlInstanceModel::Reusable);
+    QCOMPARE(vdm->poolSize(), 1);
+
+    model.setName(1, "pooled");
+    QCoreApplication::sendPostedEvents(vdm, QEvent::MetaCall);
+    QCOMPARE(item1->property("name").toString(), QString("second"));
+
+    const int itemDataCalls = model.itemDataCalls;
+    QCOMPARE(qobject_cast<QQuickItem*>(vdm->object(1)), item1);
+    QCOMPARE(vdm->poolSize(), 0);
+    QCOMPARE(item1->property("name").toString(), QString("pooled"));
+    QCOMPARE(item1->property("summary").toString(), QString("pooled:1"));
+    QCOMPARE(model.itemDataCalls, itemDataCalls + 1);
+
+    vdm->release(item0);
+    vdm->release(item1);
+
+    QCoreApplication::sendPostedEvents(0, QEvent::DeferredDelete);  // Ensure released items are deleted before test exits.
+}
+
 void tst_qquickvisualdatamodel::remove_data()
 {
     QTest::addColumn<QUrl>("source");
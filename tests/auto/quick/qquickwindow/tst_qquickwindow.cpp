@@ -380,6 +380,9 @@ private slots:
 
     void testRenderJob();
 
+    void frameStatistics();
+    void frameStatisticsCustomRenderStage();
+
     void testHoverChildMouseEventFilter();
     void testHoverTimestamp();
     void test_circleMapItem();
@@ -2401,6 +2404,98 @@ void tst_qquickwindow::testRenderJob()
     QCOMPARE(completedJobs.size(), 0);
 }
 
+void tst_qquickwindow::frameStatistics()
+{
+    QQuickWindow window;
+    window.setTitle(QTest::currentTestFunction());
+    window.resize(200, 200);
+
+    QCOMPARE(window.frameStatisticsCapacity(), 0);
+    QVERIFY(window.frameStatistics().isEmpty());
+
+    window.setFrameStatisticsCapacity(3);
+    QCOMPARE(window.frameStatisticsCapacity(), 3);
+
+    QQuickRectangle rect(window.contentItem());
+    rect.setSize(QSizeF(100, 100));
+    rect.setColor(Qt::red);
+
+    QSignalSpy swapSpy(&window, SIGNAL(frameSwapped()));
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    for (int i = 0; i < 5; ++i) {
+        const int frames = swapSpy.count();
+        rect.setX(i * 10);
+        QTRY_VERIFY(swapSpy.count() > frames);
+    }
+
+    const QVector<QQuickFrameStatistics> stats = window.frameStatistics();
+    QCOMPARE(stats.size(), 3);
+    for (int i = 1; i < stats.size(); ++i)
+        QCOMPARE(stats.at(i).frameNumber(), stats.at(i - 1).frameNumber() + 1);
+    QVERIFY(stats.last().frameNumber() >= 4);
+    QVERIFY(stats.last().nodeCount() > 0);
+    QVERIFY(stats.last().renderTime() > 0);
+
+    // Changing the capacity starts a new ring, which fills up before it wraps.
+    window.setFrameStatisticsCapacity(10);
+    QVERIFY(window.frameStatistics().isEmpty());
+    for (int i = 0; i < 2; ++i) {
+        const int frames = swapSpy.count();
+        rect.setX(i * 10 + 5);
+        QTRY_VERIFY(swapSpy.count() > frames);
+    }
+    const QVector<QQuickFrameStatistics> restarted = window.frameStatistics();
+    QVERIFY(restarted.size() >= 2);
+    QVERIFY(restarted.size() <= 10);
+    QCOMPARE(restarted.first().frameNumber(), qint64(0));
+    for (int i = 1; i < restarted.size(); ++i)
+        QCOMPARE(restarted.at(i).frameNumber(), restarted.at(i - 1).frameNumber() + 1);
+
+    window.setFrameStatisticsCapacity(0);
+    QVERIFY(window.frameStatistics().isEmpty());
+}
+
+class SkipRenderStage : public QQuickCustomRenderStage
+{
+public:
+    bool render() override { return true; }
+    bool swap() override { return false; }
+};
+
+// Frames rendered by a custom render stage do not go through the renderer, so
+// they must not report its statistics.
+void tst_qquickwindow::frameStatisticsCustomRenderStage()
+{
+    QQuickWindow window;
+    window.setTitle(QTest::currentTestFunction());
+    window.resize(200, 200);
+    QQuickWindowPrivate::get(&window)->customRenderStage = new SkipRenderStage;
+    window.setFrameStatisticsCapacity(3);
+
+    QQuickRectangle rect(window.contentItem());
+    rect.setSize(QSizeF(100, 100));
+    rect.setColor(Qt::red);
+
+    QSignalSpy swapSpy(&window, SIGNAL(frameSwapped()));
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    for (int i = 0; i < 3; ++i) {
+        const int frames = swapSpy.count();
+        rect.setX(i * 10);
+        QTRY_VERIFY(swapSpy.count() > frames);
+    }
+
+    const QVector<QQuickFrameStatistics> stats = window.frameStatistics();
+    QVERIFY(!stats.isEmpty());
+    for (const QQuickFrameStatistics &frame : stats) {
+        QCOMPARE(frame.nodeCount(), 0);
+        QCOMPARE(frame.renderRenderTime(), qint64(0));
+    }
+}
+
 class EventCounter : public QQuickRectangle
 {
 public:
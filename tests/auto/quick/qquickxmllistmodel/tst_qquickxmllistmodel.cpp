@@ -92,6 +92,7 @@ private slots:
     void threading_data();
     void propertyChanges();
     void selectAncestor();
+    void streaming();
 
     void roleCrash();
     void proxyCrash();
@@ -968,6 +969,46 @@ void tst_qquickxmllistmodel::selectAncestor()
     QCOMPARE(model->data(index, Qt::UserRole+1).toString(), QLatin1String("cats"));
 }
 
+void tst_qquickxmllistmodel::streaming()
+{
+    QQmlComponent component(&engine, testFileUrl("streaming.qml"));
+    QAbstractItemModel *model = qobject_cast<QAbstractItemModel *>(component.create());
+    QVERIFY(model != 0);
+
+    const int itemCount = 1000;
+    QString xml = QLatin1String("<data>");
+    for (int i = 0; i < itemCount; ++i) {
+        xml += QString::fromLatin1("<item id=\"%1\"><name>Item <b>%1</b></name><other><name>x</name></other></item>")
+                .arg(i);
+    }
+    xml += QLatin1String("</data>");
+
+    QSignalSpy spyInsert(model, SIGNAL(rowsInserted(QModelIndex,int,int)));
+    model->setProperty("xml", xml);
+    QTRY_COMPARE(qvariant_cast<QQuickXmlListModel::Status>(model->property("status")), QQuickXmlListModel::Ready);
+    QCOMPARE(model->rowCount(), itemCount);
+
+    // The rows are published in several batches, each appended to the previous ones.
+    QVERIFY(spyInsert.count() > 1);
+    int expectedFirst = 0;
+    for (int i = 0; i < spyInsert.count(); ++i) {
+        QCOMPARE(spyInsert[i][1].toInt(), expectedFirst);
+        expectedFirst = spyInsert[i][2].toInt() + 1;
+    }
+    QCOMPARE(expectedFirst, itemCount);
+
+    QHash<int, QByteArray> roleNames = model->roleNames();
+    const int idRole = roleNames.key("id");
+    const int nameRole = roleNames.key("name");
+    const int missingRole = roleNames.key("missing");
+    QCOMPARE(model->data(model->index(0, 0), idRole), QVariant(0.0));
+    QCOMPARE(model->data(model->index(999, 0), idRole), QVariant(999.0));
+    QCOMPARE(model->data(model->index(42, 0), nameRole).toString(), QLatin1String("Item 42"));
+    QCOMPARE(model->data(model->index(42, 0), missingRole).toString(), QLatin1String(""));
+
+    delete model;
+}
+
 void tst_qquickxmllistmodel::roleCrash()
 {
     // don't crash
@@ -14,6 +14,7 @@ qtConfig(opengl(es1|es2)?) {
         qquickanimatedsprite \
         qquickframebufferobject \
         qquickopenglinfo \
+        pipelinedrenderloop \
         qquickspritesequence \
         qquickshadereffect
 }
@@ -88,6 +89,7 @@ QUICKTESTS =  \
     qquickscreen \
     touchmouse \
     scenegraph \
+    softwarerenderer \
     sharedimage
 
 SUBDIRS += $$PUBLICTESTS
@@ -0,0 +1,81 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+
+/*
+    Translucent rectangles scattered over the window, alternating between
+    antialiased and plain ones so that neighbours in the render list have
+    different materials. Merging the alpha batches takes many overlap
+    checks, and with this many elements they go through the overlap grid.
+*/
+
+Item {
+    id: root
+    width: 320
+    height: 320
+
+    function move() {
+        for (var i = 0; i < 300; i += 7)
+            rects.itemAt(i).x = (rects.itemAt(i).x + 41) % 296
+    }
+
+    Repeater {
+        id: rects
+        model: 300
+        Rectangle {
+            x: (index * 37) % 296
+            y: (index * 53) % 304
+            width: 24
+            height: 16
+            antialiasing: index % 2 == 0
+            color: Qt.rgba(index % 3 == 0 ? 1 : 0, index % 3 == 1 ? 1 : 0, index % 3 == 2 ? 1 : 0, 0.5)
+        }
+    }
+
+    // Covers too many cells to be stored in them
+    Rectangle {
+        x: 40
+        y: 40
+        width: 240
+        height: 240
+        color: "#40000000"
+    }
+
+    Repeater {
+        model: 100
+        Rectangle {
+            x: (index * 61) % 296
+            y: (index * 29) % 304
+            width: 24
+            height: 16
+            antialiasing: index % 2 == 1
+            color: Qt.rgba(0.5, index % 2, 1 - index % 2, 0.5)
+        }
+    }
+}
@@ -0,0 +1,78 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+
+/*
+    Two large merged batches of rectangles, whose geometry is drawn as
+    triangle strips: an opaque one and an antialiased, blended one. move()
+    and retint() each change a single rectangle of both, so with a dynamic
+    buffer strategy only that element's vertices are uploaded again.
+*/
+
+Item {
+    id: root
+    width: 320
+    height: 320
+
+    function move() {
+        opaque.itemAt(57).x += 3
+        blended.itemAt(123).y -= 2
+    }
+
+    function retint() {
+        opaque.itemAt(141).color = "red"
+        blended.itemAt(8).color = "blue"
+    }
+
+    Repeater {
+        id: opaque
+        model: 200
+        Rectangle {
+            x: (index % 20) * 16
+            y: Math.floor(index / 20) * 16
+            width: 12
+            height: 12
+            color: Qt.rgba(index / 200, 0.5, 1 - index / 200, 1)
+        }
+    }
+
+    Repeater {
+        id: blended
+        model: 200
+        Rectangle {
+            x: (index % 20) * 16 + 2
+            y: Math.floor(index / 20) * 16 + 162
+            width: 10
+            height: 10
+            antialiasing: true
+            rotation: 10
+            color: Qt.rgba(1 - index / 200, index / 200, 0.5, 1)
+        }
+    }
+}
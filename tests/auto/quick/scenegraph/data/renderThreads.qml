@@ -0,0 +1,67 @@
+/****************************************************************************
+**
+** Copyright (C) 2016 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+
+/*
+    Many clipped groups, each of which becomes a batch root. Calling change()
+    adds nodes to all of them, so that they are rebuilt in the same frame.
+*/
+
+Grid {
+    id: root
+    width: 320
+    height: 320
+    columns: 8
+
+    property int phase: 0
+    function change() { phase = 1 }
+
+    Repeater {
+        model: 64
+        Rectangle {
+            width: 40
+            height: 40
+            clip: true
+            color: Qt.rgba(index / 64, 0.5, 1 - index / 64, 1)
+
+            Repeater {
+                model: root.phase ? 6 : 4
+                Rectangle {
+                    x: index * 7 + root.phase * 2
+                    y: index * 5
+                    width: 12
+                    height: 12
+                    color: index % 2 ? "white" : "black"
+                    opacity: index % 3 ? 1 : 0.5
+                    rotation: root.phase * 15
+                }
+            }
+        }
+    }
+}
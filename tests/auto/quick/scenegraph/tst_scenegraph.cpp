@@ -39,6 +39,7 @@
 
 #if QT_CONFIG(opengl)
 #include <private/qopenglcontext_p.h>
+#include <private/qsgatlastexture_p.h>
 #endif
 
 #include <private/qsgcontext_p.h>
@@ -108,8 +109,12 @@ private slots:
 
     void render_data();
     void render();
+    void renderThreads();
+    void partialUploads();
+    void overlapGrid();
 #if QT_CONFIG(opengl)
     void hideWithOtherContext();
+    void atlasPages();
 #endif
     void createTextureFromImage_data();
     void createTextureFromImage();
@@ -485,6 +490,121 @@ void tst_SceneGraph::render()
     }
 }
 
+// The renderer builds the render lists of several batch roots and merges the
+// vertex data of batches on multiple threads with QSG_RENDERER_THREADS. The
+// result must not differ from the serial path.
+void tst_SceneGraph::renderThreads()
+{
+    if (!isRunningOnOpenGL())
+        QSKIP("Skipping complex rendering tests due to not running with OpenGL");
+
+    const auto grab = [this](const QByteArray &threads, QImage *before, QImage *unchanged, QImage *after) {
+        // Read when the window creates its renderer.
+        qputenv("QSG_RENDERER_THREADS", threads);
+        QQuickView view;
+        view.setSource(testFileUrl("renderThreads.qml"));
+        view.setResizeMode(QQuickView::SizeViewToRootObject);
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+        *before = view.grabWindow();
+        qunsetenv("QSG_RENDERER_THREADS");
+
+        // Nothing has changed, so this frame has no batches to upload.
+        *unchanged = view.grabWindow();
+
+        QMetaObject::invokeMethod(view.rootObject(), "change");
+        *after = view.grabWindow();
+    };
+
+    QImage serialBefore, serialUnchanged, serialAfter;
+    grab("1", &serialBefore, &serialUnchanged, &serialAfter);
+    QImage threadedBefore, threadedUnchanged, threadedAfter;
+    grab("4", &threadedBefore, &threadedUnchanged, &threadedAfter);
+
+    QVERIFY(!serialBefore.isNull());
+    QVERIFY(serialBefore != serialAfter);
+    QCOMPARE(serialUnchanged, serialBefore);
+    QCOMPARE(threadedBefore, serialBefore);
+    QCOMPARE(threadedUnchanged, threadedBefore);
+    QCOMPARE(threadedAfter, serialAfter);
+}
+
+// With QSG_RENDERER_BUFFER_STRATEGY=dynamic, merged batches in which only a
+// few elements changed are updated in place with glBufferSubData(). The
+// result must not differ from uploading the whole batch.
+void tst_SceneGraph::partialUploads()
+{
+    if (!isRunningOnOpenGL())
+        QSKIP("Skipping complex rendering tests due to not running with OpenGL");
+
+    const auto grab = [this](const QByteArray &strategy, QImage *before, QImage *moved, QImage *retinted) {
+        // Read when the window creates its renderer.
+        if (!strategy.isEmpty())
+            qputenv("QSG_RENDERER_BUFFER_STRATEGY", strategy);
+        QQuickView view;
+        view.setSource(testFileUrl("partialUploads.qml"));
+        view.setResizeMode(QQuickView::SizeViewToRootObject);
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+        *before = view.grabWindow();
+        qunsetenv("QSG_RENDERER_BUFFER_STRATEGY");
+
+        QMetaObject::invokeMethod(view.rootObject(), "move");
+        *moved = view.grabWindow();
+
+        QMetaObject::invokeMethod(view.rootObject(), "retint");
+        *retinted = view.grabWindow();
+    };
+
+    QImage fullBefore, fullMoved, fullRetinted;
+    grab(QByteArray(), &fullBefore, &fullMoved, &fullRetinted);
+    QImage partialBefore, partialMoved, partialRetinted;
+    grab("dynamic", &partialBefore, &partialMoved, &partialRetinted);
+
+    QVERIFY(!fullBefore.isNull());
+    QVERIFY(fullMoved != fullBefore);
+    QVERIFY(fullRetinted != fullMoved);
+    QCOMPARE(partialBefore, fullBefore);
+    QCOMPARE(partialMoved, fullMoved);
+    QCOMPARE(partialRetinted, fullRetinted);
+}
+
+// With more than 64 unbatched alpha elements, the overlap checks made while
+// merging alpha batches look up the elements near the bounds in a grid. The
+// result must not differ from scanning the render list, which is what a
+// threshold above the number of elements falls back to.
+void tst_SceneGraph::overlapGrid()
+{
+    if (!isRunningOnOpenGL())
+        QSKIP("Skipping complex rendering tests due to not running with OpenGL");
+
+    const auto grab = [this](const QByteArray &threshold, QImage *before, QImage *moved) {
+        // Read when the window creates its renderer.
+        if (!threshold.isEmpty())
+            qputenv("QSG_RENDERER_OVERLAP_GRID_THRESHOLD", threshold);
+        QQuickView view;
+        view.setSource(testFileUrl("overlapGrid.qml"));
+        view.setResizeMode(QQuickView::SizeViewToRootObject);
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+        *before = view.grabWindow();
+        qunsetenv("QSG_RENDERER_OVERLAP_GRID_THRESHOLD");
+
+        QMetaObject::invokeMethod(view.rootObject(), "move");
+        *moved = view.grabWindow();
+    };
+
+    QImage gridBefore, gridMoved;
+    grab(QByteArray(), &gridBefore, &gridMoved);
+    QImage linearBefore, linearMoved;
+    grab("100000", &linearBefore, &linearMoved);
+
+    QVERIFY(!gridBefore.isNull());
+    QVERIFY(gridMoved != gridBefore);
+    QCOMPARE(gridBefore, linearBefore);
+    QCOMPARE(gridMoved, linearMoved);
+}
+
 #if QT_CONFIG(opengl)
 // Testcase for QTBUG-34898. We make another context current on another surface
 // in the GUI thread and hide the QQuickWindow while the other context is
@@ -521,6 +641,85 @@ void tst_SceneGraph::hideWithOtherContext()
     // GL calls to a new frame (see QOpenGLContext docs).
     QVERIFY(!renderingOnMainThread || QOpenGLContext::currentContext() != &context);
 }
+
+void tst_SceneGraph::atlasPages()
+{
+    if (!isRunningOnOpenGL())
+        QSKIP("Skipping OpenGL context test due to not running with OpenGL");
+
+    QOffscreenSurface surface;
+    surface.create();
+    QOpenGLContext context;
+    QVERIFY(context.create());
+    QVERIFY(context.makeCurrent(&surface));
+
+    // Pages of 256x256 fit four 100x100 images, including their padding.
+    qputenv("QSG_ATLAS_WIDTH", "256");
+    qputenv("QSG_ATLAS_HEIGHT", "256");
+    qputenv("QSG_ATLAS_MAX_PAGES", "2");
+    QSGAtlasTexture::Manager manager;
+    qunsetenv("QSG_ATLAS_WIDTH");
+    qunsetenv("QSG_ATLAS_HEIGHT");
+    qunsetenv("QSG_ATLAS_MAX_PAGES");
+
+    QImage small(100, 100, QImage::Format_ARGB32_Premultiplied);
+    small.fill(Qt::red);
+    QImage large(200, 200, QImage::Format_ARGB32_Premultiplied);
+    large.fill(Qt::blue);
+    QImage tiny(20, 20, QImage::Format_ARGB32_Premultiplied);
+    tiny.fill(Qt::green);
+
+    ScopedList<QSGTexture *> firstPage;
+    for (int i = 0; i < 4; ++i)
+        firstPage << manager.create(small, true);
+    QVERIFY(!firstPage.contains(nullptr));
+    QCOMPARE(manager.statistics().pageCount, 1);
+
+    // A full page makes room for a second one.
+    ScopedList<QSGTexture *> secondPage;
+    for (int i = 0; i < 4; ++i)
+        secondPage << manager.create(small, true);
+    QVERIFY(!secondPage.contains(nullptr));
+    QSGAtlasTexture::Manager::Statistics stats = manager.statistics();
+    QCOMPARE(stats.pageCount, 2);
+    QCOMPARE(stats.textureCount, 8);
+
+    // At the page limit, with both pages mostly in use, the image gets its own texture.
+    QVERIFY(!manager.create(small, true));
+    QCOMPARE(manager.statistics().fallbackCount, 1);
+
+    // The remaining texture on the first page leaves no room for the large image, and
+    // the page is now below the retire threshold, so a fresh page replaces it.
+    delete firstPage.takeFirst();
+    delete firstPage.takeFirst();
+    delete firstPage.takeFirst();
+    QScopedPointer<QSGTexture> largeTexture(manager.create(large, true));
+    QVERIFY(largeTexture);
+    stats = manager.statistics();
+    QCOMPARE(stats.pageCount, 3);
+    QCOMPARE(stats.retiredPageCount, 1);
+
+    // Once drained, the retired page is released the next time the atlas is used.
+    delete firstPage.takeFirst();
+    stats = manager.statistics();
+    QCOMPARE(stats.pageCount, 2);
+    QCOMPARE(stats.retiredPageCount, 0);
+    QCOMPARE(stats.emptiedPageCount, 1);
+
+    QScopedPointer<QSGTexture> tinyTexture(manager.create(tiny, true));
+    QVERIFY(tinyTexture);
+    stats = manager.statistics();
+    QCOMPARE(stats.pageCount, 2);
+    QCOMPARE(stats.emptiedPageCount, 0);
+    QCOMPARE(stats.textureCount, 6);
+
+    tinyTexture.reset();
+    largeTexture.reset();
+    qDeleteAll(secondPage);
+    secondPage.clear();
+    manager.invalidate();
+    QCOMPARE(manager.statistics().pageCount, 0);
+}
 #endif
 
 void tst_SceneGraph::createTextureFromImage_data()
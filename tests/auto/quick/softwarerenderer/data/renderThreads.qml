@@ -0,0 +1,83 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+
+/*
+    Content of every kind the software renderer paints, spread over several
+    tiles and crossing tile edges. change() moves and recolors part of it,
+    so that the next frame only repaints some of the tiles.
+*/
+
+Item {
+    id: root
+    width: 400
+    height: 300
+
+    property int phase: 0
+    function change() { phase = 1 }
+
+    Rectangle {
+        anchors.fill: parent
+        gradient: Gradient {
+            GradientStop { position: 0; color: "lightsteelblue" }
+            GradientStop { position: 1; color: "white" }
+        }
+    }
+
+    Repeater {
+        model: 24
+        Rectangle {
+            x: (index % 6) * 62 + root.phase * (index % 3) * 5
+            y: Math.floor(index / 6) * 70 + 10
+            width: 70
+            height: 50
+            radius: index % 4 ? 0 : 10
+            border.width: index % 2 ? 3 : 0
+            border.color: "black"
+            color: Qt.rgba((index + root.phase * 5) % 24 / 24, 0.4, 1 - index / 24, 1)
+            opacity: index % 5 ? 1 : 0.6
+            rotation: index % 7 ? 0 : 15
+            clip: index % 3 === 0
+
+            Text {
+                x: 5
+                y: 5
+                text: "Tile " + index
+                color: root.phase ? "white" : "black"
+            }
+            Rectangle {
+                x: 40
+                y: 25
+                width: 50
+                height: 40
+                color: "#80ff8000"
+            }
+        }
+    }
+}
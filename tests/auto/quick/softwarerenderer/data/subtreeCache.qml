@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+import QtQuick 2.0
+
+/*
+    Groups of rectangles that stay static while the ticker changes every
+    frame, so that each group can be cached on its own. change() modifies
+    the first group in one of the ways that must invalidate its cache.
+*/
+
+Item {
+    id: root
+    width: 320
+    height: 240
+
+    property int tick: 0
+
+    function change(kind) {
+        var first = groups.itemAt(0)
+        if (kind === "updated")
+            first.tint = "yellow"
+        else if (kind === "added")
+            Qt.createQmlObject("import QtQuick 2.0; Rectangle { x: 100; y: 60; width: 20; height: 20; color: \"black\" }", first)
+        else if (kind === "removed")
+            first.children[5].parent = null
+        else if (kind === "hidden")
+            first.visible = false
+    }
+
+    Rectangle {
+        width: 20
+        height: 20
+        color: root.tick % 2 ? "red" : "blue"
+    }
+
+    Repeater {
+        id: groups
+        model: 4
+        Item {
+            id: group
+            property color tint: "green"
+
+            x: 30 + (index % 2) * 140
+            y: 30 + Math.floor(index / 2) * 100
+            width: 130
+            height: 90
+
+            Repeater {
+                model: 12
+                Rectangle {
+                    x: (index % 4) * 30
+                    y: Math.floor(index / 4) * 30
+                    width: 25
+                    height: 25
+                    radius: index % 3 ? 0 : 6
+                    rotation: index % 5 ? 0 : 20
+                    color: index ? Qt.rgba(index / 12, 0.5, 1 - index / 12, index % 2 ? 1 : 0.6) : group.tint
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,15 @@
+CONFIG += testcase
+TARGET = tst_softwarerenderer
+SOURCES += tst_softwarerenderer.cpp
+
+include (../../shared/util.pri)
+
+macx:CONFIG -= app_bundle
+
+TESTDATA = data/*
+
+QT += core-private gui-private qml-private quick-private testlib
+
+OTHER_FILES += \
+    data/subtreeCache.qml \
+    data/renderThreads.qml
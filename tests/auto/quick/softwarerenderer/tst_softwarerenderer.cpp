@@ -0,0 +1,327 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+#include <QtGui/QPainter>
+#include <QtQuick/QQuickItem>
+#include <QtQuick/QQuickView>
+#include <QtQuick/QSGRendererInterface>
+
+#include <private/qquickwindow_p.h>
+#include <private/qsgabstractsoftwarerenderer_p.h>
+#include <private/qsgsoftwareblitter_p.h>
+
+#include "../../shared/util.h"
+
+class tst_SoftwareRenderer : public QQmlDataTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void subtreeCache_data();
+    void subtreeCache();
+    void renderThreads();
+    void blitter_data();
+    void blitter();
+};
+
+void tst_SoftwareRenderer::initTestCase()
+{
+    QQuickWindow::setSceneGraphBackend(QSGRendererInterface::Software);
+    QQmlDataTest::initTestCase();
+}
+
+static int subtreeCacheCount(QQuickWindow *window)
+{
+    QSGRenderer *renderer = QQuickWindowPrivate::get(window)->renderer;
+    return renderer ? static_cast<QSGAbstractSoftwareRenderer *>(renderer)->subtreeCacheCount() : 0;
+}
+
+void tst_SoftwareRenderer::subtreeCache_data()
+{
+    QTest::addColumn<QString>("change");
+
+    QTest::newRow("node updated") << QStringLiteral("updated");
+    QTest::newRow("node added") << QStringLiteral("added");
+    QTest::newRow("node removed") << QStringLiteral("removed");
+    QTest::newRow("subtree hidden") << QStringLiteral("hidden");
+}
+
+// Static groups are replaced by cached images with QSG_SOFTWARE_SUBTREE_CACHE.
+// The frames must not differ from the uncached ones, and each kind of change
+// to a group must drop its cache.
+void tst_SoftwareRenderer::subtreeCache()
+{
+    QFETCH(QString, change);
+
+    const auto grab = [this, &change](bool cached, QImage *before, QImage *after) {
+        // Read when the window creates its renderer.
+        if (cached)
+            qputenv("QSG_SOFTWARE_SUBTREE_CACHE", "2");
+        QQuickView view;
+        view.setSource(testFileUrl("subtreeCache.qml"));
+        view.setResizeMode(QQuickView::SizeViewToRootObject);
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+        QQuickItem *root = view.rootObject();
+        QVERIFY(root);
+
+        for (int tick = 0; tick < 5; ++tick) {
+            root->setProperty("tick", tick);
+            *before = view.grabWindow();
+        }
+        qunsetenv("QSG_SOFTWARE_SUBTREE_CACHE");
+        const int caches = subtreeCacheCount(&view);
+        QCOMPARE(caches, cached ? 4 : 0);
+
+        QMetaObject::invokeMethod(root, "change", Q_ARG(QVariant, change));
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        root->setProperty("tick", 5);
+        *after = view.grabWindow();
+        QCOMPARE(subtreeCacheCount(&view), cached ? 3 : 0);
+    };
+
+    QImage uncachedBefore, uncachedAfter;
+    grab(false, &uncachedBefore, &uncachedAfter);
+    QImage cachedBefore, cachedAfter;
+    grab(true, &cachedBefore, &cachedAfter);
+
+    QVERIFY(!uncachedBefore.isNull());
+    QVERIFY(uncachedBefore != uncachedAfter);
+    QCOMPARE(cachedBefore, uncachedBefore);
+    QCOMPARE(cachedAfter, uncachedAfter);
+}
+
+// With QSG_SOFTWARE_RENDER_THREADS the dirty region is split into tiles that
+// are rasterized in parallel. The result must not differ from painting the
+// render list serially.
+void tst_SoftwareRenderer::renderThreads()
+{
+    const auto grab = [this](const QByteArray &threads, QImage *before, QImage *after) {
+        // Read when the window creates its renderer.
+        qputenv("QSG_SOFTWARE_RENDER_THREADS", threads);
+        QQuickView view;
+        view.setSource(testFileUrl("renderThreads.qml"));
+        view.setResizeMode(QQuickView::SizeViewToRootObject);
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+        *before = view.grabWindow();
+        qunsetenv("QSG_SOFTWARE_RENDER_THREADS");
+
+        QMetaObject::invokeMethod(view.rootObject(), "change");
+        *after = view.grabWindow();
+    };
+
+    QImage serialBefore, serialAfter;
+    grab("1", &serialBefore, &serialAfter);
+    QImage threadedBefore, threadedAfter;
+    grab("4", &threadedBefore, &threadedAfter);
+
+    QVERIFY(!serialBefore.isNull());
+    QVERIFY(serialBefore != serialAfter);
+    QCOMPARE(threadedBefore, serialBefore);
+    QCOMPARE(threadedAfter, serialAfter);
+}
+
+// Premultiplied pixels whose channels change by a few steps per pixel, so
+// that sampling a neighboring source pixel only makes a small difference.
+static QImage rampImage(int width, int height)
+{
+    QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x)
+            image.setPixel(x, y, qPremultiply(qRgba(40 + 4 * x, 200 - 4 * y, 100 + 2 * (x + y), 255 - 5 * y)));
+    }
+    return image;
+}
+
+static int maximumDifference(const QImage &a, const QImage &b)
+{
+    int difference = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        const QRgb *lineA = reinterpret_cast<const QRgb *>(a.constScanLine(y));
+        const QRgb *lineB = reinterpret_cast<const QRgb *>(b.constScanLine(y));
+        for (int x = 0; x < a.width(); ++x) {
+            difference = qMax(difference, qAbs(qRed(lineA[x]) - qRed(lineB[x])));
+            difference = qMax(difference, qAbs(qGreen(lineA[x]) - qGreen(lineB[x])));
+            difference = qMax(difference, qAbs(qBlue(lineA[x]) - qBlue(lineB[x])));
+            difference = qMax(difference, qAbs(qAlpha(lineA[x]) - qAlpha(lineB[x])));
+        }
+    }
+    return difference;
+}
+
+void tst_SoftwareRenderer::blitter_data()
+{
+    QTest::addColumn<QString>("primitive");
+    QTest::addColumn<qreal>("opacity");
+    QTest::addColumn<bool>("clipped");
+    QTest::addColumn<bool>("smooth");
+    QTest::addColumn<int>("tolerance");
+
+    const struct {
+        const char *primitive;
+        bool scaled;
+        int tolerance;
+    } primitives[] = {
+        { "opaqueRect", false, 2 },
+        { "translucentRect", false, 2 },
+        { "verticalGradient", false, 2 },
+        { "horizontalGradient", false, 2 },
+        { "pixmap", true, 8 },
+        { "ninePatch", true, 8 }
+    };
+
+    for (const auto &p : primitives) {
+        for (const qreal opacity : { 1.0, 0.6 }) {
+            for (const bool clipped : { false, true }) {
+                for (const bool smooth : { false, true }) {
+                    if (smooth && !p.scaled)
+                        continue;
+                    const QByteArray name = QByteArray(p.primitive)
+                            + (opacity < 1 ? " translucent" : "")
+                            + (clipped ? " clipped" : "")
+                            + (p.scaled ? (smooth ? " bilinear" : " nearest") : "");
+                    QTest::newRow(name.constData()) << QString::fromLatin1(p.primitive)
+                                                    << opacity << clipped << smooth << p.tolerance;
+                }
+            }
+        }
+    }
+}
+
+// The software renderer can paint rectangles, gradients and pixmaps straight
+// into the pixels of its target with QSG_SOFTWARE_BLITTER. The spans are
+// processed four (SSE2) or eight (NEON) pixels at a time with a scalar tail,
+// so every primitive is painted at widths hitting both. The result must
+// match QPainter, give or take rounding and, for scaled pixmaps, sampling a
+// neighboring source pixel.
+void tst_SoftwareRenderer::blitter()
+{
+    QFETCH(QString, primitive);
+    QFETCH(qreal, opacity);
+    QFETCH(bool, clipped);
+    QFETCH(bool, smooth);
+    QFETCH(int, tolerance);
+
+    const QPixmap pixmap = QPixmap::fromImage(rampImage(12, 12));
+    const QMargins margins(4, 3, 3, 4);
+    QGradientStops stops;
+    stops << QGradientStop(0, QColor(255, 0, 0)) << QGradientStop(0.4, QColor(0, 128, 255, 100))
+          << QGradientStop(1, QColor(20, 220, 40));
+
+    struct EnableBlitter {
+        EnableBlitter() : wasEnabled(QSGSoftwareBlitter::isEnabled()) { QSGSoftwareBlitter::setEnabled(true); }
+        ~EnableBlitter() { QSGSoftwareBlitter::setEnabled(wasEnabled); }
+        const bool wasEnabled;
+    } enableBlitter;
+
+    for (const int width : { 1, 3, 4, 5, 7, 8, 9, 13, 16, 19, 33 }) {
+        const QRect rect(3, 2, width, 15);
+        const auto paint = [&](bool blit) {
+            QImage image(48, 24, QImage::Format_ARGB32_Premultiplied);
+            for (int y = 0; y < image.height(); ++y) {
+                for (int x = 0; x < image.width(); ++x)
+                    image.setPixel(x, y, qRgb(5 * x, 255 - 10 * y, (x * y) % 256));
+            }
+
+            QPainter painter(&image);
+            if (clipped)
+                painter.setClipRegion(QRegion(4, 0, 5, 24) + QRegion(0, 6, 48, 7));
+            painter.setOpacity(opacity);
+            painter.setRenderHint(QPainter::SmoothPixmapTransform, smooth);
+            QSGSoftwareBlitter blitter(&painter);
+            if (blit && !blitter.isValid())
+                return QImage();
+
+            bool blitted = true;
+            if (primitive == QLatin1String("opaqueRect") || primitive == QLatin1String("translucentRect")) {
+                const QColor color = primitive == QLatin1String("opaqueRect")
+                        ? QColor(30, 140, 220) : QColor(230, 60, 20, 140);
+                if (blit)
+                    blitted = blitter.fillRect(rect, color);
+                else
+                    painter.fillRect(rect, color);
+            } else if (primitive.endsWith(QLatin1String("Gradient"))) {
+                const Qt::Orientation orientation = primitive == QLatin1String("verticalGradient")
+                        ? Qt::Vertical : Qt::Horizontal;
+                if (blit) {
+                    blitted = blitter.fillGradient(rect, stops, orientation);
+                } else {
+                    QLinearGradient gradient(rect.topLeft(), orientation == Qt::Vertical
+                                             ? rect.bottomLeft() + QPoint(0, 1)
+                                             : rect.topRight() + QPoint(1, 0));
+                    gradient.setStops(stops);
+                    painter.fillRect(rect, gradient);
+                }
+            } else if (primitive == QLatin1String("pixmap")) {
+                const QRect source(2, 1, 9, 10);
+                if (blit)
+                    blitted = blitter.drawPixmap(rect, pixmap, source);
+                else
+                    painter.drawPixmap(rect, pixmap, source);
+            } else {
+                // Stretched nine-patch, each section drawn on its own like qDrawBorderPixmap()
+                const QRect target(rect.x(), rect.y(), rect.width() + 8, rect.height());
+                if (blit) {
+                    blitted = blitter.drawBorderPixmap(target, margins, pixmap, margins);
+                } else {
+                    const int xs[4] = { 0, margins.left(), pixmap.width() - margins.right(), pixmap.width() };
+                    const int ys[4] = { 0, margins.top(), pixmap.height() - margins.bottom(), pixmap.height() };
+                    const int xt[4] = { target.left(), target.left() + margins.left(),
+                                        target.left() + target.width() - margins.right(),
+                                        target.left() + target.width() };
+                    const int yt[4] = { target.top(), target.top() + margins.top(),
+                                        target.top() + target.height() - margins.bottom(),
+                                        target.top() + target.height() };
+                    for (int row = 0; row < 3; ++row) {
+                        for (int column = 0; column < 3; ++column) {
+                            painter.drawPixmap(QRect(xt[column], yt[row], xt[column + 1] - xt[column], yt[row + 1] - yt[row]),
+                                               pixmap,
+                                               QRect(xs[column], ys[row], xs[column + 1] - xs[column], ys[row + 1] - ys[row]));
+                        }
+                    }
+                }
+            }
+            return blitted ? image : QImage();
+        };
+
+        const QImage expected = paint(false);
+        const QImage actual = paint(true);
+        QVERIFY2(!actual.isNull(), qPrintable(QString::fromLatin1("width %1 not blitted").arg(width)));
+        const int difference = maximumDifference(actual, expected);
+        QVERIFY2(difference <= tolerance,
+                 qPrintable(QString::fromLatin1("width %1 differs by %2").arg(width).arg(difference)));
+    }
+}
+
+QTEST_MAIN(tst_SoftwareRenderer)
+
+#include "tst_softwarerenderer.moc"
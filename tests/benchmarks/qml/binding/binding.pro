@@ -1,7 +1,7 @@
 CONFIG += benchmark
 TEMPLATE = app
 TARGET = tst_binding
-QT += qml testlib
+QT += qml-private testlib
 macx:CONFIG -= app_bundle
 
 SOURCES += tst_binding.cpp testtypes.cpp
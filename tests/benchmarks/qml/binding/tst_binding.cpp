@@ -32,6 +32,7 @@
 #include <QQmlComponent>
 #include <QFile>
 #include <QDebug>
+#include <private/qqmlengine_p.h>
 #include "testtypes.h"
 
 class tst_binding : public QObject
@@ -53,6 +54,8 @@ private slots:
     void basicproperty();
     void creation_data();
     void creation();
+    void batchedUpdates_data();
+    void batchedUpdates();
 
 private:
     QQmlEngine engine;
@@ -171,5 +174,50 @@ void tst_binding::creation()
     }
 }
 
+void tst_binding::batchedUpdates_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<QString>("binding");
+    QTest::addColumn<bool>("batched");
+    QTest::addColumn<int>("evaluationsPerChange");
+
+    QTest::newRow("diamond") << SRCDIR "/data/diamond.txt" << "left + right" << false << 2;
+    QTest::newRow("diamond, batched") << SRCDIR "/data/diamond.txt" << "left + right" << true << 1;
+    QTest::newRow("fan") << SRCDIR "/data/fan.txt" << "ab + cd" << false << 4;
+    QTest::newRow("fan, batched") << SRCDIR "/data/fan.txt" << "ab + cd" << true << 1;
+}
+
+void tst_binding::batchedUpdates()
+{
+    QFETCH(QString, file);
+    QFETCH(QString, binding);
+    QFETCH(bool, batched);
+    QFETCH(int, evaluationsPerChange);
+
+    QQmlEnginePrivate *ep = QQmlEnginePrivate::get(&engine);
+    const bool wasBatched = ep->batchedBindingUpdates;
+    ep->batchedBindingUpdates = batched;
+
+    COMPONENT(file, binding);
+
+    MyQmlObject *object = qobject_cast<MyQmlObject *>(c.create());
+    QVERIFY(object != 0);
+    ep->flushPendingBindingUpdates();
+
+    const int initialEvaluations = object->evaluations();
+    object->setValue(1);
+    ep->flushPendingBindingUpdates();
+    QCOMPARE(object->evaluations() - initialEvaluations, evaluationsPerChange);
+
+    int value = 1;
+    QBENCHMARK {
+        object->setValue(++value);
+        ep->flushPendingBindingUpdates();
+    }
+
+    delete object;
+    ep->batchedBindingUpdates = wasBatched;
+}
+
 QTEST_MAIN(tst_binding)
 #include "tst_binding.moc"
@@ -62,6 +62,8 @@ private slots:
     void itemtests_qml_data();
     void itemtests_qml();
 
+    void delegates_qml();
+
     void bindings_cpp();
     void bindings_cpp2();
     void bindings_qml();
@@ -335,6 +337,25 @@ void tst_creation::itemtests_qml()
     QBENCHMARK { delete component.create(); }
 }
 
+// Creates and destroys instances the way a view does with its delegates. Run with
+// QML_CREATION_ARENA=1 to compare with allocating the engine internal objects of each
+// instance from an arena.
+void tst_creation::delegates_qml()
+{
+    QQmlComponent component(&engine, TEST_FILE("delegate.qml"));
+    if (!component.isReady()) {
+        qWarning() << "Unable to create component: " << component.errorString();
+        return;
+    }
+
+    QVector<QObject *> delegates(100);
+    QBENCHMARK {
+        for (QObject *&delegate : delegates)
+            delegate = component.create();
+        qDeleteAll(delegates);
+    }
+}
+
 void tst_creation::bindings_cpp()
 {
     QQuickItem item;
@@ -7,7 +7,9 @@ SUBDIRS += \
            holistic \
            qqmlchangeset \
            qqmlcomponent \
+           qqmllistcompositor \
            qqmlmetaproperty \
+           qquicksoftwarerenderer \
            librarymetrics_performance \
            script \
            js \
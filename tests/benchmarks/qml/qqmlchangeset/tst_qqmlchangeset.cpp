@@ -38,6 +38,9 @@ class tst_qqmlchangeset : public QObject
 
 private slots:
     void move();
+    void insert();
+    void remove();
+    void change();
 };
 
 void tst_qqmlchangeset::move()
@@ -51,5 +54,38 @@ void tst_qqmlchangeset::move()
     }
 }
 
+void tst_qqmlchangeset::insert()
+{
+    QBENCHMARK {
+        QQmlChangeSet set;
+        const int MAX_ROWS = 30000;
+        for (int i = 0; i < MAX_ROWS; ++i) {
+            set.insert(2 * i, 1);
+        }
+    }
+}
+
+void tst_qqmlchangeset::remove()
+{
+    QBENCHMARK {
+        QQmlChangeSet set;
+        const int MAX_ROWS = 30000;
+        for (int i = 0; i < MAX_ROWS; ++i) {
+            set.remove(i, 1);
+        }
+    }
+}
+
+void tst_qqmlchangeset::change()
+{
+    QBENCHMARK {
+        QQmlChangeSet set;
+        const int MAX_ROWS = 30000;
+        for (int i = 0; i < MAX_ROWS; ++i) {
+            set.change(2 * i, 1);
+        }
+    }
+}
+
 QTEST_MAIN(tst_qqmlchangeset)
 #include "tst_qqmlchangeset.moc"
@@ -0,0 +1,10 @@
+CONFIG += benchmark
+TEMPLATE = app
+TARGET = tst_qqmllistcompositor
+QT += qml quick-private testlib
+osx:CONFIG -= app_bundle
+
+SOURCES += tst_qqmllistcompositor.cpp
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
+
@@ -0,0 +1,99 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <qtest.h>
+
+#include <private/qqmllistcompositor_p.h>
+
+class tst_qqmllistcompositor : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void find_data();
+    void find();
+    void setFlags();
+
+private:
+    void populate(QQmlListCompositor *compositor, int count);
+};
+
+static const QQmlListCompositor::Group Filtered = QQmlListCompositor::Group(3);
+
+// Puts every other item of a list of count items in the Filtered group, creating a range per item.
+void tst_qqmllistcompositor::populate(QQmlListCompositor *compositor, int count)
+{
+    static int list;
+    compositor->setGroupCount(4);
+    for (int i = 0; i < count; ++i) {
+        const uint flags = QQmlListCompositor::DefaultFlag | (i % 2 ? 0 : (1 << Filtered));
+        compositor->append(&list, i, 1, flags);
+    }
+}
+
+void tst_qqmllistcompositor::find_data()
+{
+    QTest::addColumn<int>("count");
+
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("100000") << 100000;
+}
+
+void tst_qqmllistcompositor::find()
+{
+    QFETCH(int, count);
+
+    QQmlListCompositor compositor;
+    populate(&compositor, count);
+    const int filteredCount = compositor.count(Filtered);
+
+    QBENCHMARK {
+        // Alternate between lookups in the filtered and default groups, far apart in both.
+        for (int i = 0; i < 1000; ++i) {
+            const int index = (i * 7919) % filteredCount;
+            QCOMPARE(compositor.find(Filtered, index).modelIndex(), 2 * index);
+            QCOMPARE(compositor.find(QQmlListCompositor::Default, count - 1 - index).modelIndex(), count - 1 - index);
+        }
+    }
+}
+
+void tst_qqmllistcompositor::setFlags()
+{
+    const int count = 100000;
+
+    QBENCHMARK {
+        QQmlListCompositor compositor;
+        populate(&compositor, count);
+        for (int i = 0; i < 1000; ++i)
+            compositor.setFlags(QQmlListCompositor::Default, (i * 7919) % count, 1, QQmlListCompositor::PersistedFlag);
+    }
+}
+
+QTEST_MAIN(tst_qqmllistcompositor)
+#include "tst_qqmllistcompositor.moc"
@@ -0,0 +1,9 @@
+CONFIG += benchmark
+TEMPLATE = app
+TARGET = tst_qquicksoftwarerenderer
+QT += qml quick testlib
+osx:CONFIG -= app_bundle
+
+SOURCES += tst_qquicksoftwarerenderer.cpp
+
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0
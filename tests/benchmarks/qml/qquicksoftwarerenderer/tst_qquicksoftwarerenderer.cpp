@@ -0,0 +1,174 @@
+/****************************************************************************
+**
+** Copyright (C) 2018 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtQml/QQmlComponent>
+#include <QtQml/QQmlEngine>
+#include <QtQuick/QQuickImageProvider>
+#include <QtQuick/QQuickItem>
+#include <QtQuick/QQuickView>
+#include <QtQuick/QSGRendererInterface>
+
+// Opaque content that still comes with an alpha channel, as most decoded PNGs do
+class TileImageProvider : public QQuickImageProvider
+{
+public:
+    TileImageProvider() : QQuickImageProvider(QQuickImageProvider::Image) {}
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &) override
+    {
+        QImage image(120, 90, QImage::Format_ARGB32_Premultiplied);
+        image.fill(id == QLatin1String("translucent") ? QColor(0, 0, 255, 128) : QColor(Qt::darkGreen));
+        if (size)
+            *size = image.size();
+        return image;
+    }
+};
+
+class tst_qquicksoftwarerenderer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void overlappingStacks_data();
+    void overlappingStacks();
+};
+
+static const char stacksQml[] =
+    "import QtQuick 2.0\n"
+    "Item {\n"
+    "    width: 640; height: 480\n"
+    "    property int depth\n"
+    "    property bool translucent\n"
+    "    property real shift: 0\n"
+    "    Repeater {\n"
+    "        model: 16\n"
+    "        Item {\n"
+    "            x: (index % 4) * 150 + shift; y: Math.floor(index / 4) * 110\n"
+    "            Repeater {\n"
+    "                model: depth\n"
+    "                Loader {\n"
+    "                    x: (index % 8) * 2; y: (index % 8) * 2\n"
+    "                    sourceComponent: index % 2 ? rect : image\n"
+    "                }\n"
+    "            }\n"
+    "        }\n"
+    "    }\n"
+    "    Component {\n"
+    "        id: rect\n"
+    "        Rectangle { width: 120; height: 90; color: translucent ? \"#80ff0000\" : \"red\" }\n"
+    "    }\n"
+    "    Component {\n"
+    "        id: image\n"
+    "        Image { source: translucent ? \"image://tiles/translucent\" : \"image://tiles/opaque\" }\n"
+    "    }\n"
+    "}\n";
+
+void tst_qquicksoftwarerenderer::initTestCase()
+{
+    QQuickWindow::setSceneGraphBackend(QSGRendererInterface::Software);
+}
+
+void tst_qquicksoftwarerenderer::overlappingStacks_data()
+{
+    QTest::addColumn<int>("depth");
+    QTest::addColumn<bool>("translucent");
+    QTest::addColumn<bool>("blitter");
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("opaque, depth 10") << 10 << false << false << 0;
+    QTest::newRow("opaque, depth 100") << 100 << false << false << 0;
+    QTest::newRow("opaque, depth 400") << 400 << false << false << 0;
+    QTest::newRow("translucent, depth 10") << 10 << true << false << 0;
+    QTest::newRow("translucent, depth 100") << 100 << true << false << 0;
+    QTest::newRow("translucent, depth 400") << 400 << true << false << 0;
+
+    // The same scenes with rectangles and images blitted directly
+    QTest::newRow("opaque, depth 100, blitter") << 100 << false << true << 0;
+    QTest::newRow("opaque, depth 400, blitter") << 400 << false << true << 0;
+    QTest::newRow("translucent, depth 100, blitter") << 100 << true << true << 0;
+    QTest::newRow("translucent, depth 400, blitter") << 400 << true << true << 0;
+
+    // The same scenes rasterized in tiles on several threads
+    QTest::newRow("opaque, depth 100, 4 threads") << 100 << false << false << 4;
+    QTest::newRow("opaque, depth 400, 4 threads") << 400 << false << false << 4;
+    QTest::newRow("translucent, depth 100, 4 threads") << 100 << true << false << 4;
+    QTest::newRow("translucent, depth 400, 4 threads") << 400 << true << false << 4;
+}
+
+void tst_qquicksoftwarerenderer::overlappingStacks()
+{
+    QFETCH(int, depth);
+    QFETCH(bool, translucent);
+    QFETCH(bool, blitter);
+    QFETCH(int, threads);
+
+    // Read by the renderer when the window creates it
+    if (blitter)
+        qputenv("QSG_SOFTWARE_BLITTER", "1");
+    else
+        qunsetenv("QSG_SOFTWARE_BLITTER");
+    if (threads)
+        qputenv("QSG_SOFTWARE_RENDER_THREADS", QByteArray::number(threads));
+    else
+        qunsetenv("QSG_SOFTWARE_RENDER_THREADS");
+
+    QQuickView view;
+    view.engine()->addImageProvider(QLatin1String("tiles"), new TileImageProvider);
+
+    QQmlComponent component(view.engine());
+    component.setData(stacksQml, QUrl());
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QQuickItem> root(qobject_cast<QQuickItem *>(component.beginCreate(view.engine()->rootContext())));
+    QVERIFY(root);
+    root->setProperty("depth", depth);
+    root->setProperty("translucent", translucent);
+    component.completeCreate();
+    root->setParentItem(view.contentItem());
+    view.resize(640, 480);
+
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    // Each frame moves every stack by one pixel, so the whole scene has to
+    // go through dirty and opaque region tracking again.
+    qreal shift = 0;
+    QBENCHMARK {
+        shift = shift ? 0 : 1;
+        root->setProperty("shift", shift);
+        QImage frame = view.grabWindow();
+        Q_UNUSED(frame);
+    }
+}
+
+QTEST_MAIN(tst_qquicksoftwarerenderer)
+
+#include "tst_qquicksoftwarerenderer.moc"
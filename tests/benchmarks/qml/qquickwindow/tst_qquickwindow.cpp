@@ -41,6 +41,10 @@ public:
 
 private slots:
     void tst_updateCursor();
+    void render_data();
+    void render();
+    void overlap_data();
+    void overlap();
     void cleanupTestCase();
 private:
     QQuickWindow* window;
@@ -73,6 +77,104 @@ void tst_qquickwindow::tst_updateCursor()
     }
 }
 
+void tst_qquickwindow::render_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("serial") << 1;
+    QTest::newRow("4 threads") << 4;
+}
+
+// 20000 rectangles in 200 clipped groups, each of which is a batch root. Every
+// frame adds and removes a node in each group, so that all of them are rebuilt
+// at once. QSG_RENDERER_THREADS spreads that work over several threads.
+void tst_qquickwindow::render()
+{
+    QFETCH(int, threads);
+
+    // Read when the window creates its renderer.
+    qputenv("QSG_RENDERER_THREADS", QByteArray::number(threads));
+
+    QQuickWindow renderWindow;
+    renderWindow.resize(400, 400);
+    QList<QQuickItem *> toggled;
+    for (int i = 0; i < 200; ++i) {
+        QQuickRectangle *group = new QQuickRectangle(renderWindow.contentItem());
+        group->setClip(true);
+        group->setPosition(QPointF(i % 20 * 20, i / 20 * 40));
+        group->setSize(QSizeF(20, 40));
+        for (int j = 0; j < 99; ++j) {
+            QQuickRectangle *r = new QQuickRectangle(group);
+            r->setPosition(QPointF(j % 5 * 4, j / 5 * 2));
+            r->setSize(QSizeF(4, 2));
+            r->setColor(j % 2 ? Qt::red : Qt::blue);
+        }
+        toggled.append(group->childItems().first());
+    }
+    renderWindow.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&renderWindow));
+    renderWindow.grabWindow();
+    qunsetenv("QSG_RENDERER_THREADS");
+
+    bool visible = true;
+    QBENCHMARK {
+        visible = !visible;
+        for (QQuickItem *item : qAsConst(toggled))
+            item->setVisible(visible);
+        renderWindow.grabWindow();
+    }
+}
+
+void tst_qquickwindow::overlap_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("grid");
+
+    QTest::newRow("500, linear") << 500 << false;
+    QTest::newRow("500, grid") << 500 << true;
+    QTest::newRow("2000, linear") << 2000 << false;
+    QTest::newRow("2000, grid") << 2000 << true;
+    QTest::newRow("8000, linear") << 8000 << false;
+    QTest::newRow("8000, grid") << 8000 << true;
+}
+
+// Translucent rectangles scattered over the window, alternating between
+// antialiased and plain ones, so that merging the alpha batches takes an
+// overlap check for nearly every element. Every frame shows or hides one of
+// them, so that the batches are merged again. Without the grid, each check
+// scans the render list from the start of the batch.
+void tst_qquickwindow::overlap()
+{
+    QFETCH(int, count);
+    QFETCH(bool, grid);
+
+    // Read when the window creates its renderer.
+    if (!grid)
+        qputenv("QSG_RENDERER_OVERLAP_GRID_THRESHOLD", QByteArray::number(count + 1));
+
+    QQuickWindow renderWindow;
+    renderWindow.resize(400, 400);
+    for (int i = 0; i < count; ++i) {
+        QQuickRectangle *r = new QQuickRectangle(renderWindow.contentItem());
+        r->setPosition(QPointF(i * 37 % 380, i * 53 % 390));
+        r->setSize(QSizeF(20, 10));
+        r->setAntialiasing(i % 2);
+        r->setColor(i % 3 ? QColor(255, 0, 0, 128) : QColor(0, 0, 255, 128));
+    }
+    QQuickItem *toggled = renderWindow.contentItem()->childItems().at(count / 2);
+    renderWindow.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&renderWindow));
+    renderWindow.grabWindow();
+    qunsetenv("QSG_RENDERER_OVERLAP_GRID_THRESHOLD");
+
+    bool visible = true;
+    QBENCHMARK {
+        visible = !visible;
+        toggled->setVisible(visible);
+        renderWindow.grabWindow();
+    }
+}
+
 QTEST_MAIN(tst_qquickwindow);
 
 #include "tst_qquickwindow.moc"